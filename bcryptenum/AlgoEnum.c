@@ -0,0 +1,406 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Documented algorithms as sets of their ids.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "AlgoEnum.h"
+#include "Timer.h"
+
+#ifdef _WIN32
+#include "CngBackend.h"
+#endif
+
+// ******** Private constants ********
+
+/// Block size of the arena of the process wide catalog.
+#define ALGOENUM_ARENA_BLOCK_SIZE 0x4000
+
+/// The process wide catalog has not been built.
+#define ALGOENUM_EMPTY    0
+
+/// The process wide catalog is being built, or its backend is being set.
+#define ALGOENUM_BUILDING 1
+
+/// The process wide catalog is ready.
+#define ALGOENUM_READY    2
+
+/// The process wide catalog could not be built.
+#define ALGOENUM_FAILED   3
+
+// ******** Private variables ********
+
+/// State of the process wide catalog.
+static volatile LONG algoEnumState = ALGOENUM_EMPTY;
+
+/// Backend of the process wide catalog. NULL, if the default backend is used.
+static const ALGORITHM_BACKEND* pAlgoEnumBackend = NULL;
+
+/// Arena of the process wide catalog. It is never released.
+static ARENA algoEnumArena;
+
+/// Process wide catalog.
+static ALGOENUM algoEnum;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Load the state of the process wide catalog.
+/// </summary>
+/// <returns>State.</returns>
+static LONG loadState(void) {
+#ifdef _WIN32
+   return InterlockedCompareExchange(&algoEnumState, 0, 0);
+#else
+   return __atomic_load_n(&algoEnumState, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/// <summary>
+/// Store the state of the process wide catalog.
+/// </summary>
+/// <param name="state">New state.</param>
+static void storeState(const LONG state) {
+#ifdef _WIN32
+   InterlockedExchange(&algoEnumState, state);
+#else
+   __atomic_store_n(&algoEnumState, state, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/// <summary>
+/// Change the state of the process wide catalog from empty to building.
+/// </summary>
+/// <returns>TRUE, if this thread changed the state, FALSE if the state was not empty.</returns>
+static BOOL claimState(void) {
+#ifdef _WIN32
+   return (InterlockedCompareExchange(&algoEnumState, ALGOENUM_BUILDING, ALGOENUM_EMPTY) == ALGOENUM_EMPTY);
+#else
+   LONG expected = ALGOENUM_EMPTY;
+   return __atomic_compare_exchange_n(&algoEnumState, &expected, ALGOENUM_BUILDING, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? TRUE : FALSE;
+#endif
+}
+
+/// <summary>
+/// Check, if an id is in a set of known algorithm ids.
+/// </summary>
+/// <param name="pSet">Set.</param>
+/// <param name="id">Id of a documented algorithm.</param>
+/// <returns>TRUE, if the id is in the set, FALSE if not.</returns>
+static BOOL isInKnownSet(const uint64_t* const pSet, const long id) {
+   return (BOOL) ((pSet[id >> 6] >> (id & 63)) & 1);
+}
+
+/// <summary>
+/// Find an algorithm that is not documented in the name index.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="hash">Hash of the name with KNOWN_HASH_SEED.</param>
+/// <returns>Index of the algorithm or -1, if the catalog does not contain the algorithm.</returns>
+static long findAlgorithm(const ALGOENUM* const pEnum, LPCWSTR const name, const ULONG hash) {
+   if (pEnum->pSlots == NULL)
+      return -1;
+
+   ULONG slot = hash & pEnum->slotMask;
+
+   for (;;) {
+      const ULONG entry = pEnum->pSlots[slot];
+      if (entry == 0)
+         return -1;
+
+      if (wcscmp(pEnum->catalog.pAlgorithms[entry - 1].pszName, name) == 0)
+         return (long) (entry - 1);
+
+      slot = (slot + 1) & pEnum->slotMask;
+   }
+}
+
+/// <summary>
+/// Add the documented algorithms of a catalog to the id sets and count the others.
+/// </summary>
+/// <param name="pEnum">Catalog with the algorithms.</param>
+/// <returns>Number of the algorithms that are not documented.</returns>
+static ULONG buildKnownSets(ALGOENUM* const pEnum) {
+   ULONG unknownCount = 0;
+
+   for (ULONG i = 0; i < pEnum->catalog.count; i++) {
+      const long id = FindKnownAlgorithm(pEnum->catalog.pAlgorithms[i].pszName);
+      if (id < 0) {
+         unknownCount++;
+         continue;
+      }
+
+      for (int b = 0; b < OPERATION_TYPE_COUNT; b++)
+         if ((pEnum->catalog.pOperations[i] & (1u << b)) != 0)
+            pEnum->knownSets[b][id >> 6] |= (uint64_t) 1 << (id & 63);
+   }
+
+   return unknownCount;
+}
+
+/// <summary>
+/// Build the name index of the algorithms that are not documented.
+/// The index has at least twice as many slots as there are names, so the probe sequences stay short.
+/// It uses the lower bits of the hash of the perfect hash, so a query only hashes the name once.
+/// </summary>
+/// <param name="pEnum">Catalog with the algorithms.</param>
+/// <param name="pArena">Arena of the index.</param>
+/// <param name="unknownCount">Number of the algorithms that are not documented.</param>
+/// <returns>TRUE, if the index could be built, FALSE if not.</returns>
+static BOOL buildNameIndex(ALGOENUM* const pEnum, ARENA* const pArena, const ULONG unknownCount) {
+   const PCHAR functionName = "buildNameIndex";
+
+   ULONG slotCount = 8;
+   while (slotCount < unknownCount * 2)
+      slotCount <<= 1;
+
+   pEnum->pSlots = ArenaAlloc(pArena, slotCount * sizeof(ULONG));
+   if (pEnum->pSlots == NULL) {
+      fprintf(stderr, "Function \"%s\": Arena allocation for name index failed.\n", functionName);
+      return FALSE;
+   }
+
+   memset(pEnum->pSlots, 0, slotCount * sizeof(ULONG));
+   pEnum->slotMask = slotCount - 1;
+
+   for (ULONG i = 0; i < pEnum->catalog.count; i++) {
+      LPCWSTR name = pEnum->catalog.pAlgorithms[i].pszName;
+      const ULONG hash = HashAlgorithmName(name, KNOWN_HASH_SEED);
+      if (FindHashedKnownAlgorithm(name, hash) >= 0)
+         continue;
+
+      ULONG slot = hash & pEnum->slotMask;
+
+      while (pEnum->pSlots[slot] != 0)
+         slot = (slot + 1) & pEnum->slotMask;
+
+      pEnum->pSlots[slot] = i + 1;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Build the process wide catalog.
+/// </summary>
+/// <returns>TRUE, if the catalog could be built, FALSE if not.</returns>
+static BOOL buildProcessAlgoEnum(void) {
+   const PCHAR functionName = "buildProcessAlgoEnum";
+
+   const ALGORITHM_BACKEND* pBackend = pAlgoEnumBackend;
+
+#ifdef _WIN32
+   if (pBackend == NULL)
+      pBackend = GetCngBackend();
+#endif
+
+   if (pBackend == NULL) {
+      fprintf(stderr, "Function \"%s\": No enumeration backend has been set.\n", functionName);
+      return FALSE;
+   }
+
+   InitArena(&algoEnumArena, GetProcessHeap(), ALGOENUM_ARENA_BLOCK_SIZE);
+
+   if (BuildAlgoEnum(pBackend, &algoEnumArena, &algoEnum, NULL) == FALSE) {
+      FreeArena(&algoEnumArena);
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Build the catalog of a backend and the index of its names.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pArena">Arena of the catalog. The catalog is released with the arena.</param>
+/// <param name="pEnum">Pointer to the catalog to fill. It is empty, if the catalog could not be built.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+/// <returns>TRUE, if the catalog could be built, FALSE if not.</returns>
+BOOL BuildAlgoEnum(const ALGORITHM_BACKEND* const pBackend,
+                   ARENA* const pArena,
+                   ALGOENUM* const pEnum,
+                   LIST_STATISTICS* const pStatistics) {
+   memset(pEnum, 0, sizeof(ALGOENUM));
+
+   // 1. Enumerate and sort the algorithms.
+   if (BuildAlgorithmCatalog(pBackend, pArena, &pEnum->catalog, pStatistics) == FALSE)
+      return FALSE;
+
+   // 2. Index the names. The catalog stays usable without the index.
+   const BOOL result = buildNameIndex(pEnum, pArena, buildKnownSets(pEnum));
+   EndListPhase(pStatistics, LIST_PHASE_COPY);
+
+   return result;
+}
+
+/// <summary>
+/// Get the operation types of an algorithm.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <returns>BCRYPT_*_OPERATION bit mask of the algorithm or 0, if the catalog does not contain the algorithm.</returns>
+ULONG GetAlgoEnumOperations(const ALGOENUM* const pEnum, LPCWSTR const name) {
+   const ULONG hash = HashAlgorithmName(name, KNOWN_HASH_SEED);
+   const long id = FindHashedKnownAlgorithm(name, hash);
+
+   if (id >= 0) {
+      ULONG operations = 0;
+      for (int b = 0; b < OPERATION_TYPE_COUNT; b++)
+         if (isInKnownSet(pEnum->knownSets[b], id) != FALSE)
+            operations |= 1u << b;
+
+      return operations;
+   }
+
+   const long index = findAlgorithm(pEnum, name, hash);
+
+   return (index >= 0) ? pEnum->catalog.pOperations[index] : 0;
+}
+
+/// <summary>
+/// Check, if an algorithm supports an operation type.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>TRUE, if the catalog contains the algorithm and it supports the type, FALSE if not.</returns>
+BOOL AlgoEnumSupports(const ALGOENUM* const pEnum, LPCWSTR const name, const ULONG operationType) {
+   const ULONG hash = HashAlgorithmName(name, KNOWN_HASH_SEED);
+   const long id = FindHashedKnownAlgorithm(name, hash);
+
+   // A documented name only needs the bit of its id in the set of the type.
+   if (id >= 0) {
+      for (int b = 0; b < OPERATION_TYPE_COUNT; b++)
+         if ((operationType & (1u << b)) != 0 && isInKnownSet(pEnum->knownSets[b], id) != FALSE)
+            return TRUE;
+
+      return FALSE;
+   }
+
+   const long index = findAlgorithm(pEnum, name, hash);
+
+   return (index >= 0 && (pEnum->catalog.pOperations[index] & operationType) != 0);
+}
+
+/// <summary>
+/// Start an iteration over the algorithms that support some operation types.
+/// The algorithms are returned in collation order of the names.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="operationMask">BCRYPT_*_OPERATION bit mask. ALL_OPERATIONS_MASK returns all algorithms.</param>
+/// <param name="pIterator">Iterator to initialize.</param>
+void BeginAlgoEnumIteration(const ALGOENUM* const pEnum, const ULONG operationMask, ALGOENUM_ITERATOR* const pIterator) {
+   pIterator->pEnum = pEnum;
+   pIterator->operationMask = operationMask;
+   pIterator->index = 0;
+}
+
+/// <summary>
+/// Get the next algorithm of an iteration.
+/// </summary>
+/// <param name="pIterator">Iterator.</param>
+/// <returns>Next algorithm or NULL, if there are no more algorithms.</returns>
+const BCRYPT_ALGORITHM_IDENTIFIER* NextAlgoEnumAlgorithm(ALGOENUM_ITERATOR* const pIterator) {
+   const ALGORITHM_CATALOG* pCatalog = &pIterator->pEnum->catalog;
+
+   while (pIterator->index < pCatalog->count) {
+      const ULONG i = pIterator->index++;
+
+      if ((pCatalog->pOperations[i] & pIterator->operationMask) != 0)
+         return &pCatalog->pAlgorithms[i];
+   }
+
+   return NULL;
+}
+
+/// <summary>
+/// Set the backend of the process wide catalog.
+/// This is only possible before the catalog is used for the first time.
+/// </summary>
+/// <param name="pBackend">Enumeration backend. It must live as long as the process uses the catalog.</param>
+/// <returns>TRUE, if the backend has been set, FALSE, if the catalog has already been built.</returns>
+BOOL SetAlgoEnumBackend(const ALGORITHM_BACKEND* const pBackend) {
+   // The state is claimed like for a build, so the backend can not change while a thread builds the catalog.
+   for (;;) {
+      if (claimState() != FALSE) {
+         pAlgoEnumBackend = pBackend;
+         storeState(ALGOENUM_EMPTY);
+         return TRUE;
+      }
+
+      if (loadState() != ALGOENUM_BUILDING)
+         return FALSE;
+
+      SleepMilliseconds(1);
+   }
+}
+
+/// <summary>
+/// Get the process wide catalog. It is built on the first call.
+/// Threads that call this while the catalog is built wait for it.
+/// </summary>
+/// <returns>Catalog or NULL, if it could not be built.</returns>
+const ALGOENUM* GetAlgoEnum(void) {
+   for (;;) {
+      const LONG state = loadState();
+
+      if (state == ALGOENUM_READY)
+         return &algoEnum;
+
+      if (state == ALGOENUM_FAILED)
+         return NULL;
+
+      if (state == ALGOENUM_EMPTY && claimState() != FALSE) {
+         const BOOL result = buildProcessAlgoEnum();
+         storeState((result != FALSE) ? ALGOENUM_READY : ALGOENUM_FAILED);
+         return (result != FALSE) ? &algoEnum : NULL;
+      }
+
+      // Another thread builds the catalog or sets the backend.
+      SleepMilliseconds(1);
+   }
+}
+
+/// <summary>
+/// Check, if an algorithm of the process wide catalog supports an operation type.
+/// </summary>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>TRUE, if the algorithm supports the type, FALSE if not or if the catalog could not be built.</returns>
+BOOL IsAlgorithmSupported(LPCWSTR const name, const ULONG operationType) {
+   const ALGOENUM* pEnum = GetAlgoEnum();
+   if (pEnum == NULL)
+      return FALSE;
+
+   return AlgoEnumSupports(pEnum, name, operationType);
+}
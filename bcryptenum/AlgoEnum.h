@@ -0,0 +1,112 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "AlgorithmCatalog.h"
+#include "Arena.h"
+#include "KnownAlgorithms.h"
+#include "ListStatistics.h"
+
+/// <summary>
+/// Immutable catalog of a backend with an index of the exact algorithm names.
+/// The documented algorithms are kept as sets of their ids, all other names in a hash index.
+/// After it has been built it is only read, so any number of threads may query it.
+/// The memory belongs to the arena it was built in.
+/// </summary>
+typedef struct _ALGOENUM {
+   /// Catalog of all algorithms.
+   ALGORITHM_CATALOG catalog;
+
+   /// Ids of the documented algorithms of the catalog for each operation type.
+   /// The index is the number of the bit of the BCRYPT_*_OPERATION type.
+   uint64_t knownSets[OPERATION_TYPE_COUNT][KNOWN_SET_WORDS];
+
+   /// Open addressing index of the names that are not documented.
+   /// Each slot holds the catalog index + 1, or 0, if the slot is empty.
+   ULONG* pSlots;
+
+   /// Number of slots - 1. The number of slots is a power of 2.
+   ULONG slotMask;
+} ALGOENUM;
+
+/// <summary>
+/// Iterator over the algorithms of a catalog that support some operation types.
+/// </summary>
+typedef struct _ALGOENUM_ITERATOR {
+   /// Catalog that is iterated.
+   const ALGOENUM* pEnum;
+
+   /// BCRYPT_*_OPERATION bit mask. An algorithm is returned, if it supports any of these types.
+   ULONG operationMask;
+
+   /// Index of the next algorithm to look at.
+   ULONG index;
+} ALGOENUM_ITERATOR;
+
+/// <summary>
+/// Build the catalog of a backend and the index of its names.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pArena">Arena of the catalog. The catalog is released with the arena.</param>
+/// <param name="pEnum">Pointer to the catalog to fill. It is empty, if the catalog could not be built.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+/// <returns>TRUE, if the catalog could be built, FALSE if not.</returns>
+BOOL BuildAlgoEnum(const ALGORITHM_BACKEND* const pBackend,
+                   ARENA* const pArena,
+                   ALGOENUM* const pEnum,
+                   LIST_STATISTICS* const pStatistics);
+
+/// <summary>
+/// Get the operation types of an algorithm.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <returns>BCRYPT_*_OPERATION bit mask of the algorithm or 0, if the catalog does not contain the algorithm.</returns>
+ULONG GetAlgoEnumOperations(const ALGOENUM* const pEnum, LPCWSTR const name);
+
+/// <summary>
+/// Check, if an algorithm supports an operation type.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>TRUE, if the catalog contains the algorithm and it supports the type, FALSE if not.</returns>
+BOOL AlgoEnumSupports(const ALGOENUM* const pEnum, LPCWSTR const name, const ULONG operationType);
+
+/// <summary>
+/// Start an iteration over the algorithms that support some operation types.
+/// The algorithms are returned in collation order of the names.
+/// </summary>
+/// <param name="pEnum">Catalog.</param>
+/// <param name="operationMask">BCRYPT_*_OPERATION bit mask. ALL_OPERATIONS_MASK returns all algorithms.</param>
+/// <param name="pIterator">Iterator to initialize.</param>
+void BeginAlgoEnumIteration(const ALGOENUM* const pEnum, const ULONG operationMask, ALGOENUM_ITERATOR* const pIterator);
+
+/// <summary>
+/// Get the next algorithm of an iteration.
+/// </summary>
+/// <param name="pIterator">Iterator.</param>
+/// <returns>Next algorithm or NULL, if there are no more algorithms.</returns>
+const BCRYPT_ALGORITHM_IDENTIFIER* NextAlgoEnumAlgorithm(ALGOENUM_ITERATOR* const pIterator);
+
+/// <summary>
+/// Set the backend of the process wide catalog.
+/// This is only possible before the catalog is used for the first time.
+/// </summary>
+/// <param name="pBackend">Enumeration backend. It must live as long as the process uses the catalog.</param>
+/// <returns>TRUE, if the backend has been set, FALSE, if the catalog has already been built.</returns>
+BOOL SetAlgoEnumBackend(const ALGORITHM_BACKEND* const pBackend);
+
+/// <summary>
+/// Get the process wide catalog. It is built on the first call.
+/// Threads that call this while the catalog is built wait for it.
+/// </summary>
+/// <returns>Catalog or NULL, if it could not be built.</returns>
+const ALGOENUM* GetAlgoEnum(void);
+
+/// <summary>
+/// Check, if an algorithm of the process wide catalog supports an operation type.
+/// </summary>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>TRUE, if the algorithm supports the type, FALSE if not or if the catalog could not be built.</returns>
+BOOL IsAlgorithmSupported(LPCWSTR const name, const ULONG operationType);
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "FileMapping.h"
+#include "Platform.h"
+
+/// <summary>
+/// Version numbers of a module.
+/// </summary>
+typedef struct _MODULE_VERSION {
+   USHORT major;
+   USHORT minor;
+   USHORT build;
+   USHORT revision;
+} MODULE_VERSION;
+
+/// <summary>
+/// Enumeration backend.
+/// The listing functions only talk to the algorithm provider through this interface.
+/// </summary>
+typedef struct _ALGORITHM_BACKEND {
+   /// Name of the backend for messages.
+   const char* name;
+
+   /// Backend specific data that is passed to all functions.
+   PVOID context;
+
+   /// <summary>
+   /// Get the list of algorithms that support at least one of the operations in the operation mask.
+   /// The list has to be released with FreeBuffer.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="operationMask">Bit mask of BCRYPT_*_OPERATION values.</param>
+   /// <param name="pAlgoCount">Pointer to the variable that receives the number of algorithms.</param>
+   /// <param name="ppAlgoList">Pointer to the variable that receives the algorithm list.</param>
+   /// <returns>NTSTATUS of the enumeration.</returns>
+   NTSTATUS (*EnumAlgorithms)(PVOID const context,
+                              const ULONG operationMask,
+                              ULONG* const pAlgoCount,
+                              BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList);
+
+   /// <summary>
+   /// Release a buffer returned by the backend.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="pBuffer">Buffer to release.</param>
+   void (*FreeBuffer)(PVOID const context, PVOID const pBuffer);
+
+   /// <summary>
+   /// Get the version of the module that implements the algorithms.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="moduleName">Name of the module.</param>
+   /// <param name="pVersion">Pointer to the version structure to fill.</param>
+   /// <returns>TRUE, if the version could be determined, FALSE if not.</returns>
+   BOOL (*GetModuleVersion)(PVOID const context, const PCHAR moduleName, MODULE_VERSION* const pVersion);
+
+   /// <summary>
+   /// Get the modification time and size of the file of the module that implements the algorithms.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="moduleName">Name of the module.</param>
+   /// <param name="pStamp">Pointer to the file stamp to fill.</param>
+   /// <returns>TRUE, if the file stamp could be determined, FALSE if not.</returns>
+   BOOL (*GetModuleStamp)(PVOID const context, const PCHAR moduleName, FILE_STAMP* const pStamp);
+
+   /// <summary>
+   /// Open an algorithm provider. This function may be called from several threads at the same time.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="algorithmName">Name of the algorithm.</param>
+   /// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+   /// <returns>NTSTATUS of the open operation.</returns>
+   NTSTATUS (*OpenAlgorithm)(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm);
+
+   /// <summary>
+   /// Get a property of an algorithm provider.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   /// <param name="property">Name of the property.</param>
+   /// <param name="pOutput">Buffer that receives the property value.</param>
+   /// <param name="outputLength">Size of the buffer.</param>
+   /// <param name="pResultLength">Pointer to the variable that receives the size of the property value.</param>
+   /// <returns>NTSTATUS of the query.</returns>
+   NTSTATUS (*GetProperty)(PVOID const context,
+                           BCRYPT_ALG_HANDLE const hAlgorithm,
+                           LPCWSTR const property,
+                           PUCHAR const pOutput,
+                           const ULONG outputLength,
+                           ULONG* const pResultLength);
+
+   /// <summary>
+   /// Set a property of an algorithm provider.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   /// <param name="property">Name of the property.</param>
+   /// <param name="pInput">Property value.</param>
+   /// <param name="inputLength">Size of the property value.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*SetProperty)(PVOID const context,
+                           BCRYPT_ALG_HANDLE const hAlgorithm,
+                           LPCWSTR const property,
+                           PUCHAR const pInput,
+                           const ULONG inputLength);
+
+   /// <summary>
+   /// Close an algorithm provider.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   void (*CloseAlgorithm)(PVOID const context, BCRYPT_ALG_HANDLE const hAlgorithm);
+
+   /// <summary>
+   /// Get the list of the registered providers.
+   /// The list has to be released with FreeBuffer.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+   /// <param name="ppProviders">Pointer to the variable that receives the list.</param>
+   /// <returns>NTSTATUS of the enumeration.</returns>
+   NTSTATUS (*EnumProviders)(PVOID const context, ULONG* const pBufferSize, PCRYPT_PROVIDERS* const ppProviders);
+
+   /// <summary>
+   /// Get the registration of a provider for one interface.
+   /// The registration has to be released with FreeBuffer.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="providerName">Name of the provider.</param>
+   /// <param name="mode">CRYPT_UM, CRYPT_KM or CRYPT_ANY.</param>
+   /// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+   /// <param name="pBufferSize">Pointer to the variable that receives the size of the registration.</param>
+   /// <param name="ppRegistration">Pointer to the variable that receives the registration.</param>
+   /// <returns>NTSTATUS of the query. STATUS_NOT_FOUND, if the provider has no functions for the interface.</returns>
+   NTSTATUS (*QueryProviderRegistration)(PVOID const context,
+                                         LPCWSTR const providerName,
+                                         const ULONG mode,
+                                         const ULONG interfaceId,
+                                         ULONG* const pBufferSize,
+                                         PCRYPT_PROVIDER_REG* const ppRegistration);
+
+   /// <summary>
+   /// Get the list of the configuration contexts of a table.
+   /// The list has to be released with FreeBuffer.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+   /// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+   /// <param name="ppContexts">Pointer to the variable that receives the list.</param>
+   /// <returns>NTSTATUS of the enumeration.</returns>
+   NTSTATUS (*EnumContexts)(PVOID const context, const ULONG table, ULONG* const pBufferSize, PCRYPT_CONTEXTS* const ppContexts);
+
+   /// <summary>
+   /// Get the list of the functions of an interface in a configuration context.
+   /// The list has to be released with FreeBuffer.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+   /// <param name="contextName">Name of the configuration context.</param>
+   /// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+   /// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+   /// <param name="ppFunctions">Pointer to the variable that receives the list.</param>
+   /// <returns>NTSTATUS of the enumeration.</returns>
+   NTSTATUS (*EnumContextFunctions)(PVOID const context,
+                                    const ULONG table,
+                                    LPCWSTR const contextName,
+                                    const ULONG interfaceId,
+                                    ULONG* const pBufferSize,
+                                    PCRYPT_CONTEXT_FUNCTIONS* const ppFunctions);
+
+   /// <summary>
+   /// Get the providers of a function in a configuration context in the order of their priority.
+   /// The list has to be released with FreeBuffer.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+   /// <param name="contextName">Name of the configuration context.</param>
+   /// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+   /// <param name="functionName">Name of the function, i.e. the algorithm.</param>
+   /// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+   /// <param name="ppProviders">Pointer to the variable that receives the list.</param>
+   /// <returns>NTSTATUS of the enumeration.</returns>
+   NTSTATUS (*EnumContextFunctionProviders)(PVOID const context,
+                                            const ULONG table,
+                                            LPCWSTR const contextName,
+                                            const ULONG interfaceId,
+                                            LPCWSTR const functionName,
+                                            ULONG* const pBufferSize,
+                                            PCRYPT_CONTEXT_FUNCTION_PROVIDERS* const ppProviders);
+
+   /// <summary>
+   /// Bring the backend up to date before the algorithms are enumerated again, e.g. re-read a changed snapshot file.
+   /// No buffer returned by the backend may be in use.
+   /// </summary>
+   /// <param name="context">Backend context.</param>
+   /// <returns>TRUE, if the backend is up to date, FALSE if it could not be refreshed. It then keeps its previous state.</returns>
+   BOOL (*Refresh)(PVOID const context);
+} ALGORITHM_BACKEND;
+
+/// Mask of all operation types.
+#define ALL_OPERATIONS_MASK (BCRYPT_CIPHER_OPERATION | \
+                             BCRYPT_HASH_OPERATION | \
+                             BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION | \
+                             BCRYPT_SECRET_AGREEMENT_OPERATION | \
+                             BCRYPT_SIGNATURE_OPERATION | \
+                             BCRYPT_RNG_OPERATION | \
+                             BCRYPT_KEY_DERIVATION_OPERATION)
+
+/// Number of operation types.
+#define OPERATION_TYPE_COUNT 7
+
+/// Operation types in the order they are listed.
+extern const ULONG OperationTypes[OPERATION_TYPE_COUNT];
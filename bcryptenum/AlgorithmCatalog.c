@@ -0,0 +1,271 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Catalog memory from an arena.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "AlgorithmCatalog.h"
+#include "ApiErrorHandler.h"
+#include "ListEmitter.h"
+#include "NameSort.h"
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the operation type of an algorithm from its interface class.
+/// </summary>
+/// <param name="algorithmClass">BCRYPT_*_INTERFACE class.</param>
+/// <returns>BCRYPT_*_OPERATION type or 0, if the class is not known.</returns>
+static ULONG getClassOperation(const ULONG algorithmClass) {
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      if (OperationTypeInterface(OperationTypes[t]) == algorithmClass)
+         return OperationTypes[t];
+
+   return 0;
+}
+
+/// <summary>
+/// Copy the sorted algorithms into the catalog and intern their names.
+/// An algorithm that is enumerated more than once is stored once with the operations of all entries.
+/// The catalog memory must have room for all enumerated algorithms.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="ppSorted">Pointers to the enumerated algorithms in collation order of the names.</param>
+/// <param name="algoCount">Number of enumerated algorithms.</param>
+static void internAlgorithms(ALGORITHM_CATALOG* const pCatalog, BCRYPT_ALGORITHM_IDENTIFIER** const ppSorted, const ULONG algoCount) {
+   // Copy the algorithms in sorted order. Their names are stored in the same order, one after the other.
+   BCRYPT_ALGORITHM_IDENTIFIER* pActAlgo = pCatalog->pAlgorithms - 1;
+   wchar_t* pNextName = pCatalog->pNameArena;
+   ULONG count = 0;
+   for (ULONG i = 0; i < algoCount; i++) {
+      const BCRYPT_ALGORITHM_IDENTIFIER* pSource = ppSorted[i];
+      ULONG operation = getClassOperation(pSource->dwClass);
+
+      if (count != 0 && wcscmp(pActAlgo->pszName, pSource->pszName) == 0) {
+         pCatalog->pOperations[count - 1] |= operation;
+         continue;
+      }
+
+      size_t nameLength = wcslen(pSource->pszName) + 1;
+      memcpy(pNextName, pSource->pszName, nameLength * sizeof(wchar_t));
+
+      pActAlgo++;
+      pActAlgo->pszName = pNextName;
+      pActAlgo->dwClass = pSource->dwClass;
+      pActAlgo->dwFlags = pSource->dwFlags;
+      pCatalog->pOperations[count] = operation;
+
+      pNextName += nameLength;
+      count++;
+   }
+
+   pCatalog->count = count;
+}
+
+/// <summary>
+/// Add the signature operation to the asymmetric ciphers that can sign.
+/// These are the only algorithms whose operation types do not all follow from their class,
+/// so one more enumeration of the signature algorithms is needed for them.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pCatalog">Catalog.</param>
+/// <returns>TRUE, if the signature algorithms could be enumerated, FALSE if not.</returns>
+static BOOL addSigningCiphers(const ALGORITHM_BACKEND* const pBackend, ALGORITHM_CATALOG* const pCatalog) {
+   const PCHAR functionName = "addSigningCiphers";
+
+   ULONG algoCount;
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList;
+   NTSTATUS nts = pBackend->EnumAlgorithms(pBackend->context, BCRYPT_SIGNATURE_OPERATION, &algoCount, &pAlgoList);
+   if (nts < 0) {
+      PrintNtStatus(functionName, "EnumAlgorithms", nts);
+      return FALSE;
+   }
+
+   for (ULONG i = 0; i < algoCount; i++)
+      if (pAlgoList[i].dwClass != BCRYPT_SIGNATURE_INTERFACE) {
+         long index = FindCatalogAlgorithm(pCatalog, pAlgoList[i].pszName);
+         if (index >= 0)
+            pCatalog->pOperations[index] |= BCRYPT_SIGNATURE_OPERATION;
+      }
+
+   pBackend->FreeBuffer(pBackend->context, pAlgoList);
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Build the catalog of a backend.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pArena">Arena of the catalog. The catalog is released with the arena.</param>
+/// <param name="pCatalog">Pointer to the catalog to fill. It is empty, if the catalog could not be built.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+/// <returns>TRUE, if the catalog could be built, FALSE if not.</returns>
+BOOL BuildAlgorithmCatalog(const ALGORITHM_BACKEND* const pBackend,
+                           ARENA* const pArena,
+                           ALGORITHM_CATALOG* const pCatalog,
+                           LIST_STATISTICS* const pStatistics) {
+   const PCHAR functionName = "BuildAlgorithmCatalog";
+
+   memset(pCatalog, 0, sizeof(ALGORITHM_CATALOG));
+
+   // 1. Get all algorithms with one call.
+   ULONG algoCount;
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList;
+   NTSTATUS nts = pBackend->EnumAlgorithms(pBackend->context, ALL_OPERATIONS_MASK, &algoCount, &pAlgoList);
+   if (nts < 0) {
+      PrintNtStatus(functionName, "EnumAlgorithms", nts);
+      return FALSE;
+   }
+
+   EndListPhase(pStatistics, LIST_PHASE_ENUMERATION);
+
+   // 2. Allocate the algorithms, their operations and the names in one block, and temporary pointers for the sort behind it.
+   size_t nameLength = 0;
+   for (ULONG i = 0; i < algoCount; i++)
+      nameLength += wcslen(pAlgoList[i].pszName) + 1;
+
+   ARENA_MARK start;
+   GetArenaMark(pArena, &start);
+
+   PUCHAR pBlock = ArenaAlloc(pArena, algoCount * (sizeof(BCRYPT_ALGORITHM_IDENTIFIER) + sizeof(ULONG)) + nameLength * sizeof(wchar_t));
+
+   ARENA_MARK sortStart;
+   GetArenaMark(pArena, &sortStart);
+
+   BCRYPT_ALGORITHM_IDENTIFIER** ppSorted = ArenaAlloc(pArena, algoCount * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*));
+   if (pBlock == NULL || ppSorted == NULL) {
+      fprintf(stderr, "Function \"%s\": Arena allocation for algorithm catalog failed.\n", functionName);
+      ResetArena(pArena, &start);
+      pBackend->FreeBuffer(pBackend->context, pAlgoList);
+      return FALSE;
+   }
+
+   pCatalog->pAlgorithms = (BCRYPT_ALGORITHM_IDENTIFIER*)pBlock;
+   pCatalog->pOperations = (ULONG*)(pCatalog->pAlgorithms + algoCount);
+   pCatalog->pNameArena = (wchar_t*)(pCatalog->pOperations + algoCount);
+
+   // 3. Sort pointers to the algorithms by name.
+   for (ULONG i = 0; i < algoCount; i++)
+      ppSorted[i] = pAlgoList + i;
+
+   EndListPhase(pStatistics, LIST_PHASE_COPY);
+
+   BOOL result = SortAlgorithms(ppSorted, algoCount);
+   EndListPhase(pStatistics, LIST_PHASE_SORT);
+
+   // 4. Copy the algorithms and their names into the catalog. The sort pointers are not needed after that.
+   if (result != FALSE)
+      internAlgorithms(pCatalog, ppSorted, algoCount);
+
+   ResetArena(pArena, &sortStart);
+   EndListPhase(pStatistics, LIST_PHASE_COPY);
+
+   pBackend->FreeBuffer(pBackend->context, pAlgoList);
+
+   // 5. Complete the operations and count the algorithms of each type.
+   if (result != FALSE)
+      result = addSigningCiphers(pBackend, pCatalog);
+
+   EndListPhase(pStatistics, LIST_PHASE_ENUMERATION);
+
+   if (result == FALSE) {
+      ResetArena(pArena, &start);
+      memset(pCatalog, 0, sizeof(ALGORITHM_CATALOG));
+      return FALSE;
+   }
+
+   for (ULONG i = 0; i < pCatalog->count; i++)
+      for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+         if ((pCatalog->pOperations[i] & OperationTypes[t]) != 0)
+            pCatalog->typeCounts[t]++;
+
+   EndListPhase(pStatistics, LIST_PHASE_COPY);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the number of algorithms of an operation type.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>Number of algorithms of this type.</returns>
+ULONG GetCatalogTypeCount(const ALGORITHM_CATALOG* const pCatalog, const ULONG operationType) {
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      if (OperationTypes[t] == operationType)
+         return pCatalog->typeCounts[t];
+
+   return 0;
+}
+
+/// <summary>
+/// Get the algorithms of an operation type in collation order of the names.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="ppView">Array that receives the pointers to the algorithms. It must have room for GetCatalogTypeCount pointers.</param>
+/// <returns>Number of algorithms of this type.</returns>
+ULONG GetCatalogView(const ALGORITHM_CATALOG* const pCatalog, const ULONG operationType, BCRYPT_ALGORITHM_IDENTIFIER** const ppView) {
+   ULONG count = 0;
+
+   for (ULONG i = 0; i < pCatalog->count; i++)
+      if ((pCatalog->pOperations[i] & operationType) != 0)
+         ppView[count++] = pCatalog->pAlgorithms + i;
+
+   return count;
+}
+
+/// <summary>
+/// Find an algorithm by name.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="name">Name of the algorithm.</param>
+/// <returns>Index of the algorithm or -1, if the catalog does not contain the algorithm.</returns>
+long FindCatalogAlgorithm(const ALGORITHM_CATALOG* const pCatalog, LPCWSTR const name) {
+   // The algorithms are sorted by name, so this is a binary search.
+   ULONG low = 0;
+   ULONG high = pCatalog->count;
+   while (low < high) {
+      ULONG middle = low + ((high - low) >> 1);
+
+      int order = CompareNames(pCatalog->pAlgorithms[middle].pszName, name);
+      if (order == 0)
+         return (long)middle;
+
+      if (order < 0)
+         low = middle + 1;
+      else
+         high = middle;
+   }
+
+   return -1;
+}
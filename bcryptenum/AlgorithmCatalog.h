@@ -0,0 +1,66 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "Arena.h"
+#include "ListStatistics.h"
+
+/// <summary>
+/// All algorithms of a backend, sorted by name.
+/// Each algorithm is stored once, with the bit mask of the operation types it supports.
+/// The names are interned in one contiguous arena.
+/// The memory of the catalog belongs to the arena it was built in.
+/// </summary>
+typedef struct _ALGORITHM_CATALOG {
+   /// Number of algorithms.
+   ULONG count;
+
+   /// Algorithms in collation order of the names. The names point into the name arena.
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgorithms;
+
+   /// BCRYPT_*_OPERATION bit mask of each algorithm.
+   ULONG* pOperations;
+
+   /// Names of all algorithms, each terminated by a 0.
+   wchar_t* pNameArena;
+
+   /// Number of algorithms of each type in the order of OperationTypes.
+   ULONG typeCounts[OPERATION_TYPE_COUNT];
+} ALGORITHM_CATALOG;
+
+/// <summary>
+/// Build the catalog of a backend.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pArena">Arena of the catalog. The catalog is released with the arena.</param>
+/// <param name="pCatalog">Pointer to the catalog to fill. It is empty, if the catalog could not be built.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+/// <returns>TRUE, if the catalog could be built, FALSE if not.</returns>
+BOOL BuildAlgorithmCatalog(const ALGORITHM_BACKEND* const pBackend,
+                           ARENA* const pArena,
+                           ALGORITHM_CATALOG* const pCatalog,
+                           LIST_STATISTICS* const pStatistics);
+
+/// <summary>
+/// Get the number of algorithms of an operation type.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>Number of algorithms of this type.</returns>
+ULONG GetCatalogTypeCount(const ALGORITHM_CATALOG* const pCatalog, const ULONG operationType);
+
+/// <summary>
+/// Get the algorithms of an operation type in collation order of the names.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="ppView">Array that receives the pointers to the algorithms. It must have room for GetCatalogTypeCount pointers.</param>
+/// <returns>Number of algorithms of this type.</returns>
+ULONG GetCatalogView(const ALGORITHM_CATALOG* const pCatalog, const ULONG operationType, BCRYPT_ALGORITHM_IDENTIFIER** const ppView);
+
+/// <summary>
+/// Find an algorithm by name.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+/// <param name="name">Name of the algorithm.</param>
+/// <returns>Index of the algorithm or -1, if the catalog does not contain the algorithm.</returns>
+long FindCatalogAlgorithm(const ALGORITHM_CATALOG* const pCatalog, LPCWSTR const name);
@@ -0,0 +1,152 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 2.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Collect phase statistics.
+//    2026-10-16: V2.0.0: Lists are views of the algorithm catalog.
+//    2026-10-16: V2.1.0: Lists and shared detail records from an arena.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "AlgorithmList.h"
+
+// ******** Public methods ********
+
+/// <summary>
+/// Initialize a details table for a catalog. No algorithm has a record yet.
+/// </summary>
+/// <param name="pTable">Details table.</param>
+/// <param name="pCatalog">Algorithm catalog.</param>
+/// <param name="pArena">Arena of the table and its records.</param>
+/// <returns>TRUE, if the table could be allocated, FALSE if not.</returns>
+BOOL InitDetailsTable(DETAILS_TABLE* const pTable, const ALGORITHM_CATALOG* const pCatalog, ARENA* const pArena) {
+   const PCHAR functionName = "InitDetailsTable";
+
+   InitRecordPool(&pTable->pool, pArena, sizeof(ALGORITHM_DETAILS));
+
+   pTable->ppRecords = ArenaAlloc(pArena, pCatalog->count * sizeof(ALGORITHM_DETAILS*));
+   if (pTable->ppRecords == NULL) {
+      fprintf(stderr, "Function \"%s\": Arena allocation for details table failed.\n", functionName);
+      return FALSE;
+   }
+
+   memset(pTable->ppRecords, 0, pCatalog->count * sizeof(ALGORITHM_DETAILS*));
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the algorithms of an operation type from the catalog in collation order of the names.
+/// If there is a details table, the list gets the detail records of its algorithms.
+/// The algorithms that do not have a record yet get one and have to be probed by this list.
+/// </summary>
+/// <param name="pCatalog">Algorithm catalog. It must be kept until the list is no longer used.</param>
+/// <param name="pArena">Arena of the list.</param>
+/// <param name="algorithmType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pTable">Details table of the catalog. NULL, if the capabilities are not needed.</param>
+/// <param name="pList">Pointer to the structure that receives the sorted algorithms.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+/// <returns>TRUE, if the list could be built, FALSE if not.</returns>
+BOOL GetSortedAlgorithms(const ALGORITHM_CATALOG* const pCatalog,
+                         ARENA* const pArena,
+                         const ULONG algorithmType,
+                         DETAILS_TABLE* const pTable,
+                         SORTED_ALGORITHMS* const pList,
+                         LIST_STATISTICS* const pStatistics) {
+   const PCHAR functionName = "GetSortedAlgorithms";
+
+   memset(pList, 0, sizeof(SORTED_ALGORITHMS));
+
+   // 1. Allocate the identifier pointers and the name pointers.
+   ULONG count = GetCatalogTypeCount(pCatalog, algorithmType);
+   pList->ppSorted = ArenaAlloc(pArena, count * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*));
+   pList->pNames = ArenaAlloc(pArena, count * sizeof(LPWSTR));
+   if (pList->ppSorted == NULL || pList->pNames == NULL) {
+      fprintf(stderr, "Function \"%s\": Arena allocation for algorithm list failed.\n", functionName);
+      return FALSE;
+   }
+
+   // 2. The catalog is sorted, so the algorithms of this type are collected in sorted order.
+   pList->count = GetCatalogView(pCatalog, algorithmType, pList->ppSorted);
+
+   for (ULONG i = 0; i < pList->count; i++)
+      pList->pNames[i] = pList->ppSorted[i]->pszName;
+
+   // 3. Get the detail records. An algorithm is probed by the first list that claims its record.
+   if (pTable != NULL) {
+      pList->ppDetails = ArenaAlloc(pArena, count * sizeof(ALGORITHM_DETAILS*));
+      pList->pProbeNames = ArenaAlloc(pArena, count * sizeof(LPWSTR));
+      pList->ppProbeDetails = ArenaAlloc(pArena, count * sizeof(ALGORITHM_DETAILS*));
+      if (pList->ppDetails == NULL || pList->pProbeNames == NULL || pList->ppProbeDetails == NULL) {
+         fprintf(stderr, "Function \"%s\": Arena allocation for algorithm details failed.\n", functionName);
+         return FALSE;
+      }
+
+      for (ULONG i = 0; i < pList->count; i++) {
+         size_t index = pList->ppSorted[i] - pCatalog->pAlgorithms;
+
+         ALGORITHM_DETAILS* pDetails = pTable->ppRecords[index];
+         if (pDetails == NULL) {
+            pDetails = AllocRecord(&pTable->pool);
+            if (pDetails == NULL) {
+               fprintf(stderr, "Function \"%s\": Allocation of algorithm details record failed.\n", functionName);
+               return FALSE;
+            }
+
+            pTable->ppRecords[index] = pDetails;
+
+            pList->pProbeNames[pList->probeCount] = pList->pNames[i];
+            pList->ppProbeDetails[pList->probeCount] = pDetails;
+            pList->probeCount++;
+         }
+
+         pList->ppDetails[i] = pDetails;
+      }
+   }
+
+   EndListPhase(pStatistics, LIST_PHASE_COPY);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Probe the algorithms a list has claimed.
+/// This does not use the arena, so the lists of several types can be probed at the same time.
+/// </summary>
+/// <param name="pBackend">Backend that probes the algorithms.</param>
+/// <param name="pList">Sorted algorithms.</param>
+/// <param name="maxThreads">Maximum number of probe threads. 0 means the number of processors.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+void ProbeSortedAlgorithms(const ALGORITHM_BACKEND* const pBackend,
+                           const SORTED_ALGORITHMS* const pList,
+                           const ULONG maxThreads,
+                           LIST_STATISTICS* const pStatistics) {
+   // The probes run in parallel. Each result goes to the record of its algorithm.
+   ProbeAlgorithmRecords(pBackend, pList->pProbeNames, pList->ppProbeDetails, pList->probeCount, maxThreads);
+
+   EndListPhase(pStatistics, LIST_PHASE_PROBE);
+}
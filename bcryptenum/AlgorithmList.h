@@ -0,0 +1,88 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "AlgorithmCatalog.h"
+#include "AlgorithmProbe.h"
+#include "Arena.h"
+#include "ListStatistics.h"
+
+/// <summary>
+/// Capabilities of the algorithms of a catalog.
+/// Each algorithm has one record, even if it is listed under more than one operation type.
+/// </summary>
+typedef struct _DETAILS_TABLE {
+   /// Pool of the detail records.
+   RECORD_POOL pool;
+
+   /// Detail record of each catalog algorithm. NULL, if no list has claimed the algorithm yet.
+   ALGORITHM_DETAILS** ppRecords;
+} DETAILS_TABLE;
+
+/// <summary>
+/// Algorithms of one operation type, sorted by name.
+/// The identifiers are the ones in the algorithm catalog, so the names are not copied.
+/// The memory of the list belongs to the arena it was built in.
+/// </summary>
+typedef struct _SORTED_ALGORITHMS {
+   /// Number of algorithms.
+   ULONG count;
+
+   /// Pointers to the algorithm identifiers in collation order of the names.
+   BCRYPT_ALGORITHM_IDENTIFIER** ppSorted;
+
+   /// Pointers to the names in the same order.
+   LPWSTR* pNames;
+
+   /// Pointers to the capabilities of the algorithms in the same order. NULL, if there is no details table.
+   ALGORITHM_DETAILS** ppDetails;
+
+   /// Number of algorithms this list has to probe.
+   ULONG probeCount;
+
+   /// Names of the algorithms this list has to probe.
+   LPWSTR* pProbeNames;
+
+   /// Detail records of the algorithms this list has to probe.
+   ALGORITHM_DETAILS** ppProbeDetails;
+} SORTED_ALGORITHMS;
+
+/// <summary>
+/// Initialize a details table for a catalog. No algorithm has a record yet.
+/// </summary>
+/// <param name="pTable">Details table.</param>
+/// <param name="pCatalog">Algorithm catalog.</param>
+/// <param name="pArena">Arena of the table and its records.</param>
+/// <returns>TRUE, if the table could be allocated, FALSE if not.</returns>
+BOOL InitDetailsTable(DETAILS_TABLE* const pTable, const ALGORITHM_CATALOG* const pCatalog, ARENA* const pArena);
+
+/// <summary>
+/// Get the algorithms of an operation type from the catalog in collation order of the names.
+/// If there is a details table, the list gets the detail records of its algorithms.
+/// The algorithms that do not have a record yet get one and have to be probed by this list.
+/// </summary>
+/// <param name="pCatalog">Algorithm catalog. It must be kept until the list is no longer used.</param>
+/// <param name="pArena">Arena of the list.</param>
+/// <param name="algorithmType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pTable">Details table of the catalog. NULL, if the capabilities are not needed.</param>
+/// <param name="pList">Pointer to the structure that receives the sorted algorithms.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+/// <returns>TRUE, if the list could be built, FALSE if not.</returns>
+BOOL GetSortedAlgorithms(const ALGORITHM_CATALOG* const pCatalog,
+                         ARENA* const pArena,
+                         const ULONG algorithmType,
+                         DETAILS_TABLE* const pTable,
+                         SORTED_ALGORITHMS* const pList,
+                         LIST_STATISTICS* const pStatistics);
+
+/// <summary>
+/// Probe the algorithms a list has claimed.
+/// This does not use the arena, so the lists of several types can be probed at the same time.
+/// </summary>
+/// <param name="pBackend">Backend that probes the algorithms.</param>
+/// <param name="pList">Sorted algorithms.</param>
+/// <param name="maxThreads">Maximum number of probe threads. 0 means the number of processors.</param>
+/// <param name="pStatistics">Statistics that receive the phase times. NULL, if no statistics are collected.</param>
+void ProbeSortedAlgorithms(const ALGORITHM_BACKEND* const pBackend,
+                           const SORTED_ALGORITHMS* const pList,
+                           const ULONG maxThreads,
+                           LIST_STATISTICS* const pStatistics);
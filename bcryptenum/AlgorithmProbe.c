@@ -0,0 +1,212 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Probe into separate records.
+//
+
+#include <string.h>
+
+#include "AlgorithmProbe.h"
+#include "WorkerPool.h"
+
+// ******** Public constants ********
+
+/// Known chaining modes.
+const CHAINING_MODE ChainingModes[CHAINING_MODE_COUNT] = {
+   { CHAINING_MODE_ECB, BCRYPT_CHAIN_MODE_ECB, "ECB" },
+   { CHAINING_MODE_CBC, BCRYPT_CHAIN_MODE_CBC, "CBC" },
+   { CHAINING_MODE_CFB, BCRYPT_CHAIN_MODE_CFB, "CFB" },
+   { CHAINING_MODE_CCM, BCRYPT_CHAIN_MODE_CCM, "CCM" },
+   { CHAINING_MODE_GCM, BCRYPT_CHAIN_MODE_GCM, "GCM" }
+};
+
+// ******** Private types ********
+
+/// <summary>
+/// Work of a probe run.
+/// </summary>
+typedef struct _PROBE_WORK {
+   const ALGORITHM_BACKEND* pBackend;
+   LPWSTR const* pAlgorithmNames;
+   ALGORITHM_DETAILS* pDetails;
+   ALGORITHM_DETAILS* const* ppDetails;
+} PROBE_WORK;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get a ULONG property.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="property">Name of the property.</param>
+/// <param name="pValue">Pointer to the variable that receives the value.</param>
+/// <returns>TRUE, if the property exists, FALSE if not.</returns>
+static BOOL getUlongProperty(const ALGORITHM_BACKEND* const pBackend,
+                             BCRYPT_ALG_HANDLE const hAlgorithm,
+                             LPCWSTR const property,
+                             ULONG* const pValue) {
+   ULONG resultLength;
+   NTSTATUS nts = pBackend->GetProperty(pBackend->context,
+                                        hAlgorithm,
+                                        property,
+                                        (PUCHAR)pValue,
+                                        sizeof(ULONG),
+                                        &resultLength);
+
+   return (nts >= 0 && resultLength == sizeof(ULONG));
+}
+
+/// <summary>
+/// Probe one algorithm as a work item.
+/// </summary>
+/// <param name="context">Probe work.</param>
+/// <param name="index">Index of the algorithm.</param>
+static void probeWorkItem(PVOID const context, const ULONG index) {
+   const PROBE_WORK* const pWork = context;
+
+   ProbeAlgorithm(pWork->pBackend, pWork->pAlgorithmNames[index], &pWork->pDetails[index]);
+}
+
+/// <summary>
+/// Probe one algorithm into its record as a work item.
+/// </summary>
+/// <param name="context">Probe work.</param>
+/// <param name="index">Index of the algorithm.</param>
+static void probeRecordWorkItem(PVOID const context, const ULONG index) {
+   const PROBE_WORK* const pWork = context;
+
+   ProbeAlgorithm(pWork->pBackend, pWork->pAlgorithmNames[index], pWork->ppDetails[index]);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Probe the capabilities of one algorithm.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="pDetails">Pointer to the structure that receives the capabilities.</param>
+void ProbeAlgorithm(const ALGORITHM_BACKEND* const pBackend, LPCWSTR const algorithmName, ALGORITHM_DETAILS* const pDetails) {
+   memset(pDetails, 0, sizeof(ALGORITHM_DETAILS));
+
+   // 1. Open the algorithm. This is the slow part.
+   BCRYPT_ALG_HANDLE hAlgorithm;
+   pDetails->status = pBackend->OpenAlgorithm(pBackend->context, algorithmName, &hAlgorithm);
+   if (pDetails->status < 0)
+      return;
+
+   // 2. Query the properties. Not all algorithms have all properties.
+   ULONG resultLength;
+   NTSTATUS nts = pBackend->GetProperty(pBackend->context,
+                                        hAlgorithm,
+                                        BCRYPT_KEY_LENGTHS,
+                                        (PUCHAR)&pDetails->keyLengths,
+                                        sizeof(BCRYPT_KEY_LENGTHS_STRUCT),
+                                        &resultLength);
+   if (nts >= 0 && resultLength == sizeof(BCRYPT_KEY_LENGTHS_STRUCT))
+      pDetails->validFields |= DETAIL_KEY_LENGTHS;
+
+   if (getUlongProperty(pBackend, hAlgorithm, BCRYPT_BLOCK_LENGTH, &pDetails->blockLength) != FALSE)
+      pDetails->validFields |= DETAIL_BLOCK_LENGTH;
+
+   if (getUlongProperty(pBackend, hAlgorithm, BCRYPT_HASH_LENGTH, &pDetails->hashLength) != FALSE)
+      pDetails->validFields |= DETAIL_HASH_LENGTH;
+
+   if (getUlongProperty(pBackend, hAlgorithm, BCRYPT_OBJECT_LENGTH, &pDetails->objectLength) != FALSE)
+      pDetails->validFields |= DETAIL_OBJECT_LENGTH;
+
+   // 3. Chaining modes can not be queried. One has to try to set each of them.
+   //    Only block ciphers have chaining modes.
+   if ((pDetails->validFields & (DETAIL_BLOCK_LENGTH | DETAIL_HASH_LENGTH)) == DETAIL_BLOCK_LENGTH) {
+      const CHAINING_MODE* pMode = ChainingModes;
+      for (int i = CHAINING_MODE_COUNT; i > 0; i--) {
+         ULONG valueLength = (ULONG)((wcslen(pMode->propertyValue) + 1) * sizeof(WCHAR));
+         nts = pBackend->SetProperty(pBackend->context,
+                                     hAlgorithm,
+                                     BCRYPT_CHAINING_MODE,
+                                     (PUCHAR)pMode->propertyValue,
+                                     valueLength);
+         if (nts >= 0)
+            pDetails->chainingModes |= pMode->flag;
+
+         pMode++;
+      }
+
+      if (pDetails->chainingModes != 0)
+         pDetails->validFields |= DETAIL_CHAINING_MODES;
+   }
+
+   pBackend->CloseAlgorithm(pBackend->context, hAlgorithm);
+}
+
+/// <summary>
+/// Probe the capabilities of a list of algorithms on a pool of worker threads.
+/// The details are stored in the same order as the names.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="pAlgorithmNames">List of algorithm names.</param>
+/// <param name="algorithmCount">Number of algorithms.</param>
+/// <param name="pDetails">Array that receives the capabilities.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+void ProbeAlgorithms(const ALGORITHM_BACKEND* const pBackend,
+                     LPWSTR const* const pAlgorithmNames,
+                     const ULONG algorithmCount,
+                     ALGORITHM_DETAILS* const pDetails,
+                     const ULONG maxThreads) {
+   PROBE_WORK work;
+   work.pBackend = pBackend;
+   work.pAlgorithmNames = pAlgorithmNames;
+   work.pDetails = pDetails;
+   work.ppDetails = NULL;
+
+   // Each worker writes only to the details of its own item, so no locking is needed.
+   RunWorkItems(algorithmCount, maxThreads, probeWorkItem, &work);
+}
+
+/// <summary>
+/// Probe the capabilities of a list of algorithms on a pool of worker threads.
+/// The details of each algorithm are stored in its own record.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="pAlgorithmNames">List of algorithm names.</param>
+/// <param name="ppDetails">Records that receive the capabilities, in the same order as the names.</param>
+/// <param name="algorithmCount">Number of algorithms.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+void ProbeAlgorithmRecords(const ALGORITHM_BACKEND* const pBackend,
+                           LPWSTR const* const pAlgorithmNames,
+                           ALGORITHM_DETAILS* const* const ppDetails,
+                           const ULONG algorithmCount,
+                           const ULONG maxThreads) {
+   PROBE_WORK work;
+   work.pBackend = pBackend;
+   work.pAlgorithmNames = pAlgorithmNames;
+   work.pDetails = NULL;
+   work.ppDetails = ppDetails;
+
+   // Each worker writes only to the record of its own item, so no locking is needed.
+   RunWorkItems(algorithmCount, maxThreads, probeRecordWorkItem, &work);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+
+// ******** Valid detail flags ********
+
+#define DETAIL_KEY_LENGTHS     0x01
+#define DETAIL_BLOCK_LENGTH    0x02
+#define DETAIL_HASH_LENGTH     0x04
+#define DETAIL_OBJECT_LENGTH   0x08
+#define DETAIL_CHAINING_MODES  0x10
+
+// ******** Chaining mode flags ********
+
+#define CHAINING_MODE_ECB  0x01
+#define CHAINING_MODE_CBC  0x02
+#define CHAINING_MODE_CFB  0x04
+#define CHAINING_MODE_CCM  0x08
+#define CHAINING_MODE_GCM  0x10
+
+/// Number of known chaining modes.
+#define CHAINING_MODE_COUNT 5
+
+/// <summary>
+/// Description of a chaining mode.
+/// </summary>
+typedef struct _CHAINING_MODE {
+   ULONG flag;
+   LPCWSTR propertyValue;
+   const char* shortName;
+} CHAINING_MODE;
+
+/// Known chaining modes.
+extern const CHAINING_MODE ChainingModes[CHAINING_MODE_COUNT];
+
+/// <summary>
+/// Capabilities of an algorithm.
+/// </summary>
+typedef struct _ALGORITHM_DETAILS {
+   /// Status of opening the algorithm provider.
+   NTSTATUS status;
+
+   /// DETAIL_* flags of the valid fields.
+   ULONG validFields;
+
+   /// Supported key lengths in bits.
+   BCRYPT_KEY_LENGTHS_STRUCT keyLengths;
+
+   /// Block length in bytes.
+   ULONG blockLength;
+
+   /// Hash length in bytes.
+   ULONG hashLength;
+
+   /// Size of the algorithm object in bytes.
+   ULONG objectLength;
+
+   /// CHAINING_MODE_* flags of the supported chaining modes.
+   ULONG chainingModes;
+} ALGORITHM_DETAILS;
+
+/// <summary>
+/// Probe the capabilities of one algorithm.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="pDetails">Pointer to the structure that receives the capabilities.</param>
+void ProbeAlgorithm(const ALGORITHM_BACKEND* const pBackend, LPCWSTR const algorithmName, ALGORITHM_DETAILS* const pDetails);
+
+/// <summary>
+/// Probe the capabilities of a list of algorithms on a pool of worker threads.
+/// The details are stored in the same order as the names.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="pAlgorithmNames">List of algorithm names.</param>
+/// <param name="algorithmCount">Number of algorithms.</param>
+/// <param name="pDetails">Array that receives the capabilities.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+void ProbeAlgorithms(const ALGORITHM_BACKEND* const pBackend,
+                     LPWSTR const* const pAlgorithmNames,
+                     const ULONG algorithmCount,
+                     ALGORITHM_DETAILS* const pDetails,
+                     const ULONG maxThreads);
+
+/// <summary>
+/// Probe the capabilities of a list of algorithms on a pool of worker threads.
+/// The details of each algorithm are stored in its own record.
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="pAlgorithmNames">List of algorithm names.</param>
+/// <param name="ppDetails">Records that receive the capabilities, in the same order as the names.</param>
+/// <param name="algorithmCount">Number of algorithms.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+void ProbeAlgorithmRecords(const ALGORITHM_BACKEND* const pBackend,
+                           LPWSTR const* const pAlgorithmNames,
+                           ALGORITHM_DETAILS* const* const ppDetails,
+                           const ULONG algorithmCount,
+                           const ULONG maxThreads);
@@ -1,5 +1,5 @@
 //
-// SPDX-FileCopyrightText: Copyright 2023-2025 Frank Schwab
+// SPDX-FileCopyrightText: Copyright 2023-2026 Frank Schwab
 //
 // SPDX-License-Identifier: Apache-2.0
 //
@@ -20,36 +20,197 @@
 //
 // Author: Frank Schwab
 //
-// Version: 2.0.0
+// Version: 3.0.1
 //
 // Change history:
 //    2023-11-18: V1.0.0: Created.
 //    2025-11-12: V2.0.0: Print messages in console code page.
+//    2026-10-16: V2.1.0: Build on platforms other than Windows.
+//    2026-10-16: V3.0.0: Thread-safe message cache and built-in NTSTATUS messages.
+//    2026-10-16: V3.0.1: Failed message lookups are not cached.
 //
 
-#include <Windows.h>
-#include <bcrypt.h>
+#include <errno.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "Console.h"
+#include "Platform.h"
 
 // ******** Private constants ********
 
 #define MESSAGE_BUFFER_LENGTH 256
 
+/// Number of bits of the cache index.
+#define CACHE_INDEX_BITS 6
+
+/// Number of cache slots. Must be a power of 2.
+#define CACHE_SIZE (1 << CACHE_INDEX_BITS)
+
+/// Maximum number of slots that are probed for a message.
+#define MAX_PROBES 8
+
+/// The slot is free.
+#define SLOT_EMPTY   0
+
+/// A thread fills the slot.
+#define SLOT_FILLING 1
+
+/// The slot holds a message that never changes again.
+#define SLOT_READY   2
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+// ******** Private types ********
+
+/// <summary>
+/// Message of an error code in the console code page.
+/// Only messages that could be looked up are stored.
+/// </summary>
+typedef struct _MESSAGE_SLOT {
+   volatile LONG state;
+   DWORD errorNumber;
+   BOOL isNtStatus;
+   char text[MESSAGE_BUFFER_LENGTH];
+} MESSAGE_SLOT;
+
+/// <summary>
+/// Built-in text of an NTSTATUS.
+/// </summary>
+typedef struct _STATUS_TEXT {
+   DWORD status;
+   const wchar_t* text;
+} STATUS_TEXT;
+
+// ******** Private constants ********
+
+/// Number of built-in NTSTATUS messages.
+#define STATUS_TEXT_COUNT 19
+
+/// Messages of the NTSTATUS codes returned by the BCrypt functions and the backends, sorted by code.
+/// The texts are the ones of "ntdll.dll", so that the output is the same on all platforms.
+static const STATUS_TEXT statusTexts[STATUS_TEXT_COUNT] = {
+   { 0x80000005UL, L"{Buffer Overflow} The data was too large to fit into the specified buffer.\n" },
+   { 0xC0000001UL, L"{Operation Failed} The requested operation was unsuccessful.\n" },
+   { 0xC0000002UL, L"{Not Implemented} The requested operation is not implemented.\n" },
+   { 0xC0000004UL, L"The specified information record length does not match the length required for the specified information class.\n" },
+   { 0xC0000008UL, L"An invalid HANDLE was specified.\n" },
+   { 0xC000000DUL, L"An invalid parameter was passed to a service or function.\n" },
+   { 0xC0000010UL, L"The specified request is not a valid operation for the target device.\n" },
+   { 0xC0000017UL, L"{Not Enough Quota} Not enough virtual memory or paging file quota is available to complete the specified operation.\n" },
+   { 0xC0000022UL, L"{Access Denied} A process has requested access to an object, but has not been granted those access rights.\n" },
+   { 0xC0000023UL, L"{Buffer Too Small} The buffer is too small to contain the entry. No information has been written to the buffer.\n" },
+   { 0xC0000034UL, L"Object Name not found.\n" },
+   { 0xC000009AUL, L"Insufficient system resources exist to complete the API.\n" },
+   { 0xC00000BBUL, L"The request is not supported.\n" },
+   { 0xC0000184UL, L"The device is not in a valid state to perform this request.\n" },
+   { 0xC0000206UL, L"The size of the buffer is invalid for the specified operation.\n" },
+   { 0xC0000225UL, L"The object was not found.\n" },
+   { 0xC000A000UL, L"The cryptographic signature is invalid.\n" },
+   { 0xC000A002UL, L"{Authentication Tag Mismatch} The computed authentication tag did not match the input authentication tag.\n" },
+   { 0xC000A003UL, L"The cryptographic provider does not support HMAC.\n" }
+};
+
 // ******** Private variables ********
 
-/// Buffer for wide character error message text.
-static WCHAR messageBuffer[MESSAGE_BUFFER_LENGTH];
+/// Messages that have already been looked up. Slots are only filled, never changed or freed.
+static MESSAGE_SLOT messageCache[CACHE_SIZE];
+
+/// Buffer for messages that do not fit into the cache.
+static THREAD_LOCAL char overflowBuffer[MESSAGE_BUFFER_LENGTH];
 
 // ******** Private methods ********
 
+/// <summary>
+/// Read the state of a slot with acquire semantics.
+/// </summary>
+/// <param name="pState">Pointer to the state.</param>
+/// <returns>State of the slot.</returns>
+static inline LONG loadState(volatile LONG* const pState) {
+#ifdef _WIN32
+   return InterlockedCompareExchange(pState, 0, 0);
+#else
+   return __atomic_load_n(pState, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/// <summary>
+/// Mark a slot as ready with release semantics.
+/// </summary>
+/// <param name="pState">Pointer to the state.</param>
+static inline void publishState(volatile LONG* const pState) {
+#ifdef _WIN32
+   InterlockedExchange(pState, SLOT_READY);
+#else
+   __atomic_store_n(pState, SLOT_READY, __ATOMIC_RELEASE);
+#endif
+}
+
+/// <summary>
+/// Release a claimed slot with release semantics, so that it is empty again.
+/// </summary>
+/// <param name="pState">Pointer to the state.</param>
+static inline void releaseSlot(volatile LONG* const pState) {
+#ifdef _WIN32
+   InterlockedExchange(pState, SLOT_EMPTY);
+#else
+   __atomic_store_n(pState, SLOT_EMPTY, __ATOMIC_RELEASE);
+#endif
+}
+
+/// <summary>
+/// Claim an empty slot.
+/// </summary>
+/// <param name="pState">Pointer to the state.</param>
+/// <returns>TRUE, if this thread claimed the slot, FALSE if another thread was faster.</returns>
+static inline BOOL claimSlot(volatile LONG* const pState) {
+#ifdef _WIN32
+   return (InterlockedCompareExchange(pState, SLOT_FILLING, SLOT_EMPTY) == SLOT_EMPTY);
+#else
+   LONG expected = SLOT_EMPTY;
+   return __atomic_compare_exchange_n(pState, &expected, SLOT_FILLING, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) ? TRUE : FALSE;
+#endif
+}
+
+/// <summary>
+/// Get the built-in text for an NTSTATUS.
+/// </summary>
+/// <param name="errorNumber">NTSTATUS to get the text for.</param>
+/// <param name="messageBuffer">Buffer for the message.</param>
+/// <returns>Length of message text. A value of 0 indicates that there is no built-in text.</returns>
+static DWORD getBuiltInStatusMessage(const DWORD errorNumber, WCHAR* const messageBuffer) {
+   size_t low = 0;
+   size_t high = STATUS_TEXT_COUNT;
+
+   while (low < high) {
+      size_t middle = (low + high) >> 1;
+      if (statusTexts[middle].status < errorNumber)
+         low = middle + 1;
+      else
+         high = middle;
+   }
+
+   if (low == STATUS_TEXT_COUNT || statusTexts[low].status != errorNumber)
+      return 0;
+
+   size_t msgLen = wcslen(statusTexts[low].text);
+   memcpy(messageBuffer, statusTexts[low].text, (msgLen + 1) * sizeof(WCHAR));
+
+   return (DWORD)msgLen;
+}
+
+#ifdef _WIN32
 /// <summary>
 /// Get the text for an NTSTATUS.
 /// </summary>
 /// <param name="errorNumber">NTSTATUS to get the text for.</param>
+/// <param name="messageBuffer">Buffer for the message with a size of MESSAGE_BUFFER_LENGTH.</param>
 /// <returns>Length of message text. A value of 0 indicates that no message could be found.</returns>
-static DWORD getNtStatusErrorMessage(const DWORD errorNumber) {
+static DWORD getNtStatusErrorMessage(const DWORD errorNumber, WCHAR* const messageBuffer) {
    // For *all* NTSTATUS codes it is necessary to look them up in "ntdll.dll"!
    HMODULE ntdllModule = GetModuleHandleW(L"ntdll.dll");
    DWORD msgLen = FormatMessageW(FORMAT_MESSAGE_FROM_HMODULE | FORMAT_MESSAGE_IGNORE_INSERTS,
@@ -59,6 +220,12 @@ static DWORD getNtStatusErrorMessage(const DWORD errorNumber) {
                                  messageBuffer,
                                  MESSAGE_BUFFER_LENGTH,
                                  NULL);
+   if (msgLen == 0) {
+      DWORD le = GetLastError();
+      msgLen = getBuiltInStatusMessage(errorNumber, messageBuffer);
+      SetLastError(le);
+   }
+
    return msgLen;
 }
 
@@ -66,8 +233,9 @@ static DWORD getNtStatusErrorMessage(const DWORD errorNumber) {
 /// Get the text for a Windows error code (GetLastError).
 /// </summary>
 /// <param name="errorNumber">Error code.</param>
+/// <param name="messageBuffer">Buffer for the message with a size of MESSAGE_BUFFER_LENGTH.</param>
 /// <returns>Length of message text. A value of 0 indicates that no message could be found.</returns>
-static DWORD getSystemErrorMessage(const DWORD errorNumber) {
+static DWORD getSystemErrorMessage(const DWORD errorNumber, WCHAR* const messageBuffer) {
    DWORD msgLen = FormatMessageW(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS,
                                  NULL,
                                  errorNumber,
@@ -77,36 +245,138 @@ static DWORD getSystemErrorMessage(const DWORD errorNumber) {
                                  NULL);
    return msgLen;
 }
+#else
+/// <summary>
+/// Get the text for an NTSTATUS.
+/// There is no message source for NTSTATUS codes on this platform, so only the built-in texts are known.
+/// </summary>
+/// <param name="errorNumber">NTSTATUS to get the text for.</param>
+/// <param name="messageBuffer">Buffer for the message with a size of MESSAGE_BUFFER_LENGTH.</param>
+/// <returns>Length of message text. A value of 0 indicates that no message could be found. The last error is then ENOENT.</returns>
+static DWORD getNtStatusErrorMessage(const DWORD errorNumber, WCHAR* const messageBuffer) {
+   DWORD msgLen = getBuiltInStatusMessage(errorNumber, messageBuffer);
+   if (msgLen == 0)
+      errno = ENOENT;
+
+   return msgLen;
+}
 
 /// <summary>
-/// Print an error message for a specified function and error number.
+/// Get the text for a C runtime error code (errno).
+/// </summary>
+/// <param name="errorNumber">Error code.</param>
+/// <param name="messageBuffer">Buffer for the message with a size of MESSAGE_BUFFER_LENGTH.</param>
+/// <returns>Length of message text.</returns>
+static DWORD getSystemErrorMessage(const DWORD errorNumber, WCHAR* const messageBuffer) {
+   const char* message = strerror((int)errorNumber);
+   size_t msgLen = mbstowcs(messageBuffer, message, MESSAGE_BUFFER_LENGTH - 2);
+   if (msgLen == (size_t)-1)
+      return 0;
+
+   // Messages from FormatMessage end with a new line. Do the same here.
+   messageBuffer[msgLen++] = L'\n';
+   messageBuffer[msgLen] = 0;
+
+   return (DWORD)msgLen;
+}
+#endif
+
+/// <summary>
+/// Look up the message of an error number and convert it into the console code page.
 /// </summary>
-/// <param name="functionName">Name of the function calling the failing Windows API function.</param>
-/// <param name="apiName">Name of the failing Windows API function.</param>
 /// <param name="errorNumber">Error number.</param>
 /// <param name="isNtStatus">Is the error number an NTSTATUS.</param>
-static void printError(const PCHAR functionName, const PCHAR apiName, const DWORD errorNumber, const BOOL isNtStatus) {
+/// <param name="text">Buffer for the message with a size of MESSAGE_BUFFER_LENGTH.</param>
+/// <param name="pLastError">Pointer to the variable that receives the error of the lookup, if there is no message.</param>
+/// <returns>TRUE, if the message could be looked up, FALSE if not. The text is then empty.</returns>
+static BOOL resolveMessage(const DWORD errorNumber, const BOOL isNtStatus, char* const text, DWORD* const pLastError) {
+   WCHAR messageBuffer[MESSAGE_BUFFER_LENGTH];
+
    DWORD msgLen;
    if (isNtStatus == FALSE)
-      msgLen = getSystemErrorMessage(errorNumber);
+      msgLen = getSystemErrorMessage(errorNumber, messageBuffer);
    else
-      msgLen = getNtStatusErrorMessage(errorNumber);
+      msgLen = getNtStatusErrorMessage(errorNumber, messageBuffer);
 
-   DWORD le = 0;
-   if (msgLen == 0)
-      le = GetLastError();
+   if (msgLen == 0 || EncodeForConsole(messageBuffer, text, MESSAGE_BUFFER_LENGTH) == 0) {
+      *pLastError = GetLastError();
+      text[0] = 0;
+      return FALSE;
+   }
+
+   *pLastError = 0;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the message of an error number in the console code page.
+/// Each message is looked up and converted only once. Later calls read it from the cache without any lock.
+/// A lookup that fails is not cached, as it may succeed later.
+/// </summary>
+/// <param name="errorNumber">Error number.</param>
+/// <param name="isNtStatus">Is the error number an NTSTATUS.</param>
+/// <param name="pLastError">Pointer to the variable that receives the error of the lookup, if there is no message.</param>
+/// <returns>Message. An empty string, if there is no message.</returns>
+static const char* getMessage(const DWORD errorNumber, const BOOL isNtStatus, DWORD* const pLastError) {
+   // 1. Probe the slots that start at the hash of the error number.
+   //    A slot that is being filled is skipped. At worst the same message is then stored twice.
+   ULONG hash = (ULONG)((errorNumber ^ ((isNtStatus != FALSE) ? 0x5bd1e995UL : 0UL)) * 0x9e3779b1UL) >> (32 - CACHE_INDEX_BITS);
+
+   for (ULONG probe = 0; probe < MAX_PROBES; probe++) {
+      MESSAGE_SLOT* pSlot = messageCache + ((hash + probe) & (CACHE_SIZE - 1));
+
+      LONG state = loadState(&pSlot->state);
+      if (state == SLOT_EMPTY && claimSlot(&pSlot->state) != FALSE) {
+         // 2. Fill a new slot and publish it. If there is no message, the slot is released again.
+         pSlot->errorNumber = errorNumber;
+         pSlot->isNtStatus = isNtStatus;
+         if (resolveMessage(errorNumber, isNtStatus, pSlot->text, pLastError) == FALSE) {
+            releaseSlot(&pSlot->state);
+            overflowBuffer[0] = 0;
+            return overflowBuffer;
+         }
+
+         publishState(&pSlot->state);
+
+         return pSlot->text;
+      }
+
+      if (loadState(&pSlot->state) == SLOT_READY &&
+          pSlot->errorNumber == errorNumber &&
+          pSlot->isNtStatus == isNtStatus) {
+         *pLastError = 0;
+         return pSlot->text;
+      }
+   }
+
+   // 3. All probed slots hold other messages. Look the message up without caching it.
+   resolveMessage(errorNumber, isNtStatus, overflowBuffer, pLastError);
+   return overflowBuffer;
+}
+
+/// <summary>
+/// Print an error message for a specified function and error number.
+/// </summary>
+/// <param name="functionName">Name of the function calling the failing Windows API function.</param>
+/// <param name="apiName">Name of the failing Windows API function.</param>
+/// <param name="errorNumber">Error number.</param>
+/// <param name="isNtStatus">Is the error number an NTSTATUS.</param>
+static void printError(const PCHAR functionName, const PCHAR apiName, const DWORD errorNumber, const BOOL isNtStatus) {
+   DWORD le;
+   const char* message = getMessage(errorNumber, isNtStatus, &le);
 
    fprintf(stderr,
            "Function \"%s\", API function \"%s\" failed with error %lu (0x%08lx): ",
            functionName,
            apiName,
-           errorNumber,
-           errorNumber);
+           (unsigned long)errorNumber,
+           (unsigned long)errorNumber);
 
-   if (msgLen > 0)
-      fputs(AsConsoleCodePageString(messageBuffer), stderr);
+   if (message[0] != 0)
+      fputs(message, stderr);
    else
-      fprintf(stderr, "Could not get error message (FormatMessage error code = %ld (0x%08lx)\n", le, le);
+      fprintf(stderr, "Could not get error message (FormatMessage error code = %lu (0x%08lx)\n", (unsigned long)le, (unsigned long)le);
 }
 
 // ******** Public methods ********
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <Windows.h>
+#include "Platform.h"
 
 /// <summary>
 /// Print the error message for a Windows error code.
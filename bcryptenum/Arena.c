@@ -0,0 +1,230 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Arena.h"
+
+// ******** Private constants ********
+
+/// Alignment of all allocations. This is enough for all types.
+#define ARENA_ALIGNMENT 16
+
+// ******** Private types ********
+
+/// <summary>
+/// Block of an arena. The memory of the block follows this header.
+/// </summary>
+struct _ARENA_BLOCK {
+   /// Block that was the current block before this one.
+   ARENA_BLOCK* pPrevious;
+
+   /// Number of bytes after the header.
+   size_t size;
+};
+
+/// Size of the block header, rounded up to the alignment.
+#define BLOCK_HEADER_SIZE ((sizeof(ARENA_BLOCK) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+/// <summary>
+/// Released record in the free list of a pool.
+/// </summary>
+typedef struct _FREE_RECORD {
+   struct _FREE_RECORD* pNext;
+} FREE_RECORD;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the memory of a block.
+/// </summary>
+/// <param name="pBlock">Block.</param>
+/// <returns>Pointer to the first byte after the header.</returns>
+static inline PUCHAR blockData(ARENA_BLOCK* const pBlock) {
+   return (PUCHAR)pBlock + BLOCK_HEADER_SIZE;
+}
+
+/// <summary>
+/// Make a new block the current block.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="minimumSize">Number of bytes the block must have room for.</param>
+/// <returns>TRUE, if the block could be allocated, FALSE if not.</returns>
+static BOOL addBlock(ARENA* const pArena, const size_t minimumSize) {
+   const PCHAR functionName = "addBlock";
+
+   size_t size = (minimumSize > pArena->blockSize) ? minimumSize : pArena->blockSize;
+
+   ARENA_BLOCK* pBlock = HeapAlloc(pArena->hHeap, 0, BLOCK_HEADER_SIZE + size);
+   if (pBlock == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for arena block failed.\n", functionName);
+      return FALSE;
+   }
+
+   pBlock->pPrevious = pArena->pBlock;
+   pBlock->size = size;
+
+   pArena->pBlock = pBlock;
+   pArena->blockUsed = 0;
+   pArena->blockCount++;
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Initialize an arena. No memory is taken from the heap until the first allocation.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="hHeap">Heap of the blocks.</param>
+/// <param name="blockSize">Minimum size of a block in bytes. Larger allocations get their own block.</param>
+void InitArena(ARENA* const pArena, const HANDLE hHeap, const size_t blockSize) {
+   memset(pArena, 0, sizeof(ARENA));
+   pArena->hHeap = hHeap;
+   pArena->blockSize = blockSize;
+}
+
+/// <summary>
+/// Release all blocks of an arena.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+void FreeArena(ARENA* const pArena) {
+   ARENA_MARK start = { NULL, 0, 0 };
+
+   ResetArena(pArena, &start);
+}
+
+/// <summary>
+/// Allocate memory in an arena. The memory is aligned for all types.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="size">Number of bytes.</param>
+/// <returns>Pointer to the memory or NULL, if there is not enough memory.</returns>
+PVOID ArenaAlloc(ARENA* const pArena, const size_t size) {
+   // 1. Round the size up, so that the next allocation is aligned, too. A size of 0 gets its own address.
+   size_t alignedSize = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+   if (alignedSize == 0)
+      alignedSize = ARENA_ALIGNMENT;
+
+   // 2. Take a new block, if the current one is full. The rest of the current block is not used any more.
+   if (pArena->pBlock == NULL || pArena->pBlock->size - pArena->blockUsed < alignedSize)
+      if (addBlock(pArena, alignedSize) == FALSE)
+         return NULL;
+
+   PVOID pMemory = blockData(pArena->pBlock) + pArena->blockUsed;
+   pArena->blockUsed += alignedSize;
+
+   // 3. Count.
+   pArena->allocationCount++;
+   pArena->bytesAllocated += alignedSize;
+   pArena->bytesInUse += alignedSize;
+   if (pArena->bytesInUse > pArena->peakBytes)
+      pArena->peakBytes = pArena->bytesInUse;
+
+   return pMemory;
+}
+
+/// <summary>
+/// Get the current position of an arena.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="pMark">Pointer to the mark to fill.</param>
+void GetArenaMark(const ARENA* const pArena, ARENA_MARK* const pMark) {
+   pMark->pBlock = pArena->pBlock;
+   pMark->blockUsed = pArena->blockUsed;
+   pMark->bytesInUse = pArena->bytesInUse;
+}
+
+/// <summary>
+/// Release all memory that was allocated in an arena after a mark.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="pMark">Mark of the position.</param>
+void ResetArena(ARENA* const pArena, const ARENA_MARK* const pMark) {
+   while (pArena->pBlock != pMark->pBlock) {
+      ARENA_BLOCK* pPrevious = pArena->pBlock->pPrevious;
+      HeapFree(pArena->hHeap, 0, pArena->pBlock);
+      pArena->pBlock = pPrevious;
+   }
+
+   pArena->blockUsed = pMark->blockUsed;
+   pArena->bytesInUse = pMark->bytesInUse;
+}
+
+/// <summary>
+/// Initialize a record pool.
+/// </summary>
+/// <param name="pPool">Record pool.</param>
+/// <param name="pArena">Arena of the records.</param>
+/// <param name="recordSize">Size of a record in bytes.</param>
+void InitRecordPool(RECORD_POOL* const pPool, ARENA* const pArena, const size_t recordSize) {
+   memset(pPool, 0, sizeof(RECORD_POOL));
+   pPool->pArena = pArena;
+
+   // A released record has to hold the link of the free list.
+   pPool->recordSize = (recordSize < sizeof(FREE_RECORD)) ? sizeof(FREE_RECORD) : recordSize;
+}
+
+/// <summary>
+/// Get a record from a pool.
+/// </summary>
+/// <param name="pPool">Record pool.</param>
+/// <returns>Pointer to the record or NULL, if there is not enough memory.</returns>
+PVOID AllocRecord(RECORD_POOL* const pPool) {
+   PVOID pRecord;
+   if (pPool->pFreeList != NULL) {
+      FREE_RECORD* pFree = pPool->pFreeList;
+      pPool->pFreeList = pFree->pNext;
+      pRecord = pFree;
+   } else {
+      pRecord = ArenaAlloc(pPool->pArena, pPool->recordSize);
+      if (pRecord == NULL)
+         return NULL;
+   }
+
+   pPool->recordCount++;
+   if (pPool->recordCount > pPool->peakRecordCount)
+      pPool->peakRecordCount = pPool->recordCount;
+
+   return pRecord;
+}
+
+/// <summary>
+/// Return a record to a pool.
+/// </summary>
+/// <param name="pPool">Record pool.</param>
+/// <param name="pRecord">Record.</param>
+void FreeRecord(RECORD_POOL* const pPool, PVOID const pRecord) {
+   FREE_RECORD* pFree = pRecord;
+   pFree->pNext = pPool->pFreeList;
+   pPool->pFreeList = pFree;
+
+   pPool->recordCount--;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Platform.h"
+
+/// <summary>
+/// Block of an arena. The memory of the block follows this header.
+/// </summary>
+typedef struct _ARENA_BLOCK ARENA_BLOCK;
+
+/// <summary>
+/// Bump allocator. Memory is taken from large blocks and only released all at once or back to a mark.
+/// An arena must only be used by one thread at a time.
+/// </summary>
+typedef struct _ARENA {
+   /// Heap of the blocks.
+   HANDLE hHeap;
+
+   /// Minimum size of a block in bytes.
+   size_t blockSize;
+
+   /// Current block. Each block points to the one before it.
+   ARENA_BLOCK* pBlock;
+
+   /// Number of bytes used in the current block.
+   size_t blockUsed;
+
+   /// Number of allocations.
+   ULONG allocationCount;
+
+   /// Number of allocated bytes over the lifetime of the arena.
+   uint64_t bytesAllocated;
+
+   /// Number of bytes that are currently allocated.
+   uint64_t bytesInUse;
+
+   /// Maximum number of bytes that were allocated at the same time.
+   uint64_t peakBytes;
+
+   /// Number of blocks taken from the heap.
+   ULONG blockCount;
+} ARENA;
+
+/// <summary>
+/// Position in an arena to reset it to.
+/// </summary>
+typedef struct _ARENA_MARK {
+   ARENA_BLOCK* pBlock;
+   size_t blockUsed;
+   uint64_t bytesInUse;
+} ARENA_MARK;
+
+/// <summary>
+/// Pool of records of one size in an arena.
+/// Released records are kept in a free list and reused.
+/// </summary>
+typedef struct _RECORD_POOL {
+   /// Arena of the records.
+   ARENA* pArena;
+
+   /// Size of a record in bytes.
+   size_t recordSize;
+
+   /// Released records.
+   PVOID pFreeList;
+
+   /// Number of records in use.
+   ULONG recordCount;
+
+   /// Maximum number of records that were in use at the same time.
+   ULONG peakRecordCount;
+} RECORD_POOL;
+
+/// <summary>
+/// Initialize an arena. No memory is taken from the heap until the first allocation.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="hHeap">Heap of the blocks.</param>
+/// <param name="blockSize">Minimum size of a block in bytes. Larger allocations get their own block.</param>
+void InitArena(ARENA* const pArena, const HANDLE hHeap, const size_t blockSize);
+
+/// <summary>
+/// Release all blocks of an arena.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+void FreeArena(ARENA* const pArena);
+
+/// <summary>
+/// Allocate memory in an arena. The memory is aligned for all types.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="size">Number of bytes.</param>
+/// <returns>Pointer to the memory or NULL, if there is not enough memory.</returns>
+PVOID ArenaAlloc(ARENA* const pArena, const size_t size);
+
+/// <summary>
+/// Get the current position of an arena.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="pMark">Pointer to the mark to fill.</param>
+void GetArenaMark(const ARENA* const pArena, ARENA_MARK* const pMark);
+
+/// <summary>
+/// Release all memory that was allocated in an arena after a mark.
+/// </summary>
+/// <param name="pArena">Arena.</param>
+/// <param name="pMark">Mark of the position.</param>
+void ResetArena(ARENA* const pArena, const ARENA_MARK* const pMark);
+
+/// <summary>
+/// Initialize a record pool.
+/// </summary>
+/// <param name="pPool">Record pool.</param>
+/// <param name="pArena">Arena of the records.</param>
+/// <param name="recordSize">Size of a record in bytes.</param>
+void InitRecordPool(RECORD_POOL* const pPool, ARENA* const pArena, const size_t recordSize);
+
+/// <summary>
+/// Get a record from a pool.
+/// </summary>
+/// <param name="pPool">Record pool.</param>
+/// <returns>Pointer to the record or NULL, if there is not enough memory.</returns>
+PVOID AllocRecord(RECORD_POOL* const pPool);
+
+/// <summary>
+/// Return a record to a pool.
+/// </summary>
+/// <param name="pPool">Record pool.</param>
+/// <param name="pRecord">Record.</param>
+void FreeRecord(RECORD_POOL* const pPool, PVOID const pRecord);
@@ -1,5 +1,5 @@
 //
-// SPDX-FileCopyrightText: Copyright 2023-2025 Frank Schwab
+// SPDX-FileCopyrightText: Copyright 2023-2026 Frank Schwab
 //
 // SPDX-License-Identifier: Apache-2.0
 //
@@ -20,7 +20,7 @@
 //
 // Author: Frank Schwab
 //
-// Version: 2.1.0
+// Version: 2.13.1
 //
 // Change history:
 //    2023-12-01: V1.0.0: Created.
@@ -33,17 +33,42 @@
 //    2025-11-12: V1.4.1: Removed unnecessary compare in shell sort.
 //    2025-11-12: V2.0.0: Print to console in console code page.
 //    2025-11-14: V2.1.0: Removed wide character functions.
+//    2026-10-16: V2.2.0: Enumerate through an exchangeable backend.
+//    2026-10-16: V2.3.0: Optionally print the capabilities of the algorithms.
+//    2026-10-16: V2.3.1: Print status without sign extension.
+//    2026-10-16: V2.4.0: Sort names with collation keys, instead of shell sort.
+//    2026-10-16: V2.5.0: Compose the output in a buffer and write it at once.
+//    2026-10-16: V2.6.0: Print numbers without printf.
+//    2026-10-16: V2.7.0: Print the lists from a persistent cache.
+//    2026-10-16: V2.8.0: Emit the lists as text, JSON, CSV or binary records.
+//    2026-10-16: V2.8.1: Get the sorted lists from the algorithm list module.
+//    2026-10-16: V2.9.0: Phase statistics of repeated listings.
+//    2026-10-16: V2.10.0: Enumerate and sort the types concurrently, emit them in type order.
+//    2026-10-16: V2.11.0: List the types from one algorithm catalog.
+//    2026-10-16: V2.12.0: Take the memory of a listing from an arena.
+//    2026-10-16: V2.13.0: List the types from the catalog of the algoenum library.
+//    2026-10-16: V2.13.1: Probe all types on one pool of at most maxThreads threads.
 //
 
 #define _CRT_DISABLE_PERFCRIT_LOCKS 1
 
-#include <Windows.h>
-#include <bcrypt.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "AlgoEnum.h"
+#include "AlgorithmBackend.h"
+#include "AlgorithmList.h"
+#include "AlgorithmProbe.h"
 #include "ApiErrorHandler.h"
-#include "Console.h"
+#include "BCryptList.h"
+#include "CatalogCache.h"
+#include "CountingBackend.h"
+#include "ListEmitter.h"
+#include "ListStatistics.h"
+#include "OutputBuffer.h"
 #include "PrintModVersion.h"
+#include "Timer.h"
+#include "WorkerPool.h"
 
 
 // ******** Private constants ********
@@ -51,176 +76,548 @@
 #define RC_OK  0
 #define RC_ERR 0xff
 
+/// Module that implements the algorithms.
+#define MODULE_NAME "bcrypt.dll"
+
+/// Size of the arena blocks. One block holds the lists of a usual catalog.
+#define ARENA_BLOCK_SIZE 0x10000
+
+// ******** Private types ********
+
+/// <summary>
+/// Sorted list of one type. The list is built before the threads start.
+/// Its algorithms are probed by the threads of the pool and it is emitted by the thread that drains the results.
+/// </summary>
+typedef struct _TYPE_RESULT {
+   /// Sorted algorithms.
+   SORTED_ALGORITHMS list;
+
+   /// TRUE, if the list could be built.
+   BOOL isSorted;
+
+   /// Index of the first probe of this list in the probes of all lists.
+   ULONG firstProbe;
+
+   /// Number of probes of this list.
+   ULONG probeCount;
+
+   /// Number of probes of this list that have not finished yet.
+   volatile LONG remainingProbes;
+
+   /// Set, when the list may be emitted.
+   volatile LONG isReady;
+} TYPE_RESULT;
+
+/// <summary>
+/// State of a listing of all types.
+/// </summary>
+typedef struct _LIST_PIPELINE {
+   const ALGORITHM_BACKEND* pBackend;
+   const LIST_OPTIONS* pOptions;
+   const LIST_EMITTER* pEmitter;
+   EMITTER_STATE* pState;
+   CATALOG_WRITER* pWriter;
+
+   /// One slot per type in the order of the output.
+   TYPE_RESULT results[OPERATION_TYPE_COUNT];
+
+   /// Time of each probe in nanoseconds. NULL, if no statistics are collected.
+   uint64_t* pProbeNs;
+
+   /// Set, while a thread emits lists. Only that thread uses the fields below.
+   volatile LONG isDraining;
+
+   /// Index of the next type to emit.
+   int nextType;
+
+   /// TRUE, if all lists could be enumerated.
+   BOOL result;
+
+   /// Phase times of the emitting threads. pDrainStatistics is NULL, if no statistics are collected.
+   LIST_STATISTICS drainStatistics;
+   LIST_STATISTICS* pDrainStatistics;
+} LIST_PIPELINE;
+
 // ******** Private methods ********
 
 /// <summary>
-/// Sort the list of algorithm names with the shell sort algorithm.
+/// Print the type of the elements in the list.
+/// </summary>
+/// <param name="listType">BCrypt algorithm type.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printAlgorithmTypeName(const ULONG algorithmType, OUTPUT_BUFFER* const pOutput) {
+   OutputChar(pOutput, '\n');
+
+   const char* title = OperationTypeTitle(algorithmType);
+   if (title != NULL)
+      OutputString(pOutput, title);
+   else
+      fprintf(stderr, "Unknown algorithm type 0x%lx", (unsigned long)algorithmType);
+
+   OutputString(pOutput, ":\n\n");
+}
+
+/// <summary>
+/// Print the capabilities of an algorithm.
 /// </summary>
-/// <param name="pAlgorithmNames">Pointer to list of algorithm names.</param>
-/// <param name="algorithmCount">Count of algorithm names.</param>
-static void shellSort(LPWSTR* const pAlgorithmNames, const USHORT algorithmCount) {
-   USHORT stepSize[] = {7, 4, 1};
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printDetails(const ALGORITHM_DETAILS* const pDetails, OUTPUT_BUFFER* const pOutput) {
+   if (pDetails->status < 0) {
+      OutputFormat(pOutput, "      Could not open algorithm: 0x%08lx\n", (unsigned long)(ULONG)pDetails->status);
+      return;
+   }
 
-   for (USHORT s = 0; s < sizeof(stepSize) / sizeof(stepSize[0]); s++) {
-      USHORT step = stepSize[s];
+   if ((pDetails->validFields & DETAIL_KEY_LENGTHS) != 0) {
+      const BCRYPT_KEY_LENGTHS_STRUCT* pKeyLengths = &pDetails->keyLengths;
+      if (pKeyLengths->dwMinLength == pKeyLengths->dwMaxLength) {
+         OutputString(pOutput, "      Key length: ");
+         OutputNumber(pOutput, pKeyLengths->dwMinLength);
+         OutputString(pOutput, " bits\n");
+      } else {
+         OutputString(pOutput, "      Key lengths: ");
+         OutputNumber(pOutput, pKeyLengths->dwMinLength);
+         OutputString(pOutput, " - ");
+         OutputNumber(pOutput, pKeyLengths->dwMaxLength);
+         OutputString(pOutput, " bits in steps of ");
+         OutputNumber(pOutput, pKeyLengths->dwIncrement);
+         OutputChar(pOutput, '\n');
+      }
+   }
 
-      for (USHORT i = step; i < algorithmCount; i++) {
-         LPWSTR insertionName = pAlgorithmNames[i];
-         USHORT insertionIndex = i;
-         
-         while (insertionIndex >= step &&
-                wcscmp(insertionName, pAlgorithmNames[insertionIndex - step]) < 0) {
-            pAlgorithmNames[insertionIndex] = pAlgorithmNames[insertionIndex - step];
-            insertionIndex -= step;
+   if ((pDetails->validFields & DETAIL_BLOCK_LENGTH) != 0) {
+      OutputString(pOutput, "      Block length: ");
+      OutputNumber(pOutput, pDetails->blockLength);
+      OutputString(pOutput, " bytes\n");
+   }
+
+   if ((pDetails->validFields & DETAIL_HASH_LENGTH) != 0) {
+      OutputString(pOutput, "      Hash length: ");
+      OutputNumber(pOutput, pDetails->hashLength);
+      OutputString(pOutput, " bytes\n");
+   }
+
+   if ((pDetails->validFields & DETAIL_OBJECT_LENGTH) != 0) {
+      OutputString(pOutput, "      Object length: ");
+      OutputNumber(pOutput, pDetails->objectLength);
+      OutputString(pOutput, " bytes\n");
+   }
+
+   if ((pDetails->validFields & DETAIL_CHAINING_MODES) != 0) {
+      OutputString(pOutput, "      Chaining modes:");
+
+      const CHAINING_MODE* pMode = ChainingModes;
+      for (int i = CHAINING_MODE_COUNT; i > 0; i--) {
+         if ((pDetails->chainingModes & pMode->flag) != 0) {
+            OutputChar(pOutput, ' ');
+            OutputString(pOutput, pMode->shortName);
          }
 
-         // This may be the same as the original position. It is faster to always assign, than to compare first.
-         pAlgorithmNames[insertionIndex] = insertionName;
+         pMode++;
       }
+
+      OutputChar(pOutput, '\n');
    }
 }
 
 /// <summary>
-/// Print the type of the elements in the list.
+/// Print the start of the text list.
 /// </summary>
-/// <param name="listType">BCrypt algorithm type.</param>
-/// <param name="fStdOut">Stdout file pointer.</param>
-static void printAlgorithmTypeName(const ULONG algorithmType, FILE* fStdOut) {
-   _putc_nolock('\n', fStdOut);
+/// <param name="pState">Emitter state.</param>
+/// <param name="moduleName">Name of the module that implements the algorithms (not used).</param>
+/// <param name="pVersion">Version of the module or NULL, if it is not known.</param>
+static void textBeginList(EMITTER_STATE* const pState, const PCHAR moduleName, const MODULE_VERSION* const pVersion) {
+   (void)moduleName;
+
+   OutputString(pState->pOutput, "\nList of Bcrypt ");
+   if (pVersion != NULL)
+      OutputModuleVersion(pVersion, pState->pOutput);
+   OutputString(pState->pOutput, " algorithms by type:\n\n");
+}
 
-   switch (algorithmType) {
-   case BCRYPT_CIPHER_OPERATION:
-      fputs("Symmetric ciphers", fStdOut);
-      break;
+/// <summary>
+/// Print the name of an algorithm type.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+static void textBeginType(EMITTER_STATE* const pState, const ULONG operationType) {
+   printAlgorithmTypeName(operationType, pState->pOutput);
+}
 
-   case BCRYPT_HASH_OPERATION:
-      fputs("Hashes", fStdOut);
-      break;
+/// <summary>
+/// Print the name of an algorithm and its capabilities.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type (not used).</param>
+/// <param name="pAlgorithm">Algorithm identifier from the enumeration.</param>
+/// <param name="pDetails">Capabilities of the algorithm or NULL, if it was not probed.</param>
+static void textEmitAlgorithm(EMITTER_STATE* const pState,
+                              const ULONG operationType,
+                              const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm,
+                              const ALGORITHM_DETAILS* const pDetails) {
+   (void)operationType;
+
+   OutputString(pState->pOutput, "   ");
+   OutputWideString(pState->pOutput, pAlgorithm->pszName);
+   OutputChar(pState->pOutput, '\n');
+
+   if (pDetails != NULL)
+      printDetails(pDetails, pState->pOutput);
+}
 
-   case BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION:
-      fputs("Asymmetric ciphers", fStdOut);
-      break;
+/// <summary>
+/// Add a new line at the end of the list of an algorithm type.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void textEndType(EMITTER_STATE* const pState) {
+   OutputChar(pState->pOutput, '\n');
+}
 
-   case BCRYPT_SECRET_AGREEMENT_OPERATION:
-      fputs("Secret agreements", fStdOut);
-      break;
+/// <summary>
+/// End the text list. There is nothing to print.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void textEndList(EMITTER_STATE* const pState) {
+   (void)pState;
+}
 
-   case BCRYPT_SIGNATURE_OPERATION:
-      fputs("Signatures", fStdOut);
-      break;
+/// <summary>
+/// Read a flag. The access is sequentially consistent, so that a flag that is set
+/// after a drainer stopped is seen by the thread that set it or by the drainer.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+/// <returns>Value of the flag.</returns>
+static inline LONG loadFlag(volatile LONG* const pFlag) {
+#ifdef _WIN32
+   return InterlockedCompareExchange(pFlag, 0, 0);
+#else
+   return __atomic_load_n(pFlag, __ATOMIC_SEQ_CST);
+#endif
+}
 
-   case BCRYPT_RNG_OPERATION:
-      fputs("Pseudorandom Number Generators", fStdOut);
-      break;
+/// <summary>
+/// Set a flag to a value.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+/// <param name="value">New value.</param>
+static inline void storeFlag(volatile LONG* const pFlag, const LONG value) {
+#ifdef _WIN32
+   InterlockedExchange(pFlag, value);
+#else
+   __atomic_store_n(pFlag, value, __ATOMIC_SEQ_CST);
+#endif
+}
 
-   case BCRYPT_KEY_DERIVATION_OPERATION:
-      fputs("Key derivation", fStdOut);
-      break;
+/// <summary>
+/// Decrement a counter.
+/// </summary>
+/// <param name="pCounter">Pointer to the counter.</param>
+/// <returns>Value of the counter after the decrement.</returns>
+static inline LONG decrementCounter(volatile LONG* const pCounter) {
+#ifdef _WIN32
+   return InterlockedDecrement(pCounter);
+#else
+   return __atomic_sub_fetch(pCounter, 1, __ATOMIC_ACQ_REL);
+#endif
+}
 
-   default:
-      fprintf(stderr, "Unknown algorithm type 0x%lx", algorithmType);
+/// <summary>
+/// Set a flag, if it is not set.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+/// <returns>TRUE, if this call set the flag, FALSE if it was already set.</returns>
+static inline BOOL trySetFlag(volatile LONG* const pFlag) {
+#ifdef _WIN32
+   return (InterlockedCompareExchange(pFlag, 1, 0) == 0);
+#else
+   LONG expected = 0;
+   return __atomic_compare_exchange_n(pFlag, &expected, 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? TRUE : FALSE;
+#endif
+}
+
+/// <summary>
+/// Emit the sorted list of algorithms of one type.
+/// The end of the type is emitted even if the list could not be enumerated, so that the output stays well-formed.
+/// </summary>
+/// <param name="pPipeline">List pipeline.</param>
+/// <param name="typeIndex">Index of the operation type.</param>
+static void emitType(LIST_PIPELINE* const pPipeline, const int typeIndex) {
+   TYPE_RESULT* pResult = pPipeline->results + typeIndex;
+   const ULONG algorithmType = OperationTypes[typeIndex];
+   const LIST_EMITTER* pEmitter = pPipeline->pEmitter;
+   EMITTER_STATE* pState = pPipeline->pState;
+   LIST_STATISTICS* pStatistics = pPipeline->pDrainStatistics;
+
+   pState->algorithmCount = 0;
+   pEmitter->BeginType(pState, algorithmType);
+   EndListPhase(pStatistics, LIST_PHASE_FORMAT);
+
+   if (pResult->isSorted != FALSE) {
+      // 1. Add the sorted list to the cache.
+      SORTED_ALGORITHMS* pList = &pResult->list;
+      if (pPipeline->pWriter != NULL) {
+         AddCatalogSection(pPipeline->pWriter, algorithmType, pList->pNames, pList->count);
+         EndListPhase(pStatistics, LIST_PHASE_CACHE);
+      }
+
+      // 2. Emit the sorted list.
+      //    The records are emitted from the identifiers, so the names are never copied.
+      BCRYPT_ALGORITHM_IDENTIFIER** pActAlgo = pList->ppSorted;
+      ALGORITHM_DETAILS** ppActDetails = pList->ppDetails;
+      for (ULONG i = pList->count; i > 0; i--) {
+         pEmitter->EmitAlgorithm(pState, algorithmType, *pActAlgo++, (ppActDetails != NULL) ? *ppActDetails++ : NULL);
+         pState->algorithmCount++;
+      }
+
+      EndListPhase(pStatistics, LIST_PHASE_FORMAT);
    }
+   else
+      pPipeline->result = FALSE;
 
-   fputs(":\n\n", fStdOut);
+   pEmitter->EndType(pState);
+   pState->typeCount++;
+   EndListPhase(pStatistics, LIST_PHASE_FORMAT);
 }
 
 /// <summary>
-/// Copy the pointers to the algorithm names from the BCrypt algorithm list into a local memory area.
+/// Emit all sorted lists that are next in type order.
+/// Only one thread drains at a time. A thread that finds another one draining leaves its list to that thread.
 /// </summary>
-/// <param name="hHeap">Handle of the local heap.</param>
-/// <param name="pAlgoList">Pointer to the list of BCrypt algorithm identifiers.</param>
-/// <param name="algoCount">Number of algorithms.</param>
-/// <returns>Pointer to the local copy of the algorithm name pointers.</returns>
-static LPWSTR* copyAlgorithmNamePointers(const HANDLE hHeap, BCRYPT_ALGORITHM_IDENTIFIER* const pAlgoList, const ULONG algoCount) {
-   const PCHAR functionName = "copyAlgorithmNames";
+/// <param name="pPipeline">List pipeline.</param>
+static void drainResults(LIST_PIPELINE* const pPipeline) {
+   for (;;) {
+      if (trySetFlag(&pPipeline->isDraining) == FALSE)
+         return;
 
-   LPWSTR* pNameList = HeapAlloc(hHeap, 0, algoCount * sizeof(LPWSTR));
-   if (pNameList == NULL) {
-      fprintf(stderr, "Function \"%s\": HeapAlloc for algorithm name list failed.\n", functionName);
-      return pNameList;
-   }
+      if (pPipeline->pDrainStatistics != NULL)
+         pPipeline->pDrainStatistics->phaseStart = GetTimeNs();
+
+      int nextType = pPipeline->nextType;
+      while (nextType < OPERATION_TYPE_COUNT && loadFlag(&pPipeline->results[nextType].isReady) != 0)
+         emitType(pPipeline, nextType++);
 
-   // Pointer to algorithm identifier.
-   BCRYPT_ALGORITHM_IDENTIFIER* pActAlgo = pAlgoList;
-   LPWSTR* pName = pNameList;
-   for (ULONG i = algoCount; i > 0; i--)
-      *pName++ = pActAlgo++->pszName;
+      pPipeline->nextType = nextType;
+      storeFlag(&pPipeline->isDraining, 0);
 
-   return pNameList;
+      // A list that became ready after the check above and whose thread found this one draining has to be emitted here.
+      if (nextType == OPERATION_TYPE_COUNT || loadFlag(&pPipeline->results[nextType].isReady) == 0)
+         return;
+   }
 }
 
 /// <summary>
-/// Print the list of algorithm names for the specified type.
+/// Probe one algorithm. The last probe of a list emits the lists that are next in type order.
+/// An algorithm of more than one type is probed by the first type in the output order,
+/// which is emitted before the others, so its details are complete when they are emitted.
 /// </summary>
-/// <param name="listType">BCrypt algorithm type.</param>
-/// <param name="fStdOut">Stdout file pointer.</param>
-static BOOL listForType(const HANDLE hHeap, const ULONG algorithmType, FILE* fStdOut) {
-   const PCHAR functionName = "listForType";
-
-   // 1. Print the algorithm type.
-   printAlgorithmTypeName(algorithmType, fStdOut);
-
-   // 2. Get the list of algorithms of this type.
-   ULONG algoCount;
-   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList;
-   NTSTATUS nts = BCryptEnumAlgorithms(algorithmType, &algoCount, &pAlgoList, 0);
-   if (nts < 0) {
-      PrintNtStatus(functionName, "BCryptEnumAlgorithms", nts);
+/// <param name="context">List pipeline.</param>
+/// <param name="index">Index of the probe in the probes of all lists.</param>
+static void probeWorkItem(PVOID const context, const ULONG index) {
+   LIST_PIPELINE* pPipeline = context;
+
+   // 1. Find the list of the probe. The probes of the lists follow each other in type order.
+   int t = 0;
+   while (t < OPERATION_TYPE_COUNT - 1 && index >= pPipeline->results[t].firstProbe + pPipeline->results[t].probeCount)
+      t++;
+
+   TYPE_RESULT* pResult = pPipeline->results + t;
+   ULONG i = index - pResult->firstProbe;
+
+   // 2. Probe the algorithm into its record.
+   uint64_t startTime = (pPipeline->pProbeNs != NULL) ? GetTimeNs() : 0;
+   ProbeAlgorithm(pPipeline->pBackend, pResult->list.pProbeNames[i], pResult->list.ppProbeDetails[i]);
+   if (pPipeline->pProbeNs != NULL)
+      pPipeline->pProbeNs[index] = GetTimeNs() - startTime;
+
+   // 3. The thread that finishes the last probe of a list makes it ready.
+   if (decrementCounter(&pResult->remainingProbes) == 0) {
+      storeFlag(&pResult->isReady, 1);
+      drainResults(pPipeline);
+   }
+}
+
+/// <summary>
+/// Emit the lists of all types.
+/// The algorithms are enumerated once into a catalog. If they are probed, the probes of all types share one pool of threads.
+/// Each sorted list waits in its slot until all types before it have been emitted,
+/// so the output is the same as with a sequential listing.
+/// All memory is taken from the arena before the threads start, so the threads do not allocate.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options.</param>
+/// <param name="pArena">Arena of the listing.</param>
+/// <param name="pEmitter">Emitter of the output format.</param>
+/// <param name="pState">Emitter state.</param>
+/// <param name="pWriter">Catalog writer that receives the sorted lists. NULL, if the lists are not cached.</param>
+/// <returns>TRUE, if all lists could be emitted, FALSE if not.</returns>
+static BOOL listAllTypesConcurrently(const ALGORITHM_BACKEND* const pBackend,
+                                     const LIST_OPTIONS* const pOptions,
+                                     ARENA* const pArena,
+                                     const LIST_EMITTER* const pEmitter,
+                                     EMITTER_STATE* const pState,
+                                     CATALOG_WRITER* const pWriter) {
+   const PCHAR functionName = "listAllTypesConcurrently";
+
+   LIST_PIPELINE* pPipeline = ArenaAlloc(pArena, sizeof(LIST_PIPELINE));
+   if (pPipeline == NULL) {
+      fprintf(stderr, "Function \"%s\": Arena allocation for list pipeline failed.\n", functionName);
       return FALSE;
    }
 
-   // 3. Sort the algorithm names.
+   memset(pPipeline, 0, sizeof(LIST_PIPELINE));
 
-   // 3.1 Copy the pointers to the names into a local memory area.
-   //     This is necessary, so that this list can be sorted.
-   
-   // Pointer to list of string pointers to algorithm names.
-   LPWSTR* pSortedList = copyAlgorithmNamePointers(hHeap, pAlgoList, algoCount);
-   if (pSortedList == NULL) {
-      BCryptFreeBuffer(pAlgoList);
-      return FALSE;
+   LIST_STATISTICS* pStatistics = pOptions->pStatistics;
+
+   // 1. Enumerate all algorithms at once.
+   //    If that fails, the catalog is empty and the types are emitted without algorithms, so that the output stays well-formed.
+   ALGOENUM algoEnum;
+   pPipeline->result = BuildAlgoEnum(pBackend, pArena, &algoEnum, pStatistics);
+
+   pPipeline->pBackend = pBackend;
+   pPipeline->pOptions = pOptions;
+   pPipeline->pEmitter = pEmitter;
+   pPipeline->pState = pState;
+   pPipeline->pWriter = pWriter;
+
+   // 2. Build the lists of all types. Each algorithm that is probed gets one details record for all of its types.
+   DETAILS_TABLE detailsTable;
+   DETAILS_TABLE* pDetailsTable = NULL;
+   if (pOptions->showDetails != FALSE) {
+      if (InitDetailsTable(&detailsTable, &algoEnum.catalog, pArena) == FALSE)
+         return FALSE;
+
+      pDetailsTable = &detailsTable;
    }
 
-   // 3.2 Sort the string pointers in the list.
-   shellSort(pSortedList, (USHORT)algoCount);
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      pPipeline->results[t].isSorted = GetSortedAlgorithms(&algoEnum.catalog,
+                                                           pArena,
+                                                           OperationTypes[t],
+                                                           pDetailsTable,
+                                                           &pPipeline->results[t].list,
+                                                           pStatistics);
+
+   if (pStatistics != NULL) {
+      BeginListStatistics(&pPipeline->drainStatistics);
+      pPipeline->pDrainStatistics = &pPipeline->drainStatistics;
+   }
 
-   // 4. Print the sorted list of names.
+   // 3. Put the probes of all lists one after the other. A list without probes may be emitted at once.
+   ULONG probeCount = 0;
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+      TYPE_RESULT* pResult = pPipeline->results + t;
+      pResult->firstProbe = probeCount;
+      pResult->probeCount = (pResult->isSorted != FALSE && pOptions->showDetails != FALSE) ? pResult->list.probeCount : 0;
+      pResult->remainingProbes = (LONG)pResult->probeCount;
+      pResult->isReady = (pResult->probeCount == 0);
+      probeCount += pResult->probeCount;
+   }
 
-   // Pointer to algorithm identifier.
-   LPWSTR* pActAlgoName = pSortedList;
-   for (ULONG i = algoCount; i > 0; i--) {
-      fputs("   ", fStdOut);
-      fputs(AsConsoleCodePageString(*pActAlgoName++), fStdOut);
-      _putc_nolock('\n', fStdOut);
+   if (pStatistics != NULL && probeCount != 0) {
+      pPipeline->pProbeNs = ArenaAlloc(pArena, probeCount * sizeof(uint64_t));
+      if (pPipeline->pProbeNs == NULL) {
+         fprintf(stderr, "Function \"%s\": Arena allocation for probe times failed.\n", functionName);
+         return FALSE;
+      }
    }
 
-   // 5. Add a new line at the end of the list.
-   _putc_nolock('\n', fStdOut);
+   // 4. One work item per probe on one pool, so that no more than maxThreads threads probe.
+   //    With one thread this is the sequential listing.
+   RunWorkItems(probeCount, pOptions->maxThreads, probeWorkItem, pPipeline);
+
+   // 5. Emit the lists that are left. Without probes these are all lists.
+   drainResults(pPipeline);
+
+   // 6. Collect the statistics of the concurrent parts.
+   if (pStatistics != NULL) {
+      LIST_STATISTICS probeStatistics;
+      memset(&probeStatistics, 0, sizeof(probeStatistics));
+      for (ULONG i = 0; i < probeCount; i++)
+         probeStatistics.phaseNs[LIST_PHASE_PROBE] += pPipeline->pProbeNs[i];
+
+      MergeListStatistics(pStatistics, &probeStatistics);
+      MergeListStatistics(pStatistics, &pPipeline->drainStatistics);
+   }
+
+   return pPipeline->result;
+}
+
+/// <summary>
+/// Print the lists of all types from a catalog cache.
+/// </summary>
+/// <param name="pCache">Catalog cache.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printCachedLists(const CATALOG_CACHE* const pCache, OUTPUT_BUFFER* const pOutput) {
+   CATALOG_SECTION section;
+   FirstCatalogSection(pCache, &section);
+
+   for (ULONG s = pCache->sectionCount; s > 0; s--) {
+      printAlgorithmTypeName(section.operationType, pOutput);
+
+      for (ULONG i = section.nameCount; i > 0; i--) {
+         size_t nameLength;
+         const char* pName = NextCatalogName(&section, &nameLength);
+
+         OutputString(pOutput, "   ");
+         OutputBytes(pOutput, pName, nameLength);
+         OutputChar(pOutput, '\n');
+      }
 
-   // 6. Release memory.
-   HeapFree(hHeap, 0, pSortedList);  // This must be freed *before* the algorithm list is freed.
-   BCryptFreeBuffer(pAlgoList);      // This must be freed *after* the names have been printed.
+      OutputChar(pOutput, '\n');
 
-   return TRUE;
+      if (s > 1)
+         NextCatalogSection(&section);
+   }
 }
 
+// ******** Private constants ********
+
+/// The text emitter.
+static const LIST_EMITTER textEmitter = {
+   textBeginList,
+   textBeginType,
+   textEmitAlgorithm,
+   textEndType,
+   textEndList
+};
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the emitter of an output format.
+/// </summary>
+/// <param name="format">Output format.</param>
+/// <returns>Pointer to the emitter.</returns>
+static const LIST_EMITTER* getEmitter(const LIST_FORMAT format) {
+   switch (format) {
+   case LIST_FORMAT_JSON:
+      return GetJsonEmitter();
+
+   case LIST_FORMAT_CSV:
+      return GetCsvEmitter();
+
+   case LIST_FORMAT_BINARY:
+      return GetBinaryEmitter();
+
+   default:
+      return &textEmitter;
+   }
+}
 
 // ******** Public methods ********
 
 /// <summary>
 /// Print the names of all BCrypt algorithms.
 /// </summary>
-unsigned char ListAllTypes() {
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options.</param>
+unsigned char ListAllTypes(const ALGORITHM_BACKEND* const pBackend, const LIST_OPTIONS* const pOptions) {
    const PCHAR functionName = "ListAllTypes";
 
-   FILE* fStdOut = stdout;
+   LIST_STATISTICS* pStatistics = pOptions->pStatistics;
+   BeginListStatistics(pStatistics);
 
-   // 1. Print header.
-   fputs("\nList of Bcrypt ", fStdOut);
-   PrintModuleVersion("bcrypt.dll", fStdOut);
-   fputs(" algorithms by type:\n\n", fStdOut);
-   
-   // 2. Get the process heap to use in the list functions.
+   // 1. Get the process heap for the arena of the list functions.
    
    // Process heap.
    HANDLE hHeap = GetProcessHeap();
@@ -229,17 +626,136 @@ unsigned char ListAllTypes() {
       return RC_ERR;
    }
 
-   // 3. Print lists for each type.
-   BOOL result = listForType(hHeap, BCRYPT_CIPHER_OPERATION, fStdOut);
-   result &= listForType(hHeap, BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION, fStdOut);
-   result &= listForType(hHeap, BCRYPT_HASH_OPERATION, fStdOut);
-   result &= listForType(hHeap, BCRYPT_SECRET_AGREEMENT_OPERATION, fStdOut);
-   result &= listForType(hHeap, BCRYPT_SIGNATURE_OPERATION, fStdOut);
-   result &= listForType(hHeap, BCRYPT_RNG_OPERATION, fStdOut);
-   result &= listForType(hHeap, BCRYPT_KEY_DERIVATION_OPERATION, fStdOut);
+   ARENA arena;
+   InitArena(&arena, hHeap, ARENA_BLOCK_SIZE);
+
+   // 2. Compose the whole output in one buffer.
+   OUTPUT_BUFFER output;
+   if (InitOutputBuffer(&output, stdout, 0) == FALSE)
+      return RC_ERR;
+
+   const LIST_EMITTER* pEmitter = getEmitter(pOptions->format);
+   EMITTER_STATE state = { &output, 0, 0 };
+
+   // 3. Print header.
+   MODULE_VERSION version;
+   BOOL hasVersion = pBackend->GetModuleVersion(pBackend->context, MODULE_NAME, &version);
+   EndListPhase(pStatistics, LIST_PHASE_MODULE_VERSION);
+
+   pEmitter->BeginList(&state, MODULE_NAME, (hasVersion != FALSE) ? &version : NULL);
+   EndListPhase(pStatistics, LIST_PHASE_FORMAT);
+
+   // 4. Print the lists from the cache, if it is valid.
+   //    The details are not cached, as they are probed each time.
+   //    The cache only holds the names, so it is only used for the text format.
+   CACHE_KEY cacheKey;
+   BOOL useCache = (pOptions->cachePath != NULL &&
+                    pOptions->format == LIST_FORMAT_TEXT &&
+                    pOptions->showDetails == FALSE &&
+                    hasVersion != FALSE &&
+                    BuildCacheKey(pBackend, MODULE_NAME, &version, &cacheKey) != FALSE);
+
+   CATALOG_CACHE cache;
+   BOOL isCached = (useCache != FALSE && OpenCatalogCache(pOptions->cachePath, &cacheKey, &cache) != FALSE);
+   EndListPhase(pStatistics, LIST_PHASE_CACHE);
+
+   BOOL result = TRUE;
+   const char* catalogSource;
+   if (isCached != FALSE) {
+      printCachedLists(&cache, &output);
+      EndListPhase(pStatistics, LIST_PHASE_FORMAT);
+
+      CloseCatalogCache(&cache);
+      EndListPhase(pStatistics, LIST_PHASE_CACHE);
+
+      catalogSource = "read from cache";
+   } else {
+      // 5. Enumerate and print the lists of all types and write the cache.
+      CATALOG_WRITER writer;
+      CATALOG_WRITER* pWriter = NULL;
+      if (useCache != FALSE && InitCatalogWriter(&writer, &cacheKey) != FALSE)
+         pWriter = &writer;
+
+      EndListPhase(pStatistics, LIST_PHASE_CACHE);
+
+      result = listAllTypesConcurrently(pBackend, pOptions, &arena, pEmitter, &state, pWriter);
+
+      catalogSource = "enumerated";
+      if (pWriter != NULL) {
+         if (result != FALSE && WriteCatalogCache(pWriter, pOptions->cachePath) != FALSE)
+            catalogSource = "enumerated, cache written";
+         else
+            catalogSource = "enumerated, cache not written";
+
+         FreeCatalogWriter(pWriter);
+         EndListPhase(pStatistics, LIST_PHASE_CACHE);
+      }
+   }
+
+   pEmitter->EndList(&state);
+   EndListPhase(pStatistics, LIST_PHASE_FORMAT);
+
+   // 6. Write the output with a single write.
+   result &= FlushOutputBuffer(&output);
+   EndListPhase(pStatistics, LIST_PHASE_WRITE);
+
+   if (pStatistics != NULL) {
+      pStatistics->catalogSource = catalogSource;
+      pStatistics->bytesWritten = output.byteCount;
+      pStatistics->writeCount = output.flushCount;
+      AddAllocatedBytes(pStatistics, output.capacity);
+      AddArenaStatistics(pStatistics, &arena);
+   }
+
+   FreeArena(&arena);
+   FreeOutputBuffer(&output);
+   EndListStatistics(pStatistics);
 
    if (result == FALSE)
       return RC_ERR;
 
    return RC_OK;
 }
+
+/// <summary>
+/// Print the names of all BCrypt algorithms several times and print the statistics of the phases to stderr.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options.</param>
+/// <param name="repeatCount">Number of listings.</param>
+unsigned char ProfileListAllTypes(const ALGORITHM_BACKEND* const pBackend, const LIST_OPTIONS* const pOptions, const ULONG repeatCount) {
+   const PCHAR functionName = "ProfileListAllTypes";
+
+   // 1. Count the calls to the backend.
+   ALGORITHM_BACKEND* pCountingBackend = OpenCountingBackend(pBackend);
+   if (pCountingBackend == NULL)
+      return RC_ERR;
+
+   HANDLE hHeap = GetProcessHeap();
+   LIST_STATISTICS* pRuns = HeapAlloc(hHeap, 0, repeatCount * sizeof(LIST_STATISTICS));
+   if (pRuns == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for statistics failed.\n", functionName);
+      CloseCountingBackend(pCountingBackend);
+      return RC_ERR;
+   }
+
+   // 2. List the algorithms with statistics.
+   LIST_OPTIONS runOptions = *pOptions;
+   unsigned char rc = RC_OK;
+   for (ULONG r = 0; r < repeatCount && rc == RC_OK; r++) {
+      runOptions.pStatistics = pRuns + r;
+
+      ULONG startCalls = GetBackendCallCount(pCountingBackend);
+      rc = ListAllTypes(pCountingBackend, &runOptions);
+      pRuns[r].apiCalls = GetBackendCallCount(pCountingBackend) - startCalls;
+   }
+
+   // 3. Print the statistics.
+   if (rc == RC_OK && PrintListStatistics(pRuns, repeatCount, stderr) == FALSE)
+      rc = RC_ERR;
+
+   HeapFree(hHeap, 0, pRuns);
+   CloseCountingBackend(pCountingBackend);
+
+   return rc;
+}
@@ -1,6 +1,43 @@
 #pragma once
 
+#include "AlgorithmBackend.h"
+#include "ListEmitter.h"
+#include "ListStatistics.h"
+
+/// <summary>
+/// Options for listing the algorithms.
+/// </summary>
+typedef struct _LIST_OPTIONS {
+   /// Probe and print the capabilities of each algorithm.
+   BOOL showDetails;
+
+   /// Maximum number of threads for the enumeration and the probes. 0 means the number of processors.
+   ULONG maxThreads;
+
+   /// Print the output statistics to stderr.
+   BOOL showStatistics;
+
+   /// Path of the catalog cache file. NULL means no cache.
+   const char* cachePath;
+
+   /// Output format.
+   LIST_FORMAT format;
+
+   /// Receives the times and counters of the phases of the listing. NULL, if no statistics are collected.
+   LIST_STATISTICS* pStatistics;
+} LIST_OPTIONS;
+
 /// <summary>
 /// Print the names of all BCrypt algorithms.
 /// </summary>
-unsigned char ListAllTypes();
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options.</param>
+unsigned char ListAllTypes(const ALGORITHM_BACKEND* const pBackend, const LIST_OPTIONS* const pOptions);
+
+/// <summary>
+/// Print the names of all BCrypt algorithms several times and print the statistics of the phases to stderr.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options.</param>
+/// <param name="repeatCount">Number of listings.</param>
+unsigned char ProfileListAllTypes(const ALGORITHM_BACKEND* const pBackend, const LIST_OPTIONS* const pOptions, const ULONG repeatCount);
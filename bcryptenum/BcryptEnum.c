@@ -1,5 +1,5 @@
 //
-// SPDX-FileCopyrightText: Copyright 2023-2025 Frank Schwab
+// SPDX-FileCopyrightText: Copyright 2023-2026 Frank Schwab
 //
 // SPDX-License-Identifier: Apache-2.0
 //
@@ -20,7 +20,7 @@
 //
 // Author: Frank Schwab
 //
-// Version: 2.0.0
+// Version: 2.15.0
 //
 // Change history:
 //    2024-06-01: V1.0.0: Created.
@@ -28,14 +28,42 @@
 //    2025-10-22: V1.1.0: List all types.
 //    2025-10-23: V1.2.0: Simplified output of results.
 //    2025-11-12: V2.0.0: Output printed in console code page.
+//    2026-10-16: V2.1.0: Select enumeration backend and record snapshots.
+//    2026-10-16: V2.2.0: Print algorithm capabilities.
+//    2026-10-16: V2.3.0: Throughput benchmark.
+//    2026-10-16: V2.4.0: Multi-core scaling benchmark.
+//    2026-10-16: V2.5.0: Output statistics.
+//    2026-10-16: V2.6.0: Persistent catalog cache.
+//    2026-10-16: V2.7.0: Output formats.
+//    2026-10-16: V2.8.0: Compare the lists with a snapshot.
+//    2026-10-16: V2.9.0: Aggregate the snapshots of a fleet.
+//    2026-10-16: V2.10.0: Print the versions of a directory of modules.
+//    2026-10-16: V2.11.0: List providers and provider chains.
+//    2026-10-16: V2.12.0: Phase statistics of repeated listings.
+//    2026-10-16: V2.13.0: Watch the lists.
+//    2026-10-16: V2.14.0: Latency of asymmetric algorithms.
+//    2026-10-16: V2.15.0: Throughput of random number generators.
 //
 
-#include <fcntl.h>
-#include <io.h>
 #include <stdio.h>
-#include <Windows.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "AlgorithmBackend.h"
 #include "BCryptList.h"
+#include "Benchmark.h"
+#include "CatalogCache.h"
+#include "CatalogDiff.h"
+#include "CatalogWatch.h"
+#include "CryptoEngine.h"
+#include "FixtureBackend.h"
+#include "FleetReport.h"
+#include "ModuleVersions.h"
+#include "ProviderList.h"
+
+#ifdef _WIN32
+#include "CngBackend.h"
+#endif
 
 // ******** Private constants ********
 
@@ -43,11 +71,296 @@
 #define RC_CMD_ERR 1
 #define RC_PROC_ERR 2
 
+// ******** Private types ********
+
+/// <summary>
+/// Command line options.
+/// </summary>
+typedef struct _OPTIONS {
+   const char* fixturePath;
+   const char* recordPath;
+   const char* diffPath;
+   const char* aggregatePath;
+   const char* query;
+   const char* versionsPath;
+   BOOL noCache;
+   BOOL listProviders;
+   BOOL runBenchmark;
+   ULONG repeatCount;
+   BOOL watch;
+   WATCH_OPTIONS watchOptions;
+   LIST_OPTIONS list;
+   BENCH_OPTIONS bench;
+} OPTIONS;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Print the usage of the program.
+/// </summary>
+static void printUsage(void) {
+   fputs("Usage: bcryptenum [--fixture <snapshot file>] [--record <snapshot file> | --diff <snapshot file> | --providers |\n"
+         "                   --watch <ms> [--watch-count <n>]]\n"
+         "                  [--format text|json|csv|bin]\n"
+         "                  [--details] [--threads <n>] [--stats [--repeat <n>]] [--cache <cache file> | --no-cache] [--bench [--bench-time <ms>] [--scaling | --latency [--batch <n>] | --rng]]\n"
+         "       bcryptenum --aggregate <snapshot directory> [--query <algorithm>] [--threads <n>] [--stats]\n"
+         "       bcryptenum --versions <module directory> [--threads <n>] [--stats]\n"
+         "\n"
+         "   --fixture <file>   Replay the algorithm lists recorded in a snapshot file.\n"
+         "   --record <file>    Record the algorithm lists in a snapshot file instead of printing them.\n"
+         "   --diff <file>      Print the algorithms that were added (+), removed (-) or changed (~) since the snapshot file.\n"
+         "                      The current lists come from --fixture or from this machine.\n"
+         "   --aggregate <dir>  Print the algorithm coverage by bcrypt.dll version of a directory with one snapshot file per host.\n"
+         "   --query <name>     Print the hosts of the --aggregate directory that do not have this algorithm.\n"
+         "   --versions <dir>   Print the versions of the modules in a directory, e.g. of collected copies of bcrypt.dll.\n"
+         "   --providers        Print the registered providers and the provider chain of each function in the local contexts.\n"
+         "   --watch <ms>       List the algorithms every <ms> milliseconds and print only the added (+), removed (-)\n"
+         "                      and changed (~) algorithms and a changed module version (v), each with the Unix time.\n"
+         "   --watch-count <n>  Stop after n lists. Default: run until the program is stopped.\n"
+         "   --format <format>  Output format: text (default), json, csv or bin (length-prefixed binary records).\n"
+         "   --details          Open each algorithm and print (or record) its capabilities.\n"
+         "   --threads <n>      Maximum number of threads for listing, for probing, for --aggregate, for --versions, for --providers, for --scaling or for --rng. Default: number of processors.\n"
+         "   --stats            Print timing statistics to stderr. For the lists these are the time of each phase\n"
+         "                      and the numbers of API calls and of allocated and written bytes.\n"
+         "   --repeat <n>       List the algorithms n times and print the minimum, median and 99th percentile of the statistics.\n"
+         "   --cache <file>     Cache the sorted algorithm lists in this file.\n"
+         "                      Default: bcryptenum.cache in the user cache directory, if no snapshot file is replayed.\n"
+         "   --no-cache         Neither read nor write the cache.\n"
+         "   --bench            Measure the throughput of the hash and symmetric cipher algorithms.\n"
+         "   --bench-time <ms>  Minimum duration of one measurement sample. Default: 10 ms.\n"
+         "   --scaling          Measure the throughput on 1 up to --threads pinned threads,\n"
+         "                      with a shared and with a per-thread algorithm handle.\n"
+         "   --latency          Measure the p50, p99 and p99.9 latency of the key generation, signature and verification\n"
+         "                      of the asymmetric cipher and signature algorithms.\n"
+         "   --batch <n>        Time n signatures or verifications together. Default: 1.\n"
+         "   --rng              Measure the throughput and the latency per call of the random number generators\n"
+         "                      for request sizes from 16 bytes to 64 KiB on 1 up to --threads threads, with and without a buffer per thread.\n",
+         stderr);
+}
+
+/// <summary>
+/// Parse the command line arguments.
+/// </summary>
+/// <param name="argc">Number of arguments.</param>
+/// <param name="argv">Arguments.</param>
+/// <param name="pOptions">Options to fill.</param>
+/// <returns>TRUE, if the arguments are valid, FALSE if not.</returns>
+static BOOL parseArguments(int const argc, char const* argv[], OPTIONS* const pOptions) {
+   memset(pOptions, 0, sizeof(OPTIONS));
+
+   for (int i = 1; i < argc; i++) {
+      const char* arg = argv[i];
+
+      if (strcmp(arg, "--fixture") == 0 && i + 1 < argc)
+         pOptions->fixturePath = argv[++i];
+      else if (strcmp(arg, "--record") == 0 && i + 1 < argc)
+         pOptions->recordPath = argv[++i];
+      else if (strcmp(arg, "--diff") == 0 && i + 1 < argc)
+         pOptions->diffPath = argv[++i];
+      else if (strcmp(arg, "--aggregate") == 0 && i + 1 < argc)
+         pOptions->aggregatePath = argv[++i];
+      else if (strcmp(arg, "--query") == 0 && i + 1 < argc)
+         pOptions->query = argv[++i];
+      else if (strcmp(arg, "--versions") == 0 && i + 1 < argc)
+         pOptions->versionsPath = argv[++i];
+      else if (strcmp(arg, "--providers") == 0)
+         pOptions->listProviders = TRUE;
+      else if (strcmp(arg, "--watch") == 0 && i + 1 < argc) {
+         char* pEnd;
+         pOptions->watchOptions.intervalMs = (ULONG)strtoul(argv[++i], &pEnd, 10);
+         if (*pEnd != 0 || pOptions->watchOptions.intervalMs == 0) {
+            fprintf(stderr, "Invalid watch interval \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+
+         pOptions->watch = TRUE;
+      }
+      else if (strcmp(arg, "--watch-count") == 0 && i + 1 < argc) {
+         char* pEnd;
+         pOptions->watchOptions.checkCount = (ULONG)strtoul(argv[++i], &pEnd, 10);
+         if (*pEnd != 0 || pOptions->watchOptions.checkCount == 0) {
+            fprintf(stderr, "Invalid watch count \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+      }
+      else if (strcmp(arg, "--format") == 0 && i + 1 < argc) {
+         if (ParseListFormat(argv[++i], &pOptions->list.format) == FALSE) {
+            fprintf(stderr, "Invalid format \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+      }
+      else if (strcmp(arg, "--details") == 0)
+         pOptions->list.showDetails = TRUE;
+      else if (strcmp(arg, "--stats") == 0)
+         pOptions->list.showStatistics = TRUE;
+      else if (strcmp(arg, "--cache") == 0 && i + 1 < argc)
+         pOptions->list.cachePath = argv[++i];
+      else if (strcmp(arg, "--no-cache") == 0)
+         pOptions->noCache = TRUE;
+      else if (strcmp(arg, "--threads") == 0 && i + 1 < argc) {
+         char* pEnd;
+         pOptions->list.maxThreads = (ULONG)strtoul(argv[++i], &pEnd, 10);
+         if (*pEnd != 0 || pOptions->list.maxThreads == 0) {
+            fprintf(stderr, "Invalid thread count \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+      }
+      else if (strcmp(arg, "--repeat") == 0 && i + 1 < argc) {
+         char* pEnd;
+         pOptions->repeatCount = (ULONG)strtoul(argv[++i], &pEnd, 10);
+         if (*pEnd != 0 || pOptions->repeatCount == 0) {
+            fprintf(stderr, "Invalid repeat count \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+      }
+      else if (strcmp(arg, "--bench") == 0)
+         pOptions->runBenchmark = TRUE;
+      else if (strcmp(arg, "--scaling") == 0)
+         pOptions->bench.measureScaling = TRUE;
+      else if (strcmp(arg, "--latency") == 0)
+         pOptions->bench.measureLatency = TRUE;
+      else if (strcmp(arg, "--rng") == 0)
+         pOptions->bench.measureRng = TRUE;
+      else if (strcmp(arg, "--batch") == 0 && i + 1 < argc) {
+         char* pEnd;
+         pOptions->bench.batchSize = (ULONG)strtoul(argv[++i], &pEnd, 10);
+         if (*pEnd != 0 || pOptions->bench.batchSize == 0) {
+            fprintf(stderr, "Invalid batch size \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+      }
+      else if (strcmp(arg, "--bench-time") == 0 && i + 1 < argc) {
+         char* pEnd;
+         pOptions->bench.sampleTimeMs = (ULONG)strtoul(argv[++i], &pEnd, 10);
+         if (*pEnd != 0 || pOptions->bench.sampleTimeMs == 0) {
+            fprintf(stderr, "Invalid sample time \"%s\".\n\n", argv[i]);
+            return FALSE;
+         }
+      }
+      else {
+         fprintf(stderr, "Invalid argument \"%s\".\n\n", arg);
+         return FALSE;
+      }
+   }
+
+   if (pOptions->query != NULL && pOptions->aggregatePath == NULL) {
+      fputs("--query needs --aggregate.\n\n", stderr);
+      return FALSE;
+   }
+
+   if (pOptions->repeatCount != 0 && pOptions->list.showStatistics == FALSE) {
+      fputs("--repeat needs --stats.\n\n", stderr);
+      return FALSE;
+   }
+
+   if (pOptions->bench.batchSize != 0 && pOptions->bench.measureLatency == FALSE) {
+      fputs("--batch needs --latency.\n\n", stderr);
+      return FALSE;
+   }
+
+   if (pOptions->bench.measureScaling + pOptions->bench.measureLatency + pOptions->bench.measureRng > 1) {
+      fputs("Only one of --scaling, --latency and --rng can be given.\n\n", stderr);
+      return FALSE;
+   }
+
+   if (pOptions->watchOptions.checkCount != 0 && pOptions->watch == FALSE) {
+      fputs("--watch-count needs --watch.\n\n", stderr);
+      return FALSE;
+   }
+
+   pOptions->bench.maxThreads = pOptions->list.maxThreads;
+   pOptions->watchOptions.showStatistics = pOptions->list.showStatistics;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the crypto engine for the benchmarks.
+/// </summary>
+/// <returns>Pointer to the crypto engine or NULL, if there is none on this platform.</returns>
+static const CRYPTO_ENGINE* getCryptoEngine(void) {
+#if defined(_WIN32)
+   return GetCngEngine();
+#elif defined(HAVE_OPENSSL)
+   return GetLibCryptoEngine();
+#else
+   fputs("There is no crypto engine for benchmarks on this platform.\n", stderr);
+   return NULL;
+#endif
+}
+
 // ******** Main method ********
 
 int __cdecl main(int const argc, char const* argv[]) {
-   if (ListAllTypes() == 0)
-      return RC_OK;
+   OPTIONS options;
+   if (parseArguments(argc, argv, &options) == FALSE) {
+      printUsage();
+      return RC_CMD_ERR;
+   }
+
+   // 1. The aggregation and the version scan only read files, so they need no backend.
+   if (options.aggregatePath != NULL)
+      return (AggregateSnapshots(options.aggregatePath, options.query, &options.list) == 0) ? RC_OK : RC_PROC_ERR;
+
+   if (options.versionsPath != NULL)
+      return (PrintModuleVersions(options.versionsPath, &options.list) == 0) ? RC_OK : RC_PROC_ERR;
+
+   // 2. Select the backend.
+   ALGORITHM_BACKEND* pFixtureBackend = NULL;
+   const ALGORITHM_BACKEND* pBackend;
+   if (options.fixturePath != NULL) {
+      pFixtureBackend = OpenFixtureBackend(options.fixturePath);
+      if (pFixtureBackend == NULL)
+         return RC_PROC_ERR;
+
+      pBackend = pFixtureBackend;
+   } else {
+#ifdef _WIN32
+      pBackend = GetCngBackend();
+#else
+      fputs("There is no native enumeration backend on this platform. A snapshot file has to be specified.\n\n", stderr);
+      printUsage();
+      return RC_CMD_ERR;
+#endif
+   }
+
+   // 3. Select the cache file. The default cache file is only used for the native backend.
+   char defaultCachePath[CACHE_PATH_SIZE];
+   if (options.noCache != FALSE)
+      options.list.cachePath = NULL;
+   else if (options.list.cachePath == NULL && pFixtureBackend == NULL && GetDefaultCachePath(defaultCachePath, sizeof(defaultCachePath)) != FALSE)
+      options.list.cachePath = defaultCachePath;
+
+   // 4. Record, compare, list the providers, watch, measure or print the lists.
+   int rc;
+   if (options.recordPath != NULL)
+      rc = (WriteSnapshot(pBackend, options.recordPath, options.list.showDetails, options.list.maxThreads) != FALSE) ? RC_OK : RC_PROC_ERR;
+   else if (options.diffPath != NULL) {
+      ALGORITHM_BACKEND* pOldBackend = OpenFixtureBackend(options.diffPath);
+      if (pOldBackend != NULL) {
+         rc = (DiffAllTypes(pOldBackend, pBackend, &options.list) == 0) ? RC_OK : RC_PROC_ERR;
+         CloseFixtureBackend(pOldBackend);
+      }
+      else
+         rc = RC_PROC_ERR;
+   }
+   else if (options.listProviders != FALSE)
+      rc = (ListProviders(pBackend, &options.list) == 0) ? RC_OK : RC_PROC_ERR;
+   else if (options.watch != FALSE)
+      rc = (WatchCatalog(pBackend, &options.watchOptions) == 0) ? RC_OK : RC_PROC_ERR;
+   else if (options.runBenchmark != FALSE) {
+      const CRYPTO_ENGINE* pEngine = getCryptoEngine();
+      if (pEngine != NULL)
+         rc = (BenchmarkAllTypes(pBackend, pEngine, &options.bench) == 0) ? RC_OK : RC_PROC_ERR;
+      else
+         rc = RC_CMD_ERR;
+   }
+   else if (options.list.showStatistics != FALSE)
+      rc = (ProfileListAllTypes(pBackend, &options.list, (options.repeatCount != 0) ? options.repeatCount : 1) == 0) ? RC_OK : RC_PROC_ERR;
    else
-      return RC_PROC_ERR;
+      rc = (ListAllTypes(pBackend, &options.list) == 0) ? RC_OK : RC_PROC_ERR;
+
+   CloseFixtureBackend(pFixtureBackend);
+
+   return rc;
 }
@@ -0,0 +1,100 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <string.h>
+
+#include "BenchTarget.h"
+
+// ******** Public methods ********
+
+/// <summary>
+/// Create the hash or key object of a target. The engine and the isHash flag have to be set.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <returns>NTSTATUS of the operation. STATUS_NOT_SUPPORTED, if the object can not be measured.</returns>
+NTSTATUS CreateBenchObject(BENCH_TARGET* const pTarget, ENGINE_HANDLE const hAlgorithm) {
+   const CRYPTO_ENGINE* pEngine = pTarget->pEngine;
+   NTSTATUS nts;
+
+   memset(pTarget->iv, 0, sizeof(pTarget->iv));
+
+   if (pTarget->isHash != FALSE) {
+      nts = pEngine->CreateHash(pEngine->context, hAlgorithm, &pTarget->hObject, &pTarget->hashLength);
+      if (nts >= 0 && pTarget->hashLength > MAX_HASH_LENGTH) {
+         pEngine->DestroyHash(pEngine->context, pTarget->hObject);
+         nts = STATUS_NOT_SUPPORTED;
+      }
+   } else {
+      nts = pEngine->GenerateKey(pEngine->context, hAlgorithm, &pTarget->hObject, &pTarget->blockLength);
+      if (nts >= 0 && (pTarget->blockLength > MAX_BLOCK_LENGTH || (MAX_BLOCK_LENGTH % pTarget->blockLength) != 0)) {
+         pEngine->DestroyKey(pEngine->context, pTarget->hObject);
+         nts = STATUS_NOT_SUPPORTED;
+      }
+   }
+
+   return nts;
+}
+
+/// <summary>
+/// Destroy the hash or key object of a target.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+void DestroyBenchObject(BENCH_TARGET* const pTarget) {
+   const CRYPTO_ENGINE* pEngine = pTarget->pEngine;
+
+   if (pTarget->isHash != FALSE)
+      pEngine->DestroyHash(pEngine->context, pTarget->hObject);
+   else
+      pEngine->DestroyKey(pEngine->context, pTarget->hObject);
+}
+
+/// <summary>
+/// Hash or encrypt one message from the input buffer into the output buffer.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+/// <param name="messageSize">Size of the message. It has to be a multiple of MAX_BLOCK_LENGTH.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+NTSTATUS ProcessMessage(BENCH_TARGET* const pTarget, const ULONG messageSize) {
+   const CRYPTO_ENGINE* pEngine = pTarget->pEngine;
+
+   if (pTarget->isHash != FALSE) {
+      NTSTATUS nts = pEngine->HashData(pEngine->context, pTarget->hObject, pTarget->pInput, messageSize);
+      if (nts < 0)
+         return nts;
+
+      return pEngine->FinishHash(pEngine->context, pTarget->hObject, pTarget->pOutput, pTarget->hashLength);
+   }
+
+   return pEngine->Encrypt(pEngine->context,
+                           pTarget->hObject,
+                           pTarget->pInput,
+                           messageSize,
+                           (pTarget->blockLength > 1) ? pTarget->iv : NULL,
+                           pTarget->pOutput);
+}
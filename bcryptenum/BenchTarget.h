@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CryptoEngine.h"
+
+/// Maximum length of a hash value in bytes.
+#define MAX_HASH_LENGTH 64
+
+/// Maximum block length in bytes. Message sizes have to be multiples of this value.
+#define MAX_BLOCK_LENGTH 32
+
+/// <summary>
+/// Object that is measured.
+/// The hash or key object is created once, so its setup is not part of the measurement.
+/// </summary>
+typedef struct _BENCH_TARGET {
+   const CRYPTO_ENGINE* pEngine;
+   ENGINE_HANDLE hObject;
+   BOOL isHash;
+   ULONG hashLength;
+   ULONG blockLength;
+   PUCHAR pInput;
+   PUCHAR pOutput;
+   UCHAR iv[MAX_BLOCK_LENGTH];
+} BENCH_TARGET;
+
+/// <summary>
+/// Create the hash or key object of a target. The engine and the isHash flag have to be set.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <returns>NTSTATUS of the operation. STATUS_NOT_SUPPORTED, if the object can not be measured.</returns>
+NTSTATUS CreateBenchObject(BENCH_TARGET* const pTarget, ENGINE_HANDLE const hAlgorithm);
+
+/// <summary>
+/// Destroy the hash or key object of a target.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+void DestroyBenchObject(BENCH_TARGET* const pTarget);
+
+/// <summary>
+/// Hash or encrypt one message from the input buffer into the output buffer.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+/// <param name="messageSize">Size of the message. It has to be a multiple of MAX_BLOCK_LENGTH.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+NTSTATUS ProcessMessage(BENCH_TARGET* const pTarget, const ULONG messageSize);
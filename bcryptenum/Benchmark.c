@@ -0,0 +1,535 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.6.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Multi-core scaling measurement.
+//    2026-10-16: V1.2.0: Sort names in the same order as the list.
+//    2026-10-16: V1.3.0: Print header through an output buffer.
+//    2026-10-16: V1.4.0: Format throughput with the number formatter.
+//    2026-10-16: V1.5.0: Latency of asymmetric algorithms.
+//    2026-10-16: V1.6.0: Throughput of random number generators.
+//
+
+#define _CRT_DISABLE_PERFCRIT_LOCKS 1
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "ApiErrorHandler.h"
+#include "BenchTarget.h"
+#include "Benchmark.h"
+#include "Console.h"
+#include "LatencyBenchmark.h"
+#include "NameSort.h"
+#include "NumberFormatter.h"
+#include "OutputBuffer.h"
+#include "PrintModVersion.h"
+#include "RngBenchmark.h"
+#include "ScalingBenchmark.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+#define RC_OK  0
+#define RC_ERR 0xff
+
+/// Size of the smallest message in bytes.
+#define MIN_MESSAGE_SIZE 64UL
+
+/// Size of the largest message in bytes.
+#define MAX_MESSAGE_SIZE (16UL * 1024UL * 1024UL)
+
+/// The message size is multiplied by 2^SIZE_STEP_SHIFT from one measurement to the next.
+#define SIZE_STEP_SHIFT 2
+
+/// Number of measurement samples per message size.
+#define SAMPLE_COUNT 7
+
+/// Default minimum duration of a sample in milliseconds.
+#define DEFAULT_SAMPLE_TIME_MS 10
+
+/// Samples that deviate from the median by more than this multiple of the median absolute deviation are discarded.
+#define OUTLIER_FACTOR 3
+
+/// Size of the messages for the scaling measurement in bytes.
+#define SCALING_MESSAGE_SIZE (16UL * 1024UL)
+
+/// A scaling measurement lasts this multiple of the sample time.
+#define SCALING_TIME_FACTOR 20
+
+/// The latency measurement of an operation lasts at least this multiple of the sample time.
+#define LATENCY_TIME_FACTOR 50
+
+/// Operation types whose algorithms are measured by the latency measurement.
+#define LATENCY_OPERATIONS (BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION | BCRYPT_SIGNATURE_OPERATION)
+
+/// A random number measurement of one request size and thread count lasts this multiple of the sample time.
+#define RNG_TIME_FACTOR 10
+
+/// Size of the buffer for the header.
+#define HEADER_CAPACITY 256
+
+// ******** Private types ********
+
+/// <summary>
+/// One measurement sample.
+/// </summary>
+typedef struct _SAMPLE {
+   uint64_t nanoseconds;
+   uint64_t cycles;
+} SAMPLE;
+
+/// <summary>
+/// Result of the measurement of one message size.
+/// </summary>
+typedef struct _BENCH_RESULT {
+   double megabytesPerSecond;
+   double cyclesPerByte;
+   ULONG usedSamples;
+} BENCH_RESULT;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Compare two unsigned 64 bit values for qsort.
+/// </summary>
+/// <param name="pLeft">Pointer to the left value.</param>
+/// <param name="pRight">Pointer to the right value.</param>
+/// <returns>Result of the comparison.</returns>
+static int compareUint64(const void* const pLeft, const void* const pRight) {
+   uint64_t left = *(const uint64_t*)pLeft;
+   uint64_t right = *(const uint64_t*)pRight;
+
+   return (left > right) - (left < right);
+}
+
+/// <summary>
+/// Process a message several times and measure the time and the cycles that this takes.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+/// <param name="messageSize">Size of the message.</param>
+/// <param name="iterations">Number of times the message is processed.</param>
+/// <param name="pSample">Pointer to the sample that receives the measurement.</param>
+/// <returns>NTSTATUS of the operations.</returns>
+static NTSTATUS measureIterations(BENCH_TARGET* const pTarget, const ULONG messageSize, const ULONG iterations, SAMPLE* const pSample) {
+   uint64_t startCycles = ReadCycleCounter();
+   uint64_t startTime = GetTimeNs();
+
+   for (ULONG i = iterations; i > 0; i--) {
+      NTSTATUS nts = ProcessMessage(pTarget, messageSize);
+      if (nts < 0)
+         return nts;
+   }
+
+   pSample->nanoseconds = GetTimeNs() - startTime;
+   pSample->cycles = ReadCycleCounter() - startCycles;
+
+   // Guard against a clock that is too coarse for very short samples.
+   if (pSample->nanoseconds == 0)
+      pSample->nanoseconds = 1;
+
+   return 0;
+}
+
+/// <summary>
+/// Combine the samples into one result.
+/// Samples that deviate from the median by more than OUTLIER_FACTOR times the median absolute deviation
+/// are discarded, as they are caused by interrupts, context switches and frequency changes.
+/// </summary>
+/// <param name="pSamples">Samples.</param>
+/// <param name="bytesPerSample">Number of bytes processed per sample.</param>
+/// <param name="pResult">Pointer to the result.</param>
+static void combineSamples(const SAMPLE* const pSamples, const uint64_t bytesPerSample, BENCH_RESULT* const pResult) {
+   // 1. Get the median.
+   uint64_t sorted[SAMPLE_COUNT];
+   for (ULONG i = 0; i < SAMPLE_COUNT; i++)
+      sorted[i] = pSamples[i].nanoseconds;
+
+   qsort(sorted, SAMPLE_COUNT, sizeof(uint64_t), compareUint64);
+   uint64_t median = sorted[SAMPLE_COUNT / 2];
+
+   // 2. Get the median absolute deviation.
+   for (ULONG i = 0; i < SAMPLE_COUNT; i++)
+      sorted[i] = (pSamples[i].nanoseconds > median) ? pSamples[i].nanoseconds - median : median - pSamples[i].nanoseconds;
+
+   qsort(sorted, SAMPLE_COUNT, sizeof(uint64_t), compareUint64);
+   uint64_t limit = sorted[SAMPLE_COUNT / 2] * OUTLIER_FACTOR;
+
+   // 3. Average the samples that are not outliers. The median itself is never an outlier.
+   uint64_t totalNanoseconds = 0;
+   uint64_t totalCycles = 0;
+   ULONG usedSamples = 0;
+   for (ULONG i = 0; i < SAMPLE_COUNT; i++) {
+      uint64_t nanoseconds = pSamples[i].nanoseconds;
+      uint64_t deviation = (nanoseconds > median) ? nanoseconds - median : median - nanoseconds;
+      if (deviation <= limit) {
+         totalNanoseconds += nanoseconds;
+         totalCycles += pSamples[i].cycles;
+         usedSamples++;
+      }
+   }
+
+   double totalBytes = (double)bytesPerSample * (double)usedSamples;
+   pResult->megabytesPerSecond = totalBytes * 1000.0 / (double)totalNanoseconds;
+   pResult->cyclesPerByte = (double)totalCycles / totalBytes;
+   pResult->usedSamples = usedSamples;
+}
+
+/// <summary>
+/// Measure the throughput for one message size.
+/// </summary>
+/// <param name="pTarget">Object to measure.</param>
+/// <param name="messageSize">Size of the message.</param>
+/// <param name="sampleTimeNs">Minimum duration of a sample in nanoseconds.</param>
+/// <param name="pResult">Pointer to the result.</param>
+/// <returns>NTSTATUS of the operations.</returns>
+static NTSTATUS measureMessageSize(BENCH_TARGET* const pTarget,
+                                   const ULONG messageSize,
+                                   const uint64_t sampleTimeNs,
+                                   BENCH_RESULT* const pResult) {
+   // 1. Warm up caches, branch predictors and the clock frequency and find out how many iterations fill a sample.
+   ULONG iterations = 1;
+   SAMPLE sample;
+   for (;;) {
+      NTSTATUS nts = measureIterations(pTarget, messageSize, iterations, &sample);
+      if (nts < 0)
+         return nts;
+
+      if (sample.nanoseconds >= (sampleTimeNs >> 2) || iterations >= 0x40000000UL)
+         break;
+
+      iterations <<= 1;
+   }
+
+   uint64_t scaledIterations = ((uint64_t)iterations * sampleTimeNs) / sample.nanoseconds;
+   if (scaledIterations == 0)
+      scaledIterations = 1;
+   else if (scaledIterations > 0xffffffffULL)
+      scaledIterations = 0xffffffffULL;
+
+   iterations = (ULONG)scaledIterations;
+
+   // 2. Take the samples.
+   SAMPLE samples[SAMPLE_COUNT];
+   for (ULONG i = 0; i < SAMPLE_COUNT; i++) {
+      NTSTATUS nts = measureIterations(pTarget, messageSize, iterations, samples + i);
+      if (nts < 0)
+         return nts;
+   }
+
+   // 3. Combine the samples.
+   combineSamples(samples, (uint64_t)messageSize * iterations, pResult);
+
+   return 0;
+}
+
+/// <summary>
+/// Print the size of a message with a binary unit.
+/// </summary>
+/// <param name="messageSize">Size of the message.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+static void printMessageSize(const ULONG messageSize, FILE* fStdOut) {
+   const char* unit = "B";
+   ULONG value = messageSize;
+   if (messageSize >= 1024UL * 1024UL) {
+      unit = "MiB";
+      value = messageSize >> 20;
+   } else if (messageSize >= 1024UL) {
+      unit = "KiB";
+      value = messageSize >> 10;
+   }
+
+   fprintf(fStdOut, "      %5lu %-3s:", (unsigned long)value, unit);
+}
+
+/// <summary>
+/// Measure the throughput of one algorithm for all message sizes.
+/// </summary>
+/// <param name="pTarget">Object to measure with the buffers set.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="sampleTimeNs">Minimum duration of a sample in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+static BOOL benchmarkAlgorithm(BENCH_TARGET* const pTarget,
+                               LPCWSTR const algorithmName,
+                               const uint64_t sampleTimeNs,
+                               FILE* fStdOut) {
+   const PCHAR functionName = "benchmarkAlgorithm";
+
+   const CRYPTO_ENGINE* pEngine = pTarget->pEngine;
+
+   fputs("   ", fStdOut);
+   fputs(AsConsoleCodePageString(algorithmName), fStdOut);
+   _putc_nolock('\n', fStdOut);
+
+   // 1. Open the algorithm and create the hash or key object.
+   //    Algorithms the engine does not implement are skipped.
+   ENGINE_HANDLE hAlgorithm;
+   NTSTATUS nts = pEngine->OpenAlgorithm(pEngine->context, algorithmName, &hAlgorithm);
+   if (nts >= 0) {
+      nts = CreateBenchObject(pTarget, hAlgorithm);
+      if (nts < 0)
+         pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+   }
+
+   if (nts == STATUS_NOT_SUPPORTED) {
+      fprintf(fStdOut, "      Not supported by engine %s\n", pEngine->name);
+      return TRUE;
+   }
+
+   if (nts < 0) {
+      fprintf(fStdOut, "      Could not open algorithm: 0x%08lx\n", (unsigned long)(ULONG)nts);
+      return TRUE;
+   }
+
+   // 2. Measure all message sizes.
+   BOOL result = TRUE;
+   for (ULONG messageSize = MIN_MESSAGE_SIZE; messageSize <= MAX_MESSAGE_SIZE; messageSize <<= SIZE_STEP_SHIFT) {
+      BENCH_RESULT benchResult;
+      nts = measureMessageSize(pTarget, messageSize, sampleTimeNs, &benchResult);
+      if (nts < 0) {
+         PrintNtStatus(functionName, pTarget->isHash != FALSE ? "HashData" : "Encrypt", nts);
+         result = FALSE;
+         break;
+      }
+
+      printMessageSize(messageSize, fStdOut);
+      char number[NUMBER_BUFFER_SIZE];
+      FormatFixedPoint(benchResult.megabytesPerSecond, 2, number);
+      fprintf(fStdOut, " %10s MB/s", number);
+      if (benchResult.cyclesPerByte > 0.0) {
+         FormatFixedPoint(benchResult.cyclesPerByte, 2, number);
+         fprintf(fStdOut, " %8s cycles/byte", number);
+      }
+      fprintf(fStdOut, " (%lu of %u samples)\n", (unsigned long)benchResult.usedSamples, SAMPLE_COUNT);
+   }
+
+   // 3. Release the objects.
+   DestroyBenchObject(pTarget);
+
+   pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+
+   return result;
+}
+
+/// <summary>
+/// Get the title of the algorithms that are measured.
+/// </summary>
+/// <param name="algorithmType">BCRYPT_HASH_OPERATION, BCRYPT_CIPHER_OPERATION, BCRYPT_RNG_OPERATION or LATENCY_OPERATIONS.</param>
+/// <returns>Title of the algorithms.</returns>
+static const char* algorithmTypeTitle(const ULONG algorithmType) {
+   switch (algorithmType) {
+   case BCRYPT_HASH_OPERATION:
+      return "Hashes";
+
+   case BCRYPT_CIPHER_OPERATION:
+      return "Symmetric ciphers";
+
+   case BCRYPT_RNG_OPERATION:
+      return "Random number generators";
+
+   default:
+      return "Asymmetric ciphers and signatures";
+   }
+}
+
+/// <summary>
+/// Measure all algorithms of one type.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pTarget">Object to measure with the engine and the buffers set.</param>
+/// <param name="pOptions">Benchmark options.</param>
+/// <param name="hHeap">Handle of the local heap.</param>
+/// <param name="algorithmType">BCRYPT_HASH_OPERATION, BCRYPT_CIPHER_OPERATION, BCRYPT_RNG_OPERATION or LATENCY_OPERATIONS.</param>
+/// <param name="sampleTimeNs">Minimum duration of a sample in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if all algorithms could be measured, FALSE if not.</returns>
+static BOOL benchmarkForType(const ALGORITHM_BACKEND* const pBackend,
+                             BENCH_TARGET* const pTarget,
+                             const BENCH_OPTIONS* const pOptions,
+                             const HANDLE hHeap,
+                             const ULONG algorithmType,
+                             const uint64_t sampleTimeNs,
+                             FILE* fStdOut) {
+   const PCHAR functionName = "benchmarkForType";
+
+   pTarget->isHash = (algorithmType == BCRYPT_HASH_OPERATION);
+
+   fprintf(fStdOut, "\n%s:\n\n", algorithmTypeTitle(algorithmType));
+
+   // 1. Get the list of algorithms of this type.
+   ULONG algoCount;
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList;
+   NTSTATUS nts = pBackend->EnumAlgorithms(pBackend->context, algorithmType, &algoCount, &pAlgoList);
+   if (nts < 0) {
+      PrintNtStatus(functionName, "EnumAlgorithms", nts);
+      return FALSE;
+   }
+
+   // 2. Sort the algorithm names.
+   LPWSTR* pSortedList = HeapAlloc(hHeap, 0, (algoCount + 1) * sizeof(LPWSTR));
+   if (pSortedList == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for algorithm name list failed.\n", functionName);
+      pBackend->FreeBuffer(pBackend->context, pAlgoList);
+      return FALSE;
+   }
+
+   for (ULONG i = 0; i < algoCount; i++)
+      pSortedList[i] = pAlgoList[i].pszName;
+
+   if (SortNames(pSortedList, algoCount) == FALSE) {
+      HeapFree(hHeap, 0, pSortedList);
+      pBackend->FreeBuffer(pBackend->context, pAlgoList);
+      return FALSE;
+   }
+
+   // 3. Measure the algorithms one after the other, so that they do not disturb each other.
+   BOOL result = TRUE;
+   for (ULONG i = 0; i < algoCount; i++) {
+      if (pOptions->measureRng != FALSE)
+         result &= MeasureRandomNumbers(pTarget->pEngine,
+                                        pSortedList[i],
+                                        pOptions->maxThreads,
+                                        sampleTimeNs * RNG_TIME_FACTOR,
+                                        fStdOut);
+      else if (pOptions->measureLatency != FALSE)
+         result &= MeasureLatency(pTarget->pEngine,
+                                  pSortedList[i],
+                                  (pOptions->batchSize != 0) ? pOptions->batchSize : 1,
+                                  sampleTimeNs * LATENCY_TIME_FACTOR,
+                                  fStdOut);
+      else if (pOptions->measureScaling != FALSE)
+         result &= MeasureScaling(pTarget->pEngine,
+                                  pSortedList[i],
+                                  pTarget->isHash,
+                                  SCALING_MESSAGE_SIZE,
+                                  pOptions->maxThreads,
+                                  sampleTimeNs * SCALING_TIME_FACTOR,
+                                  fStdOut);
+      else
+         result &= benchmarkAlgorithm(pTarget, pSortedList[i], sampleTimeNs, fStdOut);
+
+      fflush(fStdOut);
+   }
+
+   // 4. Release memory.
+   HeapFree(hHeap, 0, pSortedList);
+   pBackend->FreeBuffer(pBackend->context, pAlgoList);
+
+   return result;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Measure the throughput of all hash and symmetric cipher algorithms the backend lists,
+/// the latency of all asymmetric cipher and signature algorithms or the throughput of all random number generators.
+/// </summary>
+/// <param name="pBackend">Enumeration backend that supplies the algorithm names.</param>
+/// <param name="pEngine">Crypto engine that runs the algorithms.</param>
+/// <param name="pOptions">Benchmark options.</param>
+/// <returns>0, if all measurements could be made, 0xff if not.</returns>
+unsigned char BenchmarkAllTypes(const ALGORITHM_BACKEND* const pBackend,
+                                const CRYPTO_ENGINE* const pEngine,
+                                const BENCH_OPTIONS* const pOptions) {
+   const PCHAR functionName = "BenchmarkAllTypes";
+
+   FILE* fStdOut = stdout;
+
+   // 1. Print header.
+   OUTPUT_BUFFER header;
+   if (InitOutputBuffer(&header, fStdOut, HEADER_CAPACITY) == FALSE)
+      return RC_ERR;
+
+   if (pOptions->measureRng != FALSE)
+      OutputString(&header, "\nRandom number throughput of Bcrypt ");
+   else if (pOptions->measureLatency != FALSE)
+      OutputString(&header, "\nLatency of Bcrypt ");
+   else
+      OutputString(&header, (pOptions->measureScaling != FALSE) ? "\nMulti-core scaling of Bcrypt " : "\nThroughput of Bcrypt ");
+   PrintModuleVersion(pBackend, "bcrypt.dll", &header);
+   OutputFormat(&header, " algorithms with engine %s:\n", pEngine->name);
+   FlushOutputBuffer(&header);
+   FreeOutputBuffer(&header);
+
+   // 2. Allocate the message buffers.
+   //    The hash value and the cipher text are written to the output buffer.
+   HANDLE hHeap = GetProcessHeap();
+   if (hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return RC_ERR;
+   }
+
+   BENCH_TARGET target;
+   memset(&target, 0, sizeof(target));
+   target.pEngine = pEngine;
+
+   target.pInput = HeapAlloc(hHeap, 0, MAX_MESSAGE_SIZE);
+   target.pOutput = HeapAlloc(hHeap, 0, MAX_MESSAGE_SIZE);
+   if (target.pInput == NULL || target.pOutput == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for message buffers failed.\n", functionName);
+      if (target.pInput != NULL)
+         HeapFree(hHeap, 0, target.pInput);
+      if (target.pOutput != NULL)
+         HeapFree(hHeap, 0, target.pOutput);
+      return RC_ERR;
+   }
+
+   // Touch all pages, so that page faults are not measured.
+   for (ULONG i = 0; i < MAX_MESSAGE_SIZE; i++) {
+      target.pInput[i] = (UCHAR)(i * 131 + 7);
+      target.pOutput[i] = 0;
+   }
+
+   // 3. Measure hashes and ciphers, the asymmetric algorithms or the random number generators.
+   ULONG sampleTimeMs = (pOptions->sampleTimeMs != 0) ? pOptions->sampleTimeMs : DEFAULT_SAMPLE_TIME_MS;
+   uint64_t sampleTimeNs = (uint64_t)sampleTimeMs * 1000000ULL;
+
+   BOOL result;
+   if (pOptions->measureRng != FALSE) {
+      // The system-preferred generator is not listed, but it is the one most programs use.
+      result = benchmarkForType(pBackend, &target, pOptions, hHeap, BCRYPT_RNG_OPERATION, sampleTimeNs, fStdOut);
+      result &= MeasureRandomNumbers(pEngine, NULL, pOptions->maxThreads, sampleTimeNs * RNG_TIME_FACTOR, fStdOut);
+   } else if (pOptions->measureLatency != FALSE)
+      result = benchmarkForType(pBackend, &target, pOptions, hHeap, LATENCY_OPERATIONS, sampleTimeNs, fStdOut);
+   else {
+      result = benchmarkForType(pBackend, &target, pOptions, hHeap, BCRYPT_HASH_OPERATION, sampleTimeNs, fStdOut);
+      result &= benchmarkForType(pBackend, &target, pOptions, hHeap, BCRYPT_CIPHER_OPERATION, sampleTimeNs, fStdOut);
+   }
+
+   _putc_nolock('\n', fStdOut);
+
+   // 4. Release memory.
+   HeapFree(hHeap, 0, target.pOutput);
+   HeapFree(hHeap, 0, target.pInput);
+
+   if (result == FALSE)
+      return RC_ERR;
+
+   return RC_OK;
+}
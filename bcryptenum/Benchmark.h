@@ -0,0 +1,39 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "CryptoEngine.h"
+
+/// <summary>
+/// Benchmark options.
+/// </summary>
+typedef struct _BENCH_OPTIONS {
+   /// Minimum duration of one measurement sample in milliseconds. 0 means the default.
+   ULONG sampleTimeMs;
+
+   /// Measure the throughput on 1 up to maxThreads threads, instead of the throughput per message size.
+   BOOL measureScaling;
+
+   /// Maximum number of threads for the scaling measurement. 0 means the number of processors.
+   ULONG maxThreads;
+
+   /// Measure the latency percentiles of the key generation, signature and verification of the asymmetric algorithms.
+   BOOL measureLatency;
+
+   /// Number of signatures or verifications the latency measurement times together. 0 means 1.
+   ULONG batchSize;
+
+   /// Measure the throughput of the random number generators for several request sizes on 1 up to maxThreads threads.
+   BOOL measureRng;
+} BENCH_OPTIONS;
+
+/// <summary>
+/// Measure the throughput of all hash and symmetric cipher algorithms the backend lists,
+/// the latency of all asymmetric cipher and signature algorithms or the throughput of all random number generators.
+/// </summary>
+/// <param name="pBackend">Enumeration backend that supplies the algorithm names.</param>
+/// <param name="pEngine">Crypto engine that runs the algorithms.</param>
+/// <param name="pOptions">Benchmark options.</param>
+/// <returns>0, if all measurements could be made, 0xff if not.</returns>
+unsigned char BenchmarkAllTypes(const ALGORITHM_BACKEND* const pBackend,
+                                const CRYPTO_ENGINE* const pEngine,
+                                const BENCH_OPTIONS* const pOptions);
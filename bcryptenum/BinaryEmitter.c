@@ -0,0 +1,218 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <string.h>
+#include <wchar.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#include "BinaryEmitter.h"
+#include "ListEmitter.h"
+#include "Transcoder.h"
+
+// ******** Private constants ********
+
+/// Maximum number of UTF-8 bytes for a wide character.
+#define MAX_BYTES_PER_WIDE_CHARACTER 4
+
+/// Size of the name buffer, if the record can not be built in the output buffer.
+#define FALLBACK_NAME_SIZE 1024
+
+/// Zero bytes for the padding.
+static const char padding[BINARY_LIST_ALIGNMENT] = { 0 };
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the length of a name with the terminating 0 and the padding.
+/// </summary>
+/// <param name="nameLength">Length of the name without the terminating 0.</param>
+/// <returns>Padded length.</returns>
+static inline size_t paddedLength(const size_t nameLength) {
+   return (nameLength + BINARY_LIST_ALIGNMENT) & ~(size_t)(BINARY_LIST_ALIGNMENT - 1);
+}
+
+/// <summary>
+/// Fill the fixed part of an algorithm record.
+/// </summary>
+/// <param name="pRecord">Record.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pAlgorithm">Algorithm identifier from the enumeration.</param>
+/// <param name="pDetails">Capabilities of the algorithm or NULL, if it was not probed.</param>
+/// <param name="nameLength">Length of the UTF-8 name.</param>
+static void fillRecord(BINARY_LIST_RECORD* const pRecord,
+                       const ULONG operationType,
+                       const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm,
+                       const ALGORITHM_DETAILS* const pDetails,
+                       const size_t nameLength) {
+   memset(pRecord, 0, sizeof(BINARY_LIST_RECORD));
+
+   pRecord->recordLength = (ULONG)(sizeof(BINARY_LIST_RECORD) + paddedLength(nameLength));
+   pRecord->operationType = operationType;
+   pRecord->algorithmClass = pAlgorithm->dwClass;
+   pRecord->flags = pAlgorithm->dwFlags;
+   pRecord->nameLength = (ULONG)nameLength;
+
+   if (pDetails != NULL) {
+      pRecord->hasDetails = 1;
+      pRecord->status = pDetails->status;
+      pRecord->validFields = (pDetails->status >= 0) ? pDetails->validFields : 0;
+      pRecord->minKeyLength = pDetails->keyLengths.dwMinLength;
+      pRecord->maxKeyLength = pDetails->keyLengths.dwMaxLength;
+      pRecord->keyLengthIncrement = pDetails->keyLengths.dwIncrement;
+      pRecord->blockLength = pDetails->blockLength;
+      pRecord->hashLength = pDetails->hashLength;
+      pRecord->objectLength = pDetails->objectLength;
+      pRecord->chainingModes = pDetails->chainingModes;
+   }
+}
+
+/// <summary>
+/// Emit the header of the binary list.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="moduleName">Name of the module that implements the algorithms (not used).</param>
+/// <param name="pVersion">Version of the module or NULL, if it is not known.</param>
+static void binaryBeginList(EMITTER_STATE* const pState, const PCHAR moduleName, const MODULE_VERSION* const pVersion) {
+   (void)moduleName;
+
+#ifdef _WIN32
+   // Line feeds must not be converted.
+   _setmode(_fileno(pState->pOutput->fOut), _O_BINARY);
+#endif
+
+   BINARY_LIST_HEADER header;
+   memset(&header, 0, sizeof(header));
+
+   memcpy(header.magic, BINARY_LIST_MAGIC, sizeof(BINARY_LIST_MAGIC));
+   header.byteOrderMark = BINARY_LIST_BYTE_ORDER_MARK;
+   header.formatVersion = BINARY_LIST_FORMAT_VERSION;
+   header.headerLength = sizeof(BINARY_LIST_HEADER);
+
+   if (pVersion != NULL) {
+      header.hasVersion = 1;
+      header.version[0] = pVersion->major;
+      header.version[1] = pVersion->minor;
+      header.version[2] = pVersion->build;
+      header.version[3] = pVersion->revision;
+   }
+
+   OutputBytes(pState->pOutput, (const char*)&header, sizeof(header));
+}
+
+/// <summary>
+/// Emit the start of an operation type. Each record has the operation type, so there is nothing to emit.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+static void binaryBeginType(EMITTER_STATE* const pState, const ULONG operationType) {
+   (void)pState;
+   (void)operationType;
+}
+
+/// <summary>
+/// Emit the record of one algorithm.
+/// The name is converted directly behind the place of the record in the output buffer
+/// and the record is filled in, when the length of the name is known.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pAlgorithm">Algorithm identifier from the enumeration.</param>
+/// <param name="pDetails">Capabilities of the algorithm or NULL, if it was not probed.</param>
+static void binaryEmitAlgorithm(EMITTER_STATE* const pState,
+                                const ULONG operationType,
+                                const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm,
+                                const ALGORITHM_DETAILS* const pDetails) {
+   OUTPUT_BUFFER* pOutput = pState->pOutput;
+
+   size_t wideLength = wcslen(pAlgorithm->pszName);
+   size_t maxNameSize = wideLength * MAX_BYTES_PER_WIDE_CHARACTER + BINARY_LIST_ALIGNMENT;
+
+   BINARY_LIST_RECORD record;
+   char* pRecord = ReserveOutput(pOutput, sizeof(BINARY_LIST_RECORD) + maxNameSize);
+   if (pRecord != NULL) {
+      char* pName = pRecord + sizeof(BINARY_LIST_RECORD);
+      size_t nameLength = TranscodeToUtf8(pAlgorithm->pszName, wideLength, pName, maxNameSize);
+      memset(pName + nameLength, 0, paddedLength(nameLength) - nameLength);
+
+      fillRecord(&record, operationType, pAlgorithm, pDetails, nameLength);
+      memcpy(pRecord, &record, sizeof(record));  // The output buffer may not be aligned for the record.
+
+      CommitOutput(pOutput, record.recordLength);
+   } else {
+      // If the output buffer can not hold the record, a possibly truncated name is written.
+      char name[FALLBACK_NAME_SIZE];
+      size_t nameLength = TranscodeToUtf8(pAlgorithm->pszName, wideLength, name, sizeof(name) - BINARY_LIST_ALIGNMENT);
+
+      fillRecord(&record, operationType, pAlgorithm, pDetails, nameLength);
+
+      OutputBytes(pOutput, (const char*)&record, sizeof(record));
+      OutputBytes(pOutput, name, nameLength);
+      OutputBytes(pOutput, padding, paddedLength(nameLength) - nameLength);
+   }
+}
+
+/// <summary>
+/// Emit the end of an operation type. There is nothing to emit.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void binaryEndType(EMITTER_STATE* const pState) {
+   (void)pState;
+}
+
+/// <summary>
+/// Emit the end of the binary list, which is a record length of 0.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void binaryEndList(EMITTER_STATE* const pState) {
+   OutputBytes(pState->pOutput, padding, BINARY_LIST_ALIGNMENT);
+}
+
+// ******** Private constants ********
+
+/// The binary emitter.
+static const LIST_EMITTER binaryEmitter = {
+   binaryBeginList,
+   binaryBeginType,
+   binaryEmitAlgorithm,
+   binaryEndType,
+   binaryEndList
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the binary emitter.
+/// </summary>
+/// <returns>Pointer to the emitter.</returns>
+const LIST_EMITTER* GetBinaryEmitter(void) {
+   return &binaryEmitter;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Platform.h"
+
+// ******** Binary list format ********
+//
+// The binary list is a header followed by one record per algorithm and a terminating record length of 0.
+// All numbers are 32 bit values in the byte order of the writer, which is given by the byte order mark.
+// Each record starts on a 4 byte boundary, so a reader can map the file and use the records in place.
+// The name follows the record structure as a 0 terminated UTF-8 string, padded with zeros to a 4 byte boundary.
+
+/// Magic bytes at the start of a binary list.
+#define BINARY_LIST_MAGIC "BCELIST"
+
+/// Size of the magic bytes including the terminating 0.
+#define BINARY_LIST_MAGIC_SIZE 8
+
+/// Value of the byte order mark.
+#define BINARY_LIST_BYTE_ORDER_MARK 0x01020304
+
+/// Version of the binary list format.
+#define BINARY_LIST_FORMAT_VERSION 1
+
+/// Alignment of the records.
+#define BINARY_LIST_ALIGNMENT 4
+
+/// <summary>
+/// Header of a binary list.
+/// </summary>
+typedef struct _BINARY_LIST_HEADER {
+   /// BINARY_LIST_MAGIC.
+   char magic[BINARY_LIST_MAGIC_SIZE];
+
+   /// BINARY_LIST_BYTE_ORDER_MARK.
+   ULONG byteOrderMark;
+
+   /// BINARY_LIST_FORMAT_VERSION.
+   ULONG formatVersion;
+
+   /// Length of the header. The first record starts here.
+   ULONG headerLength;
+
+   /// 1, if the module version is known, 0 if not.
+   ULONG hasVersion;
+
+   /// Version of the module: major, minor, build and revision.
+   ULONG version[4];
+} BINARY_LIST_HEADER;
+
+/// <summary>
+/// Record of one algorithm.
+/// </summary>
+typedef struct _BINARY_LIST_RECORD {
+   /// Length of the record including the name and the padding. The next record starts here.
+   ULONG recordLength;
+
+   /// BCRYPT_*_OPERATION type.
+   ULONG operationType;
+
+   /// dwClass of the algorithm identifier.
+   ULONG algorithmClass;
+
+   /// dwFlags of the algorithm identifier.
+   ULONG flags;
+
+   /// 1, if the algorithm was probed, 0 if not. The following fields are only valid, if it was probed.
+   ULONG hasDetails;
+
+   /// Status of opening the algorithm provider.
+   LONG status;
+
+   /// DETAIL_* flags of the valid capabilities.
+   ULONG validFields;
+
+   /// Minimum key length in bits.
+   ULONG minKeyLength;
+
+   /// Maximum key length in bits.
+   ULONG maxKeyLength;
+
+   /// Key length increment in bits.
+   ULONG keyLengthIncrement;
+
+   /// Block length in bytes.
+   ULONG blockLength;
+
+   /// Hash length in bytes.
+   ULONG hashLength;
+
+   /// Size of the algorithm object in bytes.
+   ULONG objectLength;
+
+   /// CHAINING_MODE_* flags of the supported chaining modes.
+   ULONG chainingModes;
+
+   /// Length of the UTF-8 name in bytes without the terminating 0.
+   ULONG nameLength;
+} BINARY_LIST_RECORD;
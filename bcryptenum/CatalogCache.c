@@ -0,0 +1,483 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// A cache file holds the sorted algorithm lists of all operation types, already converted to the console code page.
+// It is only valid for the module version, the module file stamp, the backend and the code page it was written for.
+//
+// Layout (all numbers in the byte order of the machine):
+//
+//    CACHE_HEADER
+//    For each operation type in the order of OperationTypes:
+//       SECTION_HEADER
+//       For each name: USHORT length, name bytes
+//
+// A cache file is not used, if
+//    - the magic or the format version is different,
+//    - any value of the key is different,
+//    - the file size is not the size recorded in the header,
+//    - the checksum of the data after the header is different,
+//    - the sections do not match the operation types or do not fit into the file.
+//
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "CatalogCache.h"
+#include "Transcoder.h"
+
+// ******** Private constants ********
+
+/// Magic bytes at the start of a cache file.
+static const char CACHE_MAGIC[8] = {'B', 'C', 'E', 'C', 'A', 'C', 'H', 'E'};
+
+/// Version of the file layout.
+#define CACHE_FORMAT_VERSION 1
+
+/// Name of the cache file.
+#define CACHE_FILE_NAME "bcryptenum.cache"
+
+/// Maximum number of bytes a wide character needs in the console code page.
+#define MAX_BYTES_PER_WIDE_CHARACTER 4
+
+/// Initial size of the writer buffer.
+#define INITIAL_CAPACITY 0x10000
+
+// ******** Private types ********
+
+/// <summary>
+/// Header of a cache file.
+/// </summary>
+typedef struct _CACHE_HEADER {
+   char magic[8];
+   ULONG formatVersion;
+   ULONG sectionCount;
+   uint64_t fileSize;
+   uint64_t checksum;
+   CACHE_KEY key;
+} CACHE_HEADER;
+
+/// <summary>
+/// Header of the list of one operation type.
+/// </summary>
+typedef struct _SECTION_HEADER {
+   ULONG operationType;
+   ULONG nameCount;
+} SECTION_HEADER;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Make sure that there is room for a number of bytes in the writer buffer.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="byteCount">Number of bytes that need room.</param>
+/// <returns>TRUE, if there is room, FALSE if not.</returns>
+static BOOL reserveRoom(CATALOG_WRITER* const pWriter, const size_t byteCount) {
+   const PCHAR functionName = "reserveRoom";
+
+   size_t neededCapacity = pWriter->length + byteCount;
+   if (neededCapacity <= pWriter->capacity)
+      return TRUE;
+
+   size_t newCapacity = pWriter->capacity * 2;
+   if (newCapacity < neededCapacity)
+      newCapacity = neededCapacity;
+
+   UCHAR* pNewData = HeapReAlloc(pWriter->hHeap, 0, pWriter->pData, newCapacity);
+   if (pNewData == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapReAlloc for catalog cache failed.\n", functionName);
+      pWriter->hasError = TRUE;
+      return FALSE;
+   }
+
+   pWriter->pData = pNewData;
+   pWriter->capacity = newCapacity;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Calculate the checksum of a byte sequence. It processes 8 bytes at a time, so that it is cheap compared to reading the file.
+/// </summary>
+/// <param name="pData">Bytes.</param>
+/// <param name="byteCount">Number of bytes.</param>
+/// <returns>Checksum.</returns>
+static uint64_t calculateChecksum(const UCHAR* const pData, const size_t byteCount) {
+   const uint64_t prime = 0x100000001b3ULL;
+   uint64_t checksum = 0xcbf29ce484222325ULL ^ byteCount;
+
+   size_t i = 0;
+   for (; i + sizeof(uint64_t) <= byteCount; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, pData + i, sizeof(word));
+      checksum = (checksum ^ word) * prime;
+      checksum ^= checksum >> 29;
+   }
+
+   for (; i < byteCount; i++)
+      checksum = (checksum ^ pData[i]) * prime;
+
+   return checksum;
+}
+
+/// <summary>
+/// Check that the sections of a cache file match the operation types and fit into the file.
+/// </summary>
+/// <param name="pCache">Mapped cache file.</param>
+/// <returns>TRUE, if the sections are valid, FALSE if not.</returns>
+static BOOL hasValidSections(const CATALOG_CACHE* const pCache) {
+   const UCHAR* p = pCache->file.pData + sizeof(CACHE_HEADER);
+   const UCHAR* const pEnd = pCache->file.pData + pCache->file.size;
+
+   for (ULONG s = 0; s < pCache->sectionCount; s++) {
+      SECTION_HEADER section;
+      if ((size_t)(pEnd - p) < sizeof(section))
+         return FALSE;
+
+      memcpy(&section, p, sizeof(section));
+      p += sizeof(section);
+
+      if (section.operationType != OperationTypes[s])
+         return FALSE;
+
+      for (ULONG i = 0; i < section.nameCount; i++) {
+         USHORT nameLength;
+         if ((size_t)(pEnd - p) < sizeof(nameLength))
+            return FALSE;
+
+         memcpy(&nameLength, p, sizeof(nameLength));
+         p += sizeof(nameLength);
+
+         if ((size_t)(pEnd - p) < nameLength)
+            return FALSE;
+
+         p += nameLength;
+      }
+   }
+
+   return (p == pEnd);
+}
+
+/// <summary>
+/// Get the id of this process for the name of the temporary file.
+/// </summary>
+/// <returns>Process id.</returns>
+static unsigned long getProcessId(void) {
+#ifdef _WIN32
+   return (unsigned long)GetCurrentProcessId();
+#else
+   return (unsigned long)getpid();
+#endif
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the values a cached catalog depends on from the backend.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="moduleName">Name of the module that implements the algorithms.</param>
+/// <param name="pVersion">Version of the module.</param>
+/// <param name="pKey">Pointer to the key to fill.</param>
+/// <returns>TRUE, if all values could be determined, FALSE if the catalog can not be cached.</returns>
+BOOL BuildCacheKey(const ALGORITHM_BACKEND* const pBackend, const PCHAR moduleName, const MODULE_VERSION* const pVersion, CACHE_KEY* const pKey) {
+   // All bytes of the key are compared, so the padding has to be 0, too.
+   memset(pKey, 0, sizeof(CACHE_KEY));
+
+   if (pBackend->GetModuleStamp(pBackend->context, moduleName, &pKey->moduleStamp) == FALSE)
+      return FALSE;
+
+   size_t nameLength = strlen(pBackend->name);
+   if (nameLength >= CACHE_BACKEND_NAME_SIZE)
+      nameLength = CACHE_BACKEND_NAME_SIZE - 1;
+
+   memcpy(pKey->backendName, pBackend->name, nameLength);
+   pKey->version = *pVersion;
+   pKey->codePage = GetConsoleCodePage();
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the default path of the cache file.
+/// It is "bcryptenum.cache" in %LOCALAPPDATA% on Windows and in $XDG_CACHE_HOME or $HOME/.cache on other platforms.
+/// </summary>
+/// <param name="buffer">Buffer that receives the path.</param>
+/// <param name="bufferSize">Size of the buffer.</param>
+/// <returns>TRUE, if there is a default path, FALSE if not.</returns>
+BOOL GetDefaultCachePath(char* const buffer, const size_t bufferSize) {
+   int length;
+
+#ifdef _WIN32
+   char directory[MAX_PATH];
+   DWORD directoryLength = GetEnvironmentVariableA("LOCALAPPDATA", directory, sizeof(directory));
+   if (directoryLength == 0 || directoryLength >= sizeof(directory))
+      return FALSE;
+
+   length = sprintf_s(buffer, bufferSize, "%s\\" CACHE_FILE_NAME, directory);
+#else
+   const char* directory = getenv("XDG_CACHE_HOME");
+   if (directory != NULL && *directory != 0)
+      length = snprintf(buffer, bufferSize, "%s/" CACHE_FILE_NAME, directory);
+   else {
+      directory = getenv("HOME");
+      if (directory == NULL || *directory == 0)
+         return FALSE;
+
+      length = snprintf(buffer, bufferSize, "%s/.cache/" CACHE_FILE_NAME, directory);
+   }
+#endif
+
+   return (length > 0 && (size_t)length < bufferSize);
+}
+
+/// <summary>
+/// Map a cache file into memory, if it is valid and was written for the key.
+/// </summary>
+/// <param name="cachePath">Path of the cache file.</param>
+/// <param name="pKey">Key of the current catalog.</param>
+/// <param name="pCache">Pointer to the cache to fill.</param>
+/// <returns>TRUE, if the cache file can be used, FALSE if it is missing, invalid or stale.</returns>
+BOOL OpenCatalogCache(const char* const cachePath, const CACHE_KEY* const pKey, CATALOG_CACHE* const pCache) {
+   memset(pCache, 0, sizeof(CATALOG_CACHE));
+
+   if (MapFile(cachePath, &pCache->file) == FALSE)
+      return FALSE;
+
+   // 1. Check the header.
+   CACHE_HEADER header;
+   BOOL isValid = (pCache->file.size >= sizeof(header));
+   if (isValid != FALSE) {
+      memcpy(&header, pCache->file.pData, sizeof(header));
+
+      isValid = (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+                 header.formatVersion == CACHE_FORMAT_VERSION &&
+                 header.sectionCount == OPERATION_TYPE_COUNT &&
+                 header.fileSize == pCache->file.size &&
+                 memcmp(&header.key, pKey, sizeof(CACHE_KEY)) == 0);
+   }
+
+   if (isValid != FALSE)
+      isValid = (header.checksum == calculateChecksum(pCache->file.pData + sizeof(header), pCache->file.size - sizeof(header)));
+
+   // 2. Check the sections.
+   if (isValid != FALSE) {
+      pCache->sectionCount = header.sectionCount;
+      isValid = hasValidSections(pCache);
+   }
+
+   if (isValid == FALSE)
+      CloseCatalogCache(pCache);
+
+   return isValid;
+}
+
+/// <summary>
+/// Release a cache opened with OpenCatalogCache.
+/// </summary>
+/// <param name="pCache">Cache.</param>
+void CloseCatalogCache(CATALOG_CACHE* const pCache) {
+   UnmapFile(&pCache->file);
+   pCache->sectionCount = 0;
+}
+
+/// <summary>
+/// Get the first list of a cache.
+/// </summary>
+/// <param name="pCache">Cache.</param>
+/// <param name="pSection">Pointer to the section to fill.</param>
+void FirstCatalogSection(const CATALOG_CACHE* const pCache, CATALOG_SECTION* const pSection) {
+   pSection->nameCount = 0;
+   pSection->pNext = pCache->file.pData + sizeof(CACHE_HEADER);
+
+   NextCatalogSection(pSection);
+}
+
+/// <summary>
+/// Get the list that follows a list whose names have all been read.
+/// </summary>
+/// <param name="pSection">Section that is moved to the next list.</param>
+void NextCatalogSection(CATALOG_SECTION* const pSection) {
+   SECTION_HEADER header;
+   memcpy(&header, pSection->pNext, sizeof(header));
+
+   pSection->operationType = header.operationType;
+   pSection->nameCount = header.nameCount;
+   pSection->pNext += sizeof(header);
+}
+
+/// <summary>
+/// Get the next name of a list. The names are stored in the console code page and are not 0 terminated.
+/// </summary>
+/// <param name="pSection">Section.</param>
+/// <param name="pLength">Pointer to the variable that receives the length of the name in bytes.</param>
+/// <returns>Pointer to the name.</returns>
+const char* NextCatalogName(CATALOG_SECTION* const pSection, size_t* const pLength) {
+   USHORT nameLength;
+   memcpy(&nameLength, pSection->pNext, sizeof(nameLength));
+
+   const char* pName = (const char*)pSection->pNext + sizeof(nameLength);
+   pSection->pNext += sizeof(nameLength) + nameLength;
+
+   *pLength = nameLength;
+
+   return pName;
+}
+
+/// <summary>
+/// Initialize a catalog writer.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="pKey">Key the catalog is written for.</param>
+/// <returns>TRUE, if the writer could be initialized, FALSE if not.</returns>
+BOOL InitCatalogWriter(CATALOG_WRITER* const pWriter, const CACHE_KEY* const pKey) {
+   const PCHAR functionName = "InitCatalogWriter";
+
+   memset(pWriter, 0, sizeof(CATALOG_WRITER));
+   pWriter->hHeap = GetProcessHeap();
+
+   pWriter->pData = HeapAlloc(pWriter->hHeap, 0, INITIAL_CAPACITY);
+   if (pWriter->pData == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for catalog cache failed.\n", functionName);
+      return FALSE;
+   }
+
+   pWriter->capacity = INITIAL_CAPACITY;
+
+   // The file size and the section count are set, when the file is written.
+   CACHE_HEADER header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+   header.formatVersion = CACHE_FORMAT_VERSION;
+   memcpy(&header.key, pKey, sizeof(CACHE_KEY));
+
+   memcpy(pWriter->pData, &header, sizeof(header));
+   pWriter->length = sizeof(header);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Add the sorted list of an operation type to a catalog.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pNames">Sorted algorithm names.</param>
+/// <param name="nameCount">Number of names.</param>
+void AddCatalogSection(CATALOG_WRITER* const pWriter, const ULONG operationType, LPWSTR* const pNames, const ULONG nameCount) {
+   if (pWriter->hasError != FALSE)
+      return;
+
+   SECTION_HEADER section;
+   section.operationType = operationType;
+   section.nameCount = nameCount;
+
+   if (reserveRoom(pWriter, sizeof(section)) == FALSE)
+      return;
+
+   memcpy(pWriter->pData + pWriter->length, &section, sizeof(section));
+   pWriter->length += sizeof(section);
+
+   for (ULONG i = 0; i < nameCount; i++) {
+      size_t wideLength = wcslen(pNames[i]);
+      size_t maxLength = wideLength * MAX_BYTES_PER_WIDE_CHARACTER + 1;
+
+      // Names that do not fit into the length field are not cached.
+      if (maxLength > 0xffff) {
+         pWriter->hasError = TRUE;
+         return;
+      }
+
+      if (reserveRoom(pWriter, sizeof(USHORT) + maxLength) == FALSE)
+         return;
+
+      UCHAR* pLength = pWriter->pData + pWriter->length;
+      USHORT nameLength = (USHORT)TranscodeToConsole(pNames[i], wideLength, (char*)pLength + sizeof(USHORT), maxLength);
+      memcpy(pLength, &nameLength, sizeof(nameLength));
+
+      pWriter->length += sizeof(USHORT) + nameLength;
+   }
+
+   pWriter->sectionCount++;
+}
+
+/// <summary>
+/// Write a catalog to a cache file. The file is replaced in one step, so that concurrent readers never see a partial file.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="cachePath">Path of the cache file.</param>
+/// <returns>TRUE, if the file was written, FALSE if not.</returns>
+BOOL WriteCatalogCache(CATALOG_WRITER* const pWriter, const char* const cachePath) {
+   if (pWriter->hasError != FALSE || pWriter->sectionCount != OPERATION_TYPE_COUNT)
+      return FALSE;
+
+   // 1. Complete the header.
+   CACHE_HEADER header;
+   memcpy(&header, pWriter->pData, sizeof(header));
+   header.sectionCount = pWriter->sectionCount;
+   header.fileSize = pWriter->length;
+   header.checksum = calculateChecksum(pWriter->pData + sizeof(header), pWriter->length - sizeof(header));
+   memcpy(pWriter->pData, &header, sizeof(header));
+
+   // 2. Write a temporary file and replace the cache file with it.
+   char temporaryPath[CACHE_PATH_SIZE + 32];
+   sprintf_s(temporaryPath, sizeof(temporaryPath), "%s.%lu.tmp", cachePath, getProcessId());
+
+   FILE* f;
+   if (fopen_s(&f, temporaryPath, "wb") != 0)
+      return FALSE;
+
+   BOOL result = (fwrite(pWriter->pData, 1, pWriter->length, f) == pWriter->length);
+   result &= (fclose(f) == 0);
+
+   if (result != FALSE)
+      result = ReplaceFileAtomically(temporaryPath, cachePath);
+
+   if (result == FALSE)
+      remove(temporaryPath);
+
+   return result;
+}
+
+/// <summary>
+/// Release the memory of a catalog writer.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+void FreeCatalogWriter(CATALOG_WRITER* const pWriter) {
+   if (pWriter->pData != NULL)
+      HeapFree(pWriter->hHeap, 0, pWriter->pData);
+
+   pWriter->pData = NULL;
+   pWriter->length = 0;
+   pWriter->capacity = 0;
+}
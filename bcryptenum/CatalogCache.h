@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "AlgorithmBackend.h"
+#include "FileMapping.h"
+#include "Platform.h"
+
+/// Size of a buffer for the path of a cache file.
+#define CACHE_PATH_SIZE 1024
+
+/// Maximum length of the backend name that is stored in a cache file.
+#define CACHE_BACKEND_NAME_SIZE 16
+
+/// <summary>
+/// Everything a cached catalog depends on. A cache file is only used, if all values are the same.
+/// </summary>
+typedef struct _CACHE_KEY {
+   char backendName[CACHE_BACKEND_NAME_SIZE];
+   MODULE_VERSION version;
+   FILE_STAMP moduleStamp;
+   ULONG codePage;
+} CACHE_KEY;
+
+/// <summary>
+/// Catalog cache file that is mapped into memory.
+/// </summary>
+typedef struct _CATALOG_CACHE {
+   MAPPED_FILE file;
+   ULONG sectionCount;
+} CATALOG_CACHE;
+
+/// <summary>
+/// Position in the list of one operation type of a catalog cache.
+/// </summary>
+typedef struct _CATALOG_SECTION {
+   /// BCRYPT_*_OPERATION type of the list.
+   ULONG operationType;
+
+   /// Number of names in the list.
+   ULONG nameCount;
+
+   /// Next name.
+   const UCHAR* pNext;
+} CATALOG_SECTION;
+
+/// <summary>
+/// Collects the sorted lists of a catalog and writes them to a cache file.
+/// </summary>
+typedef struct _CATALOG_WRITER {
+   HANDLE hHeap;
+   UCHAR* pData;
+   size_t length;
+   size_t capacity;
+   ULONG sectionCount;
+   BOOL hasError;
+} CATALOG_WRITER;
+
+/// <summary>
+/// Get the values a cached catalog depends on from the backend.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="moduleName">Name of the module that implements the algorithms.</param>
+/// <param name="pVersion">Version of the module.</param>
+/// <param name="pKey">Pointer to the key to fill.</param>
+/// <returns>TRUE, if all values could be determined, FALSE if the catalog can not be cached.</returns>
+BOOL BuildCacheKey(const ALGORITHM_BACKEND* const pBackend, const PCHAR moduleName, const MODULE_VERSION* const pVersion, CACHE_KEY* const pKey);
+
+/// <summary>
+/// Get the default path of the cache file.
+/// It is "bcryptenum.cache" in %LOCALAPPDATA% on Windows and in $XDG_CACHE_HOME or $HOME/.cache on other platforms.
+/// </summary>
+/// <param name="buffer">Buffer that receives the path.</param>
+/// <param name="bufferSize">Size of the buffer.</param>
+/// <returns>TRUE, if there is a default path, FALSE if not.</returns>
+BOOL GetDefaultCachePath(char* const buffer, const size_t bufferSize);
+
+/// <summary>
+/// Map a cache file into memory, if it is valid and was written for the key.
+/// </summary>
+/// <param name="cachePath">Path of the cache file.</param>
+/// <param name="pKey">Key of the current catalog.</param>
+/// <param name="pCache">Pointer to the cache to fill.</param>
+/// <returns>TRUE, if the cache file can be used, FALSE if it is missing, invalid or stale.</returns>
+BOOL OpenCatalogCache(const char* const cachePath, const CACHE_KEY* const pKey, CATALOG_CACHE* const pCache);
+
+/// <summary>
+/// Release a cache opened with OpenCatalogCache.
+/// </summary>
+/// <param name="pCache">Cache.</param>
+void CloseCatalogCache(CATALOG_CACHE* const pCache);
+
+/// <summary>
+/// Get the first list of a cache.
+/// </summary>
+/// <param name="pCache">Cache.</param>
+/// <param name="pSection">Pointer to the section to fill.</param>
+void FirstCatalogSection(const CATALOG_CACHE* const pCache, CATALOG_SECTION* const pSection);
+
+/// <summary>
+/// Get the list that follows a list whose names have all been read.
+/// </summary>
+/// <param name="pSection">Section that is moved to the next list.</param>
+void NextCatalogSection(CATALOG_SECTION* const pSection);
+
+/// <summary>
+/// Get the next name of a list. The names are stored in the console code page and are not 0 terminated.
+/// </summary>
+/// <param name="pSection">Section.</param>
+/// <param name="pLength">Pointer to the variable that receives the length of the name in bytes.</param>
+/// <returns>Pointer to the name.</returns>
+const char* NextCatalogName(CATALOG_SECTION* const pSection, size_t* const pLength);
+
+/// <summary>
+/// Initialize a catalog writer.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="pKey">Key the catalog is written for.</param>
+/// <returns>TRUE, if the writer could be initialized, FALSE if not.</returns>
+BOOL InitCatalogWriter(CATALOG_WRITER* const pWriter, const CACHE_KEY* const pKey);
+
+/// <summary>
+/// Add the sorted list of an operation type to a catalog.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pNames">Sorted algorithm names.</param>
+/// <param name="nameCount">Number of names.</param>
+void AddCatalogSection(CATALOG_WRITER* const pWriter, const ULONG operationType, LPWSTR* const pNames, const ULONG nameCount);
+
+/// <summary>
+/// Write a catalog to a cache file. The file is replaced in one step, so that concurrent readers never see a partial file.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+/// <param name="cachePath">Path of the cache file.</param>
+/// <returns>TRUE, if the file was written, FALSE if not.</returns>
+BOOL WriteCatalogCache(CATALOG_WRITER* const pWriter, const char* const cachePath);
+
+/// <summary>
+/// Release the memory of a catalog writer.
+/// </summary>
+/// <param name="pWriter">Writer.</param>
+void FreeCatalogWriter(CATALOG_WRITER* const pWriter);
@@ -0,0 +1,514 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.0.1: No phase statistics for the compared lists.
+//    2026-10-16: V1.1.0: Compare views of the algorithm catalogs.
+//    2026-10-16: V1.2.0: Take the memory of the comparison from an arena.
+//
+
+#include <stdio.h>
+
+#include "AlgorithmList.h"
+#include "ApiErrorHandler.h"
+#include "CatalogDiff.h"
+#include "ListEmitter.h"
+#include "NameSort.h"
+#include "OutputBuffer.h"
+#include "PrintModVersion.h"
+
+// ******** Private constants ********
+
+#define RC_OK  0
+#define RC_ERR 0xff
+
+/// Module that implements the algorithms.
+#define MODULE_NAME "bcrypt.dll"
+
+/// Size of the arena blocks.
+#define ARENA_BLOCK_SIZE 0x10000
+
+// ******** Change flags ********
+
+#define CHANGE_CLASS          0x01
+#define CHANGE_FLAGS          0x02
+#define CHANGE_STATUS         0x04
+#define CHANGE_KEY_LENGTHS    0x08
+#define CHANGE_BLOCK_LENGTH   0x10
+#define CHANGE_HASH_LENGTH    0x20
+#define CHANGE_OBJECT_LENGTH  0x40
+#define CHANGE_CHAINING_MODES 0x80
+
+// ******** Private types ********
+
+/// <summary>
+/// Numbers of differences.
+/// </summary>
+typedef struct _DIFF_COUNTS {
+   ULONG added;
+   ULONG removed;
+   ULONG changed;
+} DIFF_COUNTS;
+
+/// <summary>
+/// State of the comparison of the lists of one operation type.
+/// </summary>
+typedef struct _TYPE_DIFF {
+   ULONG operationType;
+   BOOL hasDifferences;
+   OUTPUT_BUFFER* pOutput;
+   DIFF_COUNTS* pCounts;
+} TYPE_DIFF;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the valid capability fields. There are none, if the algorithm could not be opened.
+/// </summary>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+/// <returns>DETAIL_* flags of the valid fields.</returns>
+static inline ULONG validFieldsOf(const ALGORITHM_DETAILS* const pDetails) {
+   return (pDetails->status >= 0) ? pDetails->validFields : 0;
+}
+
+/// <summary>
+/// Check, if a capability field is different.
+/// </summary>
+/// <param name="pOld">Old capabilities.</param>
+/// <param name="pNew">New capabilities.</param>
+/// <param name="field">DETAIL_* flag of the field.</param>
+/// <param name="isEqual">TRUE, if the values of the field are equal.</param>
+/// <returns>TRUE, if the field is valid in only one of the capabilities or if the values are different.</returns>
+static inline BOOL isFieldChanged(const ALGORITHM_DETAILS* const pOld, const ALGORITHM_DETAILS* const pNew, const ULONG field, const BOOL isEqual) {
+   ULONG oldValid = validFieldsOf(pOld) & field;
+   ULONG newValid = validFieldsOf(pNew) & field;
+
+   return (oldValid != newValid || (oldValid != 0 && isEqual == FALSE));
+}
+
+/// <summary>
+/// Get the changes of an algorithm that is in both lists.
+/// </summary>
+/// <param name="pOld">Old algorithm identifier.</param>
+/// <param name="pOldDetails">Old capabilities or NULL, if they were not probed.</param>
+/// <param name="pNew">New algorithm identifier.</param>
+/// <param name="pNewDetails">New capabilities or NULL, if they were not probed.</param>
+/// <returns>CHANGE_* flags.</returns>
+static ULONG getChanges(const BCRYPT_ALGORITHM_IDENTIFIER* const pOld,
+                        const ALGORITHM_DETAILS* const pOldDetails,
+                        const BCRYPT_ALGORITHM_IDENTIFIER* const pNew,
+                        const ALGORITHM_DETAILS* const pNewDetails) {
+   ULONG changes = 0;
+
+   if (pOld->dwClass != pNew->dwClass)
+      changes |= CHANGE_CLASS;
+
+   if (pOld->dwFlags != pNew->dwFlags)
+      changes |= CHANGE_FLAGS;
+
+   if (pOldDetails == NULL || pNewDetails == NULL)
+      return changes;
+
+   if (pOldDetails->status != pNewDetails->status)
+      changes |= CHANGE_STATUS;
+
+   const BCRYPT_KEY_LENGTHS_STRUCT* pOldKeys = &pOldDetails->keyLengths;
+   const BCRYPT_KEY_LENGTHS_STRUCT* pNewKeys = &pNewDetails->keyLengths;
+   if (isFieldChanged(pOldDetails, pNewDetails, DETAIL_KEY_LENGTHS,
+                      pOldKeys->dwMinLength == pNewKeys->dwMinLength &&
+                      pOldKeys->dwMaxLength == pNewKeys->dwMaxLength &&
+                      pOldKeys->dwIncrement == pNewKeys->dwIncrement) != FALSE)
+      changes |= CHANGE_KEY_LENGTHS;
+
+   if (isFieldChanged(pOldDetails, pNewDetails, DETAIL_BLOCK_LENGTH, pOldDetails->blockLength == pNewDetails->blockLength) != FALSE)
+      changes |= CHANGE_BLOCK_LENGTH;
+
+   if (isFieldChanged(pOldDetails, pNewDetails, DETAIL_HASH_LENGTH, pOldDetails->hashLength == pNewDetails->hashLength) != FALSE)
+      changes |= CHANGE_HASH_LENGTH;
+
+   if (isFieldChanged(pOldDetails, pNewDetails, DETAIL_OBJECT_LENGTH, pOldDetails->objectLength == pNewDetails->objectLength) != FALSE)
+      changes |= CHANGE_OBJECT_LENGTH;
+
+   if (isFieldChanged(pOldDetails, pNewDetails, DETAIL_CHAINING_MODES, pOldDetails->chainingModes == pNewDetails->chainingModes) != FALSE)
+      changes |= CHANGE_CHAINING_MODES;
+
+   return changes;
+}
+
+/// <summary>
+/// Print a capability value or "none", if it is not valid.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+/// <param name="field">DETAIL_* flag of the field.</param>
+/// <param name="value">Value of the field.</param>
+static void printDetailValue(OUTPUT_BUFFER* const pOutput, const ALGORITHM_DETAILS* const pDetails, const ULONG field, const ULONG value) {
+   if ((validFieldsOf(pDetails) & field) != 0)
+      OutputNumber(pOutput, value);
+   else
+      OutputString(pOutput, "none");
+}
+
+/// <summary>
+/// Print the key lengths or "none", if they are not valid.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+static void printKeyLengths(OUTPUT_BUFFER* const pOutput, const ALGORITHM_DETAILS* const pDetails) {
+   if ((validFieldsOf(pDetails) & DETAIL_KEY_LENGTHS) == 0) {
+      OutputString(pOutput, "none");
+      return;
+   }
+
+   OutputNumber(pOutput, pDetails->keyLengths.dwMinLength);
+   OutputChar(pOutput, ':');
+   OutputNumber(pOutput, pDetails->keyLengths.dwMaxLength);
+   OutputChar(pOutput, ':');
+   OutputNumber(pOutput, pDetails->keyLengths.dwIncrement);
+}
+
+/// <summary>
+/// Print the chaining modes or "none", if they are not valid.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+static void printChainingModes(OUTPUT_BUFFER* const pOutput, const ALGORITHM_DETAILS* const pDetails) {
+   if ((validFieldsOf(pDetails) & DETAIL_CHAINING_MODES) == 0 || pDetails->chainingModes == 0) {
+      OutputString(pOutput, "none");
+      return;
+   }
+
+   const char* separator = "";
+   for (int i = 0; i < CHAINING_MODE_COUNT; i++)
+      if ((pDetails->chainingModes & ChainingModes[i].flag) != 0) {
+         OutputString(pOutput, separator);
+         OutputString(pOutput, ChainingModes[i].shortName);
+         separator = ",";
+      }
+}
+
+/// <summary>
+/// Print the old and the new values of the changed fields.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="changes">CHANGE_* flags.</param>
+/// <param name="pOld">Old algorithm identifier.</param>
+/// <param name="pOldDetails">Old capabilities or NULL, if they were not probed.</param>
+/// <param name="pNew">New algorithm identifier.</param>
+/// <param name="pNewDetails">New capabilities or NULL, if they were not probed.</param>
+static void printChanges(OUTPUT_BUFFER* const pOutput,
+                         const ULONG changes,
+                         const BCRYPT_ALGORITHM_IDENTIFIER* const pOld,
+                         const ALGORITHM_DETAILS* const pOldDetails,
+                         const BCRYPT_ALGORITHM_IDENTIFIER* const pNew,
+                         const ALGORITHM_DETAILS* const pNewDetails) {
+   const char* separator = ": ";
+
+   if ((changes & CHANGE_CLASS) != 0) {
+      OutputString(pOutput, separator);
+      OutputFormat(pOutput, "class 0x%08lx -> 0x%08lx", (unsigned long)pOld->dwClass, (unsigned long)pNew->dwClass);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_FLAGS) != 0) {
+      OutputString(pOutput, separator);
+      OutputFormat(pOutput, "flags 0x%08lx -> 0x%08lx", (unsigned long)pOld->dwFlags, (unsigned long)pNew->dwFlags);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_STATUS) != 0) {
+      OutputString(pOutput, separator);
+      OutputFormat(pOutput, "open status 0x%08lx -> 0x%08lx", (unsigned long)(ULONG)pOldDetails->status, (unsigned long)(ULONG)pNewDetails->status);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_KEY_LENGTHS) != 0) {
+      OutputString(pOutput, separator);
+      OutputString(pOutput, "key lengths ");
+      printKeyLengths(pOutput, pOldDetails);
+      OutputString(pOutput, " -> ");
+      printKeyLengths(pOutput, pNewDetails);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_BLOCK_LENGTH) != 0) {
+      OutputString(pOutput, separator);
+      OutputString(pOutput, "block length ");
+      printDetailValue(pOutput, pOldDetails, DETAIL_BLOCK_LENGTH, pOldDetails->blockLength);
+      OutputString(pOutput, " -> ");
+      printDetailValue(pOutput, pNewDetails, DETAIL_BLOCK_LENGTH, pNewDetails->blockLength);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_HASH_LENGTH) != 0) {
+      OutputString(pOutput, separator);
+      OutputString(pOutput, "hash length ");
+      printDetailValue(pOutput, pOldDetails, DETAIL_HASH_LENGTH, pOldDetails->hashLength);
+      OutputString(pOutput, " -> ");
+      printDetailValue(pOutput, pNewDetails, DETAIL_HASH_LENGTH, pNewDetails->hashLength);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_OBJECT_LENGTH) != 0) {
+      OutputString(pOutput, separator);
+      OutputString(pOutput, "object length ");
+      printDetailValue(pOutput, pOldDetails, DETAIL_OBJECT_LENGTH, pOldDetails->objectLength);
+      OutputString(pOutput, " -> ");
+      printDetailValue(pOutput, pNewDetails, DETAIL_OBJECT_LENGTH, pNewDetails->objectLength);
+      separator = ", ";
+   }
+
+   if ((changes & CHANGE_CHAINING_MODES) != 0) {
+      OutputString(pOutput, separator);
+      OutputString(pOutput, "chaining modes ");
+      printChainingModes(pOutput, pOldDetails);
+      OutputString(pOutput, " -> ");
+      printChainingModes(pOutput, pNewDetails);
+   }
+}
+
+/// <summary>
+/// Print the start of a difference line. The name of the operation type is printed before the first difference of the type.
+/// </summary>
+/// <param name="pDiff">Comparison state of the type.</param>
+/// <param name="marker">Kind of difference: '+' for added, '-' for removed and '~' for changed.</param>
+/// <param name="name">Name of the algorithm.</param>
+static void printDifference(TYPE_DIFF* const pDiff, const char marker, LPCWSTR const name) {
+   OUTPUT_BUFFER* pOutput = pDiff->pOutput;
+
+   if (pDiff->hasDifferences == FALSE) {
+      OutputString(pOutput, OperationTypeTitle(pDiff->operationType));
+      OutputString(pOutput, ":\n\n");
+      pDiff->hasDifferences = TRUE;
+   }
+
+   OutputString(pOutput, "   ");
+   OutputChar(pOutput, marker);
+   OutputChar(pOutput, ' ');
+   OutputWideString(pOutput, name);
+}
+
+/// <summary>
+/// Compare the sorted lists of one operation type with a linear merge.
+/// </summary>
+/// <param name="pDiff">Comparison state of the type.</param>
+/// <param name="pOld">Old sorted list.</param>
+/// <param name="pNew">New sorted list.</param>
+static void mergeLists(TYPE_DIFF* const pDiff, const SORTED_ALGORITHMS* const pOld, const SORTED_ALGORITHMS* const pNew) {
+   ULONG oldIndex = 0;
+   ULONG newIndex = 0;
+
+   while (oldIndex < pOld->count || newIndex < pNew->count) {
+      int order;
+      if (oldIndex == pOld->count)
+         order = 1;
+      else if (newIndex == pNew->count)
+         order = -1;
+      else
+         order = CompareNames(pOld->pNames[oldIndex], pNew->pNames[newIndex]);
+
+      if (order < 0) {
+         printDifference(pDiff, '-', pOld->pNames[oldIndex++]);
+         OutputChar(pDiff->pOutput, '\n');
+         pDiff->pCounts->removed++;
+      } else if (order > 0) {
+         printDifference(pDiff, '+', pNew->pNames[newIndex++]);
+         OutputChar(pDiff->pOutput, '\n');
+         pDiff->pCounts->added++;
+      } else {
+         const BCRYPT_ALGORITHM_IDENTIFIER* pOldAlgo = pOld->ppSorted[oldIndex];
+         const BCRYPT_ALGORITHM_IDENTIFIER* pNewAlgo = pNew->ppSorted[newIndex];
+         const ALGORITHM_DETAILS* pOldDetails = (pOld->ppDetails != NULL) ? pOld->ppDetails[oldIndex] : NULL;
+         const ALGORITHM_DETAILS* pNewDetails = (pNew->ppDetails != NULL) ? pNew->ppDetails[newIndex] : NULL;
+
+         ULONG changes = getChanges(pOldAlgo, pOldDetails, pNewAlgo, pNewDetails);
+         if (changes != 0) {
+            printDifference(pDiff, '~', pNew->pNames[newIndex]);
+            printChanges(pDiff->pOutput, changes, pOldAlgo, pOldDetails, pNewAlgo, pNewDetails);
+            OutputChar(pDiff->pOutput, '\n');
+            pDiff->pCounts->changed++;
+         }
+
+         oldIndex++;
+         newIndex++;
+      }
+   }
+
+   if (pDiff->hasDifferences != FALSE)
+      OutputChar(pDiff->pOutput, '\n');
+}
+
+/// <summary>
+/// Compare the lists of one operation type.
+/// </summary>
+/// <param name="pOldBackend">Backend with the old lists.</param>
+/// <param name="pOldCatalog">Algorithm catalog of the old backend.</param>
+/// <param name="pOldTable">Details table of the old catalog. NULL, if the capabilities are not compared.</param>
+/// <param name="pNewBackend">Backend with the new lists.</param>
+/// <param name="pNewCatalog">Algorithm catalog of the new backend.</param>
+/// <param name="pNewTable">Details table of the new catalog. NULL, if the capabilities are not compared.</param>
+/// <param name="pOptions">List options.</param>
+/// <param name="pArena">Arena of the lists.</param>
+/// <param name="algorithmType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pCounts">Numbers of differences.</param>
+/// <returns>TRUE, if both lists could be built, FALSE if not.</returns>
+static BOOL diffType(const ALGORITHM_BACKEND* const pOldBackend,
+                     const ALGORITHM_CATALOG* const pOldCatalog,
+                     DETAILS_TABLE* const pOldTable,
+                     const ALGORITHM_BACKEND* const pNewBackend,
+                     const ALGORITHM_CATALOG* const pNewCatalog,
+                     DETAILS_TABLE* const pNewTable,
+                     const LIST_OPTIONS* const pOptions,
+                     ARENA* const pArena,
+                     const ULONG algorithmType,
+                     OUTPUT_BUFFER* const pOutput,
+                     DIFF_COUNTS* const pCounts) {
+   // 1. Get both sorted lists and probe the algorithms that were not probed for an earlier type.
+   SORTED_ALGORITHMS oldList;
+   if (GetSortedAlgorithms(pOldCatalog, pArena, algorithmType, pOldTable, &oldList, NULL) == FALSE)
+      return FALSE;
+
+   SORTED_ALGORITHMS newList;
+   if (GetSortedAlgorithms(pNewCatalog, pArena, algorithmType, pNewTable, &newList, NULL) == FALSE)
+      return FALSE;
+
+   if (pOptions->showDetails != FALSE) {
+      ProbeSortedAlgorithms(pOldBackend, &oldList, pOptions->maxThreads, NULL);
+      ProbeSortedAlgorithms(pNewBackend, &newList, pOptions->maxThreads, NULL);
+   }
+
+   // 2. Merge them.
+   TYPE_DIFF diff = { algorithmType, FALSE, pOutput, pCounts };
+   mergeLists(&diff, &oldList, &newList);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Print the version of a backend's module or "unknown version".
+/// </summary>
+/// <param name="pBackend">Backend.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printBackendVersion(const ALGORITHM_BACKEND* const pBackend, OUTPUT_BUFFER* const pOutput) {
+   MODULE_VERSION version;
+   if (pBackend->GetModuleVersion(pBackend->context, MODULE_NAME, &version) != FALSE)
+      OutputModuleVersion(&version, pOutput);
+   else
+      OutputString(pOutput, "unknown version");
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Print the algorithms that were added, removed or changed between the lists of two backends.
+/// </summary>
+/// <param name="pOldBackend">Backend with the old lists, e.g. a snapshot of an older Windows build.</param>
+/// <param name="pNewBackend">Backend with the new lists.</param>
+/// <param name="pOptions">List options. With showDetails the capabilities are compared, too.</param>
+/// <returns>0, if the lists could be compared, an error code if not.</returns>
+unsigned char DiffAllTypes(const ALGORITHM_BACKEND* const pOldBackend, const ALGORITHM_BACKEND* const pNewBackend, const LIST_OPTIONS* const pOptions) {
+   const PCHAR functionName = "DiffAllTypes";
+
+   // 1. Get the process heap for the arena of the list functions.
+   HANDLE hHeap = GetProcessHeap();
+   if (hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return RC_ERR;
+   }
+
+   ARENA arena;
+   InitArena(&arena, hHeap, ARENA_BLOCK_SIZE);
+
+   // 2. Enumerate the algorithms of both backends.
+   //    Each algorithm that is compared with its capabilities is probed only once, even if it has several types.
+   ALGORITHM_CATALOG oldCatalog;
+   ALGORITHM_CATALOG newCatalog;
+   DETAILS_TABLE oldTable;
+   DETAILS_TABLE newTable;
+   BOOL hasDetails = (pOptions->showDetails != FALSE);
+   if (BuildAlgorithmCatalog(pOldBackend, &arena, &oldCatalog, NULL) == FALSE ||
+       BuildAlgorithmCatalog(pNewBackend, &arena, &newCatalog, NULL) == FALSE ||
+       (hasDetails != FALSE && (InitDetailsTable(&oldTable, &oldCatalog, &arena) == FALSE || InitDetailsTable(&newTable, &newCatalog, &arena) == FALSE))) {
+      FreeArena(&arena);
+      return RC_ERR;
+   }
+
+   // 3. Compose the whole output in one buffer.
+   OUTPUT_BUFFER output;
+   if (InitOutputBuffer(&output, stdout, 0) == FALSE) {
+      FreeArena(&arena);
+      return RC_ERR;
+   }
+
+   // 4. Print header.
+   OutputString(&output, "\nDifferences of Bcrypt algorithms from ");
+   printBackendVersion(pOldBackend, &output);
+   OutputString(&output, " to ");
+   printBackendVersion(pNewBackend, &output);
+   OutputString(&output, " by type:\n\n");
+
+   // 5. Compare the lists of each type.
+   DIFF_COUNTS counts = { 0, 0, 0 };
+   BOOL result = TRUE;
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      result &= diffType(pOldBackend,
+                         &oldCatalog,
+                         (hasDetails != FALSE) ? &oldTable : NULL,
+                         pNewBackend,
+                         &newCatalog,
+                         (hasDetails != FALSE) ? &newTable : NULL,
+                         pOptions,
+                         &arena,
+                         OperationTypes[t],
+                         &output,
+                         &counts);
+
+   // 6. Print the summary.
+   if (counts.added + counts.removed + counts.changed == 0)
+      OutputString(&output, "No differences.\n");
+   else {
+      OutputNumber(&output, counts.added);
+      OutputString(&output, " added, ");
+      OutputNumber(&output, counts.removed);
+      OutputString(&output, " removed, ");
+      OutputNumber(&output, counts.changed);
+      OutputString(&output, " changed.\n");
+   }
+
+   // 7. Write the output with a single write.
+   result &= FlushOutputBuffer(&output);
+
+   if (pOptions->showStatistics != FALSE)
+      PrintOutputStatistics(&output, stderr);
+
+   FreeOutputBuffer(&output);
+   FreeArena(&arena);
+
+   if (result == FALSE)
+      return RC_ERR;
+
+   return RC_OK;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "BCryptList.h"
+
+/// <summary>
+/// Print the algorithms that were added, removed or changed between the lists of two backends.
+/// </summary>
+/// <param name="pOldBackend">Backend with the old lists, e.g. a snapshot of an older Windows build.</param>
+/// <param name="pNewBackend">Backend with the new lists.</param>
+/// <param name="pOptions">List options. With showDetails the capabilities are compared, too.</param>
+/// <returns>0, if the lists could be compared, an error code if not.</returns>
+unsigned char DiffAllTypes(const ALGORITHM_BACKEND* const pOldBackend, const ALGORITHM_BACKEND* const pNewBackend, const LIST_OPTIONS* const pOptions);
@@ -0,0 +1,483 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.1
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.0.1: Count failed checks and report them in the return code.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ApiErrorHandler.h"
+#include "CatalogWatch.h"
+#include "ListEmitter.h"
+#include "NameSort.h"
+#include "OutputBuffer.h"
+#include "PrintModVersion.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+#define RC_OK  0
+#define RC_ERR 0xff
+
+/// Module that implements the algorithms.
+#define MODULE_NAME "bcrypt.dll"
+
+/// Markers of the delta lines.
+#define MARKER_ADDED   '+'
+#define MARKER_REMOVED '-'
+#define MARKER_CHANGED '~'
+#define MARKER_VERSION 'v'
+
+// ******** Private types ********
+
+/// <summary>
+/// Copy of the algorithm list of one operation type.
+/// The buffers are kept between the checks and only grow, when a list gets longer.
+/// </summary>
+typedef struct _WATCH_LIST {
+   /// Number of algorithms.
+   ULONG count;
+
+   /// Number of algorithms the buffers have room for.
+   ULONG capacity;
+
+   /// Algorithms in the order of the enumeration. The names point into the name pool.
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgorithms;
+
+   /// Pointers to the algorithms in collation order of the names.
+   BCRYPT_ALGORITHM_IDENTIFIER** ppSorted;
+
+   /// Names.
+   wchar_t* pNamePool;
+
+   /// Number of wide characters the name pool has room for.
+   size_t poolCapacity;
+} WATCH_LIST;
+
+/// <summary>
+/// State of the watch.
+/// </summary>
+typedef struct _WATCH_STATE {
+   const ALGORITHM_BACKEND* pBackend;
+   HANDLE hHeap;
+
+   /// Lists of the last check.
+   WATCH_LIST lists[OPERATION_TYPE_COUNT];
+
+   /// Buffers for a changed list. They are exchanged with the buffers of the old list.
+   WATCH_LIST spare;
+
+   BOOL hasVersion;
+   MODULE_VERSION version;
+
+   /// Output buffer. It is reused for all checks.
+   OUTPUT_BUFFER output;
+
+   /// Time of the current check in seconds since 1970-01-01 UTC.
+   uint64_t checkTime;
+
+   /// Number of delta lines.
+   ULONG changeCount;
+
+   /// Number of checks whose backend could not be refreshed or whose lists could not be enumerated or copied.
+   ULONG failedCheckCount;
+} WATCH_STATE;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Grow a buffer. The contents are not kept.
+/// </summary>
+/// <param name="hHeap">Handle of the heap.</param>
+/// <param name="ppBuffer">Pointer to the buffer pointer. The pointer may be NULL.</param>
+/// <param name="size">New size in bytes.</param>
+/// <returns>TRUE, if the buffer could be allocated, FALSE if not. The old buffer is then kept.</returns>
+static BOOL growBuffer(const HANDLE hHeap, PVOID* const ppBuffer, const size_t size) {
+   PVOID pNewBuffer = HeapAlloc(hHeap, 0, size);
+   if (pNewBuffer == NULL)
+      return FALSE;
+
+   if (*ppBuffer != NULL)
+      HeapFree(hHeap, 0, *ppBuffer);
+
+   *ppBuffer = pNewBuffer;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release the buffers of a list.
+/// </summary>
+/// <param name="hHeap">Handle of the heap.</param>
+/// <param name="pList">List.</param>
+static void freeList(const HANDLE hHeap, WATCH_LIST* const pList) {
+   if (pList->pAlgorithms != NULL)
+      HeapFree(hHeap, 0, pList->pAlgorithms);
+
+   if (pList->ppSorted != NULL)
+      HeapFree(hHeap, 0, pList->ppSorted);
+
+   if (pList->pNamePool != NULL)
+      HeapFree(hHeap, 0, pList->pNamePool);
+
+   memset(pList, 0, sizeof(WATCH_LIST));
+}
+
+/// <summary>
+/// Check, if an enumeration is the same as the list of the last check.
+/// This needs no memory and no sort, as the backend returns an unchanged list in the same order.
+/// </summary>
+/// <param name="pList">List of the last check.</param>
+/// <param name="pAlgoList">Enumerated algorithms.</param>
+/// <param name="algoCount">Number of enumerated algorithms.</param>
+/// <returns>TRUE, if the enumeration is unchanged, FALSE if not.</returns>
+static BOOL isUnchanged(const WATCH_LIST* const pList, const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgoList, const ULONG algoCount) {
+   if (algoCount != pList->count)
+      return FALSE;
+
+   const BCRYPT_ALGORITHM_IDENTIFIER* pOld = pList->pAlgorithms;
+   const BCRYPT_ALGORITHM_IDENTIFIER* pNew = pAlgoList;
+   for (ULONG i = algoCount; i > 0; i--) {
+      if (pOld->dwClass != pNew->dwClass ||
+          pOld->dwFlags != pNew->dwFlags ||
+          wcscmp(pOld->pszName, pNew->pszName) != 0)
+         return FALSE;
+
+      pOld++;
+      pNew++;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Copy an enumeration into a list and sort it.
+/// </summary>
+/// <param name="hHeap">Handle of the heap.</param>
+/// <param name="pList">List that receives the copy.</param>
+/// <param name="pAlgoList">Enumerated algorithms.</param>
+/// <param name="algoCount">Number of enumerated algorithms.</param>
+/// <returns>TRUE, if the list could be copied and sorted, FALSE if there was not enough memory.</returns>
+static BOOL copyList(const HANDLE hHeap, WATCH_LIST* const pList, const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgoList, const ULONG algoCount) {
+   const PCHAR functionName = "copyList";
+
+   // 1. Make room for the algorithms and the names. The buffers get some headroom, so that they rarely grow.
+   if (algoCount >= pList->capacity) {
+      ULONG capacity = algoCount + (algoCount >> 2) + 8;
+      if (growBuffer(hHeap, (PVOID*)&pList->pAlgorithms, capacity * sizeof(BCRYPT_ALGORITHM_IDENTIFIER)) == FALSE ||
+          growBuffer(hHeap, (PVOID*)&pList->ppSorted, capacity * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*)) == FALSE) {
+         fprintf(stderr, "Function \"%s\": HeapAlloc for algorithm list failed.\n", functionName);
+         return FALSE;
+      }
+
+      pList->capacity = capacity;
+   }
+
+   size_t poolSize = 0;
+   for (ULONG i = 0; i < algoCount; i++)
+      poolSize += wcslen(pAlgoList[i].pszName) + 1;
+
+   if (poolSize > pList->poolCapacity) {
+      size_t poolCapacity = poolSize + (poolSize >> 2) + 64;
+      if (growBuffer(hHeap, (PVOID*)&pList->pNamePool, poolCapacity * sizeof(wchar_t)) == FALSE) {
+         fprintf(stderr, "Function \"%s\": HeapAlloc for name pool failed.\n", functionName);
+         return FALSE;
+      }
+
+      pList->poolCapacity = poolCapacity;
+   }
+
+   // 2. Copy the algorithms in the order of the enumeration.
+   wchar_t* pNextName = pList->pNamePool;
+   for (ULONG i = 0; i < algoCount; i++) {
+      size_t nameSize = (wcslen(pAlgoList[i].pszName) + 1) * sizeof(wchar_t);
+      memcpy(pNextName, pAlgoList[i].pszName, nameSize);
+
+      pList->pAlgorithms[i].pszName = pNextName;
+      pList->pAlgorithms[i].dwClass = pAlgoList[i].dwClass;
+      pList->pAlgorithms[i].dwFlags = pAlgoList[i].dwFlags;
+      pList->ppSorted[i] = pList->pAlgorithms + i;
+
+      pNextName += nameSize / sizeof(wchar_t);
+   }
+
+   pList->count = algoCount;
+
+   // 3. Sort the pointers for the comparison.
+   return SortAlgorithms(pList->ppSorted, algoCount);
+}
+
+/// <summary>
+/// Print the start of a delta line: time and marker.
+/// </summary>
+/// <param name="pState">Watch state.</param>
+/// <param name="marker">Kind of delta.</param>
+static void printDeltaStart(WATCH_STATE* const pState, const char marker) {
+   OUTPUT_BUFFER* pOutput = &pState->output;
+
+   OutputNumber(pOutput, pState->checkTime);
+   OutputChar(pOutput, ' ');
+   OutputChar(pOutput, marker);
+   OutputChar(pOutput, ' ');
+
+   pState->changeCount++;
+}
+
+/// <summary>
+/// Print a delta line of an algorithm.
+/// Added and changed algorithms are printed with their new class and flags.
+/// </summary>
+/// <param name="pState">Watch state.</param>
+/// <param name="marker">Kind of delta.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pAlgorithm">Algorithm.</param>
+static void printAlgorithmDelta(WATCH_STATE* const pState,
+                                const char marker,
+                                const ULONG operationType,
+                                const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm) {
+   OUTPUT_BUFFER* pOutput = &pState->output;
+
+   printDeltaStart(pState, marker);
+   OutputString(pOutput, OperationTypeId(operationType));
+   OutputChar(pOutput, ' ');
+   OutputWideString(pOutput, pAlgorithm->pszName);
+
+   if (marker != MARKER_REMOVED)
+      OutputFormat(pOutput, " 0x%08lx 0x%08lx", (unsigned long)pAlgorithm->dwClass, (unsigned long)pAlgorithm->dwFlags);
+
+   OutputChar(pOutput, '\n');
+}
+
+/// <summary>
+/// Print the deltas between two sorted lists with a linear merge.
+/// </summary>
+/// <param name="pState">Watch state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pOld">List of the last check.</param>
+/// <param name="pNew">List of this check.</param>
+static void printListDeltas(WATCH_STATE* const pState, const ULONG operationType, const WATCH_LIST* const pOld, const WATCH_LIST* const pNew) {
+   ULONG oldIndex = 0;
+   ULONG newIndex = 0;
+
+   while (oldIndex < pOld->count || newIndex < pNew->count) {
+      int order;
+      if (oldIndex == pOld->count)
+         order = 1;
+      else if (newIndex == pNew->count)
+         order = -1;
+      else
+         order = CompareNames(pOld->ppSorted[oldIndex]->pszName, pNew->ppSorted[newIndex]->pszName);
+
+      if (order < 0)
+         printAlgorithmDelta(pState, MARKER_REMOVED, operationType, pOld->ppSorted[oldIndex++]);
+      else if (order > 0)
+         printAlgorithmDelta(pState, MARKER_ADDED, operationType, pNew->ppSorted[newIndex++]);
+      else {
+         const BCRYPT_ALGORITHM_IDENTIFIER* pOldAlgo = pOld->ppSorted[oldIndex++];
+         const BCRYPT_ALGORITHM_IDENTIFIER* pNewAlgo = pNew->ppSorted[newIndex++];
+         if (pOldAlgo->dwClass != pNewAlgo->dwClass || pOldAlgo->dwFlags != pNewAlgo->dwFlags)
+            printAlgorithmDelta(pState, MARKER_CHANGED, operationType, pNewAlgo);
+      }
+   }
+}
+
+/// <summary>
+/// Print a delta line, if the module version changed.
+/// </summary>
+/// <param name="pState">Watch state.</param>
+static void checkVersion(WATCH_STATE* const pState) {
+   MODULE_VERSION version;
+   BOOL hasVersion = pState->pBackend->GetModuleVersion(pState->pBackend->context, MODULE_NAME, &version);
+
+   if (hasVersion == pState->hasVersion &&
+       (hasVersion == FALSE || memcmp(&version, &pState->version, sizeof(MODULE_VERSION)) == 0))
+      return;
+
+   pState->hasVersion = hasVersion;
+   pState->version = version;
+
+   printDeltaStart(pState, MARKER_VERSION);
+   OutputString(&pState->output, MODULE_NAME " ");
+   if (hasVersion != FALSE)
+      OutputModuleVersion(&version, &pState->output);
+   else
+      OutputString(&pState->output, "unknown");
+   OutputChar(&pState->output, '\n');
+}
+
+/// <summary>
+/// Check the lists of one operation type.
+/// </summary>
+/// <param name="pState">Watch state.</param>
+/// <param name="typeIndex">Index of the operation type.</param>
+/// <returns>TRUE, if the list could be checked, FALSE if it could not be enumerated or copied.</returns>
+static BOOL checkType(WATCH_STATE* const pState, const int typeIndex) {
+   const PCHAR functionName = "checkType";
+
+   const ALGORITHM_BACKEND* pBackend = pState->pBackend;
+   ULONG operationType = OperationTypes[typeIndex];
+   WATCH_LIST* pList = pState->lists + typeIndex;
+
+   // 1. Enumerate the algorithms.
+   ULONG algoCount;
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList;
+   NTSTATUS nts = pBackend->EnumAlgorithms(pBackend->context, operationType, &algoCount, &pAlgoList);
+   if (nts < 0) {
+      PrintNtStatus(functionName, "EnumAlgorithms", nts);
+      return FALSE;
+   }
+
+   // 2. In the steady state nothing changed and nothing else is done.
+   BOOL result = TRUE;
+   if (isUnchanged(pList, pAlgoList, algoCount) == FALSE) {
+      // 3. Copy the new list into the spare buffers, print the deltas and keep the new list.
+      result = copyList(pState->hHeap, &pState->spare, pAlgoList, algoCount);
+      if (result != FALSE) {
+         printListDeltas(pState, operationType, pList, &pState->spare);
+
+         WATCH_LIST oldList = *pList;
+         *pList = pState->spare;
+         pState->spare = oldList;
+      }
+   }
+
+   pBackend->FreeBuffer(pBackend->context, pAlgoList);
+
+   return result;
+}
+
+/// <summary>
+/// Check the module version and the lists of all types and print the deltas.
+/// A check that fails is counted, but the watch goes on, as the next check may succeed.
+/// </summary>
+/// <param name="pState">Watch state.</param>
+/// <returns>TRUE, if the deltas could be written, FALSE if not.</returns>
+static BOOL checkCatalog(WATCH_STATE* const pState) {
+   const PCHAR functionName = "checkCatalog";
+
+   const ALGORITHM_BACKEND* pBackend = pState->pBackend;
+
+   // 1. A backend that can not be refreshed keeps its old state, so there is nothing new to compare.
+   if (pBackend->Refresh(pBackend->context) == FALSE) {
+      fprintf(stderr, "Function \"%s\": Backend \"%s\" could not be refreshed.\n", functionName, pBackend->name);
+      pState->failedCheckCount++;
+      return TRUE;
+   }
+
+   pState->checkTime = (uint64_t)time(NULL);
+
+   // 2. Compare the version and the lists.
+   checkVersion(pState);
+
+   BOOL isChecked = TRUE;
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      isChecked &= checkType(pState, t);
+
+   if (isChecked == FALSE)
+      pState->failedCheckCount++;
+
+   // 3. Write the deltas of this check, if there are any.
+   return FlushOutputBuffer(&pState->output);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Enumerate the algorithms periodically and print only the differences to the previous enumeration.
+/// The first enumeration prints all algorithms as added.
+/// </summary>
+/// <param name="pBackend">Enumeration backend. It is refreshed before each enumeration.</param>
+/// <param name="pOptions">Watch options.</param>
+/// <returns>0, if all checks could be done, an error code if not.</returns>
+unsigned char WatchCatalog(const ALGORITHM_BACKEND* const pBackend, const WATCH_OPTIONS* const pOptions) {
+   const PCHAR functionName = "WatchCatalog";
+
+   // 1. Prepare the state. All lists start empty.
+   WATCH_STATE state;
+   memset(&state, 0, sizeof(state));
+   state.pBackend = pBackend;
+
+   state.hHeap = GetProcessHeap();
+   if (state.hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return RC_ERR;
+   }
+
+   if (InitOutputBuffer(&state.output, stdout, 0) == FALSE)
+      return RC_ERR;
+
+   // 2. Check until the number of checks is reached.
+   BOOL result = TRUE;
+   ULONG checks = 0;
+   uint64_t firstCheckTime = 0;
+   uint64_t totalCheckTime = 0;
+   uint64_t maxCheckTime = 0;
+   while (result != FALSE && (pOptions->checkCount == 0 || checks < pOptions->checkCount)) {
+      if (checks != 0)
+         SleepMilliseconds(pOptions->intervalMs);
+
+      uint64_t startTime = GetTimeNs();
+      result = checkCatalog(&state);
+      uint64_t checkTime = GetTimeNs() - startTime;
+
+      // The first check copies all lists, so it is not counted for the steady state.
+      if (checks == 0)
+         firstCheckTime = checkTime;
+      else {
+         totalCheckTime += checkTime;
+         if (checkTime > maxCheckTime)
+            maxCheckTime = checkTime;
+      }
+
+      checks++;
+   }
+
+   if (pOptions->showStatistics != FALSE) {
+      fprintf(stderr,
+              "Checks: %lu, failed: %lu, changes: %lu, first check: %.3f ms, later checks: %.3f ms average, %.3f ms maximum\n",
+              (unsigned long)checks,
+              (unsigned long)state.failedCheckCount,
+              (unsigned long)state.changeCount,
+              (double)firstCheckTime / 1.0e6,
+              (checks > 1) ? (double)totalCheckTime / (double)(checks - 1) / 1.0e6 : 0.0,
+              (double)maxCheckTime / 1.0e6);
+      PrintOutputStatistics(&state.output, stderr);
+   }
+
+   // 3. Release memory.
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      freeList(state.hHeap, state.lists + t);
+
+   freeList(state.hHeap, &state.spare);
+   FreeOutputBuffer(&state.output);
+
+   if (result == FALSE || state.failedCheckCount != 0)
+      return RC_ERR;
+
+   return RC_OK;
+}
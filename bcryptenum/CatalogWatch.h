@@ -0,0 +1,26 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+
+/// <summary>
+/// Options for watching the algorithm lists.
+/// </summary>
+typedef struct _WATCH_OPTIONS {
+   /// Time between two enumerations in milliseconds.
+   ULONG intervalMs;
+
+   /// Number of enumerations. 0 means no limit.
+   ULONG checkCount;
+
+   /// Print the number of checks and changes and the time of a check to stderr at the end.
+   BOOL showStatistics;
+} WATCH_OPTIONS;
+
+/// <summary>
+/// Enumerate the algorithms periodically and print only the differences to the previous enumeration.
+/// The first enumeration prints all algorithms as added.
+/// </summary>
+/// <param name="pBackend">Enumeration backend. It is refreshed before each enumeration.</param>
+/// <param name="pOptions">Watch options.</param>
+/// <returns>0, if all checks could be done, an error code if not.</returns>
+unsigned char WatchCatalog(const ALGORITHM_BACKEND* const pBackend, const WATCH_OPTIONS* const pOptions);
@@ -0,0 +1,353 @@
+//
+// SPDX-FileCopyrightText: Copyright 2024-2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.5.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created from BCryptList and PrintModVersion.
+//    2026-10-16: V1.1.0: Open algorithm providers and query their properties.
+//    2026-10-16: V1.2.0: Get the file stamp of a module.
+//    2026-10-16: V1.3.0: Read the module version directly from the loaded image.
+//    2026-10-16: V1.4.0: Enumerate providers and configuration contexts.
+//    2026-10-16: V1.5.0: Refresh.
+//
+
+#include <stdio.h>
+
+#include <Windows.h>
+#include <bcrypt.h>
+#include <psapi.h>
+
+#include "AlgorithmBackend.h"
+#include "ApiErrorHandler.h"
+#include "FileMapping.h"
+#include "PeVersion.h"
+
+// ******** Private methods ********
+
+/// <summary>
+/// Enumerate the algorithms with BCryptEnumAlgorithms.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="operationMask">Bit mask of BCRYPT_*_OPERATION values.</param>
+/// <param name="pAlgoCount">Pointer to the variable that receives the number of algorithms.</param>
+/// <param name="ppAlgoList">Pointer to the variable that receives the algorithm list.</param>
+/// <returns>NTSTATUS of BCryptEnumAlgorithms.</returns>
+static NTSTATUS cngEnumAlgorithms(PVOID const context,
+                                  const ULONG operationMask,
+                                  ULONG* const pAlgoCount,
+                                  BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptEnumAlgorithms(operationMask, pAlgoCount, ppAlgoList, 0);
+}
+
+/// <summary>
+/// Release a buffer with BCryptFreeBuffer.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="pBuffer">Buffer to release.</param>
+static void cngFreeBuffer(PVOID const context, PVOID const pBuffer) {
+   UNREFERENCED_PARAMETER(context);
+
+   BCryptFreeBuffer(pBuffer);
+}
+
+/// <summary>
+/// Get the version of a module that is loaded in this process.
+/// The version resource is read directly from the loaded image.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="moduleName">Name of the module.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the version could be determined, FALSE if not.</returns>
+static BOOL cngGetModuleVersion(PVOID const context, const PCHAR moduleName, MODULE_VERSION* const pVersion) {
+   UNREFERENCED_PARAMETER(context);
+
+   // Name of this function for error messages.
+   const PCHAR functionName = "cngGetModuleVersion";
+
+   // 1. Get the module handle from the module name. It is the base address of the image.
+   HMODULE hModule = GetModuleHandleA(moduleName);
+   if (hModule == NULL) {
+      PrintLastError(functionName, "GetModuleHandle");
+      return FALSE;
+   }
+
+   // 2. Get the size of the image.
+   MODULEINFO moduleInfo;
+   if (GetModuleInformation(GetCurrentProcess(), hModule, &moduleInfo, sizeof(moduleInfo)) == FALSE) {
+      PrintLastError(functionName, "GetModuleInformation");
+      return FALSE;
+   }
+
+   // 3. Read the version from the resources of the image.
+   if (GetPeVersion((const UCHAR*)moduleInfo.lpBaseOfDll, moduleInfo.SizeOfImage, PE_LAYOUT_IMAGE, pVersion) == FALSE) {
+      fprintf(stderr, "Function \"%s\": Module \"%s\" has no version resource.\n", functionName, moduleName);
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the file stamp of a module that is loaded in this process.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="moduleName">Name of the module.</param>
+/// <param name="pStamp">Pointer to the file stamp to fill.</param>
+/// <returns>TRUE, if the file stamp could be determined, FALSE if not.</returns>
+static BOOL cngGetModuleStamp(PVOID const context, const PCHAR moduleName, FILE_STAMP* const pStamp) {
+   UNREFERENCED_PARAMETER(context);
+
+   // Name of this function for error messages.
+   const PCHAR functionName = "cngGetModuleStamp";
+
+   HMODULE hModule = GetModuleHandleA(moduleName);
+   if (hModule == NULL) {
+      PrintLastError(functionName, "GetModuleHandle");
+      return FALSE;
+   }
+
+   CHAR modulePath[MAX_PATH];
+   DWORD pathLength = GetModuleFileNameA(hModule, modulePath, sizeof(modulePath));
+   if (pathLength == 0 || pathLength >= sizeof(modulePath)) {
+      PrintLastError(functionName, "GetModuleFileName");
+      return FALSE;
+   }
+
+   if (GetFileStamp(modulePath, pStamp) == FALSE) {
+      PrintLastError(functionName, "GetFileAttributesEx");
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Open an algorithm provider with BCryptOpenAlgorithmProvider.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+/// <returns>NTSTATUS of BCryptOpenAlgorithmProvider.</returns>
+static NTSTATUS cngOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptOpenAlgorithmProvider(phAlgorithm, algorithmName, NULL, 0);
+}
+
+/// <summary>
+/// Get a property with BCryptGetProperty.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="property">Name of the property.</param>
+/// <param name="pOutput">Buffer that receives the property value.</param>
+/// <param name="outputLength">Size of the buffer.</param>
+/// <param name="pResultLength">Pointer to the variable that receives the size of the property value.</param>
+/// <returns>NTSTATUS of BCryptGetProperty.</returns>
+static NTSTATUS cngGetProperty(PVOID const context,
+                               BCRYPT_ALG_HANDLE const hAlgorithm,
+                               LPCWSTR const property,
+                               PUCHAR const pOutput,
+                               const ULONG outputLength,
+                               ULONG* const pResultLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptGetProperty(hAlgorithm, property, pOutput, outputLength, pResultLength, 0);
+}
+
+/// <summary>
+/// Set a property with BCryptSetProperty.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="property">Name of the property.</param>
+/// <param name="pInput">Property value.</param>
+/// <param name="inputLength">Size of the property value.</param>
+/// <returns>NTSTATUS of BCryptSetProperty.</returns>
+static NTSTATUS cngSetProperty(PVOID const context,
+                               BCRYPT_ALG_HANDLE const hAlgorithm,
+                               LPCWSTR const property,
+                               PUCHAR const pInput,
+                               const ULONG inputLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptSetProperty(hAlgorithm, property, pInput, inputLength, 0);
+}
+
+/// <summary>
+/// Close an algorithm provider with BCryptCloseAlgorithmProvider.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+static void cngCloseAlgorithm(PVOID const context, BCRYPT_ALG_HANDLE const hAlgorithm) {
+   UNREFERENCED_PARAMETER(context);
+
+   BCryptCloseAlgorithmProvider(hAlgorithm, 0);
+}
+
+/// <summary>
+/// Get the list of the registered providers with BCryptEnumRegisteredProviders.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppProviders">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of BCryptEnumRegisteredProviders.</returns>
+static NTSTATUS cngEnumProviders(PVOID const context, ULONG* const pBufferSize, PCRYPT_PROVIDERS* const ppProviders) {
+   UNREFERENCED_PARAMETER(context);
+
+   *ppProviders = NULL;
+
+   return BCryptEnumRegisteredProviders(pBufferSize, ppProviders);
+}
+
+/// <summary>
+/// Get the registration of a provider with BCryptQueryProviderRegistration.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="providerName">Name of the provider.</param>
+/// <param name="mode">CRYPT_UM, CRYPT_KM or CRYPT_ANY.</param>
+/// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the registration.</param>
+/// <param name="ppRegistration">Pointer to the variable that receives the registration.</param>
+/// <returns>NTSTATUS of BCryptQueryProviderRegistration.</returns>
+static NTSTATUS cngQueryProviderRegistration(PVOID const context,
+                                             LPCWSTR const providerName,
+                                             const ULONG mode,
+                                             const ULONG interfaceId,
+                                             ULONG* const pBufferSize,
+                                             PCRYPT_PROVIDER_REG* const ppRegistration) {
+   UNREFERENCED_PARAMETER(context);
+
+   *ppRegistration = NULL;
+
+   return BCryptQueryProviderRegistration(providerName, mode, interfaceId, pBufferSize, ppRegistration);
+}
+
+/// <summary>
+/// Get the list of the configuration contexts with BCryptEnumContexts.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppContexts">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of BCryptEnumContexts.</returns>
+static NTSTATUS cngEnumContexts(PVOID const context, const ULONG table, ULONG* const pBufferSize, PCRYPT_CONTEXTS* const ppContexts) {
+   UNREFERENCED_PARAMETER(context);
+
+   *ppContexts = NULL;
+
+   return BCryptEnumContexts(table, pBufferSize, ppContexts);
+}
+
+/// <summary>
+/// Get the functions of an interface in a configuration context with BCryptEnumContextFunctions.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+/// <param name="contextName">Name of the configuration context.</param>
+/// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppFunctions">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of BCryptEnumContextFunctions.</returns>
+static NTSTATUS cngEnumContextFunctions(PVOID const context,
+                                        const ULONG table,
+                                        LPCWSTR const contextName,
+                                        const ULONG interfaceId,
+                                        ULONG* const pBufferSize,
+                                        PCRYPT_CONTEXT_FUNCTIONS* const ppFunctions) {
+   UNREFERENCED_PARAMETER(context);
+
+   *ppFunctions = NULL;
+
+   return BCryptEnumContextFunctions(table, contextName, interfaceId, pBufferSize, ppFunctions);
+}
+
+/// <summary>
+/// Get the providers of a function with BCryptEnumContextFunctionProviders.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+/// <param name="contextName">Name of the configuration context.</param>
+/// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+/// <param name="functionName">Name of the function.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppProviders">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of BCryptEnumContextFunctionProviders.</returns>
+static NTSTATUS cngEnumContextFunctionProviders(PVOID const context,
+                                                const ULONG table,
+                                                LPCWSTR const contextName,
+                                                const ULONG interfaceId,
+                                                LPCWSTR const functionName,
+                                                ULONG* const pBufferSize,
+                                                PCRYPT_CONTEXT_FUNCTION_PROVIDERS* const ppProviders) {
+   UNREFERENCED_PARAMETER(context);
+
+   *ppProviders = NULL;
+
+   return BCryptEnumContextFunctionProviders(table, contextName, interfaceId, functionName, pBufferSize, ppProviders);
+}
+
+/// <summary>
+/// Refresh the backend. CNG always returns the current state, so there is nothing to do.
+/// </summary>
+/// <param name="context">Backend context (unused).</param>
+/// <returns>Always TRUE.</returns>
+static BOOL cngRefresh(PVOID const context) {
+   (void)context;
+
+   return TRUE;
+}
+
+// ******** Private constants ********
+
+/// The CNG backend.
+static const ALGORITHM_BACKEND cngBackend = {
+   "CNG",
+   NULL,
+   cngEnumAlgorithms,
+   cngFreeBuffer,
+   cngGetModuleVersion,
+   cngGetModuleStamp,
+   cngOpenAlgorithm,
+   cngGetProperty,
+   cngSetProperty,
+   cngCloseAlgorithm,
+   cngEnumProviders,
+   cngQueryProviderRegistration,
+   cngEnumContexts,
+   cngEnumContextFunctions,
+   cngEnumContextFunctionProviders,
+   cngRefresh
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the backend that uses the Windows CNG functions.
+/// </summary>
+/// <returns>Pointer to the CNG backend.</returns>
+const ALGORITHM_BACKEND* GetCngBackend(void) {
+   return &cngBackend;
+}
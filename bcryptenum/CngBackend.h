@@ -0,0 +1,9 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+
+/// <summary>
+/// Get the backend that uses the Windows CNG functions.
+/// </summary>
+/// <returns>Pointer to the CNG backend.</returns>
+const ALGORITHM_BACKEND* GetCngBackend(void);
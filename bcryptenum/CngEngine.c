@@ -0,0 +1,450 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Key pairs, signatures and verification.
+//    2026-10-16: V1.2.0: Random numbers.
+//
+
+#include <Windows.h>
+#include <bcrypt.h>
+
+#include "CryptoEngine.h"
+
+// ******** Private constants ********
+
+/// Maximum size of a symmetric key secret in bytes.
+#define MAX_SECRET_SIZE 64
+
+// ******** Private types ********
+
+/// <summary>
+/// Key object with the block length that is needed for the initialization vector.
+/// </summary>
+typedef struct _CNG_KEY {
+   BCRYPT_KEY_HANDLE hKey;
+   ULONG blockLength;
+} CNG_KEY;
+
+/// <summary>
+/// Key pair that knows, whether signatures need the PKCS #1 padding information (RSA) or no padding information (ECDSA, DSA).
+/// </summary>
+typedef struct _CNG_KEY_PAIR {
+   BCRYPT_KEY_HANDLE hKey;
+   BOOL usesPkcs1;
+} CNG_KEY_PAIR;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Open an algorithm provider.
+/// Hash algorithms are opened as reusable, so that a hash object can be reused without creating it again.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+/// <returns>NTSTATUS of BCryptOpenAlgorithmProvider.</returns>
+static NTSTATUS cngOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, ENGINE_HANDLE* const phAlgorithm) {
+   UNREFERENCED_PARAMETER(context);
+
+   NTSTATUS nts = BCryptOpenAlgorithmProvider(phAlgorithm, algorithmName, NULL, BCRYPT_HASH_REUSABLE_FLAG);
+   if (nts < 0)
+      nts = BCryptOpenAlgorithmProvider(phAlgorithm, algorithmName, NULL, 0);
+
+   return nts;
+}
+
+/// <summary>
+/// Close an algorithm provider.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+static void cngCloseAlgorithm(PVOID const context, ENGINE_HANDLE const hAlgorithm) {
+   UNREFERENCED_PARAMETER(context);
+
+   BCryptCloseAlgorithmProvider(hAlgorithm, 0);
+}
+
+/// <summary>
+/// Create a reusable hash object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="phHash">Pointer to the variable that receives the hash handle.</param>
+/// <param name="pHashLength">Pointer to the variable that receives the length of the hash value.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS cngCreateHash(PVOID const context, ENGINE_HANDLE const hAlgorithm, ENGINE_HANDLE* const phHash, ULONG* const pHashLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   ULONG resultLength;
+   NTSTATUS nts = BCryptGetProperty(hAlgorithm, BCRYPT_HASH_LENGTH, (PUCHAR)pHashLength, sizeof(ULONG), &resultLength, 0);
+   if (nts < 0)
+      return nts;
+
+   // The hash object memory is managed by CNG.
+   return BCryptCreateHash(hAlgorithm, phHash, NULL, 0, NULL, 0, BCRYPT_HASH_REUSABLE_FLAG);
+}
+
+/// <summary>
+/// Hash data.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hHash">Hash handle.</param>
+/// <param name="pInput">Data to hash.</param>
+/// <param name="inputLength">Length of the data.</param>
+/// <returns>NTSTATUS of BCryptHashData.</returns>
+static NTSTATUS cngHashData(PVOID const context, ENGINE_HANDLE const hHash, const PUCHAR pInput, const ULONG inputLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptHashData(hHash, pInput, inputLength, 0);
+}
+
+/// <summary>
+/// Finish a hash. As the hash object is reusable, this resets it.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hHash">Hash handle.</param>
+/// <param name="pOutput">Buffer that receives the hash value.</param>
+/// <param name="outputLength">Length of the hash value.</param>
+/// <returns>NTSTATUS of BCryptFinishHash.</returns>
+static NTSTATUS cngFinishHash(PVOID const context, ENGINE_HANDLE const hHash, PUCHAR const pOutput, const ULONG outputLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptFinishHash(hHash, pOutput, outputLength, 0);
+}
+
+/// <summary>
+/// Destroy a hash object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hHash">Hash handle.</param>
+static void cngDestroyHash(PVOID const context, ENGINE_HANDLE const hHash) {
+   UNREFERENCED_PARAMETER(context);
+
+   BCryptDestroyHash(hHash);
+}
+
+/// <summary>
+/// Create a key object with the smallest key length the algorithm supports.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="phKey">Pointer to the variable that receives the key handle.</param>
+/// <param name="pBlockLength">Pointer to the variable that receives the block length.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS cngGenerateKey(PVOID const context, ENGINE_HANDLE const hAlgorithm, ENGINE_HANDLE* const phKey, ULONG* const pBlockLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   // 1. Get the key lengths and the block length.
+   BCRYPT_KEY_LENGTHS_STRUCT keyLengths;
+   ULONG resultLength;
+   NTSTATUS nts = BCryptGetProperty(hAlgorithm, BCRYPT_KEY_LENGTHS, (PUCHAR)&keyLengths, sizeof(keyLengths), &resultLength, 0);
+   if (nts < 0)
+      return nts;
+
+   ULONG blockLength;
+   if (BCryptGetProperty(hAlgorithm, BCRYPT_BLOCK_LENGTH, (PUCHAR)&blockLength, sizeof(blockLength), &resultLength, 0) < 0)
+      blockLength = 1;  // Stream ciphers have no block length.
+
+   // 2. Generate the key.
+   //    Some algorithms report the effective key length without parity bits (e.g. 56 bits for DES),
+   //    but need the full length. So, if the exact length fails, it is rounded up to a multiple of 8 bytes.
+   UCHAR secret[MAX_SECRET_SIZE];
+   for (ULONG i = 0; i < MAX_SECRET_SIZE; i++)
+      secret[i] = (UCHAR)(i * 37 + 11);
+
+   ULONG secretLength = (keyLengths.dwMinLength + 7) >> 3;
+   if (secretLength == 0 || secretLength > MAX_SECRET_SIZE)
+      return STATUS_NOT_SUPPORTED;
+
+   BCRYPT_KEY_HANDLE hKey;
+   nts = BCryptGenerateSymmetricKey(hAlgorithm, &hKey, NULL, 0, secret, secretLength, 0);
+   if (nts < 0) {
+      ULONG roundedLength = (secretLength + 7) & ~7UL;
+      if (roundedLength == secretLength || roundedLength > MAX_SECRET_SIZE)
+         return nts;
+
+      nts = BCryptGenerateSymmetricKey(hAlgorithm, &hKey, NULL, 0, secret, roundedLength, 0);
+      if (nts < 0)
+         return nts;
+   }
+
+   // 3. Keep the block length with the key, as it is needed for the initialization vector.
+   CNG_KEY* pKey = HeapAlloc(GetProcessHeap(), 0, sizeof(CNG_KEY));
+   if (pKey == NULL) {
+      BCryptDestroyKey(hKey);
+      return STATUS_NO_MEMORY;
+   }
+
+   pKey->hKey = hKey;
+   pKey->blockLength = blockLength;
+
+   *phKey = pKey;
+   *pBlockLength = blockLength;
+
+   return 0;
+}
+
+/// <summary>
+/// Encrypt data without padding.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key handle.</param>
+/// <param name="pInput">Data to encrypt.</param>
+/// <param name="inputLength">Length of the data.</param>
+/// <param name="pIv">Initialization vector or NULL.</param>
+/// <param name="pOutput">Buffer that receives the encrypted data.</param>
+/// <returns>NTSTATUS of BCryptEncrypt.</returns>
+static NTSTATUS cngEncrypt(PVOID const context,
+                           ENGINE_HANDLE const hKey,
+                           const PUCHAR pInput,
+                           const ULONG inputLength,
+                           PUCHAR const pIv,
+                           PUCHAR const pOutput) {
+   UNREFERENCED_PARAMETER(context);
+
+   const CNG_KEY* pKey = hKey;
+   ULONG ivLength = (pIv != NULL && pKey->blockLength > 1) ? pKey->blockLength : 0;
+   ULONG resultLength;
+
+   return BCryptEncrypt(pKey->hKey,
+                        pInput,
+                        inputLength,
+                        NULL,
+                        (ivLength != 0) ? pIv : NULL,
+                        ivLength,
+                        pOutput,
+                        inputLength,
+                        &resultLength,
+                        0);
+}
+
+/// <summary>
+/// Destroy a key object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key handle.</param>
+static void cngDestroyKey(PVOID const context, ENGINE_HANDLE const hKey) {
+   UNREFERENCED_PARAMETER(context);
+
+   CNG_KEY* pKey = hKey;
+   BCryptDestroyKey(pKey->hKey);
+   HeapFree(GetProcessHeap(), 0, pKey);
+}
+
+/// <summary>
+/// Get the key lengths of an asymmetric algorithm.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="pMinLength">Pointer to the variable that receives the smallest key length in bits.</param>
+/// <param name="pMaxLength">Pointer to the variable that receives the largest key length in bits.</param>
+/// <param name="pIncrement">Pointer to the variable that receives the step between two key lengths in bits.</param>
+/// <returns>NTSTATUS of BCryptGetProperty.</returns>
+static NTSTATUS cngGetKeyPairLengths(PVOID const context,
+                                     ENGINE_HANDLE const hAlgorithm,
+                                     ULONG* const pMinLength,
+                                     ULONG* const pMaxLength,
+                                     ULONG* const pIncrement) {
+   UNREFERENCED_PARAMETER(context);
+
+   BCRYPT_KEY_LENGTHS_STRUCT keyLengths;
+   ULONG resultLength;
+   NTSTATUS nts = BCryptGetProperty(hAlgorithm, BCRYPT_KEY_LENGTHS, (PUCHAR)&keyLengths, sizeof(keyLengths), &resultLength, 0);
+   if (nts < 0)
+      return nts;
+
+   *pMinLength = keyLengths.dwMinLength;
+   *pMaxLength = keyLengths.dwMaxLength;
+   *pIncrement = keyLengths.dwIncrement;
+
+   return 0;
+}
+
+/// <summary>
+/// Generate a key pair.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="keyLength">Key length in bits.</param>
+/// <param name="phKey">Pointer to the variable that receives the key handle.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS cngGenerateKeyPair(PVOID const context, ENGINE_HANDLE const hAlgorithm, const ULONG keyLength, ENGINE_HANDLE* const phKey) {
+   UNREFERENCED_PARAMETER(context);
+
+   // 1. Generate the key.
+   BCRYPT_KEY_HANDLE hKey;
+   NTSTATUS nts = BCryptGenerateKeyPair(hAlgorithm, &hKey, keyLength, 0);
+   if (nts < 0)
+      return nts;
+
+   nts = BCryptFinalizeKeyPair(hKey, 0);
+   if (nts < 0) {
+      BCryptDestroyKey(hKey);
+      return nts;
+   }
+
+   // 2. Only RSA has padding schemes.
+   ULONG paddingSchemes;
+   ULONG resultLength;
+   if (BCryptGetProperty(hAlgorithm, BCRYPT_PADDING_SCHEMES, (PUCHAR)&paddingSchemes, sizeof(paddingSchemes), &resultLength, 0) < 0)
+      paddingSchemes = 0;
+
+   CNG_KEY_PAIR* pKeyPair = HeapAlloc(GetProcessHeap(), 0, sizeof(CNG_KEY_PAIR));
+   if (pKeyPair == NULL) {
+      BCryptDestroyKey(hKey);
+      return STATUS_NO_MEMORY;
+   }
+
+   pKeyPair->hKey = hKey;
+   pKeyPair->usesPkcs1 = (paddingSchemes & BCRYPT_SUPPORTED_PAD_PKCS1_SIG) != 0;
+
+   *phKey = pKeyPair;
+
+   return 0;
+}
+
+/// <summary>
+/// Sign a SHA-256 hash value.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key pair handle.</param>
+/// <param name="pHash">Hash value.</param>
+/// <param name="hashLength">Length of the hash value.</param>
+/// <param name="pSignature">Buffer that receives the signature.</param>
+/// <param name="signatureCapacity">Size of the signature buffer.</param>
+/// <param name="pSignatureLength">Pointer to the variable that receives the length of the signature.</param>
+/// <returns>NTSTATUS of BCryptSignHash.</returns>
+static NTSTATUS cngSignHash(PVOID const context,
+                            ENGINE_HANDLE const hKey,
+                            const PUCHAR pHash,
+                            const ULONG hashLength,
+                            PUCHAR const pSignature,
+                            const ULONG signatureCapacity,
+                            ULONG* const pSignatureLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   const CNG_KEY_PAIR* pKeyPair = hKey;
+   BCRYPT_PKCS1_PADDING_INFO paddingInfo = { BCRYPT_SHA256_ALGORITHM };
+
+   return BCryptSignHash(pKeyPair->hKey,
+                         (pKeyPair->usesPkcs1 != FALSE) ? &paddingInfo : NULL,
+                         pHash,
+                         hashLength,
+                         pSignature,
+                         signatureCapacity,
+                         pSignatureLength,
+                         (pKeyPair->usesPkcs1 != FALSE) ? BCRYPT_PAD_PKCS1 : 0);
+}
+
+/// <summary>
+/// Verify the signature of a SHA-256 hash value.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key pair handle.</param>
+/// <param name="pHash">Hash value.</param>
+/// <param name="hashLength">Length of the hash value.</param>
+/// <param name="pSignature">Signature.</param>
+/// <param name="signatureLength">Length of the signature.</param>
+/// <returns>NTSTATUS of BCryptVerifySignature.</returns>
+static NTSTATUS cngVerifySignature(PVOID const context,
+                                   ENGINE_HANDLE const hKey,
+                                   const PUCHAR pHash,
+                                   const ULONG hashLength,
+                                   const PUCHAR pSignature,
+                                   const ULONG signatureLength) {
+   UNREFERENCED_PARAMETER(context);
+
+   const CNG_KEY_PAIR* pKeyPair = hKey;
+   BCRYPT_PKCS1_PADDING_INFO paddingInfo = { BCRYPT_SHA256_ALGORITHM };
+
+   return BCryptVerifySignature(pKeyPair->hKey,
+                                (pKeyPair->usesPkcs1 != FALSE) ? &paddingInfo : NULL,
+                                pHash,
+                                hashLength,
+                                pSignature,
+                                signatureLength,
+                                (pKeyPair->usesPkcs1 != FALSE) ? BCRYPT_PAD_PKCS1 : 0);
+}
+
+/// <summary>
+/// Destroy a key pair.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key pair handle.</param>
+static void cngDestroyKeyPair(PVOID const context, ENGINE_HANDLE const hKey) {
+   UNREFERENCED_PARAMETER(context);
+
+   CNG_KEY_PAIR* pKeyPair = hKey;
+   BCryptDestroyKey(pKeyPair->hKey);
+   HeapFree(GetProcessHeap(), 0, pKeyPair);
+}
+
+/// <summary>
+/// Fill a buffer with random bytes.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Handle of a random number generator or NULL for the system-preferred random number generator.</param>
+/// <param name="pBuffer">Buffer that receives the random bytes.</param>
+/// <param name="length">Number of random bytes.</param>
+/// <returns>NTSTATUS of BCryptGenRandom.</returns>
+static NTSTATUS cngGenRandom(PVOID const context, ENGINE_HANDLE const hAlgorithm, PUCHAR const pBuffer, const ULONG length) {
+   UNREFERENCED_PARAMETER(context);
+
+   return BCryptGenRandom(hAlgorithm, pBuffer, length, (hAlgorithm == NULL) ? BCRYPT_USE_SYSTEM_PREFERRED_RNG : 0);
+}
+
+// ******** Private constants ********
+
+/// The CNG engine.
+static const CRYPTO_ENGINE cngEngine = {
+   "CNG",
+   NULL,
+   cngOpenAlgorithm,
+   cngCloseAlgorithm,
+   cngCreateHash,
+   cngHashData,
+   cngFinishHash,
+   cngDestroyHash,
+   cngGenerateKey,
+   cngEncrypt,
+   cngDestroyKey,
+   cngGetKeyPairLengths,
+   cngGenerateKeyPair,
+   cngSignHash,
+   cngVerifySignature,
+   cngDestroyKeyPair,
+   cngGenRandom
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the crypto engine that uses the Windows CNG functions.
+/// </summary>
+/// <returns>Pointer to the CNG engine.</returns>
+const CRYPTO_ENGINE* GetCngEngine(void) {
+   return &cngEngine;
+}
@@ -1,5 +1,5 @@
 //
-// SPDX-FileCopyrightText: Copyright 2023-2024 Frank Schwab
+// SPDX-FileCopyrightText: Copyright 2023-2026 Frank Schwab
 //
 // SPDX-License-Identifier: Apache-2.0
 //
@@ -20,30 +20,39 @@
 //
 // Author: Frank Schwab
 //
-// Version: 1.0.0
+// Version: 1.3.0
 //
 // Change history:
 //    2025-11-12: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Use UTF-8 on platforms other than Windows.
+//    2026-10-16: V1.2.0: Convert into a caller supplied buffer.
+//    2026-10-16: V1.3.0: Convert with the transcoder and use thread local buffers.
 //
 
-#include <Windows.h>
+#include <stdarg.h>
 #include <stdio.h>
 
+#include "Platform.h"
+#include "Transcoder.h"
+
 // ******** Private constants ********
 
 /// Length of message buffers.
 #define MESSAGE_BUFFER_LENGTH 256
 
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
 // ******** Private variables ********
 
 /// Buffer for wide character message text.
-static wchar_t wideBuffer[MESSAGE_BUFFER_LENGTH];
+static THREAD_LOCAL wchar_t wideBuffer[MESSAGE_BUFFER_LENGTH];
 
 /// Buffer for console character message text.
-static char consoleBuffer[MESSAGE_BUFFER_LENGTH];
-
-/// Code page of the console.
-UINT consoleCodePage = 0;
+static THREAD_LOCAL char consoleBuffer[MESSAGE_BUFFER_LENGTH];
 
 // ******** Public functions ********
 
@@ -51,36 +60,24 @@ UINT consoleCodePage = 0;
 /// Convert a wide character string into a string for the console code page.
 /// </summary>
 /// <param name="wideMessage">UTF-16 message.</param>
-/// <returns>Pointer to message converted to the console code page.</returns>
+/// <returns>Pointer to message converted to the console code page. The buffer is local to the calling thread.</returns>
 char* AsConsoleCodePageString(const wchar_t* const wideMessage) {
-   if (consoleCodePage == 0)
-      consoleCodePage = GetConsoleOutputCP();
-
-   int len = WideCharToMultiByte(
-      consoleCodePage,        // Destination code page.
-      0,                      // No special flags.
-      wideMessage,            // UTF-16 source string.
-      -1,                     // Source string is 0 terminated.
-      consoleBuffer,          // Destination buffer.
-      MESSAGE_BUFFER_LENGTH,  // Length of destination buffer.
-      NULL,                   // Use system default char for unmappable chars.
-      NULL                    // Not interested in whether default char was used.
-   );
-
-   if (len == 0) {
-      DWORD le = GetLastError();
-      sprintf_s(
-         consoleBuffer,
-         MESSAGE_BUFFER_LENGTH,
-         "Error converting message to console code page: %lu (0x%08lx)",
-         le,
-         le
-      );
-   }
+   TranscodeToConsole(wideMessage, wcslen(wideMessage), consoleBuffer, MESSAGE_BUFFER_LENGTH);
 
    return consoleBuffer;
 }
 
+/// <summary>
+/// Convert a wide character string into the console code page and store it in a buffer.
+/// </summary>
+/// <param name="wideString">Wide character string.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. 0, if the string could not be converted.</returns>
+size_t EncodeForConsole(const wchar_t* const wideString, char* const buffer, const size_t bufferSize) {
+   return TranscodeToConsole(wideString, wcslen(wideString), buffer, bufferSize);
+}
+
 /// <summary>
 /// Prints a wide character formatted string to the console.
 /// </summary>
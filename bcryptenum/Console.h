@@ -1,12 +1,24 @@
 #pragma once
 
+#include <stdio.h>
+#include <wchar.h>
+
 /// <summary>
 /// Convert a wide character string into a string for the console code page.
 /// </summary>
 /// <param name="wideMessage">UTF-16 message.</param>
-/// <returns>Pointer to message converted to the console code page.</returns>
+/// <returns>Pointer to message converted to the console code page. The buffer is local to the calling thread.</returns>
 char* AsConsoleCodePageString(const wchar_t* const wideMessage);
 
+/// <summary>
+/// Convert a wide character string into the console code page and store it in a buffer.
+/// </summary>
+/// <param name="wideString">Wide character string.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. 0, if the string could not be converted.</returns>
+size_t EncodeForConsole(const wchar_t* const wideString, char* const buffer, const size_t bufferSize);
+
 /// <summary>
 /// Prints a wide character formatted string to the console.
 /// </summary>
@@ -0,0 +1,278 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ApiErrorHandler.h"
+#include "CountingBackend.h"
+
+// ******** Private types ********
+
+/// <summary>
+/// Backend that counts the calls and forwards them to another backend.
+/// </summary>
+typedef struct _COUNTING_BACKEND {
+   ALGORITHM_BACKEND backend;
+   const ALGORITHM_BACKEND* pInner;
+   HANDLE hHeap;
+
+   /// Number of calls. The probes call the backend from several threads.
+   volatile LONG callCount;
+} COUNTING_BACKEND;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Count one call.
+/// </summary>
+/// <param name="context">Counting backend.</param>
+/// <returns>Counted backend.</returns>
+static inline const ALGORITHM_BACKEND* countCall(PVOID const context) {
+   COUNTING_BACKEND* pCounting = context;
+
+#ifdef _WIN32
+   InterlockedIncrement(&pCounting->callCount);
+#else
+   __atomic_add_fetch(&pCounting->callCount, 1, __ATOMIC_RELAXED);
+#endif
+
+   return pCounting->pInner;
+}
+
+/// <summary>
+/// Count a call of EnumAlgorithms and forward it.
+/// </summary>
+static NTSTATUS countingEnumAlgorithms(PVOID const context,
+                                       const ULONG operationMask,
+                                       ULONG* const pAlgoCount,
+                                       BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->EnumAlgorithms(pInner->context, operationMask, pAlgoCount, ppAlgoList);
+}
+
+/// <summary>
+/// Count a call of FreeBuffer and forward it.
+/// </summary>
+static void countingFreeBuffer(PVOID const context, PVOID const pBuffer) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   pInner->FreeBuffer(pInner->context, pBuffer);
+}
+
+/// <summary>
+/// Count a call of GetModuleVersion and forward it.
+/// </summary>
+static BOOL countingGetModuleVersion(PVOID const context, const PCHAR moduleName, MODULE_VERSION* const pVersion) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->GetModuleVersion(pInner->context, moduleName, pVersion);
+}
+
+/// <summary>
+/// Count a call of GetModuleStamp and forward it.
+/// </summary>
+static BOOL countingGetModuleStamp(PVOID const context, const PCHAR moduleName, FILE_STAMP* const pStamp) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->GetModuleStamp(pInner->context, moduleName, pStamp);
+}
+
+/// <summary>
+/// Count a call of OpenAlgorithm and forward it.
+/// </summary>
+static NTSTATUS countingOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->OpenAlgorithm(pInner->context, algorithmName, phAlgorithm);
+}
+
+/// <summary>
+/// Count a call of GetProperty and forward it.
+/// </summary>
+static NTSTATUS countingGetProperty(PVOID const context,
+                                    BCRYPT_ALG_HANDLE const hAlgorithm,
+                                    LPCWSTR const property,
+                                    PUCHAR const pOutput,
+                                    const ULONG outputLength,
+                                    ULONG* const pResultLength) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->GetProperty(pInner->context, hAlgorithm, property, pOutput, outputLength, pResultLength);
+}
+
+/// <summary>
+/// Count a call of SetProperty and forward it.
+/// </summary>
+static NTSTATUS countingSetProperty(PVOID const context,
+                                    BCRYPT_ALG_HANDLE const hAlgorithm,
+                                    LPCWSTR const property,
+                                    PUCHAR const pInput,
+                                    const ULONG inputLength) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->SetProperty(pInner->context, hAlgorithm, property, pInput, inputLength);
+}
+
+/// <summary>
+/// Count a call of CloseAlgorithm and forward it.
+/// </summary>
+static void countingCloseAlgorithm(PVOID const context, BCRYPT_ALG_HANDLE const hAlgorithm) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   pInner->CloseAlgorithm(pInner->context, hAlgorithm);
+}
+
+/// <summary>
+/// Count a call of EnumProviders and forward it.
+/// </summary>
+static NTSTATUS countingEnumProviders(PVOID const context, ULONG* const pBufferSize, PCRYPT_PROVIDERS* const ppProviders) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->EnumProviders(pInner->context, pBufferSize, ppProviders);
+}
+
+/// <summary>
+/// Count a call of QueryProviderRegistration and forward it.
+/// </summary>
+static NTSTATUS countingQueryProviderRegistration(PVOID const context,
+                                                  LPCWSTR const providerName,
+                                                  const ULONG mode,
+                                                  const ULONG interfaceId,
+                                                  ULONG* const pBufferSize,
+                                                  PCRYPT_PROVIDER_REG* const ppRegistration) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->QueryProviderRegistration(pInner->context, providerName, mode, interfaceId, pBufferSize, ppRegistration);
+}
+
+/// <summary>
+/// Count a call of EnumContexts and forward it.
+/// </summary>
+static NTSTATUS countingEnumContexts(PVOID const context, const ULONG table, ULONG* const pBufferSize, PCRYPT_CONTEXTS* const ppContexts) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->EnumContexts(pInner->context, table, pBufferSize, ppContexts);
+}
+
+/// <summary>
+/// Count a call of EnumContextFunctions and forward it.
+/// </summary>
+static NTSTATUS countingEnumContextFunctions(PVOID const context,
+                                             const ULONG table,
+                                             LPCWSTR const contextName,
+                                             const ULONG interfaceId,
+                                             ULONG* const pBufferSize,
+                                             PCRYPT_CONTEXT_FUNCTIONS* const ppFunctions) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->EnumContextFunctions(pInner->context, table, contextName, interfaceId, pBufferSize, ppFunctions);
+}
+
+/// <summary>
+/// Count a call of EnumContextFunctionProviders and forward it.
+/// </summary>
+static NTSTATUS countingEnumContextFunctionProviders(PVOID const context,
+                                                     const ULONG table,
+                                                     LPCWSTR const contextName,
+                                                     const ULONG interfaceId,
+                                                     LPCWSTR const functionName,
+                                                     ULONG* const pBufferSize,
+                                                     PCRYPT_CONTEXT_FUNCTION_PROVIDERS* const ppProviders) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->EnumContextFunctionProviders(pInner->context, table, contextName, interfaceId, functionName, pBufferSize, ppProviders);
+}
+
+/// <summary>
+/// Count a call of Refresh and forward it.
+/// </summary>
+static BOOL countingRefresh(PVOID const context) {
+   const ALGORITHM_BACKEND* pInner = countCall(context);
+   return pInner->Refresh(pInner->context);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Open a backend that counts the calls to another backend.
+/// </summary>
+/// <param name="pInner">Backend whose calls are counted.</param>
+/// <returns>Pointer to the counting backend or NULL, if it could not be created. It has to be closed with CloseCountingBackend.</returns>
+ALGORITHM_BACKEND* OpenCountingBackend(const ALGORITHM_BACKEND* const pInner) {
+   const PCHAR functionName = "OpenCountingBackend";
+
+   HANDLE hHeap = GetProcessHeap();
+   if (hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return NULL;
+   }
+
+   COUNTING_BACKEND* pCounting = HeapAlloc(hHeap, 0, sizeof(COUNTING_BACKEND));
+   if (pCounting == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for counting backend failed.\n", functionName);
+      return NULL;
+   }
+
+   memset(pCounting, 0, sizeof(COUNTING_BACKEND));
+   pCounting->pInner = pInner;
+   pCounting->hHeap = hHeap;
+
+   pCounting->backend.name = pInner->name;
+   pCounting->backend.context = pCounting;
+   pCounting->backend.EnumAlgorithms = countingEnumAlgorithms;
+   pCounting->backend.FreeBuffer = countingFreeBuffer;
+   pCounting->backend.GetModuleVersion = countingGetModuleVersion;
+   pCounting->backend.GetModuleStamp = countingGetModuleStamp;
+   pCounting->backend.OpenAlgorithm = countingOpenAlgorithm;
+   pCounting->backend.GetProperty = countingGetProperty;
+   pCounting->backend.SetProperty = countingSetProperty;
+   pCounting->backend.CloseAlgorithm = countingCloseAlgorithm;
+   pCounting->backend.EnumProviders = countingEnumProviders;
+   pCounting->backend.QueryProviderRegistration = countingQueryProviderRegistration;
+   pCounting->backend.EnumContexts = countingEnumContexts;
+   pCounting->backend.EnumContextFunctions = countingEnumContextFunctions;
+   pCounting->backend.EnumContextFunctionProviders = countingEnumContextFunctionProviders;
+   pCounting->backend.Refresh = countingRefresh;
+
+   return &pCounting->backend;
+}
+
+/// <summary>
+/// Get the number of calls to the backend since it was opened.
+/// </summary>
+/// <param name="pBackend">Counting backend.</param>
+/// <returns>Number of calls.</returns>
+ULONG GetBackendCallCount(const ALGORITHM_BACKEND* const pBackend) {
+   COUNTING_BACKEND* pCounting = pBackend->context;
+
+#ifdef _WIN32
+   return (ULONG)InterlockedCompareExchange(&pCounting->callCount, 0, 0);
+#else
+   return (ULONG)__atomic_load_n(&pCounting->callCount, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/// <summary>
+/// Close a backend opened with OpenCountingBackend. The counted backend is not closed.
+/// </summary>
+/// <param name="pBackend">Pointer to the backend.</param>
+void CloseCountingBackend(ALGORITHM_BACKEND* const pBackend) {
+   if (pBackend != NULL) {
+      COUNTING_BACKEND* pCounting = pBackend->context;
+      HeapFree(pCounting->hHeap, 0, pCounting);
+   }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+
+/// <summary>
+/// Open a backend that counts the calls to another backend.
+/// </summary>
+/// <param name="pInner">Backend whose calls are counted.</param>
+/// <returns>Pointer to the counting backend or NULL, if it could not be created. It has to be closed with CloseCountingBackend.</returns>
+ALGORITHM_BACKEND* OpenCountingBackend(const ALGORITHM_BACKEND* const pInner);
+
+/// <summary>
+/// Get the number of calls to the backend since it was opened.
+/// </summary>
+/// <param name="pBackend">Counting backend.</param>
+/// <returns>Number of calls.</returns>
+ULONG GetBackendCallCount(const ALGORITHM_BACKEND* const pBackend);
+
+/// <summary>
+/// Close a backend opened with OpenCountingBackend. The counted backend is not closed.
+/// </summary>
+/// <param name="pBackend">Pointer to the backend.</param>
+void CloseCountingBackend(ALGORITHM_BACKEND* const pBackend);
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Platform.h"
+
+/// Handle of an engine object (algorithm, hash or key).
+typedef PVOID ENGINE_HANDLE;
+
+/// <summary>
+/// Crypto engine.
+/// The benchmarks only talk to the crypto implementation through this interface.
+/// All handles are used by one thread at a time, but different handles may be used by different threads.
+/// </summary>
+typedef struct _CRYPTO_ENGINE {
+   /// Name of the engine for messages.
+   const char* name;
+
+   /// Engine specific data that is passed to all functions.
+   PVOID context;
+
+   /// <summary>
+   /// Open an algorithm.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="algorithmName">Name of the algorithm.</param>
+   /// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+   /// <returns>NTSTATUS of the operation. STATUS_NOT_SUPPORTED, if the engine does not implement the algorithm.</returns>
+   NTSTATUS (*OpenAlgorithm)(PVOID const context, LPCWSTR const algorithmName, ENGINE_HANDLE* const phAlgorithm);
+
+   /// <summary>
+   /// Close an algorithm.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   void (*CloseAlgorithm)(PVOID const context, ENGINE_HANDLE const hAlgorithm);
+
+   /// <summary>
+   /// Create a reusable hash object. It is reset, whenever a hash is finished.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   /// <param name="phHash">Pointer to the variable that receives the hash handle.</param>
+   /// <param name="pHashLength">Pointer to the variable that receives the length of the hash value.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*CreateHash)(PVOID const context, ENGINE_HANDLE const hAlgorithm, ENGINE_HANDLE* const phHash, ULONG* const pHashLength);
+
+   /// <summary>
+   /// Hash data.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hHash">Hash handle.</param>
+   /// <param name="pInput">Data to hash.</param>
+   /// <param name="inputLength">Length of the data.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*HashData)(PVOID const context, ENGINE_HANDLE const hHash, const PUCHAR pInput, const ULONG inputLength);
+
+   /// <summary>
+   /// Finish a hash and reset the hash object.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hHash">Hash handle.</param>
+   /// <param name="pOutput">Buffer that receives the hash value.</param>
+   /// <param name="outputLength">Length of the hash value.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*FinishHash)(PVOID const context, ENGINE_HANDLE const hHash, PUCHAR const pOutput, const ULONG outputLength);
+
+   /// <summary>
+   /// Destroy a hash object.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hHash">Hash handle.</param>
+   void (*DestroyHash)(PVOID const context, ENGINE_HANDLE const hHash);
+
+   /// <summary>
+   /// Create a key object with the smallest key length the algorithm supports and a fixed key value.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   /// <param name="phKey">Pointer to the variable that receives the key handle.</param>
+   /// <param name="pBlockLength">Pointer to the variable that receives the block length. 1 for stream ciphers.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*GenerateKey)(PVOID const context, ENGINE_HANDLE const hAlgorithm, ENGINE_HANDLE* const phKey, ULONG* const pBlockLength);
+
+   /// <summary>
+   /// Encrypt data in the default chaining mode of the algorithm without padding.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hKey">Key handle.</param>
+   /// <param name="pInput">Data to encrypt. The length must be a multiple of the block length.</param>
+   /// <param name="inputLength">Length of the data.</param>
+   /// <param name="pIv">Initialization vector with the size of a block or NULL for stream ciphers. It is updated.</param>
+   /// <param name="pOutput">Buffer that receives the encrypted data. It may be the same as the input.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*Encrypt)(PVOID const context,
+                       ENGINE_HANDLE const hKey,
+                       const PUCHAR pInput,
+                       const ULONG inputLength,
+                       PUCHAR const pIv,
+                       PUCHAR const pOutput);
+
+   /// <summary>
+   /// Destroy a key object.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hKey">Key handle.</param>
+   void (*DestroyKey)(PVOID const context, ENGINE_HANDLE const hKey);
+
+   /// <summary>
+   /// Get the key lengths of an asymmetric algorithm.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   /// <param name="pMinLength">Pointer to the variable that receives the smallest key length in bits.</param>
+   /// <param name="pMaxLength">Pointer to the variable that receives the largest key length in bits.</param>
+   /// <param name="pIncrement">Pointer to the variable that receives the step between two key lengths in bits.</param>
+   /// <returns>NTSTATUS of the operation. STATUS_NOT_SUPPORTED, if the algorithm has no key pairs.</returns>
+   NTSTATUS (*GetKeyPairLengths)(PVOID const context,
+                                 ENGINE_HANDLE const hAlgorithm,
+                                 ULONG* const pMinLength,
+                                 ULONG* const pMaxLength,
+                                 ULONG* const pIncrement);
+
+   /// <summary>
+   /// Generate a key pair.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hAlgorithm">Algorithm handle.</param>
+   /// <param name="keyLength">Key length in bits.</param>
+   /// <param name="phKey">Pointer to the variable that receives the key handle.</param>
+   /// <returns>NTSTATUS of the operation.</returns>
+   NTSTATUS (*GenerateKeyPair)(PVOID const context, ENGINE_HANDLE const hAlgorithm, const ULONG keyLength, ENGINE_HANDLE* const phKey);
+
+   /// <summary>
+   /// Sign a SHA-256 hash value. RSA keys use PKCS #1 v1.5 padding.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hKey">Key pair handle.</param>
+   /// <param name="pHash">Hash value.</param>
+   /// <param name="hashLength">Length of the hash value.</param>
+   /// <param name="pSignature">Buffer that receives the signature.</param>
+   /// <param name="signatureCapacity">Size of the signature buffer.</param>
+   /// <param name="pSignatureLength">Pointer to the variable that receives the length of the signature.</param>
+   /// <returns>NTSTATUS of the operation. STATUS_NOT_SUPPORTED, if the key can not sign.</returns>
+   NTSTATUS (*SignHash)(PVOID const context,
+                        ENGINE_HANDLE const hKey,
+                        const PUCHAR pHash,
+                        const ULONG hashLength,
+                        PUCHAR const pSignature,
+                        const ULONG signatureCapacity,
+                        ULONG* const pSignatureLength);
+
+   /// <summary>
+   /// Verify the signature of a SHA-256 hash value.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hKey">Key pair handle.</param>
+   /// <param name="pHash">Hash value.</param>
+   /// <param name="hashLength">Length of the hash value.</param>
+   /// <param name="pSignature">Signature.</param>
+   /// <param name="signatureLength">Length of the signature.</param>
+   /// <returns>NTSTATUS of the operation. STATUS_INVALID_SIGNATURE, if the signature does not match.</returns>
+   NTSTATUS (*VerifySignature)(PVOID const context,
+                               ENGINE_HANDLE const hKey,
+                               const PUCHAR pHash,
+                               const ULONG hashLength,
+                               const PUCHAR pSignature,
+                               const ULONG signatureLength);
+
+   /// <summary>
+   /// Destroy a key pair.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hKey">Key pair handle.</param>
+   void (*DestroyKeyPair)(PVOID const context, ENGINE_HANDLE const hKey);
+
+   /// <summary>
+   /// Fill a buffer with random bytes.
+   /// </summary>
+   /// <param name="context">Engine context.</param>
+   /// <param name="hAlgorithm">Handle of a random number generator or NULL for the system-preferred random number generator.</param>
+   /// <param name="pBuffer">Buffer that receives the random bytes.</param>
+   /// <param name="length">Number of random bytes.</param>
+   /// <returns>NTSTATUS of the operation. STATUS_NOT_SUPPORTED, if the algorithm is not a random number generator.</returns>
+   NTSTATUS (*GenRandom)(PVOID const context, ENGINE_HANDLE const hAlgorithm, PUCHAR const pBuffer, const ULONG length);
+} CRYPTO_ENGINE;
+
+/// <summary>
+/// Get the crypto engine that uses the Windows CNG functions.
+/// </summary>
+/// <returns>Pointer to the CNG engine.</returns>
+const CRYPTO_ENGINE* GetCngEngine(void);
+
+/// <summary>
+/// Get the crypto engine that uses the OpenSSL libcrypto functions.
+/// </summary>
+/// <returns>Pointer to the libcrypto engine.</returns>
+const CRYPTO_ENGINE* GetLibCryptoEngine(void);
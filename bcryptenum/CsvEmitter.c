@@ -0,0 +1,221 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include "ListEmitter.h"
+
+// ******** Private constants ********
+
+/// Header line with the column names.
+#define CSV_HEADER "operation,name,class,flags,status,min_key_length,max_key_length,key_length_increment,block_length,hash_length,object_length,chaining_modes\n"
+
+// ******** Private methods ********
+
+/// <summary>
+/// Check, if a character makes it necessary to quote a CSV field.
+/// </summary>
+/// <param name="c">Character.</param>
+/// <returns>TRUE, if the field has to be quoted, FALSE if not.</returns>
+static inline BOOL needsQuotes(const wchar_t c) {
+   return (c == L',' || c == L'"' || c == L'\n' || c == L'\r');
+}
+
+/// <summary>
+/// Print a wide character string as a CSV field.
+/// The field is only quoted, if necessary. Quotes in the field are doubled.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="text">Wide character string.</param>
+static void outputCsvString(OUTPUT_BUFFER* const pOutput, const wchar_t* const text) {
+   // 1. Look for characters that need quoting.
+   const wchar_t* pActual = text;
+   while (*pActual != 0 && needsQuotes(*pActual) == FALSE)
+      pActual++;
+
+   if (*pActual == 0) {
+      OutputUtf8String(pOutput, text, (size_t)(pActual - text));
+      return;
+   }
+
+   // 2. Quote the field and double the quotes in it.
+   OutputChar(pOutput, '"');
+
+   const wchar_t* pRunStart = text;
+   for (; *pActual != 0; pActual++)
+      if (*pActual == L'"') {
+         OutputUtf8String(pOutput, pRunStart, (size_t)(pActual - pRunStart) + 1);
+         pRunStart = pActual;  // The quote is the start of the next run, so it is printed twice.
+      }
+
+   OutputUtf8String(pOutput, pRunStart, (size_t)(pActual - pRunStart));
+
+   OutputChar(pOutput, '"');
+}
+
+/// <summary>
+/// Print a number field with the separator in front of it.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="value">Number.</param>
+static void outputNumberField(OUTPUT_BUFFER* const pOutput, const ULONG value) {
+   OutputChar(pOutput, ',');
+   OutputNumber(pOutput, value);
+}
+
+/// <summary>
+/// Print a number field, if the field is valid, and an empty field if not.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+/// <param name="field">DETAIL_* flag of the field.</param>
+/// <param name="value">Number.</param>
+static void outputDetailField(OUTPUT_BUFFER* const pOutput, const ALGORITHM_DETAILS* const pDetails, const ULONG field, const ULONG value) {
+   if ((pDetails->validFields & field) != 0)
+      outputNumberField(pOutput, value);
+   else
+      OutputChar(pOutput, ',');
+}
+
+/// <summary>
+/// Print the capability fields of an algorithm.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+static void outputDetails(OUTPUT_BUFFER* const pOutput, const ALGORITHM_DETAILS* const pDetails) {
+   OutputFormat(pOutput, ",0x%08lx", (unsigned long)(ULONG)pDetails->status);
+
+   if (pDetails->status < 0) {
+      OutputString(pOutput, ",,,,,,,");
+      return;
+   }
+
+   outputDetailField(pOutput, pDetails, DETAIL_KEY_LENGTHS, pDetails->keyLengths.dwMinLength);
+   outputDetailField(pOutput, pDetails, DETAIL_KEY_LENGTHS, pDetails->keyLengths.dwMaxLength);
+   outputDetailField(pOutput, pDetails, DETAIL_KEY_LENGTHS, pDetails->keyLengths.dwIncrement);
+   outputDetailField(pOutput, pDetails, DETAIL_BLOCK_LENGTH, pDetails->blockLength);
+   outputDetailField(pOutput, pDetails, DETAIL_HASH_LENGTH, pDetails->hashLength);
+   outputDetailField(pOutput, pDetails, DETAIL_OBJECT_LENGTH, pDetails->objectLength);
+
+   OutputChar(pOutput, ',');
+   if ((pDetails->validFields & DETAIL_CHAINING_MODES) != 0) {
+      const char* separator = "";
+      for (int i = 0; i < CHAINING_MODE_COUNT; i++)
+         if ((pDetails->chainingModes & ChainingModes[i].flag) != 0) {
+            OutputString(pOutput, separator);
+            OutputString(pOutput, ChainingModes[i].shortName);
+            separator = " ";
+         }
+   }
+}
+
+/// <summary>
+/// Emit the header line.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="moduleName">Name of the module that implements the algorithms (not used).</param>
+/// <param name="pVersion">Version of the module (not used).</param>
+static void csvBeginList(EMITTER_STATE* const pState, const PCHAR moduleName, const MODULE_VERSION* const pVersion) {
+   (void)moduleName;
+   (void)pVersion;
+
+   OutputString(pState->pOutput, CSV_HEADER);
+}
+
+/// <summary>
+/// Emit the start of an operation type. Each line has the operation type, so there is nothing to emit.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+static void csvBeginType(EMITTER_STATE* const pState, const ULONG operationType) {
+   (void)pState;
+   (void)operationType;
+}
+
+/// <summary>
+/// Emit the line of one algorithm.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pAlgorithm">Algorithm identifier from the enumeration.</param>
+/// <param name="pDetails">Capabilities of the algorithm or NULL, if it was not probed.</param>
+static void csvEmitAlgorithm(EMITTER_STATE* const pState,
+                             const ULONG operationType,
+                             const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm,
+                             const ALGORITHM_DETAILS* const pDetails) {
+   OUTPUT_BUFFER* pOutput = pState->pOutput;
+
+   OutputString(pOutput, OperationTypeId(operationType));
+   OutputChar(pOutput, ',');
+   outputCsvString(pOutput, pAlgorithm->pszName);
+   outputNumberField(pOutput, pAlgorithm->dwClass);
+   outputNumberField(pOutput, pAlgorithm->dwFlags);
+
+   if (pDetails != NULL)
+      outputDetails(pOutput, pDetails);
+   else
+      OutputString(pOutput, ",,,,,,,,");
+
+   OutputChar(pOutput, '\n');
+}
+
+/// <summary>
+/// Emit the end of an operation type. There is nothing to emit.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void csvEndType(EMITTER_STATE* const pState) {
+   (void)pState;
+}
+
+/// <summary>
+/// Emit the end of the list. There is nothing to emit.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void csvEndList(EMITTER_STATE* const pState) {
+   (void)pState;
+}
+
+// ******** Private constants ********
+
+/// The CSV emitter.
+static const LIST_EMITTER csvEmitter = {
+   csvBeginList,
+   csvBeginType,
+   csvEmitAlgorithm,
+   csvEndType,
+   csvEndList
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the CSV emitter.
+/// Lines end with a line feed. On Windows the C runtime writes it as carriage return and line feed.
+/// </summary>
+/// <returns>Pointer to the emitter.</returns>
+const LIST_EMITTER* GetCsvEmitter(void) {
+   return &csvEmitter;
+}
@@ -0,0 +1,336 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: List the files of a directory.
+//    2026-10-16: V1.2.0: Sorted paths of the files of a directory.
+//
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FileMapping.h"
+
+// ******** Private constants ********
+
+/// Initial capacity of a path list.
+#define INITIAL_PATH_CAPACITY 256
+
+// ******** Private methods ********
+
+/// <summary>
+/// Add the path of a file to a path list.
+/// </summary>
+/// <param name="context">Path list.</param>
+/// <param name="fileName">Name of the file in the directory.</param>
+/// <returns>TRUE, if the path was added, FALSE if there is not enough memory.</returns>
+static BOOL addPath(PVOID const context, const char* const fileName) {
+   const PCHAR functionName = "addPath";
+
+   DIRECTORY_PATHS* pPaths = context;
+
+   // 1. Make room for one more path.
+   if (pPaths->count == pPaths->capacity) {
+      ULONG newCapacity = (pPaths->capacity != 0) ? pPaths->capacity * 2 : INITIAL_PATH_CAPACITY;
+      char** pNewPaths;
+      if (pPaths->pPaths == NULL)
+         pNewPaths = HeapAlloc(pPaths->hHeap, 0, newCapacity * sizeof(char*));
+      else
+         pNewPaths = HeapReAlloc(pPaths->hHeap, 0, pPaths->pPaths, newCapacity * sizeof(char*));
+
+      if (pNewPaths == NULL) {
+         fprintf(stderr, "Function \"%s\": HeapAlloc for path list failed.\n", functionName);
+         pPaths->hasError = TRUE;
+         return FALSE;
+      }
+
+      pPaths->pPaths = pNewPaths;
+      pPaths->capacity = newCapacity;
+   }
+
+   // 2. Build the path from the directory and the file name.
+   size_t nameLength = strlen(fileName);
+   char* path = HeapAlloc(pPaths->hHeap, 0, pPaths->directoryLength + nameLength + 1);
+   if (path == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for path failed.\n", functionName);
+      pPaths->hasError = TRUE;
+      return FALSE;
+   }
+
+   memcpy(path, pPaths->directoryPath, pPaths->directoryLength - 1);
+   path[pPaths->directoryLength - 1] = PATH_SEPARATOR;
+   memcpy(path + pPaths->directoryLength, fileName, nameLength + 1);
+
+   pPaths->pPaths[pPaths->count++] = path;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Compare two paths for qsort.
+/// </summary>
+/// <param name="pLeft">Pointer to the left path pointer.</param>
+/// <param name="pRight">Pointer to the right path pointer.</param>
+/// <returns>Result of the comparison.</returns>
+static int comparePaths(const void* const pLeft, const void* const pRight) {
+   return strcmp(*(char* const*)pLeft, *(char* const*)pRight);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Map a file read-only into memory.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="pMappedFile">Pointer to the structure that receives the mapping.</param>
+/// <returns>TRUE, if the file could be mapped, FALSE if not. An empty file is mapped with a NULL data pointer.</returns>
+BOOL MapFile(const char* const path, MAPPED_FILE* const pMappedFile) {
+   memset(pMappedFile, 0, sizeof(MAPPED_FILE));
+
+#ifdef _WIN32
+   HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+   if (hFile == INVALID_HANDLE_VALUE)
+      return FALSE;
+
+   LARGE_INTEGER fileSize;
+   if (GetFileSizeEx(hFile, &fileSize) == FALSE || (uint64_t)fileSize.QuadPart > SIZE_MAX) {
+      CloseHandle(hFile);
+      return FALSE;
+   }
+
+   if (fileSize.QuadPart == 0) {
+      CloseHandle(hFile);
+      return TRUE;
+   }
+
+   // The view keeps the mapping alive, so both handles can be closed right away.
+   HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+   CloseHandle(hFile);
+   if (hMapping == NULL)
+      return FALSE;
+
+   const UCHAR* pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+   CloseHandle(hMapping);
+   if (pData == NULL)
+      return FALSE;
+
+   pMappedFile->pData = pData;
+   pMappedFile->size = (size_t)fileSize.QuadPart;
+#else
+   int fd = open(path, O_RDONLY);
+   if (fd < 0)
+      return FALSE;
+
+   struct stat fileStatus;
+   if (fstat(fd, &fileStatus) != 0 || (uint64_t)fileStatus.st_size > SIZE_MAX) {
+      close(fd);
+      return FALSE;
+   }
+
+   if (fileStatus.st_size == 0) {
+      close(fd);
+      return TRUE;
+   }
+
+   // The mapping stays valid after the file is closed.
+   void* pData = mmap(NULL, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (pData == MAP_FAILED)
+      return FALSE;
+
+   pMappedFile->pData = pData;
+   pMappedFile->size = (size_t)fileStatus.st_size;
+#endif
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release a file mapping.
+/// </summary>
+/// <param name="pMappedFile">Mapping created with MapFile.</param>
+void UnmapFile(MAPPED_FILE* const pMappedFile) {
+   if (pMappedFile->pData != NULL) {
+#ifdef _WIN32
+      UnmapViewOfFile(pMappedFile->pData);
+#else
+      munmap((void*)pMappedFile->pData, pMappedFile->size);
+#endif
+   }
+
+   pMappedFile->pData = NULL;
+   pMappedFile->size = 0;
+}
+
+/// <summary>
+/// Get the time of the last modification and the size of a file.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="pStamp">Pointer to the structure that receives the file stamp.</param>
+/// <returns>TRUE, if the file stamp could be determined, FALSE if not.</returns>
+BOOL GetFileStamp(const char* const path, FILE_STAMP* const pStamp) {
+#ifdef _WIN32
+   WIN32_FILE_ATTRIBUTE_DATA attributes;
+   if (GetFileAttributesExA(path, GetFileExInfoStandard, &attributes) == FALSE)
+      return FALSE;
+
+   pStamp->lastWriteTime = ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+   pStamp->size = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+#else
+   struct stat fileStatus;
+   if (stat(path, &fileStatus) != 0)
+      return FALSE;
+
+   pStamp->lastWriteTime = (uint64_t)fileStatus.st_mtim.tv_sec * 1000000000ULL + (uint64_t)fileStatus.st_mtim.tv_nsec;
+   pStamp->size = (uint64_t)fileStatus.st_size;
+#endif
+
+   return TRUE;
+}
+
+/// <summary>
+/// Replace a file by another file in one step, so that readers see either the old or the new file.
+/// </summary>
+/// <param name="sourcePath">Path of the new file.</param>
+/// <param name="destinationPath">Path of the file to replace.</param>
+/// <returns>TRUE, if the file was replaced, FALSE if not.</returns>
+BOOL ReplaceFileAtomically(const char* const sourcePath, const char* const destinationPath) {
+#ifdef _WIN32
+   return MoveFileExA(sourcePath, destinationPath, MOVEFILE_REPLACE_EXISTING);
+#else
+   return (rename(sourcePath, destinationPath) == 0);
+#endif
+}
+
+/// <summary>
+/// Call a function for each regular file of a directory.
+/// Hidden files, i.e. files whose name starts with a '.', are skipped.
+/// </summary>
+/// <param name="directoryPath">Path of the directory.</param>
+/// <param name="fileNameFunction">Function that is called with the name of each file. It stops the listing by returning FALSE.</param>
+/// <param name="context">Context for the function.</param>
+/// <returns>TRUE, if the directory could be read, FALSE if not.</returns>
+BOOL ListDirectory(const char* const directoryPath, const FILE_NAME_FUNCTION fileNameFunction, PVOID const context) {
+#ifdef _WIN32
+   char pattern[MAX_PATH];
+   int patternLength = snprintf(pattern, sizeof(pattern), "%s\\*", directoryPath);
+   if (patternLength < 0 || (size_t)patternLength >= sizeof(pattern))
+      return FALSE;
+
+   WIN32_FIND_DATAA findData;
+   HANDLE hFind = FindFirstFileA(pattern, &findData);
+   if (hFind == INVALID_HANDLE_VALUE)
+      return (GetLastError() == ERROR_FILE_NOT_FOUND);
+
+   do {
+      if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0 &&
+          findData.cFileName[0] != '.' &&
+          fileNameFunction(context, findData.cFileName) == FALSE)
+         break;
+   } while (FindNextFileA(hFind, &findData) != FALSE);
+
+   FindClose(hFind);
+#else
+   DIR* pDirectory = opendir(directoryPath);
+   if (pDirectory == NULL)
+      return FALSE;
+
+   int directoryFd = dirfd(pDirectory);
+   struct dirent* pEntry;
+   while ((pEntry = readdir(pDirectory)) != NULL) {
+      if (pEntry->d_name[0] == '.')
+         continue;
+
+      // Some file systems do not report the type in the directory entry.
+      BOOL isRegular;
+      if (pEntry->d_type == DT_UNKNOWN) {
+         struct stat fileStatus;
+         isRegular = (fstatat(directoryFd, pEntry->d_name, &fileStatus, 0) == 0 && S_ISREG(fileStatus.st_mode));
+      }
+      else
+         isRegular = (pEntry->d_type == DT_REG);
+
+      if (isRegular != FALSE && fileNameFunction(context, pEntry->d_name) == FALSE)
+         break;
+   }
+
+   closedir(pDirectory);
+#endif
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the paths of the regular files of a directory sorted by name.
+/// Hidden files, i.e. files whose name starts with a '.', are skipped.
+/// </summary>
+/// <param name="directoryPath">Path of the directory.</param>
+/// <param name="hHeap">Heap for the paths.</param>
+/// <param name="pPaths">Pointer to the structure that receives the paths.</param>
+/// <returns>TRUE, if the directory could be read, FALSE if not.</returns>
+BOOL GetDirectoryPaths(const char* const directoryPath, const HANDLE hHeap, DIRECTORY_PATHS* const pPaths) {
+   memset(pPaths, 0, sizeof(DIRECTORY_PATHS));
+   pPaths->hHeap = hHeap;
+   pPaths->directoryPath = directoryPath;
+   pPaths->directoryLength = strlen(directoryPath) + 1;
+
+   if (ListDirectory(directoryPath, addPath, pPaths) == FALSE || pPaths->hasError != FALSE) {
+      if (pPaths->hasError == FALSE)
+         fprintf(stderr, "Directory \"%s\" could not be read.\n", directoryPath);
+
+      FreeDirectoryPaths(pPaths);
+      return FALSE;
+   }
+
+   if (pPaths->count != 0)
+      qsort(pPaths->pPaths, pPaths->count, sizeof(char*), comparePaths);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release the paths of a directory.
+/// </summary>
+/// <param name="pPaths">Paths from GetDirectoryPaths.</param>
+void FreeDirectoryPaths(DIRECTORY_PATHS* const pPaths) {
+   for (ULONG i = 0; i < pPaths->count; i++)
+      HeapFree(pPaths->hHeap, 0, pPaths->pPaths[i]);
+
+   if (pPaths->pPaths != NULL)
+      HeapFree(pPaths->hHeap, 0, pPaths->pPaths);
+
+   pPaths->pPaths = NULL;
+   pPaths->count = 0;
+   pPaths->capacity = 0;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Platform.h"
+
+/// Separator of the directory names in a path.
+#ifdef _WIN32
+#define PATH_SEPARATOR '\\'
+#else
+#define PATH_SEPARATOR '/'
+#endif
+
+/// <summary>
+/// Function that is called for each file of a directory.
+/// </summary>
+/// <param name="context">Context of the caller.</param>
+/// <param name="fileName">Name of the file without the directory.</param>
+/// <returns>TRUE, if the listing should continue, FALSE if it should stop.</returns>
+typedef BOOL (*FILE_NAME_FUNCTION)(PVOID const context, const char* const fileName);
+
+/// <summary>
+/// Sorted paths of the files of a directory.
+/// </summary>
+typedef struct _DIRECTORY_PATHS {
+   /// Heap of the paths.
+   HANDLE hHeap;
+
+   /// Path of the directory.
+   const char* directoryPath;
+
+   /// Length of the directory path including the separator, i.e. the offset of the file names in the paths.
+   size_t directoryLength;
+
+   /// Paths.
+   char** pPaths;
+
+   /// Number of paths.
+   ULONG count;
+
+   /// Number of allocated path pointers.
+   ULONG capacity;
+
+   /// TRUE, if there was not enough memory.
+   BOOL hasError;
+} DIRECTORY_PATHS;
+
+/// <summary>
+/// File that is mapped read-only into memory.
+/// </summary>
+typedef struct _MAPPED_FILE {
+   /// Content of the file. NULL, if the file is empty.
+   const UCHAR* pData;
+
+   /// Size of the file in bytes.
+   size_t size;
+} MAPPED_FILE;
+
+/// <summary>
+/// Properties of a file that change, when the file is replaced.
+/// </summary>
+typedef struct _FILE_STAMP {
+   /// Time of the last modification in a platform specific unit.
+   uint64_t lastWriteTime;
+
+   /// Size of the file in bytes.
+   uint64_t size;
+} FILE_STAMP;
+
+/// <summary>
+/// Map a file read-only into memory.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="pMappedFile">Pointer to the structure that receives the mapping.</param>
+/// <returns>TRUE, if the file could be mapped, FALSE if not. An empty file is mapped with a NULL data pointer.</returns>
+BOOL MapFile(const char* const path, MAPPED_FILE* const pMappedFile);
+
+/// <summary>
+/// Release a file mapping.
+/// </summary>
+/// <param name="pMappedFile">Mapping created with MapFile.</param>
+void UnmapFile(MAPPED_FILE* const pMappedFile);
+
+/// <summary>
+/// Get the time of the last modification and the size of a file.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="pStamp">Pointer to the structure that receives the file stamp.</param>
+/// <returns>TRUE, if the file stamp could be determined, FALSE if not.</returns>
+BOOL GetFileStamp(const char* const path, FILE_STAMP* const pStamp);
+
+/// <summary>
+/// Replace a file by another file in one step, so that readers see either the old or the new file.
+/// </summary>
+/// <param name="sourcePath">Path of the new file.</param>
+/// <param name="destinationPath">Path of the file to replace.</param>
+/// <returns>TRUE, if the file was replaced, FALSE if not.</returns>
+BOOL ReplaceFileAtomically(const char* const sourcePath, const char* const destinationPath);
+
+/// <summary>
+/// Call a function for each regular file of a directory.
+/// Hidden files, i.e. files whose name starts with a '.', are skipped.
+/// </summary>
+/// <param name="directoryPath">Path of the directory.</param>
+/// <param name="fileNameFunction">Function that is called with the name of each file. It stops the listing by returning FALSE.</param>
+/// <param name="context">Context for the function.</param>
+/// <returns>TRUE, if the directory could be read, FALSE if not.</returns>
+BOOL ListDirectory(const char* const directoryPath, const FILE_NAME_FUNCTION fileNameFunction, PVOID const context);
+
+/// <summary>
+/// Get the paths of the regular files of a directory sorted by name.
+/// Hidden files, i.e. files whose name starts with a '.', are skipped.
+/// </summary>
+/// <param name="directoryPath">Path of the directory.</param>
+/// <param name="hHeap">Heap for the paths.</param>
+/// <param name="pPaths">Pointer to the structure that receives the paths.</param>
+/// <returns>TRUE, if the directory could be read, FALSE if not.</returns>
+BOOL GetDirectoryPaths(const char* const directoryPath, const HANDLE hHeap, DIRECTORY_PATHS* const pPaths);
+
+/// <summary>
+/// Release the paths of a directory.
+/// </summary>
+/// <param name="pPaths">Paths from GetDirectoryPaths.</param>
+void FreeDirectoryPaths(DIRECTORY_PATHS* const pPaths);
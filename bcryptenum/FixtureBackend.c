@@ -0,0 +1,1703 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.4.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Replay algorithm capabilities.
+//    2026-10-16: V1.2.0: Use the snapshot file stamp as module file stamp.
+//    2026-10-16: V1.3.0: Replay and record providers and configuration contexts.
+//    2026-10-16: V1.4.0: Re-read a changed snapshot file on refresh.
+//
+
+//
+// A snapshot file is a UTF-8 text file with one entry per line:
+//
+//    # Comment
+//    module <module name> <major>.<minor>.<build>.<revision>
+//    <operations> <class> <flags> <algorithm name>
+//    details <algorithm name> [status=<n>] [keylengths=<min>:<max>:<increment>] [blocklength=<n>]
+//            [hashlength=<n>] [objectlength=<n>] [modes=<mode>,...]
+//    provider <user mode image> <provider name>
+//    registration <interface> <function> <provider name>
+//    context <context name> <interface> <function> <provider name>
+//
+// "operations" is the bit mask of all BCRYPT_*_OPERATION types the algorithm was listed under,
+// "class" and "flags" are the dwClass and dwFlags values of the BCRYPT_ALGORITHM_IDENTIFIER.
+// "details" lines are optional. They hold the capabilities that are returned when an algorithm is opened.
+// "provider" lines list the registered providers, "registration" lines the functions, i.e. algorithms,
+// a provider registered for a BCRYPT_*_INTERFACE. "context" lines are the provider chains of the
+// functions in a configuration context of the local table. The providers of a chain are listed in the
+// order of their priority. Image, context and function names must not contain blanks. An image name
+// of "-" means that the provider has no user mode image.
+// All numbers may be written in decimal or in hexadecimal with a "0x" prefix.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AlgorithmBackend.h"
+#include "AlgorithmProbe.h"
+#include "ApiErrorHandler.h"
+#include "ListEmitter.h"
+#include "Utf8.h"
+
+// ******** Private constants ********
+
+/// Maximum length of an UTF-8 encoded algorithm name in a snapshot file.
+#define NAME_BUFFER_SIZE 1024
+
+/// Header line of a snapshot file.
+#define SNAPSHOT_HEADER "# bcryptenum snapshot 1\n"
+
+/// Keyword of the module version line.
+#define MODULE_KEYWORD "module"
+
+/// Keyword of the details line.
+#define DETAILS_KEYWORD "details"
+
+/// Keyword of the provider line.
+#define PROVIDER_KEYWORD "provider"
+
+/// Keyword of the registration line.
+#define REGISTRATION_KEYWORD "registration"
+
+/// Keyword of the context line.
+#define CONTEXT_KEYWORD "context"
+
+/// Image name of a provider without user mode image.
+#define NO_IMAGE_NAME "-"
+
+/// Module that the snapshot version belongs to.
+#define SNAPSHOT_MODULE_NAME "bcrypt.dll"
+
+// ******** Private types ********
+
+/// <summary>
+/// Algorithm recorded in a snapshot.
+/// </summary>
+typedef struct _FIXTURE_ALGORITHM {
+   LPWSTR name;
+   ULONG operations;
+   ULONG algorithmClass;
+   ULONG flags;
+   BOOL hasDetails;
+   ALGORITHM_DETAILS details;
+} FIXTURE_ALGORITHM;
+
+/// <summary>
+/// Provider recorded in a snapshot.
+/// </summary>
+typedef struct _FIXTURE_PROVIDER {
+   LPWSTR name;
+   LPWSTR image;
+} FIXTURE_PROVIDER;
+
+/// <summary>
+/// Function of a provider recorded in a snapshot.
+/// </summary>
+typedef struct _FIXTURE_REGISTRATION {
+   LPWSTR provider;
+   ULONG interfaceId;
+   LPWSTR function;
+} FIXTURE_REGISTRATION;
+
+/// <summary>
+/// Provider of a function in a configuration context recorded in a snapshot.
+/// </summary>
+typedef struct _FIXTURE_CONTEXT_ENTRY {
+   LPWSTR context;
+   ULONG interfaceId;
+   LPWSTR function;
+   LPWSTR provider;
+} FIXTURE_CONTEXT_ENTRY;
+
+/// <summary>
+/// Data of a loaded snapshot.
+/// </summary>
+typedef struct _FIXTURE {
+   ALGORITHM_BACKEND backend;
+   HANDLE hHeap;
+   const char* snapshotPath;
+   BOOL hasVersion;
+   MODULE_VERSION version;
+   BOOL hasStamp;
+   FILE_STAMP stamp;
+   ULONG algorithmCount;
+   FIXTURE_ALGORITHM* pAlgorithms;
+   FIXTURE_ALGORITHM** ppByName;
+   ULONG providerCount;
+   FIXTURE_PROVIDER* pProviders;
+   ULONG registrationCount;
+   FIXTURE_REGISTRATION* pRegistrations;
+   ULONG contextEntryCount;
+   FIXTURE_CONTEXT_ENTRY* pContextEntries;
+   wchar_t* pNamePool;
+} FIXTURE;
+
+/// <summary>
+/// Entry of the algorithm list that is written to a snapshot.
+/// </summary>
+typedef struct _SNAPSHOT_ENTRY {
+   LPWSTR name;
+   ULONG operations;
+   ULONG algorithmClass;
+   ULONG flags;
+} SNAPSHOT_ENTRY;
+
+/// <summary>
+/// Position of a details line in a snapshot file.
+/// </summary>
+typedef struct _DETAILS_LINE {
+   const char* text;
+   size_t lineNumber;
+} DETAILS_LINE;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Skip blanks and tabs.
+/// </summary>
+/// <param name="p">Pointer into a line.</param>
+/// <returns>Pointer to the first non-blank character.</returns>
+static const char* skipBlanks(const char* p) {
+   while (*p == ' ' || *p == '\t')
+      p++;
+
+   return p;
+}
+
+/// <summary>
+/// Parse an unsigned number.
+/// </summary>
+/// <param name="ppText">Pointer to the text pointer. It is advanced past the number.</param>
+/// <param name="pValue">Pointer to the variable that receives the value.</param>
+/// <returns>TRUE, if a number was found, FALSE if not.</returns>
+static BOOL parseNumber(const char** const ppText, ULONG* const pValue) {
+   const char* pStart = skipBlanks(*ppText);
+   char* pEnd;
+   unsigned long value = strtoul(pStart, &pEnd, 0);
+   if (pEnd == pStart)
+      return FALSE;
+
+   *pValue = (ULONG)value;
+   *ppText = pEnd;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Parse a version "major.minor.build.revision".
+/// </summary>
+/// <param name="text">Text of the version.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the version is valid, FALSE if not.</returns>
+static BOOL parseVersion(const char* text, MODULE_VERSION* const pVersion) {
+   ULONG parts[4];
+
+   for (int i = 0; i < 4; i++) {
+      if (i > 0) {
+         if (*text != '.')
+            return FALSE;
+
+         text++;
+      }
+
+      if (parseNumber(&text, &parts[i]) == FALSE || parts[i] > 0xffff)
+         return FALSE;
+   }
+
+   pVersion->major = (USHORT)parts[0];
+   pVersion->minor = (USHORT)parts[1];
+   pVersion->build = (USHORT)parts[2];
+   pVersion->revision = (USHORT)parts[3];
+
+   return TRUE;
+}
+
+/// <summary>
+/// Check, if a line starts with a keyword that is followed by a blank.
+/// </summary>
+/// <param name="p">Start of the line.</param>
+/// <param name="keyword">Keyword.</param>
+/// <returns>Pointer to the text after the keyword or NULL, if the line does not start with the keyword.</returns>
+static const char* skipKeyword(const char* const p, const char* const keyword) {
+   size_t keywordLength = strlen(keyword);
+   if (strncmp(p, keyword, keywordLength) != 0 || p[keywordLength] != ' ')
+      return NULL;
+
+   return p + keywordLength + 1;
+}
+
+/// <summary>
+/// Get the next word of a line.
+/// </summary>
+/// <param name="ppText">Pointer to the text pointer. It is advanced past the word.</param>
+/// <param name="pLength">Pointer to the variable that receives the length of the word.</param>
+/// <returns>Pointer to the word or NULL, if there is no word.</returns>
+static const char* nextWord(const char** const ppText, size_t* const pLength) {
+   const char* pWord = skipBlanks(*ppText);
+   const char* pEnd = pWord;
+   while (*pEnd != 0 && *pEnd != ' ' && *pEnd != '\t')
+      pEnd++;
+
+   if (pEnd == pWord)
+      return NULL;
+
+   *pLength = (size_t)(pEnd - pWord);
+   *ppText = pEnd;
+
+   return pWord;
+}
+
+/// <summary>
+/// Decode an UTF-8 name into the name pool.
+/// </summary>
+/// <param name="ppNextName">Pointer to the next free position of the name pool. It is advanced past the name.</param>
+/// <param name="text">UTF-8 name.</param>
+/// <param name="length">Length of the name in bytes.</param>
+/// <returns>Pointer to the decoded name.</returns>
+static LPWSTR decodeName(wchar_t** const ppNextName, const char* const text, const size_t length) {
+   LPWSTR name = *ppNextName;
+   *ppNextName += DecodeUtf8(text, length, name, length + 1) + 1;
+
+   return name;
+}
+
+/// <summary>
+/// Parse the provider, registration and context lines.
+/// </summary>
+/// <param name="pFixture">Fixture.</param>
+/// <param name="p">Start of the line.</param>
+/// <param name="ppNextName">Pointer to the next free position of the name pool.</param>
+/// <param name="pIsProviderLine">Pointer to the variable that receives TRUE, if the line is one of these lines.</param>
+/// <returns>TRUE, if the line is valid or not one of these lines, FALSE if it is invalid.</returns>
+static BOOL parseProviderLine(FIXTURE* const pFixture, const char* p, wchar_t** const ppNextName, BOOL* const pIsProviderLine) {
+   const char* pWords[2];
+   size_t wordLengths[2];
+   ULONG interfaceId;
+
+   *pIsProviderLine = TRUE;
+
+   const char* pRest;
+   if ((pRest = skipKeyword(p, PROVIDER_KEYWORD)) != NULL) {
+      // provider <image> <provider name>
+      if ((pWords[0] = nextWord(&pRest, &wordLengths[0])) == NULL || *(pRest = skipBlanks(pRest)) == 0)
+         return FALSE;
+
+      FIXTURE_PROVIDER* pProvider = pFixture->pProviders + pFixture->providerCount++;
+      pProvider->image = decodeName(ppNextName, pWords[0], wordLengths[0]);
+      pProvider->name = decodeName(ppNextName, pRest, strlen(pRest));
+   } else if ((pRest = skipKeyword(p, REGISTRATION_KEYWORD)) != NULL) {
+      // registration <interface> <function> <provider name>
+      if (parseNumber(&pRest, &interfaceId) == FALSE ||
+          (pWords[0] = nextWord(&pRest, &wordLengths[0])) == NULL ||
+          *(pRest = skipBlanks(pRest)) == 0)
+         return FALSE;
+
+      FIXTURE_REGISTRATION* pRegistration = pFixture->pRegistrations + pFixture->registrationCount++;
+      pRegistration->interfaceId = interfaceId;
+      pRegistration->function = decodeName(ppNextName, pWords[0], wordLengths[0]);
+      pRegistration->provider = decodeName(ppNextName, pRest, strlen(pRest));
+   } else if ((pRest = skipKeyword(p, CONTEXT_KEYWORD)) != NULL) {
+      // context <context name> <interface> <function> <provider name>
+      if ((pWords[0] = nextWord(&pRest, &wordLengths[0])) == NULL ||
+          parseNumber(&pRest, &interfaceId) == FALSE ||
+          (pWords[1] = nextWord(&pRest, &wordLengths[1])) == NULL ||
+          *(pRest = skipBlanks(pRest)) == 0)
+         return FALSE;
+
+      FIXTURE_CONTEXT_ENTRY* pEntry = pFixture->pContextEntries + pFixture->contextEntryCount++;
+      pEntry->context = decodeName(ppNextName, pWords[0], wordLengths[0]);
+      pEntry->interfaceId = interfaceId;
+      pEntry->function = decodeName(ppNextName, pWords[1], wordLengths[1]);
+      pEntry->provider = decodeName(ppNextName, pRest, strlen(pRest));
+   } else
+      *pIsProviderLine = FALSE;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Find a provider by name.
+/// </summary>
+/// <param name="pFixture">Fixture.</param>
+/// <param name="name">Name of the provider.</param>
+/// <returns>Pointer to the provider or NULL, if there is no provider with this name.</returns>
+static const FIXTURE_PROVIDER* findProvider(const FIXTURE* const pFixture, LPCWSTR const name) {
+   for (ULONG i = 0; i < pFixture->providerCount; i++)
+      if (wcscmp(pFixture->pProviders[i].name, name) == 0)
+         return pFixture->pProviders + i;
+
+   return NULL;
+}
+
+/// <summary>
+/// Compare two fixture algorithms by name.
+/// </summary>
+/// <param name="pLeft">Pointer to the left algorithm pointer.</param>
+/// <param name="pRight">Pointer to the right algorithm pointer.</param>
+/// <returns>Result of comparing the names.</returns>
+static int compareFixtureAlgorithms(const void* pLeft, const void* pRight) {
+   return wcscmp((*(FIXTURE_ALGORITHM* const*)pLeft)->name, (*(FIXTURE_ALGORITHM* const*)pRight)->name);
+}
+
+/// <summary>
+/// Find an algorithm by name.
+/// </summary>
+/// <param name="pFixture">Fixture.</param>
+/// <param name="name">Name of the algorithm.</param>
+/// <returns>Pointer to the algorithm or NULL, if there is no algorithm with this name.</returns>
+static FIXTURE_ALGORITHM* findAlgorithm(const FIXTURE* const pFixture, LPCWSTR const name) {
+   ULONG low = 0;
+   ULONG high = pFixture->algorithmCount;
+
+   while (low < high) {
+      ULONG middle = low + ((high - low) >> 1);
+      FIXTURE_ALGORITHM* pAlgorithm = pFixture->ppByName[middle];
+      int compareResult = wcscmp(name, pAlgorithm->name);
+      if (compareResult == 0)
+         return pAlgorithm;
+
+      if (compareResult < 0)
+         high = middle;
+      else
+         low = middle + 1;
+   }
+
+   return NULL;
+}
+
+/// <summary>
+/// Parse the chaining modes of a details line.
+/// </summary>
+/// <param name="text">Comma separated list of mode names.</param>
+/// <param name="pModes">Pointer to the variable that receives the CHAINING_MODE_* flags.</param>
+/// <returns>TRUE, if all modes are known, FALSE if not.</returns>
+static BOOL parseChainingModes(const char* text, ULONG* const pModes) {
+   ULONG modes = 0;
+
+   while (*text != 0 && *text != ' ' && *text != '\t') {
+      const CHAINING_MODE* pMode = ChainingModes;
+      int i = CHAINING_MODE_COUNT;
+      for (; i > 0; i--) {
+         size_t nameLength = strlen(pMode->shortName);
+         if (strncmp(text, pMode->shortName, nameLength) == 0 &&
+             (text[nameLength] == ',' || text[nameLength] == ' ' || text[nameLength] == '\t' || text[nameLength] == 0)) {
+            modes |= pMode->flag;
+            text += nameLength;
+            break;
+         }
+
+         pMode++;
+      }
+
+      if (i == 0)
+         return FALSE;
+
+      if (*text == ',')
+         text++;
+   }
+
+   *pModes = modes;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Parse a details line.
+/// </summary>
+/// <param name="pFixture">Fixture with sorted algorithm index.</param>
+/// <param name="p">Text after the keyword.</param>
+/// <param name="path">Path of the file for error messages.</param>
+/// <param name="lineNumber">Line number for error messages.</param>
+/// <returns>TRUE, if the line is valid, FALSE if not.</returns>
+static BOOL parseDetails(FIXTURE* const pFixture, const char* p, const char* const path, const size_t lineNumber) {
+   // 1. Find the algorithm.
+   p = skipBlanks(p);
+   const char* pNameEnd = p;
+   while (*pNameEnd != 0 && *pNameEnd != ' ' && *pNameEnd != '\t')
+      pNameEnd++;
+
+   wchar_t name[NAME_BUFFER_SIZE];
+   DecodeUtf8(p, (size_t)(pNameEnd - p), name, NAME_BUFFER_SIZE);
+   FIXTURE_ALGORITHM* pAlgorithm = findAlgorithm(pFixture, name);
+   if (pAlgorithm == NULL) {
+      fprintf(stderr, "File \"%s\", line %zu: Details for unknown algorithm.\n", path, lineNumber);
+      return FALSE;
+   }
+
+   // 2. Parse the "key=value" fields.
+   ALGORITHM_DETAILS* pDetails = &pAlgorithm->details;
+   memset(pDetails, 0, sizeof(ALGORITHM_DETAILS));
+   p = skipBlanks(pNameEnd);
+   while (*p != 0) {
+      BOOL isValid;
+      ULONG value = 0;
+      if (strncmp(p, "status=", 7) == 0) {
+         p += 7;
+         isValid = parseNumber(&p, &value);
+         pDetails->status = (NTSTATUS)value;
+      } else if (strncmp(p, "keylengths=", 11) == 0) {
+         p += 11;
+         isValid = parseNumber(&p, &pDetails->keyLengths.dwMinLength) &&
+                   *p++ == ':' &&
+                   parseNumber(&p, &pDetails->keyLengths.dwMaxLength) &&
+                   *p++ == ':' &&
+                   parseNumber(&p, &pDetails->keyLengths.dwIncrement);
+         pDetails->validFields |= DETAIL_KEY_LENGTHS;
+      } else if (strncmp(p, "blocklength=", 12) == 0) {
+         p += 12;
+         isValid = parseNumber(&p, &pDetails->blockLength);
+         pDetails->validFields |= DETAIL_BLOCK_LENGTH;
+      } else if (strncmp(p, "hashlength=", 11) == 0) {
+         p += 11;
+         isValid = parseNumber(&p, &pDetails->hashLength);
+         pDetails->validFields |= DETAIL_HASH_LENGTH;
+      } else if (strncmp(p, "objectlength=", 13) == 0) {
+         p += 13;
+         isValid = parseNumber(&p, &pDetails->objectLength);
+         pDetails->validFields |= DETAIL_OBJECT_LENGTH;
+      } else if (strncmp(p, "modes=", 6) == 0) {
+         p += 6;
+         isValid = parseChainingModes(p, &pDetails->chainingModes);
+         while (*p != 0 && *p != ' ' && *p != '\t')
+            p++;
+
+         pDetails->validFields |= DETAIL_CHAINING_MODES;
+      } else
+         isValid = FALSE;
+
+      if (isValid == FALSE) {
+         fprintf(stderr, "File \"%s\", line %zu: Invalid details.\n", path, lineNumber);
+         return FALSE;
+      }
+
+      p = skipBlanks(p);
+   }
+
+   pAlgorithm->hasDetails = TRUE;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Read a complete file into a 0 terminated memory block.
+/// </summary>
+/// <param name="hHeap">Heap to allocate the memory from.</param>
+/// <param name="path">Path of the file.</param>
+/// <param name="pSize">Pointer to the variable that receives the file size.</param>
+/// <returns>Pointer to the file contents or NULL, if the file could not be read.</returns>
+static char* readFile(const HANDLE hHeap, const char* const path, size_t* const pSize) {
+   const PCHAR functionName = "readFile";
+
+   FILE* f;
+   if (fopen_s(&f, path, "rb") != 0) {
+      fprintf(stderr, "Function \"%s\": Could not open file \"%s\".\n", functionName, path);
+      return NULL;
+   }
+
+   fseek(f, 0, SEEK_END);
+   long fileSize = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   if (fileSize < 0) {
+      fprintf(stderr, "Function \"%s\": Could not get size of file \"%s\".\n", functionName, path);
+      fclose(f);
+      return NULL;
+   }
+
+   char* pContent = HeapAlloc(hHeap, 0, (size_t)fileSize + 1);
+   if (pContent == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for file contents failed.\n", functionName);
+      fclose(f);
+      return NULL;
+   }
+
+   size_t readSize = fread(pContent, 1, (size_t)fileSize, f);
+   fclose(f);
+   if (readSize != (size_t)fileSize) {
+      fprintf(stderr, "Function \"%s\": Could not read file \"%s\".\n", functionName, path);
+      HeapFree(hHeap, 0, pContent);
+      return NULL;
+   }
+
+   pContent[fileSize] = 0;
+   *pSize = (size_t)fileSize;
+
+   return pContent;
+}
+
+/// <summary>
+/// Parse the contents of a snapshot file.
+/// </summary>
+/// <param name="pFixture">Fixture to fill.</param>
+/// <param name="pContent">0 terminated file contents.</param>
+/// <param name="contentSize">Size of the file contents.</param>
+/// <param name="path">Path of the file for error messages.</param>
+/// <returns>TRUE, if the snapshot is valid, FALSE if not.</returns>
+static BOOL parseSnapshot(FIXTURE* const pFixture, char* const pContent, const size_t contentSize, const char* const path) {
+   const PCHAR functionName = "parseSnapshot";
+
+   // 1. Count the lines to get an upper bound for the number of algorithms.
+   //    The provider, registration and context lines are counted separately. They are the only lines that start with a 'p', 'r' or 'c'.
+   size_t lineCount = 1;
+   size_t providerLineCount = 0;
+   for (const char* p = pContent; *p != 0; p++) {
+      p = skipBlanks(p);
+      if (*p == 'p' || *p == 'r' || *p == 'c')
+         providerLineCount++;
+
+      p += strcspn(p, "\n");
+      if (*p == 0)
+         break;
+
+      lineCount++;
+   }
+
+   // 2. Allocate the algorithm list and the name pool.
+   //    A name never has more wide characters than UTF-8 bytes.
+   pFixture->pAlgorithms = HeapAlloc(pFixture->hHeap, 0, lineCount * sizeof(FIXTURE_ALGORITHM));
+   pFixture->ppByName = HeapAlloc(pFixture->hHeap, 0, lineCount * sizeof(FIXTURE_ALGORITHM*));
+   pFixture->pNamePool = HeapAlloc(pFixture->hHeap, 0, (contentSize + lineCount) * sizeof(wchar_t));
+   if (pFixture->pAlgorithms == NULL || pFixture->ppByName == NULL || pFixture->pNamePool == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for snapshot data failed.\n", functionName);
+      return FALSE;
+   }
+
+   pFixture->pProviders = HeapAlloc(pFixture->hHeap, 0, (providerLineCount + 1) * sizeof(FIXTURE_PROVIDER));
+   pFixture->pRegistrations = HeapAlloc(pFixture->hHeap, 0, (providerLineCount + 1) * sizeof(FIXTURE_REGISTRATION));
+   pFixture->pContextEntries = HeapAlloc(pFixture->hHeap, 0, (providerLineCount + 1) * sizeof(FIXTURE_CONTEXT_ENTRY));
+   if (pFixture->pProviders == NULL || pFixture->pRegistrations == NULL || pFixture->pContextEntries == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for provider data failed.\n", functionName);
+      return FALSE;
+   }
+
+   DETAILS_LINE* pDetailsLines = HeapAlloc(pFixture->hHeap, 0, lineCount * sizeof(DETAILS_LINE));
+   if (pDetailsLines == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for details lines failed.\n", functionName);
+      return FALSE;
+   }
+
+   // 3. Parse the lines.
+   //    Details lines are only marked, as they can only be assigned, when all algorithms are known.
+   wchar_t* pNextName = pFixture->pNamePool;
+   FIXTURE_ALGORITHM* pAlgorithm = pFixture->pAlgorithms;
+   DETAILS_LINE* pDetailsLine = pDetailsLines;
+   BOOL result = TRUE;
+   size_t lineNumber = 0;
+   char* pLine = pContent;
+   while (*pLine != 0) {
+      lineNumber++;
+
+      char* pLineEnd = strchr(pLine, '\n');
+      char* pNextLine;
+      if (pLineEnd == NULL) {
+         pLineEnd = pLine + strlen(pLine);
+         pNextLine = pLineEnd;
+      } else
+         pNextLine = pLineEnd + 1;
+
+      if (pLineEnd > pLine && pLineEnd[-1] == '\r')
+         pLineEnd--;
+
+      *pLineEnd = 0;
+
+      const char* p = skipBlanks(pLine);
+      if (*p == 0 || *p == '#') {
+         pLine = pNextLine;
+         continue;
+      }
+
+      if (strncmp(p, MODULE_KEYWORD " ", sizeof(MODULE_KEYWORD)) == 0) {
+         // Module line: The version is the last word of the line.
+         const char* pVersionText = strrchr(p, ' ');
+         if (parseVersion(pVersionText + 1, &pFixture->version) == FALSE) {
+            fprintf(stderr, "File \"%s\", line %zu: Invalid module version.\n", path, lineNumber);
+            result = FALSE;
+            break;
+         }
+
+         pFixture->hasVersion = TRUE;
+         pLine = pNextLine;
+         continue;
+      }
+
+      if (strncmp(p, DETAILS_KEYWORD " ", sizeof(DETAILS_KEYWORD)) == 0) {
+         pDetailsLine->text = p + sizeof(DETAILS_KEYWORD);
+         pDetailsLine->lineNumber = lineNumber;
+         pDetailsLine++;
+         pLine = pNextLine;
+         continue;
+      }
+
+      BOOL isProviderLine;
+      if (parseProviderLine(pFixture, p, &pNextName, &isProviderLine) == FALSE) {
+         fprintf(stderr, "File \"%s\", line %zu: Invalid provider entry.\n", path, lineNumber);
+         result = FALSE;
+         break;
+      }
+
+      if (isProviderLine != FALSE) {
+         pLine = pNextLine;
+         continue;
+      }
+
+      if (parseNumber(&p, &pAlgorithm->operations) == FALSE ||
+          parseNumber(&p, &pAlgorithm->algorithmClass) == FALSE ||
+          parseNumber(&p, &pAlgorithm->flags) == FALSE) {
+         fprintf(stderr, "File \"%s\", line %zu: Invalid algorithm entry.\n", path, lineNumber);
+         result = FALSE;
+         break;
+      }
+
+      p = skipBlanks(p);
+      size_t nameLength = (size_t)(pLineEnd - p);
+      if (nameLength == 0) {
+         fprintf(stderr, "File \"%s\", line %zu: Missing algorithm name.\n", path, lineNumber);
+         result = FALSE;
+         break;
+      }
+
+      pAlgorithm->name = decodeName(&pNextName, p, nameLength);
+      pAlgorithm->hasDetails = FALSE;
+      pAlgorithm++;
+
+      pLine = pNextLine;
+   }
+
+   pFixture->algorithmCount = (ULONG)(pAlgorithm - pFixture->pAlgorithms);
+
+   // 4. Build the name index.
+   for (ULONG i = 0; i < pFixture->algorithmCount; i++)
+      pFixture->ppByName[i] = &pFixture->pAlgorithms[i];
+
+   qsort(pFixture->ppByName, pFixture->algorithmCount, sizeof(FIXTURE_ALGORITHM*), compareFixtureAlgorithms);
+
+   // 5. Parse the details lines.
+   if (result != FALSE)
+      for (const DETAILS_LINE* pActLine = pDetailsLines; pActLine < pDetailsLine; pActLine++)
+         if (parseDetails(pFixture, pActLine->text, path, pActLine->lineNumber) == FALSE) {
+            result = FALSE;
+            break;
+         }
+
+   HeapFree(pFixture->hHeap, 0, pDetailsLines);
+
+   // 6. Every registration needs a provider line.
+   if (result != FALSE)
+      for (ULONG i = 0; i < pFixture->registrationCount; i++)
+         if (findProvider(pFixture, pFixture->pRegistrations[i].provider) == NULL) {
+            fprintf(stderr, "File \"%s\": Registration for unknown provider.\n", path);
+            result = FALSE;
+            break;
+         }
+
+   return result;
+}
+
+/// <summary>
+/// Enumerate the algorithms recorded in the snapshot.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="operationMask">Bit mask of BCRYPT_*_OPERATION values.</param>
+/// <param name="pAlgoCount">Pointer to the variable that receives the number of algorithms.</param>
+/// <param name="ppAlgoList">Pointer to the variable that receives the algorithm list.</param>
+/// <returns>NTSTATUS of the enumeration.</returns>
+static NTSTATUS fixtureEnumAlgorithms(PVOID const context,
+                                      const ULONG operationMask,
+                                      ULONG* const pAlgoCount,
+                                      BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList) {
+   const FIXTURE* const pFixture = context;
+
+   ULONG count = 0;
+   const FIXTURE_ALGORITHM* pAlgorithm = pFixture->pAlgorithms;
+   for (ULONG i = pFixture->algorithmCount; i > 0; i--)
+      if ((pAlgorithm++->operations & operationMask) != 0)
+         count++;
+
+   // Always allocate at least one element, so that an empty list is not a NULL pointer.
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList = HeapAlloc(pFixture->hHeap, 0, (count + 1) * sizeof(BCRYPT_ALGORITHM_IDENTIFIER));
+   if (pAlgoList == NULL)
+      return STATUS_NO_MEMORY;
+
+   BCRYPT_ALGORITHM_IDENTIFIER* pActAlgo = pAlgoList;
+   pAlgorithm = pFixture->pAlgorithms;
+   for (ULONG i = pFixture->algorithmCount; i > 0; i--) {
+      if ((pAlgorithm->operations & operationMask) != 0) {
+         pActAlgo->pszName = pAlgorithm->name;
+         pActAlgo->dwClass = pAlgorithm->algorithmClass;
+         pActAlgo->dwFlags = pAlgorithm->flags;
+         pActAlgo++;
+      }
+
+      pAlgorithm++;
+   }
+
+   *pAlgoCount = count;
+   *ppAlgoList = pAlgoList;
+
+   return 0;
+}
+
+/// <summary>
+/// Release a list returned by one of the fixture functions.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="pBuffer">Buffer to release.</param>
+static void fixtureFreeBuffer(PVOID const context, PVOID const pBuffer) {
+   const FIXTURE* const pFixture = context;
+
+   HeapFree(pFixture->hHeap, 0, pBuffer);
+}
+
+/// <summary>
+/// Get the module version recorded in the snapshot.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="moduleName">Name of the module.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the snapshot contains a version, FALSE if not.</returns>
+static BOOL fixtureGetModuleVersion(PVOID const context, const PCHAR moduleName, MODULE_VERSION* const pVersion) {
+   const FIXTURE* const pFixture = context;
+
+   if (pFixture->hasVersion == FALSE) {
+      fprintf(stderr, "Snapshot contains no version for module \"%s\".\n", moduleName);
+      return FALSE;
+   }
+
+   *pVersion = pFixture->version;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the file stamp of the snapshot file. It stands in for the module file.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="moduleName">Name of the module (unused).</param>
+/// <param name="pStamp">Pointer to the file stamp to fill.</param>
+/// <returns>TRUE, if the file stamp of the snapshot is known, FALSE if not.</returns>
+static BOOL fixtureGetModuleStamp(PVOID const context, const PCHAR moduleName, FILE_STAMP* const pStamp) {
+   (void)moduleName;
+
+   const FIXTURE* const pFixture = context;
+
+   if (pFixture->hasStamp == FALSE)
+      return FALSE;
+
+   *pStamp = pFixture->stamp;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Open a recorded algorithm.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+/// <returns>Recorded status of opening the algorithm or STATUS_NOT_FOUND, if the algorithm is unknown.</returns>
+static NTSTATUS fixtureOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm) {
+   const FIXTURE* const pFixture = context;
+
+   FIXTURE_ALGORITHM* pAlgorithm = findAlgorithm(pFixture, algorithmName);
+   if (pAlgorithm == NULL)
+      return STATUS_NOT_FOUND;
+
+   if (pAlgorithm->hasDetails != FALSE && pAlgorithm->details.status < 0)
+      return pAlgorithm->details.status;
+
+   // The handle is just the pointer to the algorithm. Its data is never changed.
+   *phAlgorithm = pAlgorithm;
+
+   return 0;
+}
+
+/// <summary>
+/// Copy a property value into the output buffer.
+/// </summary>
+/// <param name="pValue">Property value.</param>
+/// <param name="valueLength">Size of the property value.</param>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="outputLength">Size of the output buffer.</param>
+/// <param name="pResultLength">Pointer to the variable that receives the size of the property value.</param>
+/// <returns>NTSTATUS of the copy.</returns>
+static NTSTATUS copyProperty(const void* const pValue,
+                             const ULONG valueLength,
+                             PUCHAR const pOutput,
+                             const ULONG outputLength,
+                             ULONG* const pResultLength) {
+   *pResultLength = valueLength;
+   if (outputLength < valueLength)
+      return STATUS_INVALID_PARAMETER;
+
+   memcpy(pOutput, pValue, valueLength);
+
+   return 0;
+}
+
+/// <summary>
+/// Get a recorded property.
+/// </summary>
+/// <param name="context">Fixture (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="property">Name of the property.</param>
+/// <param name="pOutput">Buffer that receives the property value.</param>
+/// <param name="outputLength">Size of the buffer.</param>
+/// <param name="pResultLength">Pointer to the variable that receives the size of the property value.</param>
+/// <returns>NTSTATUS of the query.</returns>
+static NTSTATUS fixtureGetProperty(PVOID const context,
+                                   BCRYPT_ALG_HANDLE const hAlgorithm,
+                                   LPCWSTR const property,
+                                   PUCHAR const pOutput,
+                                   const ULONG outputLength,
+                                   ULONG* const pResultLength) {
+   (void)context;
+
+   const FIXTURE_ALGORITHM* const pAlgorithm = hAlgorithm;
+   const ALGORITHM_DETAILS* const pDetails = &pAlgorithm->details;
+   ULONG validFields = (pAlgorithm->hasDetails != FALSE) ? pDetails->validFields : 0;
+
+   if (wcscmp(property, BCRYPT_KEY_LENGTHS) == 0 && (validFields & DETAIL_KEY_LENGTHS) != 0)
+      return copyProperty(&pDetails->keyLengths, sizeof(BCRYPT_KEY_LENGTHS_STRUCT), pOutput, outputLength, pResultLength);
+
+   if (wcscmp(property, BCRYPT_BLOCK_LENGTH) == 0 && (validFields & DETAIL_BLOCK_LENGTH) != 0)
+      return copyProperty(&pDetails->blockLength, sizeof(ULONG), pOutput, outputLength, pResultLength);
+
+   if (wcscmp(property, BCRYPT_HASH_LENGTH) == 0 && (validFields & DETAIL_HASH_LENGTH) != 0)
+      return copyProperty(&pDetails->hashLength, sizeof(ULONG), pOutput, outputLength, pResultLength);
+
+   if (wcscmp(property, BCRYPT_OBJECT_LENGTH) == 0 && (validFields & DETAIL_OBJECT_LENGTH) != 0)
+      return copyProperty(&pDetails->objectLength, sizeof(ULONG), pOutput, outputLength, pResultLength);
+
+   return STATUS_NOT_SUPPORTED;
+}
+
+/// <summary>
+/// Set a property. Only chaining modes that have been recorded can be set.
+/// </summary>
+/// <param name="context">Fixture (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="property">Name of the property.</param>
+/// <param name="pInput">Property value.</param>
+/// <param name="inputLength">Size of the property value.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS fixtureSetProperty(PVOID const context,
+                                   BCRYPT_ALG_HANDLE const hAlgorithm,
+                                   LPCWSTR const property,
+                                   PUCHAR const pInput,
+                                   const ULONG inputLength) {
+   (void)context;
+   (void)inputLength;
+
+   const FIXTURE_ALGORITHM* const pAlgorithm = hAlgorithm;
+   if (pAlgorithm->hasDetails == FALSE || wcscmp(property, BCRYPT_CHAINING_MODE) != 0)
+      return STATUS_NOT_SUPPORTED;
+
+   const CHAINING_MODE* pMode = ChainingModes;
+   for (int i = CHAINING_MODE_COUNT; i > 0; i--) {
+      if (wcscmp((LPCWSTR)pInput, pMode->propertyValue) == 0)
+         return ((pAlgorithm->details.chainingModes & pMode->flag) != 0) ? 0 : STATUS_NOT_SUPPORTED;
+
+      pMode++;
+   }
+
+   return STATUS_NOT_SUPPORTED;
+}
+
+/// <summary>
+/// Close a recorded algorithm. There is nothing to release.
+/// </summary>
+/// <param name="context">Fixture (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle (unused).</param>
+static void fixtureCloseAlgorithm(PVOID const context, BCRYPT_ALG_HANDLE const hAlgorithm) {
+   (void)context;
+   (void)hAlgorithm;
+}
+
+/// <summary>
+/// Allocate a name list like the ones returned by CNG: a header, followed by the name pointers.
+/// The names themselves stay in the name pool of the fixture.
+/// </summary>
+/// <param name="pFixture">Fixture.</param>
+/// <param name="headerSize">Size of the list header.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <param name="pppNames">Pointer to the variable that receives the address of the name pointers.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <returns>Pointer to the list or NULL, if there is not enough memory.</returns>
+static PVOID allocateNameList(const FIXTURE* const pFixture,
+                              const size_t headerSize,
+                              const ULONG nameCount,
+                              LPWSTR** const pppNames,
+                              ULONG* const pBufferSize) {
+   size_t bufferSize = headerSize + (nameCount + 1) * sizeof(LPWSTR);
+   UCHAR* pBuffer = HeapAlloc(pFixture->hHeap, 0, bufferSize);
+   if (pBuffer == NULL)
+      return NULL;
+
+   *pppNames = (LPWSTR*)(pBuffer + headerSize);
+   *pBufferSize = (ULONG)bufferSize;
+
+   return pBuffer;
+}
+
+/// <summary>
+/// Check, if a name is in the first entries of a name list.
+/// </summary>
+/// <param name="pNames">Name list.</param>
+/// <param name="count">Number of names to check.</param>
+/// <param name="name">Name.</param>
+/// <returns>TRUE, if the name is in the list, FALSE if not.</returns>
+static BOOL containsName(LPWSTR const* const pNames, const ULONG count, LPCWSTR const name) {
+   for (ULONG i = 0; i < count; i++)
+      if (wcscmp(pNames[i], name) == 0)
+         return TRUE;
+
+   return FALSE;
+}
+
+/// <summary>
+/// Get the recorded providers.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppProviders">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of the enumeration.</returns>
+static NTSTATUS fixtureEnumProviders(PVOID const context, ULONG* const pBufferSize, PCRYPT_PROVIDERS* const ppProviders) {
+   const FIXTURE* const pFixture = context;
+
+   LPWSTR* pNames;
+   CRYPT_PROVIDERS* pProviders = allocateNameList(pFixture, sizeof(CRYPT_PROVIDERS), pFixture->providerCount, &pNames, pBufferSize);
+   if (pProviders == NULL)
+      return STATUS_NO_MEMORY;
+
+   for (ULONG i = 0; i < pFixture->providerCount; i++)
+      pNames[i] = pFixture->pProviders[i].name;
+
+   pProviders->cProviders = pFixture->providerCount;
+   pProviders->rgpszProviders = pNames;
+   *ppProviders = pProviders;
+
+   return 0;
+}
+
+/// <summary>
+/// Get the recorded user mode registration of a provider for one interface.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="providerName">Name of the provider.</param>
+/// <param name="mode">CRYPT_UM, CRYPT_KM or CRYPT_ANY. Only user mode registrations are recorded.</param>
+/// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the registration.</param>
+/// <param name="ppRegistration">Pointer to the variable that receives the registration.</param>
+/// <returns>NTSTATUS of the query. STATUS_NOT_FOUND, if the provider has no functions for the interface.</returns>
+static NTSTATUS fixtureQueryProviderRegistration(PVOID const context,
+                                                 LPCWSTR const providerName,
+                                                 const ULONG mode,
+                                                 const ULONG interfaceId,
+                                                 ULONG* const pBufferSize,
+                                                 PCRYPT_PROVIDER_REG* const ppRegistration) {
+   const FIXTURE* const pFixture = context;
+
+   // 1. Count the functions.
+   const FIXTURE_PROVIDER* pProvider = findProvider(pFixture, providerName);
+   if (pProvider == NULL || mode == CRYPT_KM)
+      return STATUS_NOT_FOUND;
+
+   ULONG functionCount = 0;
+   for (ULONG i = 0; i < pFixture->registrationCount; i++)
+      if (pFixture->pRegistrations[i].interfaceId == interfaceId && wcscmp(pFixture->pRegistrations[i].provider, providerName) == 0)
+         functionCount++;
+
+   if (functionCount == 0)
+      return STATUS_NOT_FOUND;
+
+   // 2. Build the registration in one block: provider, image, interface pointer, interface and function names.
+   //    All structures contain pointers, so each of them is aligned, when they follow each other.
+   size_t headerSize = sizeof(CRYPT_PROVIDER_REG) + sizeof(CRYPT_IMAGE_REG) + sizeof(PCRYPT_INTERFACE_REG) + sizeof(CRYPT_INTERFACE_REG);
+   LPWSTR* pNames;
+   CRYPT_PROVIDER_REG* pRegistration = allocateNameList(pFixture, headerSize, functionCount, &pNames, pBufferSize);
+   if (pRegistration == NULL)
+      return STATUS_NO_MEMORY;
+
+   CRYPT_IMAGE_REG* pImage = (CRYPT_IMAGE_REG*)(pRegistration + 1);
+   PCRYPT_INTERFACE_REG* ppInterfaces = (PCRYPT_INTERFACE_REG*)(pImage + 1);
+   CRYPT_INTERFACE_REG* pInterface = (CRYPT_INTERFACE_REG*)(ppInterfaces + 1);
+
+   ULONG n = 0;
+   for (ULONG i = 0; i < pFixture->registrationCount; i++)
+      if (pFixture->pRegistrations[i].interfaceId == interfaceId && wcscmp(pFixture->pRegistrations[i].provider, providerName) == 0)
+         pNames[n++] = pFixture->pRegistrations[i].function;
+
+   pInterface->dwInterface = interfaceId;
+   pInterface->dwFlags = 0;
+   pInterface->cFunctions = functionCount;
+   pInterface->rgpszFunctions = pNames;
+
+   *ppInterfaces = pInterface;
+
+   pImage->pszImage = pProvider->image;
+   pImage->cInterfaces = 1;
+   pImage->rgpInterfaces = ppInterfaces;
+
+   pRegistration->cAliases = 0;
+   pRegistration->rgpszAliases = NULL;
+   pRegistration->pUM = pImage;
+   pRegistration->pKM = NULL;
+
+   *ppRegistration = pRegistration;
+
+   return 0;
+}
+
+/// <summary>
+/// Get the recorded configuration contexts. Only the local table is recorded.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppContexts">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of the enumeration.</returns>
+static NTSTATUS fixtureEnumContexts(PVOID const context, const ULONG table, ULONG* const pBufferSize, PCRYPT_CONTEXTS* const ppContexts) {
+   const FIXTURE* const pFixture = context;
+
+   LPWSTR* pNames;
+   CRYPT_CONTEXTS* pContexts = allocateNameList(pFixture, sizeof(CRYPT_CONTEXTS), pFixture->contextEntryCount, &pNames, pBufferSize);
+   if (pContexts == NULL)
+      return STATUS_NO_MEMORY;
+
+   ULONG count = 0;
+   if (table == CRYPT_LOCAL)
+      for (ULONG i = 0; i < pFixture->contextEntryCount; i++)
+         if (containsName(pNames, count, pFixture->pContextEntries[i].context) == FALSE)
+            pNames[count++] = pFixture->pContextEntries[i].context;
+
+   pContexts->cContexts = count;
+   pContexts->rgpszContexts = pNames;
+   *ppContexts = pContexts;
+
+   return 0;
+}
+
+/// <summary>
+/// Get the recorded functions of an interface in a configuration context.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+/// <param name="contextName">Name of the configuration context.</param>
+/// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppFunctions">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of the enumeration. STATUS_NOT_FOUND, if there are no functions.</returns>
+static NTSTATUS fixtureEnumContextFunctions(PVOID const context,
+                                            const ULONG table,
+                                            LPCWSTR const contextName,
+                                            const ULONG interfaceId,
+                                            ULONG* const pBufferSize,
+                                            PCRYPT_CONTEXT_FUNCTIONS* const ppFunctions) {
+   const FIXTURE* const pFixture = context;
+
+   if (table != CRYPT_LOCAL)
+      return STATUS_NOT_FOUND;
+
+   LPWSTR* pNames;
+   CRYPT_CONTEXT_FUNCTIONS* pFunctions = allocateNameList(pFixture, sizeof(CRYPT_CONTEXT_FUNCTIONS), pFixture->contextEntryCount, &pNames, pBufferSize);
+   if (pFunctions == NULL)
+      return STATUS_NO_MEMORY;
+
+   ULONG count = 0;
+   for (ULONG i = 0; i < pFixture->contextEntryCount; i++) {
+      const FIXTURE_CONTEXT_ENTRY* pEntry = pFixture->pContextEntries + i;
+      if (pEntry->interfaceId == interfaceId &&
+          wcscmp(pEntry->context, contextName) == 0 &&
+          containsName(pNames, count, pEntry->function) == FALSE)
+         pNames[count++] = pEntry->function;
+   }
+
+   if (count == 0) {
+      HeapFree(pFixture->hHeap, 0, pFunctions);
+      return STATUS_NOT_FOUND;
+   }
+
+   pFunctions->cFunctions = count;
+   pFunctions->rgpszFunctions = pNames;
+   *ppFunctions = pFunctions;
+
+   return 0;
+}
+
+/// <summary>
+/// Get the recorded provider chain of a function in a configuration context.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="table">CRYPT_LOCAL or CRYPT_DOMAIN.</param>
+/// <param name="contextName">Name of the configuration context.</param>
+/// <param name="interfaceId">BCRYPT_*_INTERFACE identifier.</param>
+/// <param name="functionName">Name of the function.</param>
+/// <param name="pBufferSize">Pointer to the variable that receives the size of the list.</param>
+/// <param name="ppProviders">Pointer to the variable that receives the list.</param>
+/// <returns>NTSTATUS of the enumeration. STATUS_NOT_FOUND, if the function has no providers.</returns>
+static NTSTATUS fixtureEnumContextFunctionProviders(PVOID const context,
+                                                    const ULONG table,
+                                                    LPCWSTR const contextName,
+                                                    const ULONG interfaceId,
+                                                    LPCWSTR const functionName,
+                                                    ULONG* const pBufferSize,
+                                                    PCRYPT_CONTEXT_FUNCTION_PROVIDERS* const ppProviders) {
+   const FIXTURE* const pFixture = context;
+
+   if (table != CRYPT_LOCAL)
+      return STATUS_NOT_FOUND;
+
+   LPWSTR* pNames;
+   CRYPT_CONTEXT_FUNCTION_PROVIDERS* pProviders = allocateNameList(pFixture,
+                                                                   sizeof(CRYPT_CONTEXT_FUNCTION_PROVIDERS),
+                                                                   pFixture->contextEntryCount,
+                                                                   &pNames,
+                                                                   pBufferSize);
+   if (pProviders == NULL)
+      return STATUS_NO_MEMORY;
+
+   ULONG count = 0;
+   for (ULONG i = 0; i < pFixture->contextEntryCount; i++) {
+      const FIXTURE_CONTEXT_ENTRY* pEntry = pFixture->pContextEntries + i;
+      if (pEntry->interfaceId == interfaceId && wcscmp(pEntry->function, functionName) == 0 && wcscmp(pEntry->context, contextName) == 0)
+         pNames[count++] = pEntry->provider;
+   }
+
+   if (count == 0) {
+      HeapFree(pFixture->hHeap, 0, pProviders);
+      return STATUS_NOT_FOUND;
+   }
+
+   pProviders->cProviders = count;
+   pProviders->rgpszProviders = pNames;
+   *ppProviders = pProviders;
+
+   return 0;
+}
+
+/// <summary>
+/// Release all memory of a fixture.
+/// </summary>
+/// <param name="pFixture">Fixture to release.</param>
+static void freeFixture(FIXTURE* const pFixture) {
+   HANDLE hHeap = pFixture->hHeap;
+
+   if (pFixture->pAlgorithms != NULL)
+      HeapFree(hHeap, 0, pFixture->pAlgorithms);
+
+   if (pFixture->ppByName != NULL)
+      HeapFree(hHeap, 0, pFixture->ppByName);
+
+   if (pFixture->pProviders != NULL)
+      HeapFree(hHeap, 0, pFixture->pProviders);
+
+   if (pFixture->pRegistrations != NULL)
+      HeapFree(hHeap, 0, pFixture->pRegistrations);
+
+   if (pFixture->pContextEntries != NULL)
+      HeapFree(hHeap, 0, pFixture->pContextEntries);
+
+   if (pFixture->pNamePool != NULL)
+      HeapFree(hHeap, 0, pFixture->pNamePool);
+
+   HeapFree(hHeap, 0, pFixture);
+}
+
+/// <summary>
+/// Compare two snapshot entries by name.
+/// </summary>
+/// <param name="pLeft">Left entry.</param>
+/// <param name="pRight">Right entry.</param>
+/// <returns>Result of comparing the names.</returns>
+static int compareSnapshotEntries(const void* pLeft, const void* pRight) {
+   return wcscmp(((const SNAPSHOT_ENTRY*)pLeft)->name, ((const SNAPSHOT_ENTRY*)pRight)->name);
+}
+
+/// <summary>
+/// Merge the entries of algorithms that were listed under more than one operation type.
+/// </summary>
+/// <param name="pEntries">Entries sorted by name.</param>
+/// <param name="entryCount">Number of entries.</param>
+/// <returns>Number of merged entries.</returns>
+static size_t mergeSnapshotEntries(SNAPSHOT_ENTRY* const pEntries, const size_t entryCount) {
+   if (entryCount == 0)
+      return 0;
+
+   SNAPSHOT_ENTRY* pLast = pEntries;
+   for (size_t i = 1; i < entryCount; i++) {
+      const SNAPSHOT_ENTRY* pEntry = &pEntries[i];
+      if (wcscmp(pLast->name, pEntry->name) == 0)
+         pLast->operations |= pEntry->operations;
+      else
+         *++pLast = *pEntry;
+   }
+
+   return (size_t)(pLast - pEntries) + 1;
+}
+
+/// <summary>
+/// Write a details line.
+/// </summary>
+/// <param name="f">Snapshot file.</param>
+/// <param name="utf8Name">UTF-8 encoded algorithm name.</param>
+/// <param name="pDetails">Details to write.</param>
+static void writeDetails(FILE* const f, const char* const utf8Name, const ALGORITHM_DETAILS* const pDetails) {
+   fprintf(f, DETAILS_KEYWORD " %s", utf8Name);
+
+   if (pDetails->status < 0)
+      fprintf(f, " status=0x%08lx", (unsigned long)pDetails->status);
+
+   if ((pDetails->validFields & DETAIL_KEY_LENGTHS) != 0)
+      fprintf(f,
+              " keylengths=%lu:%lu:%lu",
+              (unsigned long)pDetails->keyLengths.dwMinLength,
+              (unsigned long)pDetails->keyLengths.dwMaxLength,
+              (unsigned long)pDetails->keyLengths.dwIncrement);
+
+   if ((pDetails->validFields & DETAIL_BLOCK_LENGTH) != 0)
+      fprintf(f, " blocklength=%lu", (unsigned long)pDetails->blockLength);
+
+   if ((pDetails->validFields & DETAIL_HASH_LENGTH) != 0)
+      fprintf(f, " hashlength=%lu", (unsigned long)pDetails->hashLength);
+
+   if ((pDetails->validFields & DETAIL_OBJECT_LENGTH) != 0)
+      fprintf(f, " objectlength=%lu", (unsigned long)pDetails->objectLength);
+
+   if ((pDetails->validFields & DETAIL_CHAINING_MODES) != 0) {
+      char separator = '=';
+      fputs(" modes", f);
+
+      const CHAINING_MODE* pMode = ChainingModes;
+      for (int i = CHAINING_MODE_COUNT; i > 0; i--) {
+         if ((pDetails->chainingModes & pMode->flag) != 0) {
+            fputc(separator, f);
+            fputs(pMode->shortName, f);
+            separator = ',';
+         }
+
+         pMode++;
+      }
+   }
+
+   fputc('\n', f);
+}
+
+/// <summary>
+/// Write the provider chains of the functions of one configuration context.
+/// </summary>
+/// <param name="f">Snapshot file.</param>
+/// <param name="pBackend">Backend to record.</param>
+/// <param name="contextName">Name of the configuration context.</param>
+static void writeContext(FILE* const f, const ALGORITHM_BACKEND* const pBackend, LPCWSTR const contextName) {
+   char contextBuffer[NAME_BUFFER_SIZE];
+   char functionBuffer[NAME_BUFFER_SIZE];
+   char providerBuffer[NAME_BUFFER_SIZE];
+
+   EncodeUtf8(contextName, contextBuffer, sizeof(contextBuffer));
+
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+      ULONG interfaceId = OperationTypeInterface(OperationTypes[t]);
+
+      ULONG bufferSize;
+      PCRYPT_CONTEXT_FUNCTIONS pFunctions;
+      if (pBackend->EnumContextFunctions(pBackend->context, CRYPT_LOCAL, contextName, interfaceId, &bufferSize, &pFunctions) < 0)
+         continue;
+
+      for (ULONG i = 0; i < pFunctions->cFunctions; i++) {
+         LPCWSTR function = pFunctions->rgpszFunctions[i];
+
+         PCRYPT_CONTEXT_FUNCTION_PROVIDERS pProviders;
+         if (pBackend->EnumContextFunctionProviders(pBackend->context, CRYPT_LOCAL, contextName, interfaceId, function, &bufferSize, &pProviders) < 0)
+            continue;
+
+         EncodeUtf8(function, functionBuffer, sizeof(functionBuffer));
+         for (ULONG j = 0; j < pProviders->cProviders; j++) {
+            EncodeUtf8(pProviders->rgpszProviders[j], providerBuffer, sizeof(providerBuffer));
+            fprintf(f, CONTEXT_KEYWORD " %s %lu %s %s\n", contextBuffer, (unsigned long)interfaceId, functionBuffer, providerBuffer);
+         }
+
+         pBackend->FreeBuffer(pBackend->context, pProviders);
+      }
+
+      pBackend->FreeBuffer(pBackend->context, pFunctions);
+   }
+}
+
+/// <summary>
+/// Write the registered providers, their functions and the provider chains of the local configuration contexts.
+/// Nothing is written, if the backend knows no providers.
+/// </summary>
+/// <param name="f">Snapshot file.</param>
+/// <param name="pBackend">Backend to record.</param>
+static void writeProviders(FILE* const f, const ALGORITHM_BACKEND* const pBackend) {
+   char imageBuffer[NAME_BUFFER_SIZE];
+   char functionBuffer[NAME_BUFFER_SIZE];
+   char providerBuffer[NAME_BUFFER_SIZE];
+
+   // 1. Providers with their user mode registrations.
+   ULONG bufferSize;
+   PCRYPT_PROVIDERS pProviders;
+   if (pBackend->EnumProviders(pBackend->context, &bufferSize, &pProviders) >= 0) {
+      for (ULONG p = 0; p < pProviders->cProviders; p++) {
+         LPCWSTR providerName = pProviders->rgpszProviders[p];
+         EncodeUtf8(providerName, providerBuffer, sizeof(providerBuffer));
+
+         PCRYPT_PROVIDER_REG pRegistrations[OPERATION_TYPE_COUNT];
+         strcpy(imageBuffer, NO_IMAGE_NAME);
+         for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+            if (pBackend->QueryProviderRegistration(pBackend->context,
+                                                    providerName,
+                                                    CRYPT_UM,
+                                                    OperationTypeInterface(OperationTypes[t]),
+                                                    &bufferSize,
+                                                    &pRegistrations[t]) < 0) {
+               pRegistrations[t] = NULL;
+               continue;
+            }
+
+            if (pRegistrations[t]->pUM != NULL && pRegistrations[t]->pUM->pszImage != NULL)
+               EncodeUtf8(pRegistrations[t]->pUM->pszImage, imageBuffer, sizeof(imageBuffer));
+         }
+
+         fprintf(f, PROVIDER_KEYWORD " %s %s\n", imageBuffer, providerBuffer);
+
+         for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+            if (pRegistrations[t] == NULL)
+               continue;
+
+            const CRYPT_IMAGE_REG* pImage = pRegistrations[t]->pUM;
+            for (ULONG i = 0; pImage != NULL && i < pImage->cInterfaces; i++) {
+               const CRYPT_INTERFACE_REG* pInterface = pImage->rgpInterfaces[i];
+               for (ULONG j = 0; j < pInterface->cFunctions; j++) {
+                  EncodeUtf8(pInterface->rgpszFunctions[j], functionBuffer, sizeof(functionBuffer));
+                  fprintf(f, REGISTRATION_KEYWORD " %lu %s %s\n", (unsigned long)pInterface->dwInterface, functionBuffer, providerBuffer);
+               }
+            }
+
+            pBackend->FreeBuffer(pBackend->context, pRegistrations[t]);
+         }
+      }
+
+      pBackend->FreeBuffer(pBackend->context, pProviders);
+   }
+
+   // 2. Provider chains of the local configuration contexts.
+   PCRYPT_CONTEXTS pContexts;
+   if (pBackend->EnumContexts(pBackend->context, CRYPT_LOCAL, &bufferSize, &pContexts) >= 0) {
+      for (ULONG c = 0; c < pContexts->cContexts; c++)
+         writeContext(f, pBackend, pContexts->rgpszContexts[c]);
+
+      pBackend->FreeBuffer(pBackend->context, pContexts);
+   }
+}
+
+/// <summary>
+/// Write the merged entries to a snapshot file.
+/// </summary>
+/// <param name="pBackend">Backend for the module version.</param>
+/// <param name="pEntries">Merged entries sorted by name.</param>
+/// <param name="pDetails">Details of the entries or NULL, if there are no details.</param>
+/// <param name="entryCount">Number of entries.</param>
+/// <param name="snapshotPath">Path of the snapshot file.</param>
+/// <returns>TRUE, if the file was written, FALSE if not.</returns>
+static BOOL writeSnapshotFile(const ALGORITHM_BACKEND* const pBackend,
+                              const SNAPSHOT_ENTRY* const pEntries,
+                              const ALGORITHM_DETAILS* const pDetails,
+                              const size_t entryCount,
+                              const char* const snapshotPath) {
+   const PCHAR functionName = "writeSnapshotFile";
+
+   FILE* f;
+   if (fopen_s(&f, snapshotPath, "wb") != 0) {
+      fprintf(stderr, "Function \"%s\": Could not create file \"%s\".\n", functionName, snapshotPath);
+      return FALSE;
+   }
+
+   fputs(SNAPSHOT_HEADER, f);
+
+   MODULE_VERSION version;
+   if (pBackend->GetModuleVersion(pBackend->context, SNAPSHOT_MODULE_NAME, &version) != FALSE)
+      fprintf(f,
+              MODULE_KEYWORD " " SNAPSHOT_MODULE_NAME " %u.%u.%u.%u\n",
+              version.major,
+              version.minor,
+              version.build,
+              version.revision);
+
+   char nameBuffer[NAME_BUFFER_SIZE];
+   const SNAPSHOT_ENTRY* pEntry = pEntries;
+   for (size_t i = 0; i < entryCount; i++) {
+      EncodeUtf8(pEntry->name, nameBuffer, sizeof(nameBuffer));
+      fprintf(f,
+              "0x%08lx 0x%08lx 0x%08lx %s\n",
+              (unsigned long)pEntry->operations,
+              (unsigned long)pEntry->algorithmClass,
+              (unsigned long)pEntry->flags,
+              nameBuffer);
+
+      if (pDetails != NULL)
+         writeDetails(f, nameBuffer, &pDetails[i]);
+
+      pEntry++;
+   }
+
+   writeProviders(f, pBackend);
+
+   BOOL result = (ferror(f) == 0);
+   if (fclose(f) != 0)
+      result = FALSE;
+
+   if (result == FALSE)
+      fprintf(stderr, "Function \"%s\": Could not write file \"%s\".\n", functionName, snapshotPath);
+
+   return result;
+}
+
+/// <summary>
+/// Load a snapshot file.
+/// </summary>
+/// <param name="hHeap">Handle of the heap.</param>
+/// <param name="snapshotPath">Path of the snapshot file.</param>
+/// <returns>Pointer to the fixture without backend functions or NULL, if the snapshot could not be loaded.</returns>
+static FIXTURE* loadFixture(const HANDLE hHeap, const char* const snapshotPath) {
+   const PCHAR functionName = "loadFixture";
+
+   FIXTURE* pFixture = HeapAlloc(hHeap, 0, sizeof(FIXTURE));
+   if (pFixture == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for fixture failed.\n", functionName);
+      return NULL;
+   }
+
+   memset(pFixture, 0, sizeof(FIXTURE));
+   pFixture->hHeap = hHeap;
+   pFixture->snapshotPath = snapshotPath;
+
+   size_t contentSize;
+   char* pContent = readFile(hHeap, snapshotPath, &contentSize);
+   if (pContent == NULL) {
+      freeFixture(pFixture);
+      return NULL;
+   }
+
+   BOOL parseResult = parseSnapshot(pFixture, pContent, contentSize, snapshotPath);
+   HeapFree(hHeap, 0, pContent);  // The names have been copied into the name pool.
+   if (parseResult == FALSE) {
+      freeFixture(pFixture);
+      return NULL;
+   }
+
+   pFixture->hasStamp = GetFileStamp(snapshotPath, &pFixture->stamp);
+
+   return pFixture;
+}
+
+/// <summary>
+/// Re-read the snapshot file, if it changed since it was read.
+/// The new data replaces the old one in place, so the backend pointer stays valid.
+/// No buffer returned by the backend may be in use.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <returns>TRUE, if the fixture is up to date, FALSE if the changed file could not be read. The fixture then keeps the old data.</returns>
+static BOOL fixtureRefresh(PVOID const context) {
+   FIXTURE* const pFixture = context;
+
+   // 1. Keep the data, if the file did not change.
+   FILE_STAMP stamp;
+   if (GetFileStamp(pFixture->snapshotPath, &stamp) == FALSE)
+      return FALSE;
+
+   if (pFixture->hasStamp != FALSE &&
+       stamp.lastWriteTime == pFixture->stamp.lastWriteTime &&
+       stamp.size == pFixture->stamp.size)
+      return TRUE;
+
+   // 2. Load the changed file and exchange the data. The old data is released with the new fixture structure.
+   FIXTURE* pNewFixture = loadFixture(pFixture->hHeap, pFixture->snapshotPath);
+   if (pNewFixture == NULL)
+      return FALSE;
+
+   FIXTURE oldFixture = *pFixture;
+   *pFixture = *pNewFixture;
+   pFixture->backend = oldFixture.backend;
+   *pNewFixture = oldFixture;
+
+   freeFixture(pNewFixture);
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Open a backend that replays the algorithm lists recorded in a snapshot file.
+/// </summary>
+/// <param name="snapshotPath">Path of the snapshot file.</param>
+/// <returns>Pointer to the backend or NULL, if the snapshot could not be loaded.</returns>
+ALGORITHM_BACKEND* OpenFixtureBackend(const char* const snapshotPath) {
+   const PCHAR functionName = "OpenFixtureBackend";
+
+   HANDLE hHeap = GetProcessHeap();
+   if (hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return NULL;
+   }
+
+   FIXTURE* pFixture = loadFixture(hHeap, snapshotPath);
+   if (pFixture == NULL)
+      return NULL;
+
+   pFixture->backend.name = "fixture";
+   pFixture->backend.context = pFixture;
+   pFixture->backend.EnumAlgorithms = fixtureEnumAlgorithms;
+   pFixture->backend.FreeBuffer = fixtureFreeBuffer;
+   pFixture->backend.GetModuleVersion = fixtureGetModuleVersion;
+   pFixture->backend.GetModuleStamp = fixtureGetModuleStamp;
+   pFixture->backend.OpenAlgorithm = fixtureOpenAlgorithm;
+   pFixture->backend.GetProperty = fixtureGetProperty;
+   pFixture->backend.SetProperty = fixtureSetProperty;
+   pFixture->backend.CloseAlgorithm = fixtureCloseAlgorithm;
+   pFixture->backend.EnumProviders = fixtureEnumProviders;
+   pFixture->backend.QueryProviderRegistration = fixtureQueryProviderRegistration;
+   pFixture->backend.EnumContexts = fixtureEnumContexts;
+   pFixture->backend.EnumContextFunctions = fixtureEnumContextFunctions;
+   pFixture->backend.EnumContextFunctionProviders = fixtureEnumContextFunctionProviders;
+   pFixture->backend.Refresh = fixtureRefresh;
+
+   return &pFixture->backend;
+}
+
+/// <summary>
+/// Close a backend opened with OpenFixtureBackend.
+/// </summary>
+/// <param name="pBackend">Pointer to the backend.</param>
+void CloseFixtureBackend(ALGORITHM_BACKEND* const pBackend) {
+   if (pBackend != NULL)
+      freeFixture(pBackend->context);
+}
+
+/// <summary>
+/// Record the algorithm lists of a backend in a snapshot file.
+/// </summary>
+/// <param name="pBackend">Backend to record.</param>
+/// <param name="snapshotPath">Path of the snapshot file.</param>
+/// <param name="includeDetails">Probe and record the capabilities of the algorithms, too.</param>
+/// <param name="maxThreads">Maximum number of probe threads. 0 means the number of processors.</param>
+/// <returns>TRUE, if the snapshot was written, FALSE if not.</returns>
+BOOL WriteSnapshot(const ALGORITHM_BACKEND* const pBackend,
+                   const char* const snapshotPath,
+                   const BOOL includeDetails,
+                   const ULONG maxThreads) {
+   const PCHAR functionName = "WriteSnapshot";
+
+   HANDLE hHeap = GetProcessHeap();
+   if (hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return FALSE;
+   }
+
+   // 1. Get the lists of all operation types.
+   //    They are kept until the snapshot is written, as the entries point to their names.
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoLists[OPERATION_TYPE_COUNT] = { NULL };
+   ULONG algoCounts[OPERATION_TYPE_COUNT] = { 0 };
+   size_t entryCount = 0;
+   BOOL result = TRUE;
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+      NTSTATUS nts = pBackend->EnumAlgorithms(pBackend->context, OperationTypes[t], &algoCounts[t], &pAlgoLists[t]);
+      if (nts < 0) {
+         PrintNtStatus(functionName, "EnumAlgorithms", nts);
+         pAlgoLists[t] = NULL;
+         result = FALSE;
+         break;
+      }
+
+      entryCount += algoCounts[t];
+   }
+
+   // 2. Collect the entries of all types and sort them by name, so that the entries of one algorithm are adjacent.
+   SNAPSHOT_ENTRY* pEntries = NULL;
+   if (result != FALSE) {
+      pEntries = HeapAlloc(hHeap, 0, (entryCount + 1) * sizeof(SNAPSHOT_ENTRY));
+      if (pEntries == NULL) {
+         fprintf(stderr, "Function \"%s\": HeapAlloc for snapshot entries failed.\n", functionName);
+         result = FALSE;
+      }
+   }
+
+   if (result != FALSE) {
+      SNAPSHOT_ENTRY* pEntry = pEntries;
+      for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+         const BCRYPT_ALGORITHM_IDENTIFIER* pActAlgo = pAlgoLists[t];
+         for (ULONG i = algoCounts[t]; i > 0; i--) {
+            pEntry->name = pActAlgo->pszName;
+            pEntry->operations = OperationTypes[t];
+            pEntry->algorithmClass = pActAlgo->dwClass;
+            pEntry->flags = pActAlgo->dwFlags;
+            pEntry++;
+            pActAlgo++;
+         }
+      }
+
+      qsort(pEntries, entryCount, sizeof(SNAPSHOT_ENTRY), compareSnapshotEntries);
+      entryCount = mergeSnapshotEntries(pEntries, entryCount);
+   }
+
+   // 3. Probe the algorithms, if requested.
+   LPWSTR* pNames = NULL;
+   ALGORITHM_DETAILS* pDetails = NULL;
+   if (result != FALSE && includeDetails != FALSE) {
+      pNames = HeapAlloc(hHeap, 0, (entryCount + 1) * sizeof(LPWSTR));
+      pDetails = HeapAlloc(hHeap, 0, (entryCount + 1) * sizeof(ALGORITHM_DETAILS));
+      if (pNames == NULL || pDetails == NULL) {
+         fprintf(stderr, "Function \"%s\": HeapAlloc for algorithm details failed.\n", functionName);
+         result = FALSE;
+      } else {
+         for (size_t i = 0; i < entryCount; i++)
+            pNames[i] = pEntries[i].name;
+
+         ProbeAlgorithms(pBackend, pNames, (ULONG)entryCount, pDetails, maxThreads);
+      }
+   }
+
+   // 4. Write the file.
+   if (result != FALSE)
+      result = writeSnapshotFile(pBackend, pEntries, pDetails, entryCount, snapshotPath);
+
+   // 5. Release memory.
+   if (pDetails != NULL)
+      HeapFree(hHeap, 0, pDetails);
+
+   if (pNames != NULL)
+      HeapFree(hHeap, 0, pNames);
+
+   if (pEntries != NULL)
+      HeapFree(hHeap, 0, pEntries);
+
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      if (pAlgoLists[t] != NULL)
+         pBackend->FreeBuffer(pBackend->context, pAlgoLists[t]);
+
+   return result;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+
+/// <summary>
+/// Open a backend that replays the algorithm lists recorded in a snapshot file.
+/// </summary>
+/// <param name="snapshotPath">Path of the snapshot file. It is read again on refresh, so it has to stay valid while the backend is open.</param>
+/// <returns>Pointer to the backend or NULL, if the snapshot could not be loaded.</returns>
+ALGORITHM_BACKEND* OpenFixtureBackend(const char* const snapshotPath);
+
+/// <summary>
+/// Close a backend opened with OpenFixtureBackend.
+/// </summary>
+/// <param name="pBackend">Pointer to the backend.</param>
+void CloseFixtureBackend(ALGORITHM_BACKEND* const pBackend);
+
+/// <summary>
+/// Record the algorithm lists of a backend in a snapshot file.
+/// </summary>
+/// <param name="pBackend">Backend to record.</param>
+/// <param name="snapshotPath">Path of the snapshot file.</param>
+/// <param name="includeDetails">Probe and record the capabilities of the algorithms, too.</param>
+/// <param name="maxThreads">Maximum number of probe threads. 0 means the number of processors.</param>
+/// <returns>TRUE, if the snapshot was written, FALSE if not.</returns>
+BOOL WriteSnapshot(const ALGORITHM_BACKEND* const pBackend,
+                   const char* const snapshotPath,
+                   const BOOL includeDetails,
+                   const ULONG maxThreads);
@@ -0,0 +1,643 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.2
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.0.1: Get the sorted paths from FileMapping.
+//    2026-10-16: V1.0.2: Skip provider lines.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "FleetIndex.h"
+#include "WorkerPool.h"
+
+// ******** Private constants ********
+
+/// Value of an empty slot of the hash table.
+#define EMPTY_SLOT 0xffffffff
+
+/// Minimum number of slots of the hash table.
+#define MIN_SLOT_COUNT 16
+
+/// Offset basis of the FNV-1a hash.
+#define FNV_OFFSET_BASIS 2166136261U
+
+/// Prime of the FNV-1a hash.
+#define FNV_PRIME 16777619U
+
+/// Keyword of the module version line.
+#define MODULE_KEYWORD "module"
+
+/// Keyword of the details line.
+#define DETAILS_KEYWORD "details"
+
+/// Keywords of the provider lines.
+#define PROVIDER_KEYWORD     "provider"
+#define REGISTRATION_KEYWORD "registration"
+#define CONTEXT_KEYWORD      "context"
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the hash of a name.
+/// </summary>
+/// <param name="pName">Name.</param>
+/// <param name="nameLength">Length of the name in bytes.</param>
+/// <returns>FNV-1a hash of the name.</returns>
+static ULONG hashName(const char* const pName, const size_t nameLength) {
+   ULONG hash = FNV_OFFSET_BASIS;
+   for (size_t i = 0; i < nameLength; i++) {
+      hash ^= (UCHAR)pName[i];
+      hash *= FNV_PRIME;
+   }
+
+   return hash;
+}
+
+/// <summary>
+/// Skip blanks and tabs.
+/// </summary>
+/// <param name="p">Pointer into a line.</param>
+/// <param name="pEnd">End of the line.</param>
+/// <returns>Pointer to the first non-blank character or the end of the line.</returns>
+static const char* skipBlanks(const char* p, const char* const pEnd) {
+   while (p < pEnd && (*p == ' ' || *p == '\t'))
+      p++;
+
+   return p;
+}
+
+/// <summary>
+/// Parse an unsigned decimal or hexadecimal ("0x" prefix) number.
+/// The mapped file is not 0 terminated, so the end of the line has to be checked.
+/// </summary>
+/// <param name="ppText">Pointer to the text pointer. It is advanced past the number.</param>
+/// <param name="pEnd">End of the line.</param>
+/// <param name="pValue">Pointer to the variable that receives the value.</param>
+/// <returns>TRUE, if a number was found, FALSE if not.</returns>
+static BOOL parseNumber(const char** const ppText, const char* const pEnd, ULONG* const pValue) {
+   const char* p = skipBlanks(*ppText, pEnd);
+
+   ULONG base = 10;
+   if (pEnd - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+      base = 16;
+      p += 2;
+   }
+
+   const char* pStart = p;
+   ULONG value = 0;
+   while (p < pEnd) {
+      ULONG digit;
+      if (*p >= '0' && *p <= '9')
+         digit = (ULONG)(*p - '0');
+      else if (base == 16 && *p >= 'a' && *p <= 'f')
+         digit = (ULONG)(*p - 'a' + 10);
+      else if (base == 16 && *p >= 'A' && *p <= 'F')
+         digit = (ULONG)(*p - 'A' + 10);
+      else
+         break;
+
+      value = value * base + digit;
+      p++;
+   }
+
+   if (p == pStart)
+      return FALSE;
+
+   *pValue = value;
+   *ppText = p;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Parse a version "major.minor.build.revision".
+/// </summary>
+/// <param name="p">Text of the version.</param>
+/// <param name="pEnd">End of the line.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the version is valid, FALSE if not.</returns>
+static BOOL parseVersion(const char* p, const char* const pEnd, MODULE_VERSION* const pVersion) {
+   ULONG parts[4];
+
+   for (int i = 0; i < 4; i++) {
+      if (i > 0) {
+         if (p == pEnd || *p != '.')
+            return FALSE;
+
+         p++;
+      }
+
+      if (parseNumber(&p, pEnd, &parts[i]) == FALSE || parts[i] > 0xffff)
+         return FALSE;
+   }
+
+   pVersion->major = (USHORT)parts[0];
+   pVersion->minor = (USHORT)parts[1];
+   pVersion->build = (USHORT)parts[2];
+   pVersion->revision = (USHORT)parts[3];
+
+   return TRUE;
+}
+
+/// <summary>
+/// Check, if a line starts with a keyword that is followed by a blank.
+/// </summary>
+/// <param name="p">Start of the line.</param>
+/// <param name="pEnd">End of the line.</param>
+/// <param name="keyword">Keyword.</param>
+/// <returns>TRUE, if the line starts with the keyword, FALSE if not.</returns>
+static BOOL startsWithKeyword(const char* const p, const char* const pEnd, const char* const keyword) {
+   size_t keywordLength = strlen(keyword);
+
+   return ((size_t)(pEnd - p) > keywordLength && memcmp(p, keyword, keywordLength) == 0 && p[keywordLength] == ' ');
+}
+
+/// <summary>
+/// Parse the mapped snapshot of a host.
+/// Only the module version and the algorithm entries are needed. The names stay in the mapped file.
+/// </summary>
+/// <param name="pHost">Host.</param>
+/// <param name="hHeap">Heap for the entries.</param>
+/// <returns>TRUE, if the snapshot is valid, FALSE if not.</returns>
+static BOOL parseHost(FLEET_HOST* const pHost, const HANDLE hHeap) {
+   const PCHAR functionName = "parseHost";
+
+   // 1. Map the file.
+   if (MapFile(pHost->path, &pHost->file) == FALSE) {
+      fprintf(stderr, "File \"%s\": Could not be mapped.\n", pHost->path);
+      return FALSE;
+   }
+
+   const char* pData = (const char*)pHost->file.pData;
+   const char* pDataEnd = pData + pHost->file.size;
+
+   // 2. Count the lines to get an upper bound for the number of entries.
+   size_t lineCount = 1;
+   for (const char* p = pData; p < pDataEnd && (p = memchr(p, '\n', (size_t)(pDataEnd - p))) != NULL; p++)
+      lineCount++;
+
+   pHost->pEntries = HeapAlloc(hHeap, 0, lineCount * sizeof(HOST_ENTRY));
+   if (pHost->pEntries == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for host entries failed.\n", functionName);
+      return FALSE;
+   }
+
+   // 3. Parse the lines.
+   HOST_ENTRY* pEntry = pHost->pEntries;
+   size_t lineNumber = 0;
+   const char* pLine = pData;
+   while (pLine < pDataEnd) {
+      lineNumber++;
+
+      const char* pLineEnd = memchr(pLine, '\n', (size_t)(pDataEnd - pLine));
+      const char* pNextLine;
+      if (pLineEnd == NULL) {
+         pLineEnd = pDataEnd;
+         pNextLine = pDataEnd;
+      } else
+         pNextLine = pLineEnd + 1;
+
+      if (pLineEnd > pLine && pLineEnd[-1] == '\r')
+         pLineEnd--;
+
+      const char* p = skipBlanks(pLine, pLineEnd);
+      pLine = pNextLine;
+
+      if (p == pLineEnd ||
+          *p == '#' ||
+          startsWithKeyword(p, pLineEnd, DETAILS_KEYWORD) != FALSE ||
+          startsWithKeyword(p, pLineEnd, PROVIDER_KEYWORD) != FALSE ||
+          startsWithKeyword(p, pLineEnd, REGISTRATION_KEYWORD) != FALSE ||
+          startsWithKeyword(p, pLineEnd, CONTEXT_KEYWORD) != FALSE)
+         continue;
+
+      if (startsWithKeyword(p, pLineEnd, MODULE_KEYWORD) != FALSE) {
+         // Module line: The version is the last word of the line.
+         const char* pVersionText = pLineEnd;
+         while (pVersionText[-1] != ' ')
+            pVersionText--;
+
+         if (parseVersion(pVersionText, pLineEnd, &pHost->version) == FALSE) {
+            fprintf(stderr, "File \"%s\", line %zu: Invalid module version.\n", pHost->path, lineNumber);
+            return FALSE;
+         }
+
+         pHost->hasVersion = TRUE;
+         continue;
+      }
+
+      ULONG algorithmClass;
+      ULONG flags;
+      if (parseNumber(&p, pLineEnd, &pEntry->operations) == FALSE ||
+          parseNumber(&p, pLineEnd, &algorithmClass) == FALSE ||
+          parseNumber(&p, pLineEnd, &flags) == FALSE ||
+          (p = skipBlanks(p, pLineEnd)) == pLineEnd) {
+         fprintf(stderr, "File \"%s\", line %zu: Invalid algorithm entry.\n", pHost->path, lineNumber);
+         return FALSE;
+      }
+
+      pEntry->pName = p;
+      pEntry->nameLength = (ULONG)(pLineEnd - p);
+      pEntry->hash = hashName(p, pEntry->nameLength);
+      pEntry++;
+   }
+
+   pHost->entryCount = (ULONG)(pEntry - pHost->pEntries);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Parse the snapshot of one host on a worker thread.
+/// </summary>
+/// <param name="context">Index.</param>
+/// <param name="index">Index of the host.</param>
+static void parseWorkItem(PVOID const context, const ULONG index) {
+   FLEET_INDEX* pIndex = context;
+   FLEET_HOST* pHost = pIndex->pHosts + index;
+
+   pHost->isValid = parseHost(pHost, pIndex->hHeap);
+}
+
+/// <summary>
+/// Compare two versions for qsort. The unknown version comes last.
+/// </summary>
+/// <param name="pLeft">Pointer to the left version.</param>
+/// <param name="pRight">Pointer to the right version.</param>
+/// <returns>Result of the comparison.</returns>
+static int compareVersions(const void* const pLeft, const void* const pRight) {
+   const FLEET_VERSION* pLeftVersion = pLeft;
+   const FLEET_VERSION* pRightVersion = pRight;
+
+   if (pLeftVersion->hasVersion != pRightVersion->hasVersion)
+      return (pLeftVersion->hasVersion != FALSE) ? -1 : 1;
+
+   const MODULE_VERSION* l = &pLeftVersion->version;
+   const MODULE_VERSION* r = &pRightVersion->version;
+   uint64_t leftValue = ((uint64_t)l->major << 48) | ((uint64_t)l->minor << 32) | ((uint64_t)l->build << 16) | l->revision;
+   uint64_t rightValue = ((uint64_t)r->major << 48) | ((uint64_t)r->minor << 32) | ((uint64_t)r->build << 16) | r->revision;
+
+   return (leftValue > rightValue) - (leftValue < rightValue);
+}
+
+/// <summary>
+/// Check, if a host has a version.
+/// </summary>
+/// <param name="pHost">Host.</param>
+/// <param name="pVersion">Version.</param>
+/// <returns>TRUE, if the host has the version, FALSE if not.</returns>
+static BOOL hasVersion(const FLEET_HOST* const pHost, const FLEET_VERSION* const pVersion) {
+   if (pHost->hasVersion != pVersion->hasVersion)
+      return FALSE;
+
+   return (pHost->hasVersion == FALSE || memcmp(&pHost->version, &pVersion->version, sizeof(MODULE_VERSION)) == 0);
+}
+
+/// <summary>
+/// Find the slot of an algorithm name in the hash table.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="pName">Name.</param>
+/// <param name="nameLength">Length of the name in bytes.</param>
+/// <param name="hash">Hash of the name.</param>
+/// <returns>Pointer to the slot of the name or to the empty slot where it belongs.</returns>
+static ULONG* findSlot(const FLEET_INDEX* const pIndex, const char* const pName, const ULONG nameLength, const ULONG hash) {
+   ULONG slot = hash & pIndex->slotMask;
+
+   for (;;) {
+      ULONG* pSlot = pIndex->pSlots + slot;
+      if (*pSlot == EMPTY_SLOT)
+         return pSlot;
+
+      const FLEET_ALGORITHM* pAlgorithm = pIndex->pAlgorithms + *pSlot;
+      if (pAlgorithm->hash == hash && pAlgorithm->nameLength == nameLength && memcmp(pAlgorithm->pName, pName, nameLength) == 0)
+         return pSlot;
+
+      slot = (slot + 1) & pIndex->slotMask;
+   }
+}
+
+/// <summary>
+/// Intern the names of all entries.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="entryCount">Total number of entries of the valid hosts.</param>
+/// <returns>TRUE, if the names could be interned, FALSE if there is not enough memory.</returns>
+static BOOL internAlgorithms(FLEET_INDEX* const pIndex, const size_t entryCount) {
+   const PCHAR functionName = "internAlgorithms";
+
+   // 1. Allocate the hash table with a load factor of at most 1/2.
+   size_t slotCount = MIN_SLOT_COUNT;
+   while (slotCount < 2 * entryCount)
+      slotCount *= 2;
+
+   pIndex->pAlgorithms = HeapAlloc(pIndex->hHeap, 0, (entryCount + 1) * sizeof(FLEET_ALGORITHM));
+   pIndex->pSlots = HeapAlloc(pIndex->hHeap, 0, slotCount * sizeof(ULONG));
+   if (pIndex->pAlgorithms == NULL || pIndex->pSlots == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for algorithm table failed.\n", functionName);
+      return FALSE;
+   }
+
+   memset(pIndex->pSlots, 0xff, slotCount * sizeof(ULONG));
+   pIndex->slotMask = (ULONG)(slotCount - 1);
+
+   // 2. Intern the names. The hashes were calculated by the workers.
+   for (ULONG h = 0; h < pIndex->hostCount; h++) {
+      FLEET_HOST* pHost = pIndex->pHosts + h;
+      if (pHost->isValid == FALSE)
+         continue;
+
+      HOST_ENTRY* pEntry = pHost->pEntries;
+      for (ULONG i = pHost->entryCount; i > 0; i--) {
+         ULONG* pSlot = findSlot(pIndex, pEntry->pName, pEntry->nameLength, pEntry->hash);
+         if (*pSlot == EMPTY_SLOT) {
+            FLEET_ALGORITHM* pAlgorithm = pIndex->pAlgorithms + pIndex->algorithmCount;
+            pAlgorithm->pName = pEntry->pName;
+            pAlgorithm->nameLength = pEntry->nameLength;
+            pAlgorithm->hash = pEntry->hash;
+            pAlgorithm->operations = 0;
+
+            *pSlot = pIndex->algorithmCount++;
+         }
+
+         pEntry->algorithmIndex = *pSlot;
+         pIndex->pAlgorithms[*pSlot].operations |= pEntry->operations;
+         pEntry++;
+      }
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Collect the distinct versions of the valid hosts.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <returns>TRUE, if the versions could be collected, FALSE if there is not enough memory.</returns>
+static BOOL collectVersions(FLEET_INDEX* const pIndex) {
+   const PCHAR functionName = "collectVersions";
+
+   pIndex->pVersions = HeapAlloc(pIndex->hHeap, 0, (pIndex->validHostCount + 1) * sizeof(FLEET_VERSION));
+   if (pIndex->pVersions == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for version list failed.\n", functionName);
+      return FALSE;
+   }
+
+   // 1. Collect the versions. There are only a few of them, so a linear search is fast enough.
+   for (ULONG h = 0; h < pIndex->hostCount; h++) {
+      const FLEET_HOST* pHost = pIndex->pHosts + h;
+      if (pHost->isValid == FALSE)
+         continue;
+
+      ULONG v = 0;
+      while (v < pIndex->versionCount && hasVersion(pHost, pIndex->pVersions + v) == FALSE)
+         v++;
+
+      if (v == pIndex->versionCount) {
+         FLEET_VERSION* pVersion = pIndex->pVersions + pIndex->versionCount++;
+         pVersion->hasVersion = pHost->hasVersion;
+         pVersion->version = pHost->version;
+         pVersion->hostCount = 0;
+      }
+   }
+
+   // 2. Sort them and assign them to the hosts.
+   qsort(pIndex->pVersions, pIndex->versionCount, sizeof(FLEET_VERSION), compareVersions);
+
+   for (ULONG h = 0; h < pIndex->hostCount; h++) {
+      FLEET_HOST* pHost = pIndex->pHosts + h;
+      if (pHost->isValid == FALSE)
+         continue;
+
+      ULONG v = 0;
+      while (hasVersion(pHost, pIndex->pVersions + v) == FALSE)
+         v++;
+
+      pHost->versionIndex = v;
+      pIndex->pVersions[v].hostCount++;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Build the host bitmaps of the algorithms and the versions.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <returns>TRUE, if the bitmaps could be built, FALSE if there is not enough memory.</returns>
+static BOOL buildBitmaps(FLEET_INDEX* const pIndex) {
+   const PCHAR functionName = "buildBitmaps";
+
+   // 1. Allocate all bitmaps in one block.
+   pIndex->wordCount = (pIndex->hostCount + 63) / 64;
+   size_t bitmapCount = (size_t)pIndex->algorithmCount + pIndex->versionCount + 1;
+   size_t bitmapsSize = bitmapCount * pIndex->wordCount * sizeof(uint64_t);
+
+   pIndex->pAlgorithmBitmaps = HeapAlloc(pIndex->hHeap, 0, bitmapsSize + sizeof(uint64_t));
+   if (pIndex->pAlgorithmBitmaps == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for bitmaps failed.\n", functionName);
+      return FALSE;
+   }
+
+   memset(pIndex->pAlgorithmBitmaps, 0, bitmapsSize);
+   pIndex->pVersionBitmaps = pIndex->pAlgorithmBitmaps + (size_t)pIndex->algorithmCount * pIndex->wordCount;
+   pIndex->pValidHosts = pIndex->pVersionBitmaps + (size_t)pIndex->versionCount * pIndex->wordCount;
+
+   // 2. Set the bits of the hosts.
+   for (ULONG h = 0; h < pIndex->hostCount; h++) {
+      const FLEET_HOST* pHost = pIndex->pHosts + h;
+      if (pHost->isValid == FALSE)
+         continue;
+
+      ULONG word = h >> 6;
+      uint64_t bit = (uint64_t)1 << (h & 63);
+
+      pIndex->pValidHosts[word] |= bit;
+      pIndex->pVersionBitmaps[(size_t)pHost->versionIndex * pIndex->wordCount + word] |= bit;
+
+      const HOST_ENTRY* pEntry = pHost->pEntries;
+      for (ULONG i = pHost->entryCount; i > 0; i--) {
+         pIndex->pAlgorithmBitmaps[(size_t)pEntry->algorithmIndex * pIndex->wordCount + word] |= bit;
+         pEntry++;
+      }
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Count the bits of a word.
+/// </summary>
+/// <param name="value">Word.</param>
+/// <returns>Number of set bits.</returns>
+static inline ULONG countBits(const uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+   return (ULONG)__popcnt64(value);
+#elif defined(__GNUC__)
+   return (ULONG)__builtin_popcountll(value);
+#else
+   ULONG count = 0;
+   for (uint64_t rest = value; rest != 0; rest &= rest - 1)
+      count++;
+
+   return count;
+#endif
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Build the index of a directory of snapshot files.
+/// The files are mapped into memory and parsed on a pool of worker threads.
+/// </summary>
+/// <param name="directoryPath">Directory with one snapshot file per host.</param>
+/// <param name="maxThreads">Maximum number of worker threads. 0 means the number of processors.</param>
+/// <param name="pIndex">Pointer to the index that is built.</param>
+/// <returns>TRUE, if the index could be built, FALSE if not.</returns>
+BOOL BuildFleetIndex(const char* const directoryPath, const ULONG maxThreads, FLEET_INDEX* const pIndex) {
+   const PCHAR functionName = "BuildFleetIndex";
+
+   memset(pIndex, 0, sizeof(FLEET_INDEX));
+   pIndex->hHeap = GetProcessHeap();
+
+   // 1. List the snapshot files in a fixed order.
+   DIRECTORY_PATHS paths;
+   if (GetDirectoryPaths(directoryPath, pIndex->hHeap, &paths) == FALSE)
+      return FALSE;
+
+   pIndex->pHosts = HeapAlloc(pIndex->hHeap, 0, (paths.count + 1) * sizeof(FLEET_HOST));
+   if (pIndex->pHosts == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for host list failed.\n", functionName);
+      FreeDirectoryPaths(&paths);
+      return FALSE;
+   }
+
+   memset(pIndex->pHosts, 0, (paths.count + 1) * sizeof(FLEET_HOST));
+   pIndex->hostCount = paths.count;
+   for (ULONG i = 0; i < paths.count; i++) {
+      pIndex->pHosts[i].path = paths.pPaths[i];
+      pIndex->pHosts[i].fileName = paths.pPaths[i] + paths.directoryLength;
+   }
+
+   // The hosts own the paths now.
+   paths.count = 0;
+   FreeDirectoryPaths(&paths);
+
+   // 2. Map and parse the snapshots in parallel.
+   RunWorkItems(pIndex->hostCount, maxThreads, parseWorkItem, pIndex);
+
+   size_t entryCount = 0;
+   for (ULONG h = 0; h < pIndex->hostCount; h++)
+      if (pIndex->pHosts[h].isValid != FALSE) {
+         pIndex->validHostCount++;
+         entryCount += pIndex->pHosts[h].entryCount;
+      }
+
+   // 3. Intern the names, collect the versions and build the bitmaps.
+   if (internAlgorithms(pIndex, entryCount) == FALSE ||
+       collectVersions(pIndex) == FALSE ||
+       buildBitmaps(pIndex) == FALSE) {
+      FreeFleetIndex(pIndex);
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release the memory and the file mappings of an index.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+void FreeFleetIndex(FLEET_INDEX* const pIndex) {
+   HANDLE hHeap = pIndex->hHeap;
+
+   if (pIndex->pHosts != NULL) {
+      for (ULONG h = 0; h < pIndex->hostCount; h++) {
+         FLEET_HOST* pHost = pIndex->pHosts + h;
+
+         if (pHost->pEntries != NULL)
+            HeapFree(hHeap, 0, pHost->pEntries);
+
+         UnmapFile(&pHost->file);
+         HeapFree(hHeap, 0, pHost->path);
+      }
+
+      HeapFree(hHeap, 0, pIndex->pHosts);
+   }
+
+   if (pIndex->pAlgorithms != NULL)
+      HeapFree(hHeap, 0, pIndex->pAlgorithms);
+
+   if (pIndex->pSlots != NULL)
+      HeapFree(hHeap, 0, pIndex->pSlots);
+
+   if (pIndex->pVersions != NULL)
+      HeapFree(hHeap, 0, pIndex->pVersions);
+
+   if (pIndex->pAlgorithmBitmaps != NULL)
+      HeapFree(hHeap, 0, pIndex->pAlgorithmBitmaps);
+
+   memset(pIndex, 0, sizeof(FLEET_INDEX));
+}
+
+/// <summary>
+/// Find the host bitmap of an algorithm.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="name">UTF-8 name of the algorithm.</param>
+/// <returns>Host bitmap or NULL, if no host has the algorithm.</returns>
+const uint64_t* FindAlgorithmHosts(const FLEET_INDEX* const pIndex, const char* const name) {
+   if (pIndex->pSlots == NULL)
+      return NULL;
+
+   size_t nameLength = strlen(name);
+   ULONG* pSlot = findSlot(pIndex, name, (ULONG)nameLength, hashName(name, nameLength));
+   if (*pSlot == EMPTY_SLOT)
+      return NULL;
+
+   return pIndex->pAlgorithmBitmaps + (size_t)*pSlot * pIndex->wordCount;
+}
+
+/// <summary>
+/// Count the hosts that are in two bitmaps.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="pLeft">Left host bitmap.</param>
+/// <param name="pRight">Right host bitmap.</param>
+/// <returns>Number of hosts.</returns>
+ULONG CountCommonHosts(const FLEET_INDEX* const pIndex, const uint64_t* const pLeft, const uint64_t* const pRight) {
+   ULONG count = 0;
+   for (ULONG i = 0; i < pIndex->wordCount; i++)
+      count += countBits(pLeft[i] & pRight[i]);
+
+   return count;
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "AlgorithmBackend.h"
+#include "FileMapping.h"
+#include "Platform.h"
+
+/// <summary>
+/// Algorithm entry of a host snapshot.
+/// </summary>
+typedef struct _HOST_ENTRY {
+   /// UTF-8 name in the mapped snapshot file. It is not 0 terminated.
+   const char* pName;
+
+   /// Length of the name in bytes.
+   ULONG nameLength;
+
+   /// Hash of the name.
+   ULONG hash;
+
+   /// Bit mask of the BCRYPT_*_OPERATION types.
+   ULONG operations;
+
+   /// Index of the interned algorithm.
+   ULONG algorithmIndex;
+} HOST_ENTRY;
+
+/// <summary>
+/// Snapshot of one host.
+/// </summary>
+typedef struct _FLEET_HOST {
+   /// Path of the snapshot file.
+   char* path;
+
+   /// File name part of the path.
+   const char* fileName;
+
+   /// Mapped snapshot file.
+   MAPPED_FILE file;
+
+   /// TRUE, if the snapshot could be read.
+   BOOL isValid;
+
+   /// TRUE, if the snapshot has a module version.
+   BOOL hasVersion;
+
+   /// Version of bcrypt.dll.
+   MODULE_VERSION version;
+
+   /// Index of the version in the version list.
+   ULONG versionIndex;
+
+   /// Number of algorithm entries.
+   ULONG entryCount;
+
+   /// Algorithm entries.
+   HOST_ENTRY* pEntries;
+} FLEET_HOST;
+
+/// <summary>
+/// Interned algorithm name.
+/// </summary>
+typedef struct _FLEET_ALGORITHM {
+   /// UTF-8 name in the mapped snapshot file of the first host that has the algorithm. It is not 0 terminated.
+   const char* pName;
+
+   /// Length of the name in bytes.
+   ULONG nameLength;
+
+   /// Hash of the name.
+   ULONG hash;
+
+   /// Bit mask of the BCRYPT_*_OPERATION types on all hosts.
+   ULONG operations;
+} FLEET_ALGORITHM;
+
+/// <summary>
+/// Distinct bcrypt.dll version of the fleet.
+/// </summary>
+typedef struct _FLEET_VERSION {
+   /// FALSE for the hosts with an unknown version.
+   BOOL hasVersion;
+
+   /// Version.
+   MODULE_VERSION version;
+
+   /// Number of hosts with this version.
+   ULONG hostCount;
+} FLEET_VERSION;
+
+/// <summary>
+/// Index of the algorithms of a fleet of hosts.
+/// Each algorithm and each version has a bitmap with one bit per host.
+/// </summary>
+typedef struct _FLEET_INDEX {
+   /// Heap of the index.
+   HANDLE hHeap;
+
+   /// Number of snapshot files.
+   ULONG hostCount;
+
+   /// Snapshots sorted by path.
+   FLEET_HOST* pHosts;
+
+   /// Number of snapshots that could be read.
+   ULONG validHostCount;
+
+   /// Number of interned algorithms.
+   ULONG algorithmCount;
+
+   /// Interned algorithms.
+   FLEET_ALGORITHM* pAlgorithms;
+
+   /// Hash table of the algorithm indexes. Empty slots are 0xffffffff.
+   ULONG* pSlots;
+
+   /// Number of slots - 1. The number of slots is a power of 2.
+   ULONG slotMask;
+
+   /// Number of distinct versions.
+   ULONG versionCount;
+
+   /// Distinct versions in ascending order. The unknown version comes last.
+   FLEET_VERSION* pVersions;
+
+   /// Number of 64 bit words in a bitmap.
+   ULONG wordCount;
+
+   /// Host bitmaps of the algorithms.
+   uint64_t* pAlgorithmBitmaps;
+
+   /// Host bitmaps of the versions.
+   uint64_t* pVersionBitmaps;
+
+   /// Bitmap of the valid hosts.
+   uint64_t* pValidHosts;
+} FLEET_INDEX;
+
+/// <summary>
+/// Build the index of a directory of snapshot files.
+/// The files are mapped into memory and parsed on a pool of worker threads.
+/// </summary>
+/// <param name="directoryPath">Directory with one snapshot file per host.</param>
+/// <param name="maxThreads">Maximum number of worker threads. 0 means the number of processors.</param>
+/// <param name="pIndex">Pointer to the index that is built.</param>
+/// <returns>TRUE, if the index could be built, FALSE if not.</returns>
+BOOL BuildFleetIndex(const char* const directoryPath, const ULONG maxThreads, FLEET_INDEX* const pIndex);
+
+/// <summary>
+/// Release the memory and the file mappings of an index.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+void FreeFleetIndex(FLEET_INDEX* const pIndex);
+
+/// <summary>
+/// Find the host bitmap of an algorithm.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="name">UTF-8 name of the algorithm.</param>
+/// <returns>Host bitmap or NULL, if no host has the algorithm.</returns>
+const uint64_t* FindAlgorithmHosts(const FLEET_INDEX* const pIndex, const char* const name);
+
+/// <summary>
+/// Count the hosts that are in two bitmaps.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="pLeft">Left host bitmap.</param>
+/// <param name="pRight">Right host bitmap.</param>
+/// <returns>Number of hosts.</returns>
+ULONG CountCommonHosts(const FLEET_INDEX* const pIndex, const uint64_t* const pLeft, const uint64_t* const pRight);
+
+/// <summary>
+/// Check, if a host is in a bitmap.
+/// </summary>
+/// <param name="pBitmap">Host bitmap.</param>
+/// <param name="hostIndex">Index of the host.</param>
+/// <returns>TRUE, if the host is in the bitmap, FALSE if not.</returns>
+static inline BOOL HasHost(const uint64_t* const pBitmap, const ULONG hostIndex) {
+   return ((pBitmap[hostIndex >> 6] >> (hostIndex & 63)) & 1) != 0;
+}
@@ -0,0 +1,300 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FleetIndex.h"
+#include "FleetReport.h"
+#include "NumberFormatter.h"
+#include "OutputBuffer.h"
+#include "PrintModVersion.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+#define RC_OK  0
+#define RC_ERR 0xff
+
+/// Width of a coverage column.
+#define COVERAGE_WIDTH 7
+
+/// Minimum width of the algorithm name column.
+#define MIN_NAME_WIDTH 9
+
+// ******** Private methods ********
+
+/// <summary>
+/// Compare two interned algorithms by their names for qsort.
+/// </summary>
+/// <param name="pLeft">Pointer to the left algorithm pointer.</param>
+/// <param name="pRight">Pointer to the right algorithm pointer.</param>
+/// <returns>Result of the comparison.</returns>
+static int compareAlgorithms(const void* const pLeft, const void* const pRight) {
+   const FLEET_ALGORITHM* pLeftAlgorithm = *(const FLEET_ALGORITHM* const*)pLeft;
+   const FLEET_ALGORITHM* pRightAlgorithm = *(const FLEET_ALGORITHM* const*)pRight;
+
+   ULONG commonLength = (pLeftAlgorithm->nameLength < pRightAlgorithm->nameLength) ? pLeftAlgorithm->nameLength : pRightAlgorithm->nameLength;
+   int result = memcmp(pLeftAlgorithm->pName, pRightAlgorithm->pName, commonLength);
+   if (result != 0)
+      return result;
+
+   return (pLeftAlgorithm->nameLength > pRightAlgorithm->nameLength) - (pLeftAlgorithm->nameLength < pRightAlgorithm->nameLength);
+}
+
+/// <summary>
+/// Print a version of the fleet or "unknown version".
+/// </summary>
+/// <param name="pVersion">Version.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printFleetVersion(const FLEET_VERSION* const pVersion, OUTPUT_BUFFER* const pOutput) {
+   if (pVersion->hasVersion != FALSE)
+      OutputModuleVersion(&pVersion->version, pOutput);
+   else
+      OutputString(pOutput, "unknown version");
+}
+
+/// <summary>
+/// Print a percentage right aligned in a coverage column.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="count">Number of hosts with the algorithm.</param>
+/// <param name="total">Number of hosts.</param>
+static void printCoverage(OUTPUT_BUFFER* const pOutput, const ULONG count, const ULONG total) {
+   char number[NUMBER_BUFFER_SIZE];
+   if (total != 0)
+      FormatFixedPoint((double)count * 100.0 / (double)total, 1, number);
+   else
+      strcpy(number, "-");
+
+   OutputFormat(pOutput, "%*s", COVERAGE_WIDTH, number);
+}
+
+/// <summary>
+/// Print the versions of the fleet with their numbers of hosts.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printVersions(const FLEET_INDEX* const pIndex, OUTPUT_BUFFER* const pOutput) {
+   OutputString(pOutput, "bcrypt.dll versions:\n\n");
+
+   for (ULONG v = 0; v < pIndex->versionCount; v++) {
+      const FLEET_VERSION* pVersion = pIndex->pVersions + v;
+
+      OutputFormat(pOutput, "   [%lu] ", (unsigned long)(v + 1));
+      printFleetVersion(pVersion, pOutput);
+      OutputString(pOutput, ": ");
+      OutputNumber(pOutput, pVersion->hostCount);
+      OutputString(pOutput, (pVersion->hostCount == 1) ? " host\n" : " hosts\n");
+   }
+
+   OutputChar(pOutput, '\n');
+}
+
+/// <summary>
+/// Print the coverage matrix, i.e. the percentage of the hosts of each version that have an algorithm.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="pOutput">Output buffer.</param>
+/// <returns>TRUE, if the matrix could be printed, FALSE if there is not enough memory.</returns>
+static BOOL printCoverageMatrix(const FLEET_INDEX* const pIndex, OUTPUT_BUFFER* const pOutput) {
+   const PCHAR functionName = "printCoverageMatrix";
+
+   // 1. Sort the algorithms by name.
+   const FLEET_ALGORITHM** ppSorted = HeapAlloc(pIndex->hHeap, 0, (pIndex->algorithmCount + 1) * sizeof(FLEET_ALGORITHM*));
+   if (ppSorted == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for sorted algorithm list failed.\n", functionName);
+      return FALSE;
+   }
+
+   ULONG nameWidth = MIN_NAME_WIDTH;
+   for (ULONG a = 0; a < pIndex->algorithmCount; a++) {
+      ppSorted[a] = pIndex->pAlgorithms + a;
+      if (ppSorted[a]->nameLength > nameWidth)
+         nameWidth = ppSorted[a]->nameLength;
+   }
+
+   qsort(ppSorted, pIndex->algorithmCount, sizeof(FLEET_ALGORITHM*), compareAlgorithms);
+
+   // 2. Print the column titles.
+   OutputString(pOutput, "Coverage in percent of the hosts by bcrypt.dll version:\n\n");
+   OutputFormat(pOutput, "   %-*s%*s", (int)nameWidth, "Algorithm", COVERAGE_WIDTH, "All");
+   for (ULONG v = 0; v < pIndex->versionCount; v++) {
+      char title[NUMBER_BUFFER_SIZE];
+      snprintf(title, sizeof(title), "[%lu]", (unsigned long)(v + 1));
+      OutputFormat(pOutput, "%*s", COVERAGE_WIDTH, title);
+   }
+
+   OutputChar(pOutput, '\n');
+
+   // 3. Print one row per algorithm.
+   for (ULONG a = 0; a < pIndex->algorithmCount; a++) {
+      const FLEET_ALGORITHM* pAlgorithm = ppSorted[a];
+      const uint64_t* pHosts = pIndex->pAlgorithmBitmaps + (size_t)(pAlgorithm - pIndex->pAlgorithms) * pIndex->wordCount;
+
+      OutputFormat(pOutput, "   %-*.*s", (int)nameWidth, (int)pAlgorithm->nameLength, pAlgorithm->pName);
+      printCoverage(pOutput, CountCommonHosts(pIndex, pHosts, pIndex->pValidHosts), pIndex->validHostCount);
+
+      for (ULONG v = 0; v < pIndex->versionCount; v++)
+         printCoverage(pOutput,
+                       CountCommonHosts(pIndex, pHosts, pIndex->pVersionBitmaps + (size_t)v * pIndex->wordCount),
+                       pIndex->pVersions[v].hostCount);
+
+      OutputChar(pOutput, '\n');
+   }
+
+   OutputChar(pOutput, '\n');
+
+   HeapFree(pIndex->hHeap, 0, ppSorted);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Print the hosts that do not have an algorithm.
+/// </summary>
+/// <param name="pIndex">Index.</param>
+/// <param name="query">Name of the algorithm.</param>
+/// <param name="pOutput">Output buffer.</param>
+/// <returns>Time of the query in ns.</returns>
+static uint64_t printMissingHosts(const FLEET_INDEX* const pIndex, const char* const query, OUTPUT_BUFFER* const pOutput) {
+   // 1. Look up the algorithm and count the hosts that lack it. A name that is not in the index is missing everywhere.
+   uint64_t startTime = GetTimeNs();
+
+   const uint64_t* pHosts = FindAlgorithmHosts(pIndex, query);
+   ULONG missingCount = pIndex->validHostCount;
+   if (pHosts != NULL)
+      missingCount -= CountCommonHosts(pIndex, pHosts, pIndex->pValidHosts);
+
+   uint64_t queryTime = GetTimeNs() - startTime;
+
+   // 2. Print the count and the hosts.
+   OutputString(pOutput, "Hosts without ");
+   OutputString(pOutput, query);
+   OutputString(pOutput, ": ");
+   OutputNumber(pOutput, missingCount);
+   OutputString(pOutput, " of ");
+   OutputNumber(pOutput, pIndex->validHostCount);
+   OutputString(pOutput, "\n\n");
+
+   for (ULONG w = 0; w < pIndex->wordCount; w++) {
+      uint64_t missing = pIndex->pValidHosts[w];
+      if (pHosts != NULL)
+         missing &= ~pHosts[w];
+
+      for (ULONG h = w * 64; missing != 0; h++, missing >>= 1) {
+         if ((missing & 1) == 0)
+            continue;
+
+         const FLEET_HOST* pHost = pIndex->pHosts + h;
+         OutputString(pOutput, "   ");
+         OutputString(pOutput, pHost->fileName);
+         OutputString(pOutput, " (");
+         printFleetVersion(pIndex->pVersions + pHost->versionIndex, pOutput);
+         OutputString(pOutput, ")\n");
+      }
+   }
+
+   if (missingCount != 0)
+      OutputChar(pOutput, '\n');
+
+   return queryTime;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Print the algorithm coverage of a fleet of hosts.
+/// </summary>
+/// <param name="directoryPath">Directory with one snapshot file per host.</param>
+/// <param name="query">Name of an algorithm whose missing hosts are printed or NULL.</param>
+/// <param name="pOptions">List options. maxThreads limits the parser threads.</param>
+/// <returns>0, if the snapshots could be aggregated, an error code if not.</returns>
+unsigned char AggregateSnapshots(const char* const directoryPath, const char* const query, const LIST_OPTIONS* const pOptions) {
+   // 1. Build the index.
+   uint64_t startTime = GetTimeNs();
+
+   FLEET_INDEX index;
+   if (BuildFleetIndex(directoryPath, pOptions->maxThreads, &index) == FALSE)
+      return RC_ERR;
+
+   uint64_t indexTime = GetTimeNs() - startTime;
+
+   // 2. Compose the whole output in one buffer.
+   OUTPUT_BUFFER output;
+   if (InitOutputBuffer(&output, stdout, 0) == FALSE) {
+      FreeFleetIndex(&index);
+      return RC_ERR;
+   }
+
+   // 3. Print header.
+   OutputString(&output, "\nFleet of ");
+   OutputNumber(&output, index.validHostCount);
+   OutputString(&output, " hosts with ");
+   OutputNumber(&output, index.algorithmCount);
+   OutputString(&output, " algorithms and ");
+   OutputNumber(&output, index.versionCount);
+   OutputString(&output, " bcrypt.dll versions");
+   if (index.validHostCount != index.hostCount) {
+      OutputString(&output, " (");
+      ULONG skippedCount = index.hostCount - index.validHostCount;
+      OutputNumber(&output, skippedCount);
+      OutputString(&output, (skippedCount == 1) ? " snapshot skipped)" : " snapshots skipped)");
+   }
+
+   OutputString(&output, "\n\n");
+
+   // 4. Print the query result or the coverage of all algorithms.
+   BOOL result = TRUE;
+   uint64_t queryTime = 0;
+   printVersions(&index, &output);
+   if (query != NULL)
+      queryTime = printMissingHosts(&index, query, &output);
+   else
+      result = printCoverageMatrix(&index, &output);
+
+   // 5. Write the output with a single write.
+   result &= FlushOutputBuffer(&output);
+
+   if (pOptions->showStatistics != FALSE) {
+      fprintf(stderr, "Index: %lu snapshots in %.3f ms\n", (unsigned long)index.hostCount, (double)indexTime / 1.0e6);
+      if (query != NULL)
+         fprintf(stderr, "Query: %.3f us\n", (double)queryTime / 1.0e3);
+
+      PrintOutputStatistics(&output, stderr);
+   }
+
+   FreeOutputBuffer(&output);
+   FreeFleetIndex(&index);
+
+   if (result == FALSE)
+      return RC_ERR;
+
+   return RC_OK;
+}
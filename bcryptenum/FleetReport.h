@@ -0,0 +1,12 @@
+#pragma once
+
+#include "BCryptList.h"
+
+/// <summary>
+/// Print the algorithm coverage of a fleet of hosts.
+/// </summary>
+/// <param name="directoryPath">Directory with one snapshot file per host.</param>
+/// <param name="query">Name of an algorithm whose missing hosts are printed or NULL.</param>
+/// <param name="pOptions">List options. maxThreads limits the parser threads.</param>
+/// <returns>0, if the snapshots could be aggregated, an error code if not.</returns>
+unsigned char AggregateSnapshots(const char* const directoryPath, const char* const query, const LIST_OPTIONS* const pOptions);
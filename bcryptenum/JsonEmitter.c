@@ -0,0 +1,254 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include "ListEmitter.h"
+
+// ******** Private methods ********
+
+/// <summary>
+/// Check, if a character has to be escaped in a JSON string.
+/// </summary>
+/// <param name="c">Character.</param>
+/// <returns>TRUE, if the character has to be escaped, FALSE if not.</returns>
+static inline BOOL needsEscape(const wchar_t c) {
+   return (c < 0x20 || c == L'"' || c == L'\\');
+}
+
+/// <summary>
+/// Print an escaped character.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="c">Character that has to be escaped.</param>
+static void outputEscapedCharacter(OUTPUT_BUFFER* const pOutput, const wchar_t c) {
+   switch (c) {
+   case L'"':
+      OutputString(pOutput, "\\\"");
+      break;
+
+   case L'\\':
+      OutputString(pOutput, "\\\\");
+      break;
+
+   case L'\n':
+      OutputString(pOutput, "\\n");
+      break;
+
+   case L'\r':
+      OutputString(pOutput, "\\r");
+      break;
+
+   case L'\t':
+      OutputString(pOutput, "\\t");
+      break;
+
+   default:
+      OutputFormat(pOutput, "\\u%04x", (unsigned int)c);
+   }
+}
+
+/// <summary>
+/// Print a wide character string as a JSON string.
+/// The runs of characters that need no escaping are converted directly into the output buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="text">Wide character string.</param>
+static void outputJsonString(OUTPUT_BUFFER* const pOutput, const wchar_t* const text) {
+   OutputChar(pOutput, '"');
+
+   const wchar_t* pRunStart = text;
+   const wchar_t* pActual = text;
+   for (; *pActual != 0; pActual++)
+      if (needsEscape(*pActual) != FALSE) {
+         OutputUtf8String(pOutput, pRunStart, (size_t)(pActual - pRunStart));
+         outputEscapedCharacter(pOutput, *pActual);
+         pRunStart = pActual + 1;
+      }
+
+   OutputUtf8String(pOutput, pRunStart, (size_t)(pActual - pRunStart));
+
+   OutputChar(pOutput, '"');
+}
+
+/// <summary>
+/// Print a JSON member with a number value.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="prefix">Text in front of the number, i.e. the separator and the member name.</param>
+/// <param name="value">Number.</param>
+static void outputNumberMember(OUTPUT_BUFFER* const pOutput, const char* const prefix, const ULONG value) {
+   OutputString(pOutput, prefix);
+   OutputNumber(pOutput, value);
+}
+
+/// <summary>
+/// Print the capabilities of an algorithm as a JSON object.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pDetails">Capabilities of the algorithm.</param>
+static void outputDetails(OUTPUT_BUFFER* const pOutput, const ALGORITHM_DETAILS* const pDetails) {
+   OutputFormat(pOutput, ",\"details\":{\"status\":\"0x%08lx\"", (unsigned long)(ULONG)pDetails->status);
+
+   if (pDetails->status >= 0) {
+      if ((pDetails->validFields & DETAIL_KEY_LENGTHS) != 0) {
+         outputNumberMember(pOutput, ",\"keyLengths\":{\"min\":", pDetails->keyLengths.dwMinLength);
+         outputNumberMember(pOutput, ",\"max\":", pDetails->keyLengths.dwMaxLength);
+         outputNumberMember(pOutput, ",\"increment\":", pDetails->keyLengths.dwIncrement);
+         OutputChar(pOutput, '}');
+      }
+
+      if ((pDetails->validFields & DETAIL_BLOCK_LENGTH) != 0)
+         outputNumberMember(pOutput, ",\"blockLength\":", pDetails->blockLength);
+
+      if ((pDetails->validFields & DETAIL_HASH_LENGTH) != 0)
+         outputNumberMember(pOutput, ",\"hashLength\":", pDetails->hashLength);
+
+      if ((pDetails->validFields & DETAIL_OBJECT_LENGTH) != 0)
+         outputNumberMember(pOutput, ",\"objectLength\":", pDetails->objectLength);
+
+      if ((pDetails->validFields & DETAIL_CHAINING_MODES) != 0) {
+         OutputString(pOutput, ",\"chainingModes\":[");
+
+         const char* separator = "\"";
+         for (int i = 0; i < CHAINING_MODE_COUNT; i++)
+            if ((pDetails->chainingModes & ChainingModes[i].flag) != 0) {
+               OutputString(pOutput, separator);
+               OutputString(pOutput, ChainingModes[i].shortName);
+               OutputChar(pOutput, '"');
+               separator = ",\"";
+            }
+
+         OutputChar(pOutput, ']');
+      }
+   }
+
+   OutputChar(pOutput, '}');
+}
+
+/// <summary>
+/// Emit the start of the JSON document.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="moduleName">Name of the module that implements the algorithms.</param>
+/// <param name="pVersion">Version of the module or NULL, if it is not known.</param>
+static void jsonBeginList(EMITTER_STATE* const pState, const PCHAR moduleName, const MODULE_VERSION* const pVersion) {
+   OUTPUT_BUFFER* pOutput = pState->pOutput;
+
+   OutputString(pOutput, "{\"module\":\"");
+   OutputString(pOutput, moduleName);
+   OutputString(pOutput, "\",\"version\":");
+
+   if (pVersion != NULL) {
+      OutputChar(pOutput, '"');
+      OutputNumber(pOutput, pVersion->major);
+      OutputChar(pOutput, '.');
+      OutputNumber(pOutput, pVersion->minor);
+      OutputChar(pOutput, '.');
+      OutputNumber(pOutput, pVersion->build);
+      OutputChar(pOutput, '.');
+      OutputNumber(pOutput, pVersion->revision);
+      OutputChar(pOutput, '"');
+   } else
+      OutputString(pOutput, "null");
+
+   OutputString(pOutput, ",\"operations\":[");
+}
+
+/// <summary>
+/// Emit the start of the object of an operation type.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+static void jsonBeginType(EMITTER_STATE* const pState, const ULONG operationType) {
+   OUTPUT_BUFFER* pOutput = pState->pOutput;
+
+   OutputString(pOutput, (pState->typeCount != 0) ? ",\n {\"operation\":\"" : "\n {\"operation\":\"");
+   OutputString(pOutput, OperationTypeId(operationType));
+   OutputString(pOutput, "\",\"algorithms\":[");
+}
+
+/// <summary>
+/// Emit the object of one algorithm in one line.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <param name="pAlgorithm">Algorithm identifier from the enumeration.</param>
+/// <param name="pDetails">Capabilities of the algorithm or NULL, if it was not probed.</param>
+static void jsonEmitAlgorithm(EMITTER_STATE* const pState,
+                              const ULONG operationType,
+                              const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm,
+                              const ALGORITHM_DETAILS* const pDetails) {
+   OUTPUT_BUFFER* pOutput = pState->pOutput;
+   (void)operationType;
+
+   OutputString(pOutput, (pState->algorithmCount != 0) ? ",\n  {\"name\":" : "\n  {\"name\":");
+   outputJsonString(pOutput, pAlgorithm->pszName);
+   outputNumberMember(pOutput, ",\"class\":", pAlgorithm->dwClass);
+   outputNumberMember(pOutput, ",\"flags\":", pAlgorithm->dwFlags);
+
+   if (pDetails != NULL)
+      outputDetails(pOutput, pDetails);
+
+   OutputChar(pOutput, '}');
+}
+
+/// <summary>
+/// Emit the end of the object of an operation type.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void jsonEndType(EMITTER_STATE* const pState) {
+   OutputString(pState->pOutput, (pState->algorithmCount != 0) ? "\n ]}" : "]}");
+}
+
+/// <summary>
+/// Emit the end of the JSON document.
+/// </summary>
+/// <param name="pState">Emitter state.</param>
+static void jsonEndList(EMITTER_STATE* const pState) {
+   OutputString(pState->pOutput, (pState->typeCount != 0) ? "\n]}\n" : "]}\n");
+}
+
+// ******** Private constants ********
+
+/// The JSON emitter.
+static const LIST_EMITTER jsonEmitter = {
+   jsonBeginList,
+   jsonBeginType,
+   jsonEmitAlgorithm,
+   jsonEndType,
+   jsonEndList
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the JSON emitter.
+/// </summary>
+/// <returns>Pointer to the emitter.</returns>
+const LIST_EMITTER* GetJsonEmitter(void) {
+   return &jsonEmitter;
+}
@@ -0,0 +1,201 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// The slot table and the seed are generated by "KnownAlgorithmBench --generate".
+// It tries seeds until each name has a slot of its own. Run it again when a name is added.
+//
+
+#include <string.h>
+
+#include "KnownAlgorithms.h"
+
+// ******** Private constants ********
+
+/// FNV-1a offset basis.
+#define FNV_OFFSET_BASIS 0x811c9dc5u
+
+/// FNV-1a prime.
+#define FNV_PRIME        0x01000193u
+
+/// Operation types of an asymmetric cipher that also signs.
+#define SIGNING_CIPHER_OPERATIONS (BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION | BCRYPT_SIGNATURE_OPERATION)
+
+/// Id + 1 of the name in each slot of the perfect hash, or 0, if the slot is empty.
+static const UCHAR knownAlgorithmSlots[KNOWN_HASH_SLOT_COUNT] = {
+   23,  0,  0,  0,  0,  0,  2,  0,  0,  0,  0, 52, 30,  0, 35,  0,
+    0, 29,  0,  0,  0,  0,  1, 38,  0,  0,  0, 42,  0,  0, 17,  0,
+   33,  0,  0,  0, 10,  0, 16,  0,  0,  0,  0,  0, 37,  0,  0, 34,
+   24,  0, 25, 51, 39,  3,  0,  0, 19, 21,  0, 43, 22, 27,  0,  0,
+    0,  0, 48, 31,  0,  0,  0,  0,  9,  0, 11,  0,  6,  0,  0,  5,
+    0, 47, 15,  4, 20,  0, 50, 18,  0,  0,  0, 41,  0,  0,  0,  7,
+   28, 49,  0,  0,  0,  0,  0,  8, 32, 40, 36,  0,  0, 46,  0,  0,
+    0,  0,  0,  0, 44,  0, 26,  0,  0, 45,  0,  0, 14, 13, 12,  0
+};
+
+// ******** Public constants ********
+
+/// Documented algorithm identifiers in the order of bcrypt.h. The index is the dense id of the algorithm.
+const KNOWN_ALGORITHM KnownAlgorithms[KNOWN_ALGORITHM_COUNT] = {
+   { L"RSA",                ALGORITHM_FAMILY_ASYMMETRIC_CIPHER, SIGNING_CIPHER_OPERATIONS },
+   { L"RSA_SIGN",           ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"DH",                 ALGORITHM_FAMILY_KEY_AGREEMENT,     BCRYPT_SECRET_AGREEMENT_OPERATION },
+   { L"DSA",                ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"RC2",                ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"RC4",                ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"AES",                ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"DES",                ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"DESX",               ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"3DES",               ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"3DES_112",           ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"MD2",                ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"MD4",                ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"MD5",                ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"SHA1",               ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"SHA256",             ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"SHA384",             ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"SHA512",             ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"AES-GMAC",           ALGORITHM_FAMILY_MAC,               BCRYPT_HASH_OPERATION },
+   { L"AES-CMAC",           ALGORITHM_FAMILY_MAC,               BCRYPT_HASH_OPERATION },
+   { L"ECDSA_P256",         ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"ECDSA_P384",         ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"ECDSA_P521",         ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"ECDH_P256",          ALGORITHM_FAMILY_KEY_AGREEMENT,     BCRYPT_SECRET_AGREEMENT_OPERATION },
+   { L"ECDH_P384",          ALGORITHM_FAMILY_KEY_AGREEMENT,     BCRYPT_SECRET_AGREEMENT_OPERATION },
+   { L"ECDH_P521",          ALGORITHM_FAMILY_KEY_AGREEMENT,     BCRYPT_SECRET_AGREEMENT_OPERATION },
+   { L"RNG",                ALGORITHM_FAMILY_RNG,               BCRYPT_RNG_OPERATION },
+   { L"FIPS186DSARNG",      ALGORITHM_FAMILY_RNG,               BCRYPT_RNG_OPERATION },
+   { L"DUALECRNG",          ALGORITHM_FAMILY_RNG,               BCRYPT_RNG_OPERATION },
+   { L"SP800_108_CTR_HMAC", ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"SP800_56A_CONCAT",   ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"PBKDF2",             ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"CAPI_KDF",           ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"TLS1_1_KDF",         ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"TLS1_2_KDF",         ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"ECDSA",              ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"ECDH",               ALGORITHM_FAMILY_KEY_AGREEMENT,     BCRYPT_SECRET_AGREEMENT_OPERATION },
+   { L"XTS-AES",            ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"HKDF",               ALGORITHM_FAMILY_KEY_DERIVATION,    BCRYPT_KEY_DERIVATION_OPERATION },
+   { L"CHACHA20_POLY1305",  ALGORITHM_FAMILY_SYMMETRIC_CIPHER,  BCRYPT_CIPHER_OPERATION },
+   { L"SHA3-256",           ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"SHA3-384",           ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"SHA3-512",           ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"CSHAKE128",          ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"CSHAKE256",          ALGORITHM_FAMILY_HASH,              BCRYPT_HASH_OPERATION },
+   { L"KMAC128",            ALGORITHM_FAMILY_MAC,               BCRYPT_HASH_OPERATION },
+   { L"KMAC256",            ALGORITHM_FAMILY_MAC,               BCRYPT_HASH_OPERATION },
+   { L"ML-KEM",             ALGORITHM_FAMILY_ASYMMETRIC_CIPHER, BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION },
+   { L"ML-DSA",             ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"SLH-DSA",            ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"LMS",                ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION },
+   { L"XMSS",               ALGORITHM_FAMILY_SIGNATURE,         BCRYPT_SIGNATURE_OPERATION }
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Hash an algorithm name.
+/// This is FNV-1a with the seed mixed into the offset basis.
+/// With KNOWN_HASH_SEED the upper bits are the slot of the perfect hash, the lower bits can be used by other hash tables.
+/// </summary>
+/// <param name="name">Name.</param>
+/// <param name="seed">Seed of the hash.</param>
+/// <returns>Hash of the name.</returns>
+ULONG HashAlgorithmName(LPCWSTR const name, const ULONG seed) {
+   ULONG hash = FNV_OFFSET_BASIS ^ seed;
+
+   for (LPCWSTR p = name; *p != L'\0'; p++) {
+      hash ^= (ULONG) *p;
+      hash *= FNV_PRIME;
+   }
+
+   return hash;
+}
+
+/// <summary>
+/// Get the dense id of a documented algorithm identifier, whose hash is known.
+/// Each documented name has a slot of its own, so one comparison decides.
+/// </summary>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="hash">Hash of the name with KNOWN_HASH_SEED.</param>
+/// <returns>Id of the algorithm or -1, if the name is not a documented identifier.</returns>
+long FindHashedKnownAlgorithm(LPCWSTR const name, const ULONG hash) {
+   const ULONG entry = knownAlgorithmSlots[KNOWN_HASH_SLOT(hash)];
+   if (entry == 0)
+      return -1;
+
+   if (wcscmp(KnownAlgorithms[entry - 1].name, name) != 0)
+      return -1;
+
+   return (long) (entry - 1);
+}
+
+/// <summary>
+/// Get the dense id of a documented algorithm identifier.
+/// </summary>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <returns>Id of the algorithm or -1, if the name is not a documented identifier.</returns>
+long FindKnownAlgorithm(LPCWSTR const name) {
+   return FindHashedKnownAlgorithm(name, HashAlgorithmName(name, KNOWN_HASH_SEED));
+}
+
+/// <summary>
+/// Get the name of an algorithm family.
+/// </summary>
+/// <param name="family">Family.</param>
+/// <returns>Name of the family, e.g. "hash".</returns>
+const char* AlgorithmFamilyName(const ALGORITHM_FAMILY family) {
+   switch (family) {
+   case ALGORITHM_FAMILY_SYMMETRIC_CIPHER:
+      return "symmetric_cipher";
+
+   case ALGORITHM_FAMILY_HASH:
+      return "hash";
+
+   case ALGORITHM_FAMILY_MAC:
+      return "mac";
+
+   case ALGORITHM_FAMILY_ASYMMETRIC_CIPHER:
+      return "asymmetric_cipher";
+
+   case ALGORITHM_FAMILY_SIGNATURE:
+      return "signature";
+
+   case ALGORITHM_FAMILY_KEY_AGREEMENT:
+      return "key_agreement";
+
+   case ALGORITHM_FAMILY_RNG:
+      return "rng";
+
+   case ALGORITHM_FAMILY_KEY_DERIVATION:
+      return "key_derivation";
+
+   default:
+      return "unknown";
+   }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Platform.h"
+
+/// <summary>
+/// Family of a documented algorithm.
+/// </summary>
+typedef enum _ALGORITHM_FAMILY {
+   ALGORITHM_FAMILY_SYMMETRIC_CIPHER,
+   ALGORITHM_FAMILY_HASH,
+   ALGORITHM_FAMILY_MAC,
+   ALGORITHM_FAMILY_ASYMMETRIC_CIPHER,
+   ALGORITHM_FAMILY_SIGNATURE,
+   ALGORITHM_FAMILY_KEY_AGREEMENT,
+   ALGORITHM_FAMILY_RNG,
+   ALGORITHM_FAMILY_KEY_DERIVATION
+} ALGORITHM_FAMILY;
+
+/// <summary>
+/// Documented CNG algorithm identifier (BCRYPT_*_ALGORITHM).
+/// </summary>
+typedef struct _KNOWN_ALGORITHM {
+   /// Name of the algorithm.
+   LPCWSTR name;
+
+   /// Family of the algorithm.
+   ALGORITHM_FAMILY family;
+
+   /// BCRYPT_*_OPERATION bit mask of the operation types the algorithm is expected to support.
+   ULONG operations;
+} KNOWN_ALGORITHM;
+
+/// Number of documented algorithm identifiers.
+#define KNOWN_ALGORITHM_COUNT 52
+
+/// Number of 64 bit words of a set of known algorithm ids.
+#define KNOWN_SET_WORDS ((KNOWN_ALGORITHM_COUNT + 63) / 64)
+
+/// Number of bits of a slot of the perfect hash.
+#define KNOWN_HASH_SLOT_BITS 7
+
+/// Number of slots of the perfect hash.
+#define KNOWN_HASH_SLOT_COUNT (1 << KNOWN_HASH_SLOT_BITS)
+
+/// Seed of the perfect hash.
+#define KNOWN_HASH_SEED 0x00000f8bu
+
+/// Documented algorithm identifiers. The index is the dense id of the algorithm.
+extern const KNOWN_ALGORITHM KnownAlgorithms[KNOWN_ALGORITHM_COUNT];
+
+/// Slot of the perfect hash for the hash of a name. These are the upper bits of the hash.
+#define KNOWN_HASH_SLOT(hash) ((hash) >> (32 - KNOWN_HASH_SLOT_BITS))
+
+/// <summary>
+/// Hash an algorithm name.
+/// With KNOWN_HASH_SEED the upper bits are the slot of the perfect hash, the lower bits can be used by other hash tables.
+/// </summary>
+/// <param name="name">Name.</param>
+/// <param name="seed">Seed of the hash.</param>
+/// <returns>Hash of the name.</returns>
+ULONG HashAlgorithmName(LPCWSTR const name, const ULONG seed);
+
+/// <summary>
+/// Get the dense id of a documented algorithm identifier, whose hash is known.
+/// </summary>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <param name="hash">Hash of the name with KNOWN_HASH_SEED.</param>
+/// <returns>Id of the algorithm or -1, if the name is not a documented identifier.</returns>
+long FindHashedKnownAlgorithm(LPCWSTR const name, const ULONG hash);
+
+/// <summary>
+/// Get the dense id of a documented algorithm identifier.
+/// </summary>
+/// <param name="name">Exact name of the algorithm.</param>
+/// <returns>Id of the algorithm or -1, if the name is not a documented identifier.</returns>
+long FindKnownAlgorithm(LPCWSTR const name);
+
+/// <summary>
+/// Get the name of an algorithm family.
+/// </summary>
+/// <param name="family">Family.</param>
+/// <returns>Name of the family, e.g. "hash".</returns>
+const char* AlgorithmFamilyName(const ALGORITHM_FAMILY family);
@@ -0,0 +1,430 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#define _CRT_DISABLE_PERFCRIT_LOCKS 1
+
+#include <string.h>
+
+#include "ApiErrorHandler.h"
+#include "Console.h"
+#include "LatencyBenchmark.h"
+#include "LatencyHistogram.h"
+#include "NumberFormatter.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Key lengths in bits that are measured, if the algorithm supports them.
+static const ULONG standardKeyLengths[] = { 2048, 3072, 4096 };
+
+/// Number of standard key lengths.
+#define STANDARD_KEY_LENGTH_COUNT (sizeof(standardKeyLengths) / sizeof(standardKeyLengths[0]))
+
+/// Length of the signed hash value in bytes (SHA-256).
+#define HASH_LENGTH 32
+
+/// Size of the signature buffer in bytes. This is enough for 16384 bit RSA keys.
+#define MAX_SIGNATURE_SIZE 2048
+
+/// Minimum number of batches of each operation, even if the interval has passed.
+#define MIN_BATCH_COUNT 5
+
+/// Maximum number of samples of each operation, even if the interval has not passed.
+#define MAX_SAMPLE_COUNT 1000000ULL
+
+/// Latencies from this number of nanoseconds on are printed in milliseconds instead of microseconds.
+#define MILLISECOND_THRESHOLD_NS 10000000ULL
+
+// ******** Private types ********
+
+/// <summary>
+/// Measured operation.
+/// </summary>
+typedef enum _LATENCY_OPERATION {
+   LATENCY_OPERATION_KEY_GENERATION,
+   LATENCY_OPERATION_SIGN,
+   LATENCY_OPERATION_VERIFY
+} LATENCY_OPERATION;
+
+/// <summary>
+/// Objects of the measurement of one key length.
+/// </summary>
+typedef struct _LATENCY_RUN {
+   const CRYPTO_ENGINE* pEngine;
+   ENGINE_HANDLE hAlgorithm;
+   ULONG keyLength;
+
+   /// Key that signs and verifies.
+   ENGINE_HANDLE hKey;
+
+   /// Key of the last timed key generation.
+   ENGINE_HANDLE hGeneratedKey;
+
+   UCHAR hash[HASH_LENGTH];
+   UCHAR signature[MAX_SIGNATURE_SIZE];
+   ULONG signatureLength;
+} LATENCY_RUN;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the name of an operation.
+/// </summary>
+/// <param name="operation">Operation.</param>
+/// <returns>Name of the operation.</returns>
+static const char* operationName(const LATENCY_OPERATION operation) {
+   switch (operation) {
+   case LATENCY_OPERATION_KEY_GENERATION:
+      return "keygen";
+
+   case LATENCY_OPERATION_SIGN:
+      return "sign";
+
+   default:
+      return "verify";
+   }
+}
+
+/// <summary>
+/// Get the name of the engine function of an operation.
+/// </summary>
+/// <param name="operation">Operation.</param>
+/// <returns>Name of the engine function.</returns>
+static PCHAR operationApiName(const LATENCY_OPERATION operation) {
+   switch (operation) {
+   case LATENCY_OPERATION_KEY_GENERATION:
+      return "GenerateKeyPair";
+
+   case LATENCY_OPERATION_SIGN:
+      return "SignHash";
+
+   default:
+      return "VerifySignature";
+   }
+}
+
+/// <summary>
+/// Select the key lengths that are measured.
+/// These are the standard key lengths in the range of the algorithm.
+/// If there are none, e.g. for an elliptic curve, it is the smallest key length of the algorithm.
+/// </summary>
+/// <param name="minLength">Smallest key length of the algorithm.</param>
+/// <param name="maxLength">Largest key length of the algorithm.</param>
+/// <param name="increment">Step between two key lengths of the algorithm.</param>
+/// <param name="pKeyLengths">Array of at least STANDARD_KEY_LENGTH_COUNT elements that receives the key lengths.</param>
+/// <returns>Number of key lengths.</returns>
+static ULONG selectKeyLengths(const ULONG minLength, const ULONG maxLength, const ULONG increment, ULONG* const pKeyLengths) {
+   ULONG count = 0;
+   for (ULONG i = 0; i < STANDARD_KEY_LENGTH_COUNT; i++) {
+      ULONG keyLength = standardKeyLengths[i];
+      if (keyLength >= minLength &&
+          keyLength <= maxLength &&
+          (increment == 0 || (keyLength - minLength) % increment == 0))
+         pKeyLengths[count++] = keyLength;
+   }
+
+   if (count == 0)
+      pKeyLengths[count++] = minLength;
+
+   return count;
+}
+
+/// <summary>
+/// Run an operation once.
+/// </summary>
+/// <param name="pRun">Objects of the measurement.</param>
+/// <param name="operation">Operation.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static inline NTSTATUS runOperation(LATENCY_RUN* const pRun, const LATENCY_OPERATION operation) {
+   const CRYPTO_ENGINE* pEngine = pRun->pEngine;
+
+   switch (operation) {
+   case LATENCY_OPERATION_KEY_GENERATION:
+      return pEngine->GenerateKeyPair(pEngine->context, pRun->hAlgorithm, pRun->keyLength, &pRun->hGeneratedKey);
+
+   case LATENCY_OPERATION_SIGN:
+      return pEngine->SignHash(pEngine->context,
+                               pRun->hKey,
+                               pRun->hash,
+                               HASH_LENGTH,
+                               pRun->signature,
+                               MAX_SIGNATURE_SIZE,
+                               &pRun->signatureLength);
+
+   default:
+      return pEngine->VerifySignature(pEngine->context,
+                                      pRun->hKey,
+                                      pRun->hash,
+                                      HASH_LENGTH,
+                                      pRun->signature,
+                                      pRun->signatureLength);
+   }
+}
+
+/// <summary>
+/// Measure the latencies of an operation.
+/// The operation is run in batches until the interval has passed and at least MIN_BATCH_COUNT batches have been run.
+/// Each operation of a batch is recorded with the average latency of the batch.
+/// </summary>
+/// <param name="pRun">Objects of the measurement.</param>
+/// <param name="operation">Operation.</param>
+/// <param name="batchSize">Number of operations that are timed together.</param>
+/// <param name="intervalNs">Minimum duration of the measurement in nanoseconds.</param>
+/// <param name="pHistogram">Histogram that receives the latencies.</param>
+/// <returns>NTSTATUS of the operations.</returns>
+static NTSTATUS measureOperation(LATENCY_RUN* const pRun,
+                                 const LATENCY_OPERATION operation,
+                                 const ULONG batchSize,
+                                 const uint64_t intervalNs,
+                                 LATENCY_HISTOGRAM* const pHistogram) {
+   const CRYPTO_ENGINE* pEngine = pRun->pEngine;
+
+   ResetLatencyHistogram(pHistogram);
+
+   uint64_t totalNs = 0;
+   ULONG batchCount = 0;
+   while ((totalNs < intervalNs || batchCount < MIN_BATCH_COUNT) && pHistogram->count < MAX_SAMPLE_COUNT) {
+      uint64_t startTime = GetTimeNs();
+
+      for (ULONG i = 0; i < batchSize; i++) {
+         NTSTATUS nts = runOperation(pRun, operation);
+         if (nts < 0)
+            return nts;
+      }
+
+      uint64_t elapsedNs = GetTimeNs() - startTime;
+
+      // Destroying the generated key is not part of the key generation latency.
+      if (operation == LATENCY_OPERATION_KEY_GENERATION)
+         pEngine->DestroyKeyPair(pEngine->context, pRun->hGeneratedKey);
+
+      RecordLatencies(pHistogram, elapsedNs / batchSize, batchSize);
+
+      totalNs += elapsedNs;
+      batchCount++;
+   }
+
+   return 0;
+}
+
+/// <summary>
+/// Format a latency with a unit that keeps the number short.
+/// </summary>
+/// <param name="nanoseconds">Latency in nanoseconds.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE + 3 characters.</param>
+static void formatLatency(const uint64_t nanoseconds, char* const buffer) {
+   size_t length;
+   if (nanoseconds >= MILLISECOND_THRESHOLD_NS) {
+      length = FormatFixedPoint((double)nanoseconds / 1000000.0, 2, buffer);
+      memcpy(buffer + length, " ms", 4);
+   } else {
+      length = FormatFixedPoint((double)nanoseconds / 1000.0, 2, buffer);
+      memcpy(buffer + length, " us", 4);
+   }
+}
+
+/// <summary>
+/// Print the latency distribution of an operation.
+/// </summary>
+/// <param name="keyLength">Key length in bits.</param>
+/// <param name="operation">Operation.</param>
+/// <param name="pHistogram">Histogram of the latencies.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+static void printLatencies(const ULONG keyLength, const LATENCY_OPERATION operation, const LATENCY_HISTOGRAM* const pHistogram, FILE* fStdOut) {
+   char count[NUMBER_BUFFER_SIZE];
+   char p50[NUMBER_BUFFER_SIZE + 3];
+   char p99[NUMBER_BUFFER_SIZE + 3];
+   char p999[NUMBER_BUFFER_SIZE + 3];
+   char max[NUMBER_BUFFER_SIZE + 3];
+
+   FormatUint64(pHistogram->count, count);
+   formatLatency(GetLatencyPercentile(pHistogram, 50.0), p50);
+   formatLatency(GetLatencyPercentile(pHistogram, 99.0), p99);
+   formatLatency(GetLatencyPercentile(pHistogram, 99.9), p999);
+   formatLatency(pHistogram->max, max);
+
+   fprintf(fStdOut,
+           "      %8lu  %-9s %9s %12s %12s %12s %12s\n",
+           (unsigned long)keyLength,
+           operationName(operation),
+           count,
+           p50,
+           p99,
+           p999,
+           max);
+}
+
+/// <summary>
+/// Measure all operations with one key length.
+/// </summary>
+/// <param name="pRun">Objects of the measurement with the algorithm and the key length set.</param>
+/// <param name="batchSize">Number of signatures or verifications that are timed together.</param>
+/// <param name="intervalNs">Minimum duration of the measurement of each operation in nanoseconds.</param>
+/// <param name="pHistogram">Histogram for the latencies.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the key length could be measured or the engine can not generate such keys, FALSE if an operation failed.</returns>
+static BOOL measureKeyLength(LATENCY_RUN* const pRun,
+                             const ULONG batchSize,
+                             const uint64_t intervalNs,
+                             LATENCY_HISTOGRAM* const pHistogram,
+                             FILE* fStdOut) {
+   const PCHAR functionName = "measureKeyLength";
+
+   const CRYPTO_ENGINE* pEngine = pRun->pEngine;
+
+   // 1. Generate the key for signing and verifying. This also warms up the key generation.
+   NTSTATUS nts = pEngine->GenerateKeyPair(pEngine->context, pRun->hAlgorithm, pRun->keyLength, &pRun->hKey);
+   if (nts < 0) {
+      fprintf(fStdOut, "      %8lu  Could not generate key: 0x%08lx\n", (unsigned long)pRun->keyLength, (unsigned long)(ULONG)nts);
+      return TRUE;
+   }
+
+   // 2. Warm up the signature and the verification. The signature is the one that is verified later.
+   LATENCY_OPERATION operation = LATENCY_OPERATION_SIGN;
+   nts = runOperation(pRun, operation);
+   if (nts >= 0) {
+      operation = LATENCY_OPERATION_VERIFY;
+      nts = runOperation(pRun, operation);
+   }
+
+   // 3. Measure the operations.
+   if (nts >= 0) {
+      static const LATENCY_OPERATION operations[] = {
+         LATENCY_OPERATION_KEY_GENERATION,
+         LATENCY_OPERATION_SIGN,
+         LATENCY_OPERATION_VERIFY
+      };
+
+      for (ULONG i = 0; i < sizeof(operations) / sizeof(operations[0]); i++) {
+         operation = operations[i];
+         ULONG operationBatchSize = (operation == LATENCY_OPERATION_KEY_GENERATION) ? 1 : batchSize;
+         nts = measureOperation(pRun, operation, operationBatchSize, intervalNs, pHistogram);
+         if (nts < 0)
+            break;
+
+         printLatencies(pRun->keyLength, operation, pHistogram, fStdOut);
+         fflush(fStdOut);
+      }
+   }
+
+   pEngine->DestroyKeyPair(pEngine->context, pRun->hKey);
+
+   if (nts < 0) {
+      PrintNtStatus(functionName, operationApiName(operation), nts);
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Measure the latency distribution of the key generation, the signature and the verification of an asymmetric algorithm.
+/// RSA is measured with the standard key lengths the algorithm supports, elliptic curves with the length of their curve.
+/// </summary>
+/// <param name="pEngine">Crypto engine that runs the algorithm.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="batchSize">Number of signatures or verifications that are timed together. Key generations are always timed one by one.</param>
+/// <param name="intervalNs">Minimum duration of the measurement of each operation in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+BOOL MeasureLatency(const CRYPTO_ENGINE* const pEngine,
+                    LPCWSTR const algorithmName,
+                    const ULONG batchSize,
+                    const uint64_t intervalNs,
+                    FILE* fStdOut) {
+   const PCHAR functionName = "MeasureLatency";
+
+   fputs("   ", fStdOut);
+   fputs(AsConsoleCodePageString(algorithmName), fStdOut);
+   if (batchSize > 1)
+      fprintf(fStdOut, " (batches of %lu signatures)", (unsigned long)batchSize);
+   _putc_nolock('\n', fStdOut);
+
+   // 1. Open the algorithm and get its key lengths.
+   //    Algorithms the engine does not implement are skipped.
+   LATENCY_RUN* pRun = HeapAlloc(GetProcessHeap(), 0, sizeof(LATENCY_RUN));
+   if (pRun == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for measurement data failed.\n", functionName);
+      return FALSE;
+   }
+
+   memset(pRun, 0, sizeof(LATENCY_RUN));
+   pRun->pEngine = pEngine;
+   for (ULONG i = 0; i < HASH_LENGTH; i++)
+      pRun->hash[i] = (UCHAR)(i * 29 + 3);
+
+   ULONG minLength = 0;
+   ULONG maxLength = 0;
+   ULONG increment = 0;
+   NTSTATUS nts = pEngine->OpenAlgorithm(pEngine->context, algorithmName, &pRun->hAlgorithm);
+   if (nts >= 0) {
+      nts = pEngine->GetKeyPairLengths(pEngine->context, pRun->hAlgorithm, &minLength, &maxLength, &increment);
+      if (nts < 0)
+         pEngine->CloseAlgorithm(pEngine->context, pRun->hAlgorithm);
+   }
+
+   if (nts < 0) {
+      if (nts == STATUS_NOT_SUPPORTED)
+         fprintf(fStdOut, "      Not supported by engine %s\n", pEngine->name);
+      else
+         fprintf(fStdOut, "      Could not open algorithm: 0x%08lx\n", (unsigned long)(ULONG)nts);
+
+      HeapFree(GetProcessHeap(), 0, pRun);
+      return TRUE;
+   }
+
+   // 2. Allocate the histogram.
+   LATENCY_HISTOGRAM* pHistogram = HeapAlloc(GetProcessHeap(), 0, sizeof(LATENCY_HISTOGRAM));
+   if (pHistogram == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for latency histogram failed.\n", functionName);
+      pEngine->CloseAlgorithm(pEngine->context, pRun->hAlgorithm);
+      HeapFree(GetProcessHeap(), 0, pRun);
+      return FALSE;
+   }
+
+   // 3. Measure each key length.
+   ULONG keyLengths[STANDARD_KEY_LENGTH_COUNT];
+   ULONG keyLengthCount = selectKeyLengths(minLength, maxLength, increment, keyLengths);
+
+   fputs("      Key bits  Operation   Samples          p50          p99        p99.9          Max\n", fStdOut);
+
+   BOOL result = TRUE;
+   for (ULONG i = 0; i < keyLengthCount && result != FALSE; i++) {
+      pRun->keyLength = keyLengths[i];
+      result = measureKeyLength(pRun, batchSize, intervalNs, pHistogram, fStdOut);
+   }
+
+   // 4. Release the objects.
+   HeapFree(GetProcessHeap(), 0, pHistogram);
+   pEngine->CloseAlgorithm(pEngine->context, pRun->hAlgorithm);
+   HeapFree(GetProcessHeap(), 0, pRun);
+
+   return result;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "CryptoEngine.h"
+
+/// <summary>
+/// Measure the latency distribution of the key generation, the signature and the verification of an asymmetric algorithm.
+/// RSA is measured with the standard key lengths the algorithm supports, elliptic curves with the length of their curve.
+/// </summary>
+/// <param name="pEngine">Crypto engine that runs the algorithm.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="batchSize">Number of signatures or verifications that are timed together. Key generations are always timed one by one.</param>
+/// <param name="intervalNs">Minimum duration of the measurement of each operation in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+BOOL MeasureLatency(const CRYPTO_ENGINE* const pEngine,
+                    LPCWSTR const algorithmName,
+                    const ULONG batchSize,
+                    const uint64_t intervalNs,
+                    FILE* fStdOut);
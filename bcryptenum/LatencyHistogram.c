@@ -0,0 +1,201 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.1
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.0.1: One bucket group more, so that the largest value fits.
+//
+
+#include <assert.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "LatencyHistogram.h"
+
+// ******** Private constants ********
+
+/// Number of sub-buckets of a power of 2 range.
+#define SUB_BUCKET_COUNT (1UL << LATENCY_SUB_BUCKET_BITS)
+
+/// Largest value that is recorded.
+#define MAX_VALUE ((1ULL << LATENCY_VALUE_BITS) - 1)
+
+/// Shift of the largest value in bucketIndex.
+#define MAX_VALUE_SHIFT (LATENCY_VALUE_BITS - (LATENCY_SUB_BUCKET_BITS + 1))
+
+/// Bucket of the largest value, computed like bucketIndex does.
+#define MAX_VALUE_BUCKET ((MAX_VALUE_SHIFT << LATENCY_SUB_BUCKET_BITS) + (MAX_VALUE >> MAX_VALUE_SHIFT))
+
+static_assert(MAX_VALUE_BUCKET < LATENCY_BUCKET_COUNT, "The largest value does not fit into the buckets.");
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the number of significant bits of a number.
+/// </summary>
+/// <param name="value">Number.</param>
+/// <returns>Number of significant bits. 0 for 0.</returns>
+static inline ULONG bitLength(const uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+   unsigned long index;
+   return (_BitScanReverse64(&index, value) != 0) ? (ULONG)index + 1 : 0;
+#elif defined(__GNUC__)
+   return (value != 0) ? 64 - (ULONG)__builtin_clzll(value) : 0;
+#else
+   ULONG length = 0;
+   for (uint64_t rest = value; rest != 0; rest >>= 1)
+      length++;
+
+   return length;
+#endif
+}
+
+/// <summary>
+/// Get the bucket of a value.
+/// The first 2 * SUB_BUCKET_COUNT buckets hold one value each.
+/// Above that, each power of 2 range is divided into SUB_BUCKET_COUNT buckets.
+/// </summary>
+/// <param name="value">Value that is not larger than MAX_VALUE.</param>
+/// <returns>Index of the bucket.</returns>
+static inline ULONG bucketIndex(const uint64_t value) {
+   ULONG length = bitLength(value);
+   if (length <= LATENCY_SUB_BUCKET_BITS + 1)
+      return (ULONG)value;
+
+   ULONG shift = length - (LATENCY_SUB_BUCKET_BITS + 1);
+
+   return (shift << LATENCY_SUB_BUCKET_BITS) + (ULONG)(value >> shift);
+}
+
+/// <summary>
+/// Get the smallest value of a bucket.
+/// </summary>
+/// <param name="index">Index of the bucket.</param>
+/// <returns>Smallest value of the bucket.</returns>
+static inline uint64_t bucketLowerBound(const ULONG index) {
+   if (index < 2 * SUB_BUCKET_COUNT)
+      return index;
+
+   ULONG shift = (index >> LATENCY_SUB_BUCKET_BITS) - 1;
+
+   return (uint64_t)((index & (SUB_BUCKET_COUNT - 1)) + SUB_BUCKET_COUNT) << shift;
+}
+
+/// <summary>
+/// Get the width of a bucket.
+/// </summary>
+/// <param name="index">Index of the bucket.</param>
+/// <returns>Number of values of the bucket.</returns>
+static inline uint64_t bucketWidth(const ULONG index) {
+   if (index < 2 * SUB_BUCKET_COUNT)
+      return 1;
+
+   return 1ULL << ((index >> LATENCY_SUB_BUCKET_BITS) - 1);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Remove all values from a histogram.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+void ResetLatencyHistogram(LATENCY_HISTOGRAM* const pHistogram) {
+   memset(pHistogram, 0, sizeof(LATENCY_HISTOGRAM));
+}
+
+/// <summary>
+/// Record a value several times, e.g. the average latency of a batch of operations.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+/// <param name="value">Value in nanoseconds.</param>
+/// <param name="count">Number of times the value is recorded.</param>
+void RecordLatencies(LATENCY_HISTOGRAM* const pHistogram, const uint64_t value, const uint64_t count) {
+   if (count == 0)
+      return;
+
+   uint64_t clampedValue = (value > MAX_VALUE) ? MAX_VALUE : value;
+
+   if (pHistogram->count == 0 || clampedValue < pHistogram->min)
+      pHistogram->min = clampedValue;
+
+   if (clampedValue > pHistogram->max)
+      pHistogram->max = clampedValue;
+
+   pHistogram->count += count;
+   pHistogram->sum += clampedValue * count;
+   pHistogram->buckets[bucketIndex(clampedValue)] += count;
+}
+
+/// <summary>
+/// Record a value.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+/// <param name="value">Value in nanoseconds.</param>
+void RecordLatency(LATENCY_HISTOGRAM* const pHistogram, const uint64_t value) {
+   RecordLatencies(pHistogram, value, 1);
+}
+
+/// <summary>
+/// Get the value below which a percentage of the recorded values lie.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+/// <param name="percentile">Percentage between 0 and 100, e.g. 99.9.</param>
+/// <returns>Middle of the bucket that contains the percentile, limited by the smallest and largest value. 0, if the histogram is empty.</returns>
+uint64_t GetLatencyPercentile(const LATENCY_HISTOGRAM* const pHistogram, const double percentile) {
+   if (pHistogram->count == 0)
+      return 0;
+
+   // 1. Get the rank of the percentile. It is at least 1, so that the 0th percentile is the smallest value.
+   double exactRank = (percentile / 100.0) * (double)pHistogram->count;
+   uint64_t rank = (uint64_t)exactRank;
+   if ((double)rank < exactRank)
+      rank++;
+
+   if (rank == 0)
+      rank = 1;
+   else if (rank > pHistogram->count)
+      rank = pHistogram->count;
+
+   // 2. Find the bucket that holds the value with this rank.
+   uint64_t seen = 0;
+   ULONG index = 0;
+   for (; index < LATENCY_BUCKET_COUNT - 1; index++) {
+      seen += pHistogram->buckets[index];
+      if (seen >= rank)
+         break;
+   }
+
+   // 3. The middle of the bucket is at most half a bucket width away from any value in it.
+   uint64_t value = bucketLowerBound(index) + (bucketWidth(index) >> 1);
+   if (value < pHistogram->min)
+      value = pHistogram->min;
+
+   if (value > pHistogram->max)
+      value = pHistogram->max;
+
+   return value;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Platform.h"
+
+/// Number of bits of the sub-buckets of a power of 2 range.
+/// The relative error of a recorded value is at most 1 / 2^LATENCY_SUB_BUCKET_BITS.
+#define LATENCY_SUB_BUCKET_BITS 6
+
+/// Values are clamped to this number of bits (about 18 minutes in nanoseconds).
+#define LATENCY_VALUE_BITS 40
+
+/// Number of buckets of a histogram.
+/// The values below 2^(LATENCY_SUB_BUCKET_BITS + 1) take 2 groups, each further power of 2 one group.
+#define LATENCY_BUCKET_COUNT ((LATENCY_VALUE_BITS - LATENCY_SUB_BUCKET_BITS + 1) << LATENCY_SUB_BUCKET_BITS)
+
+/// <summary>
+/// Histogram of latencies with logarithmic buckets that are linearly divided, like an HDR histogram.
+/// Values below 2^(LATENCY_SUB_BUCKET_BITS + 1) are recorded exactly.
+/// </summary>
+typedef struct _LATENCY_HISTOGRAM {
+   /// Number of recorded values.
+   uint64_t count;
+
+   /// Smallest recorded value.
+   uint64_t min;
+
+   /// Largest recorded value.
+   uint64_t max;
+
+   /// Sum of the recorded values.
+   uint64_t sum;
+
+   /// Number of values per bucket.
+   uint64_t buckets[LATENCY_BUCKET_COUNT];
+} LATENCY_HISTOGRAM;
+
+/// <summary>
+/// Remove all values from a histogram.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+void ResetLatencyHistogram(LATENCY_HISTOGRAM* const pHistogram);
+
+/// <summary>
+/// Record a value several times, e.g. the average latency of a batch of operations.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+/// <param name="value">Value in nanoseconds.</param>
+/// <param name="count">Number of times the value is recorded.</param>
+void RecordLatencies(LATENCY_HISTOGRAM* const pHistogram, const uint64_t value, const uint64_t count);
+
+/// <summary>
+/// Record a value.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+/// <param name="value">Value in nanoseconds.</param>
+void RecordLatency(LATENCY_HISTOGRAM* const pHistogram, const uint64_t value);
+
+/// <summary>
+/// Get the value below which a percentage of the recorded values lie.
+/// </summary>
+/// <param name="pHistogram">Histogram.</param>
+/// <param name="percentile">Percentage between 0 and 100, e.g. 99.9.</param>
+/// <returns>Middle of the bucket that contains the percentile, limited by the smallest and largest value. 0, if the histogram is empty.</returns>
+uint64_t GetLatencyPercentile(const LATENCY_HISTOGRAM* const pHistogram, const double percentile);
@@ -0,0 +1,682 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: RSA and ECDSA key pairs, signatures and verification.
+//    2026-10-16: V1.2.0: Random numbers from RAND_bytes and getrandom.
+//
+
+//
+// Crypto engine that maps the CNG algorithm names to OpenSSL libcrypto algorithms.
+// This makes it possible to run the benchmarks on platforms without CNG.
+//
+
+#include <errno.h>
+#include <string.h>
+#include <sys/random.h>
+#include <wchar.h>
+
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/rand.h>
+#include <openssl/rsa.h>
+
+#include "CryptoEngine.h"
+
+// ******** Private constants ********
+
+/// Maximum size of a symmetric key in bytes.
+#define MAX_KEY_SIZE 64
+
+/// Maximum size of a block in bytes.
+#define MAX_BLOCK_SIZE 32
+
+/// Smallest RSA key length in bits. The range is the one of CNG.
+#define MIN_RSA_KEY_LENGTH 512
+
+/// Largest RSA key length in bits.
+#define MAX_RSA_KEY_LENGTH 16384
+
+/// Step between two RSA key lengths in bits.
+#define RSA_KEY_LENGTH_INCREMENT 64
+
+/// CNG name of the default random number generator. It is mapped to RAND_bytes.
+#define RNG_ALGORITHM_NAME L"RNG"
+
+// ******** Private types ********
+
+/// <summary>
+/// Mapping of a CNG algorithm name to an OpenSSL algorithm name.
+/// </summary>
+typedef struct _NAME_MAPPING {
+   LPCWSTR cngName;
+   const char* openSslName;
+   BOOL isCipher;
+} NAME_MAPPING;
+
+/// <summary>
+/// Mapping of a CNG asymmetric algorithm name to an OpenSSL key type.
+/// </summary>
+typedef struct _KEY_PAIR_MAPPING {
+   LPCWSTR cngName;
+   int keyType;
+
+   /// Curve of an elliptic curve algorithm, 0 for RSA.
+   int curveNid;
+
+   /// Key length of an elliptic curve algorithm in bits, 0 for RSA.
+   ULONG keyLength;
+} KEY_PAIR_MAPPING;
+
+/// <summary>
+/// Opened algorithm.
+/// </summary>
+typedef struct _LIBCRYPTO_ALGORITHM {
+   EVP_MD* pDigest;
+   EVP_CIPHER* pCipher;
+   const KEY_PAIR_MAPPING* pKeyPair;
+   BOOL isRng;
+} LIBCRYPTO_ALGORITHM;
+
+/// <summary>
+/// Key object.
+/// </summary>
+typedef struct _LIBCRYPTO_KEY {
+   EVP_CIPHER_CTX* pContext;
+   ULONG blockLength;
+} LIBCRYPTO_KEY;
+
+/// <summary>
+/// Key pair with the contexts for signing and verifying, so that they are not set up for every signature.
+/// </summary>
+typedef struct _LIBCRYPTO_KEY_PAIR {
+   EVP_PKEY* pKey;
+   EVP_PKEY_CTX* pSignContext;
+   EVP_PKEY_CTX* pVerifyContext;
+} LIBCRYPTO_KEY_PAIR;
+
+// ******** Private constants ********
+
+/// Known algorithms. Block ciphers use the CBC mode, which is the default of CNG.
+static const NAME_MAPPING nameMappings[] = {
+   { L"MD4",      "MD4",          FALSE },
+   { L"MD5",      "MD5",          FALSE },
+   { L"SHA1",     "SHA1",         FALSE },
+   { L"SHA256",   "SHA256",       FALSE },
+   { L"SHA384",   "SHA384",       FALSE },
+   { L"SHA512",   "SHA512",       FALSE },
+   { L"SHA3-256", "SHA3-256",     FALSE },
+   { L"SHA3-384", "SHA3-384",     FALSE },
+   { L"SHA3-512", "SHA3-512",     FALSE },
+   { L"AES",      "AES-128-CBC",  TRUE },
+   { L"DES",      "DES-CBC",      TRUE },
+   { L"DESX",     "DESX-CBC",     TRUE },
+   { L"3DES",     "DES-EDE3-CBC", TRUE },
+   { L"3DES_112", "DES-EDE-CBC",  TRUE },
+   { L"RC2",      "RC2-CBC",      TRUE },
+   { L"RC4",      "RC4",          TRUE }
+};
+
+/// Known asymmetric algorithms. RSA_SIGN is an RSA key that is only used for signatures.
+static const KEY_PAIR_MAPPING keyPairMappings[] = {
+   { L"RSA",        EVP_PKEY_RSA, 0,                      0 },
+   { L"RSA_SIGN",   EVP_PKEY_RSA, 0,                      0 },
+   { L"ECDSA_P256", EVP_PKEY_EC,  NID_X9_62_prime256v1,   256 },
+   { L"ECDSA_P384", EVP_PKEY_EC,  NID_secp384r1,          384 },
+   { L"ECDSA_P521", EVP_PKEY_EC,  NID_secp521r1,          521 }
+};
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get an OpenSSL digest by name.
+/// </summary>
+/// <param name="name">OpenSSL name of the digest.</param>
+/// <returns>Digest or NULL, if it is not available.</returns>
+static EVP_MD* fetchDigest(const char* const name) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+   // Explicitly fetched digests avoid the implicit fetch on every initialization.
+   return EVP_MD_fetch(NULL, name, NULL);
+#else
+   return (EVP_MD*)EVP_get_digestbyname(name);
+#endif
+}
+
+/// <summary>
+/// Get an OpenSSL cipher by name.
+/// </summary>
+/// <param name="name">OpenSSL name of the cipher.</param>
+/// <returns>Cipher or NULL, if it is not available.</returns>
+static EVP_CIPHER* fetchCipher(const char* const name) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+   return EVP_CIPHER_fetch(NULL, name, NULL);
+#else
+   return (EVP_CIPHER*)EVP_get_cipherbyname(name);
+#endif
+}
+
+/// <summary>
+/// Open an algorithm.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="algorithmName">CNG name of the algorithm.</param>
+/// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, ENGINE_HANDLE* const phAlgorithm) {
+   (void)context;
+
+   // 1. Find the OpenSSL algorithm.
+   const NAME_MAPPING* pMapping = NULL;
+   for (size_t i = 0; i < sizeof(nameMappings) / sizeof(nameMappings[0]); i++)
+      if (wcscmp(algorithmName, nameMappings[i].cngName) == 0) {
+         pMapping = nameMappings + i;
+         break;
+      }
+
+   const KEY_PAIR_MAPPING* pKeyPair = NULL;
+   for (size_t i = 0; pMapping == NULL && i < sizeof(keyPairMappings) / sizeof(keyPairMappings[0]); i++)
+      if (wcscmp(algorithmName, keyPairMappings[i].cngName) == 0)
+         pKeyPair = keyPairMappings + i;
+
+   BOOL isRng = (wcscmp(algorithmName, RNG_ALGORITHM_NAME) == 0);
+
+   if (pMapping == NULL && pKeyPair == NULL && isRng == FALSE)
+      return STATUS_NOT_SUPPORTED;
+
+   LIBCRYPTO_ALGORITHM* pAlgorithm = HeapAlloc(GetProcessHeap(), 0, sizeof(LIBCRYPTO_ALGORITHM));
+   if (pAlgorithm == NULL)
+      return STATUS_NO_MEMORY;
+
+   pAlgorithm->pDigest = NULL;
+   pAlgorithm->pCipher = NULL;
+   pAlgorithm->pKeyPair = pKeyPair;
+   pAlgorithm->isRng = isRng;
+
+   // 2. Key pairs and random numbers need no fetch.
+   if (pMapping != NULL) {
+      if (pMapping->isCipher != FALSE)
+         pAlgorithm->pCipher = fetchCipher(pMapping->openSslName);
+      else
+         pAlgorithm->pDigest = fetchDigest(pMapping->openSslName);
+
+      // Legacy algorithms are not available in all OpenSSL configurations.
+      if (pAlgorithm->pCipher == NULL && pAlgorithm->pDigest == NULL) {
+         HeapFree(GetProcessHeap(), 0, pAlgorithm);
+         return STATUS_NOT_SUPPORTED;
+      }
+   }
+
+   *phAlgorithm = pAlgorithm;
+
+   return 0;
+}
+
+/// <summary>
+/// Close an algorithm.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+static void libCryptoCloseAlgorithm(PVOID const context, ENGINE_HANDLE const hAlgorithm) {
+   (void)context;
+
+   LIBCRYPTO_ALGORITHM* pAlgorithm = hAlgorithm;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+   EVP_MD_free(pAlgorithm->pDigest);
+   EVP_CIPHER_free(pAlgorithm->pCipher);
+#endif
+   HeapFree(GetProcessHeap(), 0, pAlgorithm);
+}
+
+/// <summary>
+/// Create a reusable hash object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="phHash">Pointer to the variable that receives the hash handle.</param>
+/// <param name="pHashLength">Pointer to the variable that receives the length of the hash value.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoCreateHash(PVOID const context, ENGINE_HANDLE const hAlgorithm, ENGINE_HANDLE* const phHash, ULONG* const pHashLength) {
+   (void)context;
+
+   const LIBCRYPTO_ALGORITHM* pAlgorithm = hAlgorithm;
+   if (pAlgorithm->pDigest == NULL)
+      return STATUS_NOT_SUPPORTED;
+
+   EVP_MD_CTX* pContext = EVP_MD_CTX_new();
+   if (pContext == NULL)
+      return STATUS_NO_MEMORY;
+
+   if (EVP_DigestInit_ex(pContext, pAlgorithm->pDigest, NULL) != 1) {
+      EVP_MD_CTX_free(pContext);
+      return STATUS_NOT_SUPPORTED;
+   }
+
+   *phHash = pContext;
+   *pHashLength = (ULONG)EVP_MD_size(pAlgorithm->pDigest);
+
+   return 0;
+}
+
+/// <summary>
+/// Hash data.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hHash">Hash handle.</param>
+/// <param name="pInput">Data to hash.</param>
+/// <param name="inputLength">Length of the data.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoHashData(PVOID const context, ENGINE_HANDLE const hHash, const PUCHAR pInput, const ULONG inputLength) {
+   (void)context;
+
+   return (EVP_DigestUpdate(hHash, pInput, inputLength) == 1) ? 0 : STATUS_INVALID_PARAMETER;
+}
+
+/// <summary>
+/// Finish a hash and reset the hash object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hHash">Hash handle.</param>
+/// <param name="pOutput">Buffer that receives the hash value.</param>
+/// <param name="outputLength">Length of the hash value (unused).</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoFinishHash(PVOID const context, ENGINE_HANDLE const hHash, PUCHAR const pOutput, const ULONG outputLength) {
+   (void)context;
+   (void)outputLength;
+
+   EVP_MD_CTX* pContext = hHash;
+   if (EVP_DigestFinal_ex(pContext, pOutput, NULL) != 1)
+      return STATUS_INVALID_PARAMETER;
+
+   // Initializing with a NULL digest reuses the digest of the context.
+   return (EVP_DigestInit_ex(pContext, NULL, NULL) == 1) ? 0 : STATUS_INVALID_PARAMETER;
+}
+
+/// <summary>
+/// Destroy a hash object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hHash">Hash handle.</param>
+static void libCryptoDestroyHash(PVOID const context, ENGINE_HANDLE const hHash) {
+   (void)context;
+
+   EVP_MD_CTX_free(hHash);
+}
+
+/// <summary>
+/// Create a key object with the default key length of the cipher.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="phKey">Pointer to the variable that receives the key handle.</param>
+/// <param name="pBlockLength">Pointer to the variable that receives the block length.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoGenerateKey(PVOID const context, ENGINE_HANDLE const hAlgorithm, ENGINE_HANDLE* const phKey, ULONG* const pBlockLength) {
+   (void)context;
+
+   const LIBCRYPTO_ALGORITHM* pAlgorithm = hAlgorithm;
+   if (pAlgorithm->pCipher == NULL)
+      return STATUS_NOT_SUPPORTED;
+
+   int keyLength = EVP_CIPHER_key_length(pAlgorithm->pCipher);
+   if (keyLength <= 0 || keyLength > MAX_KEY_SIZE || EVP_CIPHER_iv_length(pAlgorithm->pCipher) > MAX_BLOCK_SIZE)
+      return STATUS_NOT_SUPPORTED;
+
+   UCHAR key[MAX_KEY_SIZE];
+   for (int i = 0; i < MAX_KEY_SIZE; i++)
+      key[i] = (UCHAR)(i * 37 + 11);
+
+   UCHAR iv[MAX_BLOCK_SIZE] = { 0 };
+
+   EVP_CIPHER_CTX* pContext = EVP_CIPHER_CTX_new();
+   if (pContext == NULL)
+      return STATUS_NO_MEMORY;
+
+   if (EVP_EncryptInit_ex(pContext, pAlgorithm->pCipher, NULL, key, iv) != 1) {
+      EVP_CIPHER_CTX_free(pContext);
+      return STATUS_NOT_SUPPORTED;
+   }
+
+   EVP_CIPHER_CTX_set_padding(pContext, 0);
+
+   LIBCRYPTO_KEY* pKey = HeapAlloc(GetProcessHeap(), 0, sizeof(LIBCRYPTO_KEY));
+   if (pKey == NULL) {
+      EVP_CIPHER_CTX_free(pContext);
+      return STATUS_NO_MEMORY;
+   }
+
+   pKey->pContext = pContext;
+   pKey->blockLength = (ULONG)EVP_CIPHER_block_size(pAlgorithm->pCipher);
+
+   *phKey = pKey;
+   *pBlockLength = pKey->blockLength;
+
+   return 0;
+}
+
+/// <summary>
+/// Encrypt data without padding.
+/// Like CNG, the initialization vector is updated with the last cipher block.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key handle.</param>
+/// <param name="pInput">Data to encrypt.</param>
+/// <param name="inputLength">Length of the data.</param>
+/// <param name="pIv">Initialization vector or NULL.</param>
+/// <param name="pOutput">Buffer that receives the encrypted data.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoEncrypt(PVOID const context,
+                                 ENGINE_HANDLE const hKey,
+                                 const PUCHAR pInput,
+                                 const ULONG inputLength,
+                                 PUCHAR const pIv,
+                                 PUCHAR const pOutput) {
+   (void)context;
+
+   const LIBCRYPTO_KEY* pKey = hKey;
+   BOOL hasIv = (pIv != NULL && pKey->blockLength > 1);
+   if (hasIv != FALSE && EVP_EncryptInit_ex(pKey->pContext, NULL, NULL, NULL, pIv) != 1)
+      return STATUS_INVALID_PARAMETER;
+
+   int outputLength;
+   if (EVP_EncryptUpdate(pKey->pContext, pOutput, &outputLength, pInput, (int)inputLength) != 1)
+      return STATUS_INVALID_PARAMETER;
+
+   if (hasIv != FALSE && inputLength >= pKey->blockLength)
+      memcpy(pIv, pOutput + inputLength - pKey->blockLength, pKey->blockLength);
+
+   return 0;
+}
+
+/// <summary>
+/// Destroy a key object.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key handle.</param>
+static void libCryptoDestroyKey(PVOID const context, ENGINE_HANDLE const hKey) {
+   (void)context;
+
+   LIBCRYPTO_KEY* pKey = hKey;
+   EVP_CIPHER_CTX_free(pKey->pContext);
+   HeapFree(GetProcessHeap(), 0, pKey);
+}
+
+/// <summary>
+/// Get the key lengths of an asymmetric algorithm.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="pMinLength">Pointer to the variable that receives the smallest key length in bits.</param>
+/// <param name="pMaxLength">Pointer to the variable that receives the largest key length in bits.</param>
+/// <param name="pIncrement">Pointer to the variable that receives the step between two key lengths in bits.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoGetKeyPairLengths(PVOID const context,
+                                           ENGINE_HANDLE const hAlgorithm,
+                                           ULONG* const pMinLength,
+                                           ULONG* const pMaxLength,
+                                           ULONG* const pIncrement) {
+   (void)context;
+
+   const KEY_PAIR_MAPPING* pKeyPair = ((const LIBCRYPTO_ALGORITHM*)hAlgorithm)->pKeyPair;
+   if (pKeyPair == NULL)
+      return STATUS_NOT_SUPPORTED;
+
+   if (pKeyPair->keyType == EVP_PKEY_RSA) {
+      *pMinLength = MIN_RSA_KEY_LENGTH;
+      *pMaxLength = MAX_RSA_KEY_LENGTH;
+      *pIncrement = RSA_KEY_LENGTH_INCREMENT;
+   } else {
+      *pMinLength = pKeyPair->keyLength;
+      *pMaxLength = pKeyPair->keyLength;
+      *pIncrement = 0;
+   }
+
+   return 0;
+}
+
+/// <summary>
+/// Create a signing or verifying context of a key pair.
+/// The hash is SHA-256, RSA uses PKCS #1 v1.5 padding.
+/// </summary>
+/// <param name="pKey">Key pair.</param>
+/// <param name="isSigning">TRUE for a signing context, FALSE for a verifying context.</param>
+/// <returns>Context or NULL, if it could not be created.</returns>
+static EVP_PKEY_CTX* createSignatureContext(EVP_PKEY* const pKey, const BOOL isSigning) {
+   EVP_PKEY_CTX* pContext = EVP_PKEY_CTX_new(pKey, NULL);
+   if (pContext == NULL)
+      return NULL;
+
+   int rc = (isSigning != FALSE) ? EVP_PKEY_sign_init(pContext) : EVP_PKEY_verify_init(pContext);
+   if (rc == 1 && EVP_PKEY_base_id(pKey) == EVP_PKEY_RSA)
+      rc = EVP_PKEY_CTX_set_rsa_padding(pContext, RSA_PKCS1_PADDING);
+
+   if (rc == 1)
+      rc = EVP_PKEY_CTX_set_signature_md(pContext, EVP_sha256());
+
+   if (rc != 1) {
+      EVP_PKEY_CTX_free(pContext);
+      return NULL;
+   }
+
+   return pContext;
+}
+
+/// <summary>
+/// Destroy a key pair.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key pair handle.</param>
+static void libCryptoDestroyKeyPair(PVOID const context, ENGINE_HANDLE const hKey) {
+   (void)context;
+
+   LIBCRYPTO_KEY_PAIR* pKeyPair = hKey;
+   EVP_PKEY_CTX_free(pKeyPair->pSignContext);
+   EVP_PKEY_CTX_free(pKeyPair->pVerifyContext);
+   EVP_PKEY_free(pKeyPair->pKey);
+   HeapFree(GetProcessHeap(), 0, pKeyPair);
+}
+
+/// <summary>
+/// Generate a key pair.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Algorithm handle.</param>
+/// <param name="keyLength">Key length in bits. Elliptic curves only have the length of their curve.</param>
+/// <param name="phKey">Pointer to the variable that receives the key handle.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoGenerateKeyPair(PVOID const context, ENGINE_HANDLE const hAlgorithm, const ULONG keyLength, ENGINE_HANDLE* const phKey) {
+   const KEY_PAIR_MAPPING* pMapping = ((const LIBCRYPTO_ALGORITHM*)hAlgorithm)->pKeyPair;
+   if (pMapping == NULL)
+      return STATUS_NOT_SUPPORTED;
+
+   if (pMapping->keyType != EVP_PKEY_RSA && keyLength != pMapping->keyLength)
+      return STATUS_INVALID_PARAMETER;
+
+   // 1. Generate the key.
+   EVP_PKEY_CTX* pContext = EVP_PKEY_CTX_new_id(pMapping->keyType, NULL);
+   if (pContext == NULL)
+      return STATUS_NO_MEMORY;
+
+   int rc = EVP_PKEY_keygen_init(pContext);
+   if (rc == 1) {
+      if (pMapping->keyType == EVP_PKEY_RSA)
+         rc = EVP_PKEY_CTX_set_rsa_keygen_bits(pContext, (int)keyLength);
+      else
+         rc = EVP_PKEY_CTX_set_ec_paramgen_curve_nid(pContext, pMapping->curveNid);
+   }
+
+   EVP_PKEY* pKey = NULL;
+   if (rc == 1)
+      rc = EVP_PKEY_keygen(pContext, &pKey);
+
+   EVP_PKEY_CTX_free(pContext);
+
+   if (rc != 1)
+      return STATUS_INVALID_PARAMETER;
+
+   // 2. Set up the contexts for signing and verifying.
+   LIBCRYPTO_KEY_PAIR* pKeyPair = HeapAlloc(GetProcessHeap(), 0, sizeof(LIBCRYPTO_KEY_PAIR));
+   if (pKeyPair == NULL) {
+      EVP_PKEY_free(pKey);
+      return STATUS_NO_MEMORY;
+   }
+
+   pKeyPair->pKey = pKey;
+   pKeyPair->pSignContext = createSignatureContext(pKey, TRUE);
+   pKeyPair->pVerifyContext = createSignatureContext(pKey, FALSE);
+   if (pKeyPair->pSignContext == NULL || pKeyPair->pVerifyContext == NULL) {
+      libCryptoDestroyKeyPair(context, pKeyPair);
+      return STATUS_NOT_SUPPORTED;
+   }
+
+   *phKey = pKeyPair;
+
+   return 0;
+}
+
+/// <summary>
+/// Sign a SHA-256 hash value.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key pair handle.</param>
+/// <param name="pHash">Hash value.</param>
+/// <param name="hashLength">Length of the hash value.</param>
+/// <param name="pSignature">Buffer that receives the signature.</param>
+/// <param name="signatureCapacity">Size of the signature buffer.</param>
+/// <param name="pSignatureLength">Pointer to the variable that receives the length of the signature.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoSignHash(PVOID const context,
+                                  ENGINE_HANDLE const hKey,
+                                  const PUCHAR pHash,
+                                  const ULONG hashLength,
+                                  PUCHAR const pSignature,
+                                  const ULONG signatureCapacity,
+                                  ULONG* const pSignatureLength) {
+   (void)context;
+
+   const LIBCRYPTO_KEY_PAIR* pKeyPair = hKey;
+   size_t signatureLength = signatureCapacity;
+   if (EVP_PKEY_sign(pKeyPair->pSignContext, pSignature, &signatureLength, pHash, hashLength) != 1)
+      return STATUS_INVALID_PARAMETER;
+
+   *pSignatureLength = (ULONG)signatureLength;
+
+   return 0;
+}
+
+/// <summary>
+/// Verify the signature of a SHA-256 hash value.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hKey">Key pair handle.</param>
+/// <param name="pHash">Hash value.</param>
+/// <param name="hashLength">Length of the hash value.</param>
+/// <param name="pSignature">Signature.</param>
+/// <param name="signatureLength">Length of the signature.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoVerifySignature(PVOID const context,
+                                         ENGINE_HANDLE const hKey,
+                                         const PUCHAR pHash,
+                                         const ULONG hashLength,
+                                         const PUCHAR pSignature,
+                                         const ULONG signatureLength) {
+   (void)context;
+
+   const LIBCRYPTO_KEY_PAIR* pKeyPair = hKey;
+   int rc = EVP_PKEY_verify(pKeyPair->pVerifyContext, pSignature, signatureLength, pHash, hashLength);
+   if (rc == 1)
+      return 0;
+
+   return (rc == 0) ? STATUS_INVALID_SIGNATURE : STATUS_INVALID_PARAMETER;
+}
+
+/// <summary>
+/// Fill a buffer with random bytes.
+/// The system-preferred random number generator is the kernel's, which is read with getrandom.
+/// </summary>
+/// <param name="context">Engine context (unused).</param>
+/// <param name="hAlgorithm">Handle of a random number generator or NULL for the system-preferred random number generator.</param>
+/// <param name="pBuffer">Buffer that receives the random bytes.</param>
+/// <param name="length">Number of random bytes.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static NTSTATUS libCryptoGenRandom(PVOID const context, ENGINE_HANDLE const hAlgorithm, PUCHAR const pBuffer, const ULONG length) {
+   (void)context;
+
+   if (hAlgorithm != NULL) {
+      if (((const LIBCRYPTO_ALGORITHM*)hAlgorithm)->isRng == FALSE)
+         return STATUS_NOT_SUPPORTED;
+
+      return (RAND_bytes(pBuffer, (int)length) == 1) ? 0 : STATUS_INVALID_PARAMETER;
+   }
+
+   // getrandom may return fewer bytes than requested for large requests or when it is interrupted by a signal.
+   ULONG offset = 0;
+   while (offset < length) {
+      ssize_t readLength = getrandom(pBuffer + offset, length - offset, 0);
+      if (readLength < 0) {
+         if (errno == EINTR)
+            continue;
+
+         return STATUS_INVALID_PARAMETER;
+      }
+
+      offset += (ULONG)readLength;
+   }
+
+   return 0;
+}
+
+// ******** Private constants ********
+
+/// The libcrypto engine.
+static const CRYPTO_ENGINE libCryptoEngine = {
+   "libcrypto",
+   NULL,
+   libCryptoOpenAlgorithm,
+   libCryptoCloseAlgorithm,
+   libCryptoCreateHash,
+   libCryptoHashData,
+   libCryptoFinishHash,
+   libCryptoDestroyHash,
+   libCryptoGenerateKey,
+   libCryptoEncrypt,
+   libCryptoDestroyKey,
+   libCryptoGetKeyPairLengths,
+   libCryptoGenerateKeyPair,
+   libCryptoSignHash,
+   libCryptoVerifySignature,
+   libCryptoDestroyKeyPair,
+   libCryptoGenRandom
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the crypto engine that uses the OpenSSL libcrypto functions.
+/// </summary>
+/// <returns>Pointer to the libcrypto engine.</returns>
+const CRYPTO_ENGINE* GetLibCryptoEngine(void) {
+   return &libCryptoEngine;
+}
@@ -0,0 +1,186 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Interface of an operation type.
+//    2026-10-16: V1.2.0: Operation types are defined here.
+//
+
+#include <string.h>
+
+#include "ListEmitter.h"
+
+// ******** Private types ********
+
+/// <summary>
+/// Name of an output format.
+/// </summary>
+typedef struct _FORMAT_NAME {
+   const char* name;
+   LIST_FORMAT format;
+} FORMAT_NAME;
+
+// ******** Private constants ********
+
+/// Number of output formats.
+#define FORMAT_COUNT 4
+
+/// Names of the output formats.
+static const FORMAT_NAME formatNames[FORMAT_COUNT] = {
+   { "text", LIST_FORMAT_TEXT },
+   { "json", LIST_FORMAT_JSON },
+   { "csv",  LIST_FORMAT_CSV },
+   { "bin",  LIST_FORMAT_BINARY }
+};
+
+// ******** Public constants ********
+
+/// Operation types in the order they are listed.
+const ULONG OperationTypes[OPERATION_TYPE_COUNT] = {
+   BCRYPT_CIPHER_OPERATION,
+   BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION,
+   BCRYPT_HASH_OPERATION,
+   BCRYPT_SECRET_AGREEMENT_OPERATION,
+   BCRYPT_SIGNATURE_OPERATION,
+   BCRYPT_RNG_OPERATION,
+   BCRYPT_KEY_DERIVATION_OPERATION
+};
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the format with a name.
+/// </summary>
+/// <param name="formatName">Name of the format ("text", "json", "csv" or "bin").</param>
+/// <param name="pFormat">Pointer to the variable that receives the format.</param>
+/// <returns>TRUE, if the name is known, FALSE if not.</returns>
+BOOL ParseListFormat(const char* const formatName, LIST_FORMAT* const pFormat) {
+   for (int i = 0; i < FORMAT_COUNT; i++)
+      if (strcmp(formatName, formatNames[i].name) == 0) {
+         *pFormat = formatNames[i].format;
+         return TRUE;
+      }
+
+   return FALSE;
+}
+
+/// <summary>
+/// Get the identifier of an operation type for the machine readable formats.
+/// </summary>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>Identifier, e.g. "cipher" or "hash".</returns>
+const char* OperationTypeId(const ULONG operationType) {
+   switch (operationType) {
+   case BCRYPT_CIPHER_OPERATION:
+      return "cipher";
+
+   case BCRYPT_HASH_OPERATION:
+      return "hash";
+
+   case BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION:
+      return "asymmetric_encryption";
+
+   case BCRYPT_SECRET_AGREEMENT_OPERATION:
+      return "secret_agreement";
+
+   case BCRYPT_SIGNATURE_OPERATION:
+      return "signature";
+
+   case BCRYPT_RNG_OPERATION:
+      return "rng";
+
+   case BCRYPT_KEY_DERIVATION_OPERATION:
+      return "key_derivation";
+
+   default:
+      return "unknown";
+   }
+}
+
+/// <summary>
+/// Get the title of an operation type for the text output.
+/// </summary>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>Title, e.g. "Symmetric ciphers", or NULL, if the type is not known.</returns>
+const char* OperationTypeTitle(const ULONG operationType) {
+   switch (operationType) {
+   case BCRYPT_CIPHER_OPERATION:
+      return "Symmetric ciphers";
+
+   case BCRYPT_HASH_OPERATION:
+      return "Hashes";
+
+   case BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION:
+      return "Asymmetric ciphers";
+
+   case BCRYPT_SECRET_AGREEMENT_OPERATION:
+      return "Secret agreements";
+
+   case BCRYPT_SIGNATURE_OPERATION:
+      return "Signatures";
+
+   case BCRYPT_RNG_OPERATION:
+      return "Pseudorandom Number Generators";
+
+   case BCRYPT_KEY_DERIVATION_OPERATION:
+      return "Key derivation";
+
+   default:
+      return NULL;
+   }
+}
+
+/// <summary>
+/// Get the provider interface of an operation type.
+/// </summary>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>BCRYPT_*_INTERFACE identifier or 0, if the type is not known.</returns>
+ULONG OperationTypeInterface(const ULONG operationType) {
+   switch (operationType) {
+   case BCRYPT_CIPHER_OPERATION:
+      return BCRYPT_CIPHER_INTERFACE;
+
+   case BCRYPT_HASH_OPERATION:
+      return BCRYPT_HASH_INTERFACE;
+
+   case BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION:
+      return BCRYPT_ASYMMETRIC_ENCRYPTION_INTERFACE;
+
+   case BCRYPT_SECRET_AGREEMENT_OPERATION:
+      return BCRYPT_SECRET_AGREEMENT_INTERFACE;
+
+   case BCRYPT_SIGNATURE_OPERATION:
+      return BCRYPT_SIGNATURE_INTERFACE;
+
+   case BCRYPT_RNG_OPERATION:
+      return BCRYPT_RNG_INTERFACE;
+
+   case BCRYPT_KEY_DERIVATION_OPERATION:
+      return BCRYPT_KEY_DERIVATION_INTERFACE;
+
+   default:
+      return 0;
+   }
+}
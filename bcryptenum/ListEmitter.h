@@ -0,0 +1,122 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "AlgorithmProbe.h"
+#include "OutputBuffer.h"
+
+/// <summary>
+/// Output formats of the algorithm lists.
+/// </summary>
+typedef enum _LIST_FORMAT {
+   LIST_FORMAT_TEXT,
+   LIST_FORMAT_JSON,
+   LIST_FORMAT_CSV,
+   LIST_FORMAT_BINARY
+} LIST_FORMAT;
+
+/// <summary>
+/// State of a list while it is emitted.
+/// </summary>
+typedef struct _EMITTER_STATE {
+   /// Output buffer.
+   OUTPUT_BUFFER* pOutput;
+
+   /// Number of operation types that have been ended.
+   ULONG typeCount;
+
+   /// Number of algorithms that have been emitted for the current operation type.
+   ULONG algorithmCount;
+} EMITTER_STATE;
+
+/// <summary>
+/// Emitter of an output format.
+/// The records are emitted while the lists are enumerated, directly from the enumeration buffers.
+/// The caller maintains the counts in the state.
+/// </summary>
+typedef struct _LIST_EMITTER {
+   /// <summary>
+   /// Emit the start of the list.
+   /// </summary>
+   /// <param name="pState">Emitter state.</param>
+   /// <param name="moduleName">Name of the module that implements the algorithms.</param>
+   /// <param name="pVersion">Version of the module or NULL, if it is not known.</param>
+   void (*BeginList)(EMITTER_STATE* const pState, const PCHAR moduleName, const MODULE_VERSION* const pVersion);
+
+   /// <summary>
+   /// Emit the start of the algorithms of an operation type.
+   /// </summary>
+   /// <param name="pState">Emitter state.</param>
+   /// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+   void (*BeginType)(EMITTER_STATE* const pState, const ULONG operationType);
+
+   /// <summary>
+   /// Emit one algorithm.
+   /// </summary>
+   /// <param name="pState">Emitter state.</param>
+   /// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+   /// <param name="pAlgorithm">Algorithm identifier from the enumeration.</param>
+   /// <param name="pDetails">Capabilities of the algorithm or NULL, if it was not probed.</param>
+   void (*EmitAlgorithm)(EMITTER_STATE* const pState,
+                         const ULONG operationType,
+                         const BCRYPT_ALGORITHM_IDENTIFIER* const pAlgorithm,
+                         const ALGORITHM_DETAILS* const pDetails);
+
+   /// <summary>
+   /// Emit the end of the algorithms of an operation type.
+   /// </summary>
+   /// <param name="pState">Emitter state.</param>
+   void (*EndType)(EMITTER_STATE* const pState);
+
+   /// <summary>
+   /// Emit the end of the list.
+   /// </summary>
+   /// <param name="pState">Emitter state.</param>
+   void (*EndList)(EMITTER_STATE* const pState);
+} LIST_EMITTER;
+
+/// <summary>
+/// Get the format with a name.
+/// </summary>
+/// <param name="formatName">Name of the format ("text", "json", "csv" or "bin").</param>
+/// <param name="pFormat">Pointer to the variable that receives the format.</param>
+/// <returns>TRUE, if the name is known, FALSE if not.</returns>
+BOOL ParseListFormat(const char* const formatName, LIST_FORMAT* const pFormat);
+
+/// <summary>
+/// Get the identifier of an operation type for the machine readable formats.
+/// </summary>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>Identifier, e.g. "cipher" or "hash".</returns>
+const char* OperationTypeId(const ULONG operationType);
+
+/// <summary>
+/// Get the title of an operation type for the text output.
+/// </summary>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>Title, e.g. "Symmetric ciphers", or NULL, if the type is not known.</returns>
+const char* OperationTypeTitle(const ULONG operationType);
+
+/// <summary>
+/// Get the provider interface of an operation type.
+/// </summary>
+/// <param name="operationType">BCRYPT_*_OPERATION type.</param>
+/// <returns>BCRYPT_*_INTERFACE identifier or 0, if the type is not known.</returns>
+ULONG OperationTypeInterface(const ULONG operationType);
+
+/// <summary>
+/// Get the JSON emitter.
+/// </summary>
+/// <returns>Pointer to the emitter.</returns>
+const LIST_EMITTER* GetJsonEmitter(void);
+
+/// <summary>
+/// Get the CSV emitter.
+/// </summary>
+/// <returns>Pointer to the emitter.</returns>
+const LIST_EMITTER* GetCsvEmitter(void);
+
+/// <summary>
+/// Get the binary emitter.
+/// </summary>
+/// <returns>Pointer to the emitter.</returns>
+const LIST_EMITTER* GetBinaryEmitter(void);
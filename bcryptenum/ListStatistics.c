@@ -0,0 +1,292 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Merge concurrent phases and print the elapsed time.
+//    2026-10-16: V1.2.0: Count allocations and peak bytes.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ListStatistics.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Names of the phases.
+static const char* const phaseNames[LIST_PHASE_COUNT] = {
+   "Module version",
+   "Cache",
+   "Enumeration",
+   "Pointer copy",
+   "Sort",
+   "Probe",
+   "Format",
+   "Write"
+};
+
+// ******** Private types ********
+
+/// <summary>
+/// Summary of one value over all runs.
+/// </summary>
+typedef struct _VALUE_SUMMARY {
+   uint64_t minimum;
+   uint64_t median;
+   uint64_t p99;
+} VALUE_SUMMARY;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Compare two values for qsort.
+/// </summary>
+/// <param name="pLeft">Pointer to the left value.</param>
+/// <param name="pRight">Pointer to the right value.</param>
+/// <returns>-1, 0 or 1.</returns>
+static int compareValues(const void* const pLeft, const void* const pRight) {
+   uint64_t left = *(const uint64_t*)pLeft;
+   uint64_t right = *(const uint64_t*)pRight;
+
+   return (left > right) - (left < right);
+}
+
+/// <summary>
+/// Sort the values and get the minimum, the median and the 99th percentile.
+/// The percentiles use the nearest rank.
+/// </summary>
+/// <param name="pValues">Values. They are sorted in place.</param>
+/// <param name="count">Number of values. Must not be 0.</param>
+/// <param name="pSummary">Pointer to the summary.</param>
+static void summarizeValues(uint64_t* const pValues, const ULONG count, VALUE_SUMMARY* const pSummary) {
+   qsort(pValues, count, sizeof(uint64_t), compareValues);
+
+   pSummary->minimum = pValues[0];
+   pSummary->median = pValues[(count - 1) / 2];
+   pSummary->p99 = pValues[(ULONG)(((uint64_t)count * 99 + 99) / 100) - 1];
+}
+
+/// <summary>
+/// Print one line with times in milliseconds.
+/// </summary>
+/// <param name="fStats">File to print to.</param>
+/// <param name="name">Name of the line.</param>
+/// <param name="pSummary">Times in nanoseconds.</param>
+static void printTimeLine(FILE* const fStats, const char* const name, const VALUE_SUMMARY* const pSummary) {
+   fprintf(fStats,
+           "   %-16s %12.3f %12.3f %12.3f\n",
+           name,
+           (double)pSummary->minimum / 1.0e6,
+           (double)pSummary->median / 1.0e6,
+           (double)pSummary->p99 / 1.0e6);
+}
+
+/// <summary>
+/// Print one line with counters.
+/// </summary>
+/// <param name="fStats">File to print to.</param>
+/// <param name="name">Name of the line.</param>
+/// <param name="pSummary">Counters.</param>
+static void printCounterLine(FILE* const fStats, const char* const name, const VALUE_SUMMARY* const pSummary) {
+   fprintf(fStats,
+           "   %-16s %12llu %12llu %12llu\n",
+           name,
+           (unsigned long long)pSummary->minimum,
+           (unsigned long long)pSummary->median,
+           (unsigned long long)pSummary->p99);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Reset the statistics and start the first phase.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+void BeginListStatistics(LIST_STATISTICS* const pStatistics) {
+   if (pStatistics == NULL)
+      return;
+
+   memset(pStatistics, 0, sizeof(LIST_STATISTICS));
+   pStatistics->phaseStart = GetTimeNs();
+   pStatistics->startTime = pStatistics->phaseStart;
+}
+
+/// <summary>
+/// End a phase. The time since the end of the previous phase is added to this phase.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="phase">Phase that ends.</param>
+void EndListPhase(LIST_STATISTICS* const pStatistics, const LIST_PHASE phase) {
+   if (pStatistics == NULL)
+      return;
+
+   uint64_t now = GetTimeNs();
+   pStatistics->phaseNs[phase] += now - pStatistics->phaseStart;
+   pStatistics->phaseStart = now;
+}
+
+/// <summary>
+/// Add the phase times and the allocated bytes of a concurrent part of the listing.
+/// The time since the end of the previous phase is dropped, as the concurrent part covers it.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="pPart">Statistics of the concurrent part.</param>
+void MergeListStatistics(LIST_STATISTICS* const pStatistics, const LIST_STATISTICS* const pPart) {
+   if (pStatistics == NULL)
+      return;
+
+   for (int p = 0; p < LIST_PHASE_COUNT; p++)
+      pStatistics->phaseNs[p] += pPart->phaseNs[p];
+
+   pStatistics->bytesAllocated += pPart->bytesAllocated;
+   pStatistics->allocationCount += pPart->allocationCount;
+   pStatistics->peakBytes += pPart->peakBytes;
+   pStatistics->phaseStart = GetTimeNs();
+}
+
+/// <summary>
+/// End the listing and set the elapsed time.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+void EndListStatistics(LIST_STATISTICS* const pStatistics) {
+   if (pStatistics != NULL)
+      pStatistics->elapsedNs = GetTimeNs() - pStatistics->startTime;
+}
+
+/// <summary>
+/// Count allocated bytes.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="byteCount">Number of allocated bytes.</param>
+void AddAllocatedBytes(LIST_STATISTICS* const pStatistics, const size_t byteCount) {
+   if (pStatistics == NULL)
+      return;
+
+   pStatistics->bytesAllocated += byteCount;
+   pStatistics->allocationCount++;
+   pStatistics->peakBytes += byteCount;
+}
+
+/// <summary>
+/// Count the allocations of an arena. The bytes of the arena are in use at the same time as the ones counted before.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="pArena">Arena.</param>
+void AddArenaStatistics(LIST_STATISTICS* const pStatistics, const ARENA* const pArena) {
+   if (pStatistics == NULL)
+      return;
+
+   pStatistics->bytesAllocated += pArena->bytesAllocated;
+   pStatistics->allocationCount += pArena->allocationCount;
+   pStatistics->peakBytes += pArena->peakBytes;
+}
+
+/// <summary>
+/// Print the minimum, the median and the 99th percentile of the times and counters of several listings.
+/// </summary>
+/// <param name="pRuns">Statistics of the listings.</param>
+/// <param name="runCount">Number of listings.</param>
+/// <param name="fStats">File to print to.</param>
+/// <returns>TRUE, if the statistics could be printed, FALSE if not.</returns>
+BOOL PrintListStatistics(const LIST_STATISTICS* const pRuns, const ULONG runCount, FILE* const fStats) {
+   const PCHAR functionName = "PrintListStatistics";
+
+   if (runCount == 0)
+      return TRUE;
+
+   uint64_t* pValues = HeapAlloc(GetProcessHeap(), 0, runCount * sizeof(uint64_t));
+   if (pValues == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for values failed.\n", functionName);
+      return FALSE;
+   }
+
+   // 1. Header. The catalog source of the last run is the one of all runs after the first one.
+   fprintf(fStats, "Catalog: %s\n", pRuns[runCount - 1].catalogSource);
+   fprintf(fStats, "Statistics of %lu run%s:\n", (unsigned long)runCount, (runCount == 1) ? "" : "s");
+   fprintf(fStats, "   %-16s %12s %12s %12s\n", "Time [ms]", "min", "median", "p99");
+
+   // 2. Times of the phases, their sum and the elapsed time.
+   VALUE_SUMMARY summary;
+   for (int p = 0; p < LIST_PHASE_COUNT; p++) {
+      for (ULONG r = 0; r < runCount; r++)
+         pValues[r] = pRuns[r].phaseNs[p];
+
+      summarizeValues(pValues, runCount, &summary);
+      printTimeLine(fStats, phaseNames[p], &summary);
+   }
+
+   for (ULONG r = 0; r < runCount; r++) {
+      pValues[r] = 0;
+      for (int p = 0; p < LIST_PHASE_COUNT; p++)
+         pValues[r] += pRuns[r].phaseNs[p];
+   }
+
+   summarizeValues(pValues, runCount, &summary);
+   printTimeLine(fStats, "Total", &summary);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].elapsedNs;
+
+   summarizeValues(pValues, runCount, &summary);
+   printTimeLine(fStats, "Elapsed", &summary);
+
+   // 3. Counters.
+   fputs("   Counters\n", fStats);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].apiCalls;
+   summarizeValues(pValues, runCount, &summary);
+   printCounterLine(fStats, "API calls", &summary);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].bytesAllocated;
+   summarizeValues(pValues, runCount, &summary);
+   printCounterLine(fStats, "Bytes allocated", &summary);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].allocationCount;
+   summarizeValues(pValues, runCount, &summary);
+   printCounterLine(fStats, "Allocations", &summary);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].peakBytes;
+   summarizeValues(pValues, runCount, &summary);
+   printCounterLine(fStats, "Peak bytes", &summary);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].bytesWritten;
+   summarizeValues(pValues, runCount, &summary);
+   printCounterLine(fStats, "Bytes written", &summary);
+
+   for (ULONG r = 0; r < runCount; r++)
+      pValues[r] = pRuns[r].writeCount;
+   summarizeValues(pValues, runCount, &summary);
+   printCounterLine(fStats, "Writes", &summary);
+
+   HeapFree(GetProcessHeap(), 0, pValues);
+
+   return TRUE;
+}
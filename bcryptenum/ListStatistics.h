@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "Arena.h"
+#include "Platform.h"
+
+/// <summary>
+/// Phases of listing the algorithms.
+/// </summary>
+typedef enum _LIST_PHASE {
+   LIST_PHASE_MODULE_VERSION,   // Get the version of the module.
+   LIST_PHASE_CACHE,            // Build the cache key, read and write the catalog cache.
+   LIST_PHASE_ENUMERATION,      // Enumerate the algorithms and release the enumeration buffers.
+   LIST_PHASE_COPY,             // Copy the identifier and name pointers.
+   LIST_PHASE_SORT,             // Sort the names.
+   LIST_PHASE_PROBE,            // Probe the capabilities of the algorithms.
+   LIST_PHASE_FORMAT,           // Transcode and format the output into the output buffer.
+   LIST_PHASE_WRITE,            // Write the output buffer.
+   LIST_PHASE_COUNT
+} LIST_PHASE;
+
+/// <summary>
+/// Times and counters of one listing.
+/// </summary>
+typedef struct _LIST_STATISTICS {
+   /// Time spent in each phase in nanoseconds.
+   uint64_t phaseNs[LIST_PHASE_COUNT];
+
+   /// Time at which the current phase started.
+   uint64_t phaseStart;
+
+   /// Time at which the listing started.
+   uint64_t startTime;
+
+   /// Elapsed time of the whole listing in nanoseconds.
+   /// Phases that run concurrently add up to more than this.
+   uint64_t elapsedNs;
+
+   /// Number of backend calls.
+   ULONG apiCalls;
+
+   /// Number of bytes allocated for the lists and the output.
+   uint64_t bytesAllocated;
+
+   /// Number of allocations for the lists and the output.
+   ULONG allocationCount;
+
+   /// Maximum number of bytes that were allocated at the same time.
+   uint64_t peakBytes;
+
+   /// Number of bytes written.
+   uint64_t bytesWritten;
+
+   /// Number of writes.
+   ULONG writeCount;
+
+   /// Where the catalog came from.
+   const char* catalogSource;
+} LIST_STATISTICS;
+
+/// <summary>
+/// Reset the statistics and start the first phase.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+void BeginListStatistics(LIST_STATISTICS* const pStatistics);
+
+/// <summary>
+/// End a phase. The time since the end of the previous phase is added to this phase.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="phase">Phase that ends.</param>
+void EndListPhase(LIST_STATISTICS* const pStatistics, const LIST_PHASE phase);
+
+/// <summary>
+/// Add the phase times and the allocated bytes of a concurrent part of the listing.
+/// The time since the end of the previous phase is dropped, as the concurrent part covers it.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="pPart">Statistics of the concurrent part.</param>
+void MergeListStatistics(LIST_STATISTICS* const pStatistics, const LIST_STATISTICS* const pPart);
+
+/// <summary>
+/// End the listing and set the elapsed time.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+void EndListStatistics(LIST_STATISTICS* const pStatistics);
+
+/// <summary>
+/// Count allocated bytes.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="byteCount">Number of allocated bytes.</param>
+void AddAllocatedBytes(LIST_STATISTICS* const pStatistics, const size_t byteCount);
+
+/// <summary>
+/// Count the allocations of an arena. The bytes of the arena are in use at the same time as the ones counted before.
+/// </summary>
+/// <param name="pStatistics">Statistics or NULL, if no statistics are collected.</param>
+/// <param name="pArena">Arena.</param>
+void AddArenaStatistics(LIST_STATISTICS* const pStatistics, const ARENA* const pArena);
+
+/// <summary>
+/// Print the minimum, the median and the 99th percentile of the times and counters of several listings.
+/// </summary>
+/// <param name="pRuns">Statistics of the listings.</param>
+/// <param name="runCount">Number of listings.</param>
+/// <param name="fStats">File to print to.</param>
+/// <returns>TRUE, if the statistics could be printed, FALSE if not.</returns>
+BOOL PrintListStatistics(const LIST_STATISTICS* const pRuns, const ULONG runCount, FILE* const fStats);
@@ -0,0 +1,152 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FileMapping.h"
+#include "ModuleVersions.h"
+#include "OutputBuffer.h"
+#include "PeVersion.h"
+#include "PrintModVersion.h"
+#include "Timer.h"
+#include "WorkerPool.h"
+
+// ******** Private constants ********
+
+#define RC_OK  0
+#define RC_ERR 0xff
+
+// ******** Private types ********
+
+/// <summary>
+/// Version of one file.
+/// </summary>
+typedef struct _FILE_VERSION {
+   BOOL hasVersion;
+   MODULE_VERSION version;
+} FILE_VERSION;
+
+/// <summary>
+/// Files whose versions are read by the workers.
+/// </summary>
+typedef struct _VERSION_SCAN {
+   const DIRECTORY_PATHS* pPaths;
+   FILE_VERSION* pVersions;
+} VERSION_SCAN;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Read the version of one file on a worker thread.
+/// </summary>
+/// <param name="context">Version scan.</param>
+/// <param name="index">Index of the file.</param>
+static void readVersionWorkItem(PVOID const context, const ULONG index) {
+   VERSION_SCAN* pScan = context;
+   FILE_VERSION* pFileVersion = pScan->pVersions + index;
+
+   pFileVersion->hasVersion = GetPeFileVersion(pScan->pPaths->pPaths[index], &pFileVersion->version);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Print the product versions of the PE files of a directory, e.g. of collected bcrypt.dll copies.
+/// </summary>
+/// <param name="directoryPath">Directory with the PE files.</param>
+/// <param name="pOptions">List options. maxThreads limits the parser threads.</param>
+/// <returns>0, if the directory could be read, an error code if not.</returns>
+unsigned char PrintModuleVersions(const char* const directoryPath, const LIST_OPTIONS* const pOptions) {
+   const PCHAR functionName = "PrintModuleVersions";
+
+   HANDLE hHeap = GetProcessHeap();
+
+   // 1. List the files.
+   DIRECTORY_PATHS paths;
+   if (GetDirectoryPaths(directoryPath, hHeap, &paths) == FALSE)
+      return RC_ERR;
+
+   FILE_VERSION* pVersions = HeapAlloc(hHeap, 0, (paths.count + 1) * sizeof(FILE_VERSION));
+   if (pVersions == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for version list failed.\n", functionName);
+      FreeDirectoryPaths(&paths);
+      return RC_ERR;
+   }
+
+   // 2. Read the versions in parallel.
+   uint64_t startTime = GetTimeNs();
+
+   VERSION_SCAN scan = { &paths, pVersions };
+   RunWorkItems(paths.count, pOptions->maxThreads, readVersionWorkItem, &scan);
+
+   uint64_t scanTime = GetTimeNs() - startTime;
+
+   // 3. Print them in the order of the file names.
+   OUTPUT_BUFFER output;
+   if (InitOutputBuffer(&output, stdout, 0) == FALSE) {
+      HeapFree(hHeap, 0, pVersions);
+      FreeDirectoryPaths(&paths);
+      return RC_ERR;
+   }
+
+   OutputString(&output, "\nVersions of the files in ");
+   OutputString(&output, directoryPath);
+   OutputString(&output, ":\n\n");
+
+   for (ULONG i = 0; i < paths.count; i++) {
+      OutputString(&output, "   ");
+      OutputString(&output, paths.pPaths[i] + paths.directoryLength);
+      OutputString(&output, ": ");
+      if (pVersions[i].hasVersion != FALSE)
+         OutputModuleVersion(&pVersions[i].version, &output);
+      else
+         OutputString(&output, "no version resource");
+
+      OutputChar(&output, '\n');
+   }
+
+   OutputChar(&output, '\n');
+
+   // 4. Write the output with a single write.
+   BOOL result = FlushOutputBuffer(&output);
+
+   if (pOptions->showStatistics != FALSE) {
+      fprintf(stderr, "Versions: %lu files in %.3f ms\n", (unsigned long)paths.count, (double)scanTime / 1.0e6);
+      PrintOutputStatistics(&output, stderr);
+   }
+
+   FreeOutputBuffer(&output);
+   HeapFree(hHeap, 0, pVersions);
+   FreeDirectoryPaths(&paths);
+
+   if (result == FALSE)
+      return RC_ERR;
+
+   return RC_OK;
+}
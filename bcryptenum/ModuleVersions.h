@@ -0,0 +1,11 @@
+#pragma once
+
+#include "BCryptList.h"
+
+/// <summary>
+/// Print the product versions of the PE files of a directory, e.g. of collected bcrypt.dll copies.
+/// </summary>
+/// <param name="directoryPath">Directory with the PE files.</param>
+/// <param name="pOptions">List options. maxThreads limits the parser threads.</param>
+/// <returns>0, if the directory could be read, an error code if not.</returns>
+unsigned char PrintModuleVersions(const char* const directoryPath, const LIST_OPTIONS* const pOptions);
@@ -0,0 +1,505 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Sort algorithm identifiers.
+//    2026-10-16: V1.2.0: Compare two names in collation order.
+//
+
+//
+// The names are sorted by collation keys, so that the comparisons are simple byte comparisons.
+//
+// A key consists of a body, a 0 byte and a tail:
+//
+// - In the body each character is stored with the order preserving UTF-8 scheme.
+//   A run of digits is stored as '0', the number of significant digits and the significant digits.
+//   As a number with more significant digits is larger, this compares runs of digits numerically.
+//   No byte of the body is 0, so a name that is a prefix of another name sorts first.
+// - The tail holds the number of leading zeros of each run of digits, so that e.g. "A01" sorts after "A1".
+//
+// The keys are sorted with a most significant byte first radix sort.
+// Small buckets are sorted with insertion sort and unusually long common prefixes with qsort.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "NameSort.h"
+
+// ******** Private constants ********
+
+/// Marker that starts a run of digits in the key body.
+#define DIGIT_RUN_MARKER '0'
+
+/// Maximum value of a count byte in the key.
+#define MAX_COUNT_BYTE 0xff
+
+/// Largest value that can be stored in the key body.
+#define MAX_KEY_CHARACTER 0x1fffff
+
+/// Buckets with fewer entries than this are sorted with insertion sort.
+#define INSERTION_SORT_THRESHOLD 16
+
+/// Keys that have a common prefix of this length are sorted with qsort, so that the recursion depth is bounded.
+#define MAX_RADIX_DEPTH 48
+
+/// Number of radix buckets: One for the end of the key and one for each byte value.
+#define BUCKET_COUNT 257
+
+/// Size of the key buffers on the stack for comparing two names.
+#define COMPARE_KEY_SIZE 256
+
+// ******** Private types ********
+
+/// <summary>
+/// Index of a list item with the collation key of its name.
+/// </summary>
+typedef struct _SORT_ENTRY {
+   const UCHAR* pKey;
+   size_t keyLength;
+   ULONG index;
+} SORT_ENTRY;
+
+/// <summary>
+/// Function that gets the name of an item of a list.
+/// </summary>
+typedef LPCWSTR (*NAME_OF_ITEM)(const void* const pList, const ULONG index);
+
+// ******** Private methods ********
+
+/// <summary>
+/// Check, if a character is a decimal digit.
+/// </summary>
+/// <param name="c">Character.</param>
+/// <returns>TRUE, if the character is a decimal digit, FALSE if not.</returns>
+static inline BOOL isDigit(const WCHAR c) {
+   return (c >= L'0' && c <= L'9');
+}
+
+/// <summary>
+/// Store a byte in the key, if there is room.
+/// </summary>
+/// <param name="pKey">Key buffer or NULL.</param>
+/// <param name="keySize">Size of the key buffer.</param>
+/// <param name="position">Position of the byte.</param>
+/// <param name="value">Byte value.</param>
+static inline void putKeyByte(PUCHAR const pKey, const size_t keySize, const size_t position, const ULONG value) {
+   if (pKey != NULL && position < keySize)
+      pKey[position] = (UCHAR)value;
+}
+
+/// <summary>
+/// Store a character in the key body with the order preserving UTF-8 scheme.
+/// Each wide character is stored on its own, so that the order is the same as the order of wcscmp.
+/// </summary>
+/// <param name="c">Character.</param>
+/// <param name="pKey">Key buffer or NULL.</param>
+/// <param name="keySize">Size of the key buffer.</param>
+/// <param name="position">Position of the first byte.</param>
+/// <returns>Number of bytes for the character.</returns>
+static size_t putKeyCharacter(const WCHAR c, PUCHAR const pKey, const size_t keySize, const size_t position) {
+   ULONG value = (ULONG)c;
+   if (value > MAX_KEY_CHARACTER)
+      value = MAX_KEY_CHARACTER;
+
+   if (value < 0x80) {
+      putKeyByte(pKey, keySize, position, value);
+      return 1;
+   }
+
+   if (value < 0x800) {
+      putKeyByte(pKey, keySize, position, 0xc0 | (value >> 6));
+      putKeyByte(pKey, keySize, position + 1, 0x80 | (value & 0x3f));
+      return 2;
+   }
+
+   if (value < 0x10000) {
+      putKeyByte(pKey, keySize, position, 0xe0 | (value >> 12));
+      putKeyByte(pKey, keySize, position + 1, 0x80 | ((value >> 6) & 0x3f));
+      putKeyByte(pKey, keySize, position + 2, 0x80 | (value & 0x3f));
+      return 3;
+   }
+
+   putKeyByte(pKey, keySize, position, 0xf0 | (value >> 18));
+   putKeyByte(pKey, keySize, position + 1, 0x80 | ((value >> 12) & 0x3f));
+   putKeyByte(pKey, keySize, position + 2, 0x80 | ((value >> 6) & 0x3f));
+   putKeyByte(pKey, keySize, position + 3, 0x80 | (value & 0x3f));
+   return 4;
+}
+
+/// <summary>
+/// Get the radix bucket of an entry.
+/// </summary>
+/// <param name="pEntry">Entry.</param>
+/// <param name="depth">Position in the key.</param>
+/// <returns>0, if the key ends before the position, the key byte + 1 otherwise.</returns>
+static inline ULONG bucketOf(const SORT_ENTRY* const pEntry, const size_t depth) {
+   return (depth < pEntry->keyLength) ? (ULONG)pEntry->pKey[depth] + 1 : 0;
+}
+
+/// <summary>
+/// Compare the keys of two entries from a position on.
+/// </summary>
+/// <param name="pLeft">Left entry.</param>
+/// <param name="pRight">Right entry.</param>
+/// <param name="depth">Position from which on the keys are compared. The keys are equal before this position.</param>
+/// <returns>Result of the comparison.</returns>
+static int compareKeysFrom(const SORT_ENTRY* const pLeft, const SORT_ENTRY* const pRight, const size_t depth) {
+   size_t leftLength = pLeft->keyLength;
+   size_t rightLength = pRight->keyLength;
+   size_t commonLength = (leftLength < rightLength) ? leftLength : rightLength;
+
+   if (commonLength > depth) {
+      int result = memcmp(pLeft->pKey + depth, pRight->pKey + depth, commonLength - depth);
+      if (result != 0)
+         return result;
+   }
+
+   return (leftLength > rightLength) - (leftLength < rightLength);
+}
+
+/// <summary>
+/// Compare the keys of two entries for qsort.
+/// </summary>
+/// <param name="pLeft">Pointer to the left entry.</param>
+/// <param name="pRight">Pointer to the right entry.</param>
+/// <returns>Result of the comparison.</returns>
+static int compareEntries(const void* const pLeft, const void* const pRight) {
+   return compareKeysFrom(pLeft, pRight, 0);
+}
+
+/// <summary>
+/// Sort entries with insertion sort.
+/// </summary>
+/// <param name="pEntries">Entries.</param>
+/// <param name="entryCount">Number of entries.</param>
+/// <param name="depth">Length of the common key prefix of all entries.</param>
+static void insertionSort(SORT_ENTRY* const pEntries, const ULONG entryCount, const size_t depth) {
+   for (ULONG i = 1; i < entryCount; i++) {
+      SORT_ENTRY insertionEntry = pEntries[i];
+      ULONG insertionIndex = i;
+
+      while (insertionIndex > 0 && compareKeysFrom(&insertionEntry, pEntries + insertionIndex - 1, depth) < 0) {
+         pEntries[insertionIndex] = pEntries[insertionIndex - 1];
+         insertionIndex--;
+      }
+
+      pEntries[insertionIndex] = insertionEntry;
+   }
+}
+
+/// <summary>
+/// Sort entries with a most significant byte first radix sort.
+/// </summary>
+/// <param name="pEntries">Entries.</param>
+/// <param name="pTemp">Temporary storage for at least entryCount entries.</param>
+/// <param name="entryCount">Number of entries.</param>
+/// <param name="depth">Length of the common key prefix of all entries.</param>
+static void radixSort(SORT_ENTRY* const pEntries, SORT_ENTRY* const pTemp, const ULONG entryCount, size_t depth) {
+   ULONG bucketStart[BUCKET_COUNT];
+
+   for (;;) {
+      if (entryCount < INSERTION_SORT_THRESHOLD) {
+         insertionSort(pEntries, entryCount, depth);
+         return;
+      }
+
+      if (depth >= MAX_RADIX_DEPTH) {
+         qsort(pEntries, entryCount, sizeof(SORT_ENTRY), compareEntries);
+         return;
+      }
+
+      // 1. Count the entries per bucket.
+      memset(bucketStart, 0, sizeof(bucketStart));
+      for (ULONG i = 0; i < entryCount; i++)
+         bucketStart[bucketOf(pEntries + i, depth)]++;
+
+      // 2. If all entries are in the same bucket, there is nothing to distribute.
+      //    This happens a lot with common prefixes, like "SHA".
+      ULONG bucket = bucketOf(pEntries, depth);
+      if (bucketStart[bucket] != entryCount)
+         break;
+
+      if (bucket == 0)
+         return;  // All keys end here, so they are equal.
+
+      depth++;
+   }
+
+   // 3. Distribute the entries to the buckets.
+   ULONG position = 0;
+   for (ULONG b = 0; b < BUCKET_COUNT; b++) {
+      ULONG count = bucketStart[b];
+      bucketStart[b] = position;
+      position += count;
+   }
+
+   ULONG bucketEnd[BUCKET_COUNT];
+   memcpy(bucketEnd, bucketStart, sizeof(bucketEnd));
+   for (ULONG i = 0; i < entryCount; i++)
+      pTemp[bucketEnd[bucketOf(pEntries + i, depth)]++] = pEntries[i];
+
+   memcpy(pEntries, pTemp, entryCount * sizeof(SORT_ENTRY));
+
+   // 4. Sort the buckets. Bucket 0 holds keys that end here, which are equal.
+   for (ULONG b = 1; b < BUCKET_COUNT; b++) {
+      ULONG count = bucketEnd[b] - bucketStart[b];
+      if (count > 1)
+         radixSort(pEntries + bucketStart[b], pTemp, count, depth + 1);
+   }
+}
+
+/// <summary>
+/// Sort the items of a list by their names.
+/// The entries hold the indexes of the items in sorted order. The memory after the entries can hold a copy of the list.
+/// </summary>
+/// <param name="pList">List.</param>
+/// <param name="itemCount">Number of items (at least 2).</param>
+/// <param name="nameOf">Function that gets the name of an item.</param>
+/// <returns>Sorted entries or NULL, if there was not enough memory. It has to be released with HeapFree.</returns>
+static SORT_ENTRY* sortByName(const void* const pList, const ULONG itemCount, const NAME_OF_ITEM nameOf) {
+   const PCHAR functionName = "sortByName";
+
+   // 1. Get the total size of the keys.
+   size_t totalKeySize = 0;
+   for (ULONG i = 0; i < itemCount; i++)
+      totalKeySize += BuildCollationKey(nameOf(pList, i), NULL, 0);
+
+   // 2. Allocate the entries, the temporary entries for the radix sort and the keys in one block.
+   size_t entriesSize = (size_t)itemCount * sizeof(SORT_ENTRY);
+   PUCHAR pMemory = HeapAlloc(GetProcessHeap(), 0, 2 * entriesSize + totalKeySize);
+   if (pMemory == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for collation keys failed.\n", functionName);
+      return NULL;
+   }
+
+   SORT_ENTRY* pEntries = (SORT_ENTRY*)pMemory;
+   SORT_ENTRY* pTemp = (SORT_ENTRY*)(pMemory + entriesSize);
+   PUCHAR pKeys = pMemory + 2 * entriesSize;
+
+   // 3. Build the keys.
+   PUCHAR pActKey = pKeys;
+   size_t remaining = totalKeySize;
+   for (ULONG i = 0; i < itemCount; i++) {
+      size_t keyLength = BuildCollationKey(nameOf(pList, i), pActKey, remaining);
+
+      pEntries[i].pKey = pActKey;
+      pEntries[i].keyLength = keyLength;
+      pEntries[i].index = i;
+
+      pActKey += keyLength;
+      remaining -= keyLength;
+   }
+
+   // 4. Sort the keys.
+   radixSort(pEntries, pTemp, itemCount, 0);
+
+   return pEntries;
+}
+
+/// <summary>
+/// Get a name from a list of names.
+/// </summary>
+/// <param name="pList">List of name pointers.</param>
+/// <param name="index">Index of the name.</param>
+/// <returns>Name.</returns>
+static LPCWSTR nameOfName(const void* const pList, const ULONG index) {
+   return ((LPWSTR const*)pList)[index];
+}
+
+/// <summary>
+/// Get the name of an algorithm from a list of algorithm identifier pointers.
+/// </summary>
+/// <param name="pList">List of algorithm identifier pointers.</param>
+/// <param name="index">Index of the algorithm.</param>
+/// <returns>Name of the algorithm.</returns>
+static LPCWSTR nameOfAlgorithm(const void* const pList, const ULONG index) {
+   return ((BCRYPT_ALGORITHM_IDENTIFIER* const*)pList)[index]->pszName;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Build the collation key of a name.
+/// Comparing two keys with memcmp (and the shorter key first, if one is a prefix of the other)
+/// gives the same order as comparing the names character by character,
+/// except that runs of digits are compared by their numeric value, e.g. SHA256 &lt; SHA384 &lt; SHA512 and AES_2 &lt; AES_10.
+/// </summary>
+/// <param name="name">Name.</param>
+/// <param name="pKey">Buffer that receives the key or NULL, if only the length is needed.</param>
+/// <param name="keySize">Size of the buffer.</param>
+/// <returns>Length of the key. The key is only written, if the buffer is large enough.</returns>
+size_t BuildCollationKey(LPCWSTR const name, PUCHAR const pKey, const size_t keySize) {
+   size_t position = 0;
+   size_t runCount = 0;
+
+   // 1. Build the body.
+   LPCWSTR pChar = name;
+   while (*pChar != 0) {
+      if (isDigit(*pChar) == FALSE) {
+         position += putKeyCharacter(*pChar++, pKey, keySize, position);
+         continue;
+      }
+
+      // Skip the leading zeros, but keep at least one digit.
+      while (*pChar == L'0' && isDigit(pChar[1]) != FALSE)
+         pChar++;
+
+      LPCWSTR pDigits = pChar;
+      while (isDigit(*pChar) != FALSE)
+         pChar++;
+
+      size_t digitCount = (size_t)(pChar - pDigits);
+      putKeyByte(pKey, keySize, position++, DIGIT_RUN_MARKER);
+      putKeyByte(pKey, keySize, position++, (digitCount < MAX_COUNT_BYTE) ? (ULONG)digitCount : MAX_COUNT_BYTE);
+      for (size_t i = 0; i < digitCount; i++)
+         putKeyByte(pKey, keySize, position++, (ULONG)pDigits[i]);
+
+      runCount++;
+   }
+
+   // 2. Terminate the body.
+   putKeyByte(pKey, keySize, position++, 0);
+
+   // 3. Build the tail with the number of leading zeros of each run of digits.
+   if (runCount != 0) {
+      pChar = name;
+      while (*pChar != 0) {
+         if (isDigit(*pChar) == FALSE) {
+            pChar++;
+            continue;
+         }
+
+         size_t zeroCount = 0;
+         while (*pChar == L'0' && isDigit(pChar[1]) != FALSE) {
+            zeroCount++;
+            pChar++;
+         }
+
+         while (isDigit(*pChar) != FALSE)
+            pChar++;
+
+         putKeyByte(pKey, keySize, position++, (zeroCount < MAX_COUNT_BYTE) ? (ULONG)zeroCount : MAX_COUNT_BYTE);
+      }
+   }
+
+   return position;
+}
+
+/// <summary>
+/// Compare two names in collation order.
+/// </summary>
+/// <param name="left">Left name.</param>
+/// <param name="right">Right name.</param>
+/// <returns>Less than 0, if the left name comes first, 0 if the names are equal, greater than 0 if the right name comes first.</returns>
+int CompareNames(LPCWSTR const left, LPCWSTR const right) {
+   const PCHAR functionName = "CompareNames";
+
+   // 1. Equal names have equal keys. This is the most frequent case when lists are merged.
+   if (wcscmp(left, right) == 0)
+      return 0;
+
+   // 2. Build the keys on the stack, if they are short enough.
+   UCHAR leftKey[COMPARE_KEY_SIZE];
+   UCHAR rightKey[COMPARE_KEY_SIZE];
+
+   SORT_ENTRY leftEntry = { leftKey, BuildCollationKey(left, leftKey, sizeof(leftKey)), 0 };
+   SORT_ENTRY rightEntry = { rightKey, BuildCollationKey(right, rightKey, sizeof(rightKey)), 0 };
+
+   if (leftEntry.keyLength <= sizeof(leftKey) && rightEntry.keyLength <= sizeof(rightKey))
+      return compareKeysFrom(&leftEntry, &rightEntry, 0);
+
+   // 3. Build long keys on the heap.
+   PUCHAR pKeys = HeapAlloc(GetProcessHeap(), 0, leftEntry.keyLength + rightEntry.keyLength);
+   if (pKeys == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for collation keys failed.\n", functionName);
+      return wcscmp(left, right);
+   }
+
+   leftEntry.pKey = pKeys;
+   rightEntry.pKey = pKeys + leftEntry.keyLength;
+   BuildCollationKey(left, pKeys, leftEntry.keyLength);
+   BuildCollationKey(right, pKeys + leftEntry.keyLength, rightEntry.keyLength);
+
+   int result = compareKeysFrom(&leftEntry, &rightEntry, 0);
+
+   HeapFree(GetProcessHeap(), 0, pKeys);
+
+   return result;
+}
+
+/// <summary>
+/// Sort a list of names in collation order.
+/// </summary>
+/// <param name="pNames">List of name pointers that is sorted in place.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <returns>TRUE, if the names were sorted, FALSE if there was not enough memory.</returns>
+BOOL SortNames(LPWSTR* const pNames, const ULONG nameCount) {
+   if (nameCount < 2)
+      return TRUE;
+
+   SORT_ENTRY* pEntries = sortByName(pNames, nameCount, nameOfName);
+   if (pEntries == NULL)
+      return FALSE;
+
+   // The temporary entries are not needed any more, so they hold the sorted copy.
+   LPWSTR* pSorted = (LPWSTR*)(pEntries + nameCount);
+   for (ULONG i = 0; i < nameCount; i++)
+      pSorted[i] = pNames[pEntries[i].index];
+
+   memcpy(pNames, pSorted, nameCount * sizeof(LPWSTR));
+
+   HeapFree(GetProcessHeap(), 0, pEntries);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Sort a list of algorithm identifiers by their names in collation order.
+/// </summary>
+/// <param name="pAlgorithms">List of algorithm identifier pointers that is sorted in place.</param>
+/// <param name="algorithmCount">Number of algorithms.</param>
+/// <returns>TRUE, if the algorithms were sorted, FALSE if there was not enough memory.</returns>
+BOOL SortAlgorithms(BCRYPT_ALGORITHM_IDENTIFIER** const pAlgorithms, const ULONG algorithmCount) {
+   if (algorithmCount < 2)
+      return TRUE;
+
+   SORT_ENTRY* pEntries = sortByName(pAlgorithms, algorithmCount, nameOfAlgorithm);
+   if (pEntries == NULL)
+      return FALSE;
+
+   // The temporary entries are not needed any more, so they hold the sorted copy.
+   BCRYPT_ALGORITHM_IDENTIFIER** pSorted = (BCRYPT_ALGORITHM_IDENTIFIER**)(pEntries + algorithmCount);
+   for (ULONG i = 0; i < algorithmCount; i++)
+      pSorted[i] = pAlgorithms[pEntries[i].index];
+
+   memcpy(pAlgorithms, pSorted, algorithmCount * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*));
+
+   HeapFree(GetProcessHeap(), 0, pEntries);
+
+   return TRUE;
+}
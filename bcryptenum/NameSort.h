@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "Platform.h"
+
+/// <summary>
+/// Build the collation key of a name.
+/// Comparing two keys with memcmp (and the shorter key first, if one is a prefix of the other)
+/// gives the same order as comparing the names character by character,
+/// except that runs of digits are compared by their numeric value, e.g. SHA256 &lt; SHA384 &lt; SHA512 and AES_2 &lt; AES_10.
+/// </summary>
+/// <param name="name">Name.</param>
+/// <param name="pKey">Buffer that receives the key or NULL, if only the length is needed.</param>
+/// <param name="keySize">Size of the buffer.</param>
+/// <returns>Length of the key. The key is only written, if the buffer is large enough.</returns>
+size_t BuildCollationKey(LPCWSTR const name, PUCHAR const pKey, const size_t keySize);
+
+/// <summary>
+/// Compare two names in collation order.
+/// </summary>
+/// <param name="left">Left name.</param>
+/// <param name="right">Right name.</param>
+/// <returns>Less than 0, if the left name comes first, 0 if the names are equal, greater than 0 if the right name comes first.</returns>
+int CompareNames(LPCWSTR const left, LPCWSTR const right);
+
+/// <summary>
+/// Sort a list of names in collation order.
+/// </summary>
+/// <param name="pNames">List of name pointers that is sorted in place.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <returns>TRUE, if the names were sorted, FALSE if there was not enough memory.</returns>
+BOOL SortNames(LPWSTR* const pNames, const ULONG nameCount);
+
+/// <summary>
+/// Sort a list of algorithm identifiers by their names in collation order.
+/// </summary>
+/// <param name="pAlgorithms">List of algorithm identifier pointers that is sorted in place.</param>
+/// <param name="algorithmCount">Number of algorithms.</param>
+/// <returns>TRUE, if the algorithms were sorted, FALSE if there was not enough memory.</returns>
+BOOL SortAlgorithms(BCRYPT_ALGORITHM_IDENTIFIER** const pAlgorithms, const ULONG algorithmCount);
@@ -1,5 +1,5 @@
 //
-// SPDX-FileCopyrightText: Copyright 2025 Frank Schwab
+// SPDX-FileCopyrightText: Copyright 2025-2026 Frank Schwab
 //
 // SPDX-License-Identifier: Apache-2.0
 //
@@ -20,107 +20,250 @@
 //
 // Author: Frank Schwab
 //
-// Version: 1.0.0
+// Version: 2.0.0
 //
 // Change history:
 //    2025-11-13: V1.0.0: Created.
+//    2026-10-16: V2.0.0: Reentrant 32 and 64 bit formatting with a digit pair table and fixed point numbers.
 //
 
-#include <stdint.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "NumberFormatter.h"
 
 // ******** Private constants ********
 
-/// Default thousands group separator character.
-#define DEFAULT_SEPARATOR ','
+/// Maximum number of decimal digits of a 64 bit number.
+#define MAX_DIGITS 20
+
+/// Number of digits in a thousands group.
+#define GROUP_SIZE 3
 
-/// Size of the buffer for formatting numbers with thousands grouping separators.
-#define BUFFER_SIZE 20
+/// Maximum number of fraction digits of a fixed point number.
+#define MAX_FRACTION_DIGITS 9
 
-// ******** Private variables ********
+/// Two decimal digits for all numbers from 0 to 99.
+static const char digitPairs[201] =
+   "0001020304050607080910111213141516171819"
+   "2021222324252627282930313233343536373839"
+   "4041424344454647484950515253545556575859"
+   "6061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
 
-/// Buffer for formatting numbers with thousands grouping separators.
-char numberBuffer[BUFFER_SIZE];
+/// Powers of 10 that fit into 64 bits.
+static const uint64_t powersOf10[MAX_DIGITS] = {
+   1ULL,
+   10ULL,
+   100ULL,
+   1000ULL,
+   10000ULL,
+   100000ULL,
+   1000000ULL,
+   10000000ULL,
+   100000000ULL,
+   1000000000ULL,
+   10000000000ULL,
+   100000000000ULL,
+   1000000000000ULL,
+   10000000000000ULL,
+   100000000000000ULL,
+   1000000000000000ULL,
+   10000000000000000ULL,
+   100000000000000000ULL,
+   1000000000000000000ULL,
+   10000000000000000000ULL
+};
 
 // ******** Private methods ********
 
 /// <summary>
-/// Fast division and modulo by 10 for unsigned long integers.
+/// Get the number of significant bits of a number.
 /// </summary>
-/// <param name="in">Number to divide.</param>
-/// <param name="pDivResult">Pointer to store the division result.</param>
-/// <param name="pModResult">Pointer to store the modulo result.</param>
-static inline void divmod10f32(uint16_t const in, uint16_t* const pDivResult, uint16_t* const pModResult) {
-   uint16_t x = (in | 1) - (in >> 2);
-   uint16_t q = (x >> 4) + x;
-
-   x = q;
-   q = (q >> 8) + x;
-   q = (q >> 8) + x;
-
-   uint16_t divResult = (q >> 3);
-   *pDivResult = divResult;
-   *pModResult = in - ((q & ~7) + (divResult << 1));
+/// <param name="value">Number.</param>
+/// <returns>Number of significant bits. 0 for 0.</returns>
+static inline ULONG bitLength(const uint64_t value) {
+#if defined(_MSC_VER) && defined(_M_X64)
+   unsigned long index;
+   return (_BitScanReverse64(&index, value) != 0) ? (ULONG)index + 1 : 0;
+#elif defined(__GNUC__)
+   return (value != 0) ? 64 - (ULONG)__builtin_clzll(value) : 0;
+#else
+   ULONG length = 0;
+   for (uint64_t rest = value; rest != 0; rest >>= 1)
+      length++;
+
+   return length;
+#endif
 }
 
-// ******** Public methods ********
+/// <summary>
+/// Count the decimal digits of a number.
+/// The bit length times log10(2) (1233 / 4096) is the number of digits or one less.
+/// </summary>
+/// <param name="value">Number.</param>
+/// <returns>Number of digits.</returns>
+static inline ULONG countDigits(const uint64_t value) {
+   const uint64_t nonZeroValue = value | 1;  // 0 has one digit, like 1.
+   ULONG estimate = (bitLength(nonZeroValue) * 1233) >> 12;
+
+   return (nonZeroValue < powersOf10[estimate]) ? estimate : estimate + 1;
+}
 
 /// <summary>
-/// Print an unsigned 16-bit integer with thousands groups.
+/// Store two digits in front of a position.
 /// </summary>
-/// <param name="aNumber">Number to proint.</param>
-/// <param name="separator">Thousands group separator character.</param>
-/// <returns>Pointer to string of number.</returns>
-char* FormatUint16WithSeparator(uint16_t const aNumber, char const separator) {
-   uint16_t last = aNumber;
-   char* pBuffer = &numberBuffer[BUFFER_SIZE - 1];  // Start at the end of the buffer.
-   *pBuffer-- = 0;  // Set terminating zero.
-
-   uint8_t groupCount = 0;
-   do {
-      if (groupCount >= 3) {
-         *pBuffer-- = separator;
-         groupCount = 0;
+/// <param name="pEnd">Position after the digits.</param>
+/// <param name="value">Number from 0 to 99.</param>
+/// <returns>Position of the first digit.</returns>
+static inline char* storeDigitPair(char* const pEnd, const uint32_t value) {
+   char* pStart = pEnd - 2;
+   memcpy(pStart, digitPairs + value * 2, 2);
+
+   return pStart;
+}
+
+/// <summary>
+/// Store the digits of a number in front of a position.
+/// Most of the work is done with 32 bit arithmetic, 8 digits at a time.
+/// </summary>
+/// <param name="pEnd">Position after the last digit.</param>
+/// <param name="value">Number.</param>
+static void storeDigits(char* pEnd, uint64_t value) {
+   while (value >= 100000000ULL) {
+      uint64_t quotient = value / 100000000ULL;
+      uint32_t block = (uint32_t)(value - quotient * 100000000ULL);
+      value = quotient;
+
+      for (int i = 0; i < 4; i++) {
+         pEnd = storeDigitPair(pEnd, block % 100);
+         block /= 100;
       }
+   }
 
-      uint16_t divResult;
-      uint16_t modResult;
-      divmod10f32(last, &divResult, &modResult);
+   uint32_t rest = (uint32_t)value;
+   while (rest >= 100) {
+      pEnd = storeDigitPair(pEnd, rest % 100);
+      rest /= 100;
+   }
 
-      *pBuffer-- = (char)modResult + '0';
-      groupCount++;
-      last = divResult;
-   } while (last != 0);
+   if (rest >= 10)
+      storeDigitPair(pEnd, rest);
+   else
+      pEnd[-1] = (char)('0' + rest);
+}
 
-   return ++pBuffer;
+/// <summary>
+/// Store a number with a fixed number of digits and leading zeros in front of a position.
+/// </summary>
+/// <param name="pEnd">Position after the last digit.</param>
+/// <param name="value">Number with at most digitCount digits.</param>
+/// <param name="digitCount">Number of digits to store.</param>
+static void storePaddedDigits(char* pEnd, uint32_t value, ULONG digitCount) {
+   for (; digitCount >= 2; digitCount -= 2) {
+      pEnd = storeDigitPair(pEnd, value % 100);
+      value /= 100;
+   }
+
+   if (digitCount != 0)
+      pEnd[-1] = (char)('0' + value);
 }
 
+// ******** Public methods ********
+
 /// <summary>
-/// Print an unsigned 16-bit integer with thousands groups separated by the default separator character.
+/// Format an unsigned 32 bit number.
 /// </summary>
-/// <param name="aNumber">Number to proint.</param>
-/// <returns>Pointer to string of number.</returns>
-char* FormatUint16NumberWithDefaultSeparator(uint16_t const aNumber) {
-   return FormatUint16WithSeparator(aNumber, DEFAULT_SEPARATOR);
+/// <param name="value">Number to format.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatUint32(const uint32_t value, char* const buffer) {
+   return FormatUint64(value, buffer);
 }
 
 /// <summary>
-/// Print an unsigned 16-bit integer.
+/// Format an unsigned 64 bit number.
 /// </summary>
-/// <param name="aNumber">Number to proint.</param>
-/// <returns>Pointer to string of number.</returns>
-char* FormatUint16Number(uint16_t const aNumber) {
-   uint16_t last = aNumber;
-   char* pBuffer = &numberBuffer[BUFFER_SIZE - 1];  // Start at the end of the buffer.
-   *pBuffer-- = 0;  // Set terminating zero.
-
-   do {
-      uint16_t divResult;
-      uint16_t modResult;
-      divmod10f32(last, &divResult, &modResult);
-
-      *pBuffer-- = (char)modResult + '0';
-      last = divResult;
-   } while (last != 0);
-
-   return ++pBuffer;
+/// <param name="value">Number to format.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatUint64(const uint64_t value, char* const buffer) {
+   ULONG digitCount = countDigits(value);
+
+   storeDigits(buffer + digitCount, value);
+   buffer[digitCount] = 0;
+
+   return digitCount;
+}
+
+/// <summary>
+/// Format an unsigned 64 bit number with thousands groups.
+/// </summary>
+/// <param name="value">Number to format.</param>
+/// <param name="separator">Thousands group separator character.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatUint64WithSeparator(const uint64_t value, const char separator, char* const buffer) {
+   char digits[MAX_DIGITS];
+   ULONG digitCount = countDigits(value);
+   storeDigits(digits + digitCount, value);
+
+   // 1. The first group has 1 to 3 digits.
+   ULONG groupLength = digitCount % GROUP_SIZE;
+   if (groupLength == 0)
+      groupLength = GROUP_SIZE;
+
+   memcpy(buffer, digits, groupLength);
+   size_t length = groupLength;
+
+   // 2. All other groups have 3 digits and a separator in front of them.
+   for (ULONG position = groupLength; position < digitCount; position += GROUP_SIZE) {
+      buffer[length++] = separator;
+      memcpy(buffer + length, digits + position, GROUP_SIZE);
+      length += GROUP_SIZE;
+   }
+
+   buffer[length] = 0;
+
+   return length;
+}
+
+/// <summary>
+/// Format a number as a fixed point number with a given number of fraction digits.
+/// The number is rounded half away from zero.
+/// </summary>
+/// <param name="value">Number to format.</param>
+/// <param name="fractionDigits">Number of fraction digits (at most 9).</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatFixedPoint(const double value, const ULONG fractionDigits, char* const buffer) {
+   ULONG digits = (fractionDigits <= MAX_FRACTION_DIGITS) ? fractionDigits : MAX_FRACTION_DIGITS;
+   double scale = (double)powersOf10[digits];
+   double magnitude = fabs(value);
+
+   // Numbers that do not fit into 64 bits after scaling are very rare. They are formatted by the runtime.
+   if (isfinite(value) == 0 || magnitude * scale >= 1.8e19) {
+      int length = snprintf(buffer, NUMBER_BUFFER_SIZE, "%.*f", (int)digits, value);
+      return (length > 0 && length < NUMBER_BUFFER_SIZE) ? (size_t)length : strlen(buffer);
+   }
+
+   uint64_t scaled = (uint64_t)(magnitude * scale + 0.5);
+   uint64_t integerPart = scaled / powersOf10[digits];
+   uint32_t fractionPart = (uint32_t)(scaled - integerPart * powersOf10[digits]);
+
+   size_t length = 0;
+   if (value < 0.0 && scaled != 0)
+      buffer[length++] = '-';
+
+   length += FormatUint64(integerPart, buffer + length);
+
+   if (digits != 0) {
+      buffer[length++] = '.';
+      length += digits;
+      storePaddedDigits(buffer + length, fractionPart, digits);
+      buffer[length] = 0;
+   }
+
+   return length;
 }
@@ -1,25 +1,44 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include "Platform.h"
+
+/// Size of a buffer that can hold every formatted number.
+#define NUMBER_BUFFER_SIZE 32
+
 /// <summary>
-/// Print an unsigned 16-bit integer with thousands groups.
+/// Format an unsigned 32 bit number.
 /// </summary>
-/// <param name="aNumber">Number to proint.</param>
-/// <param name="separator">Thousands group separator character.</param>
-/// <returns>Pointer to string of number.</returns>
-char* FormatUint16WithSeparator(uint16_t const aNumber, char const separator);
+/// <param name="value">Number to format.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatUint32(const uint32_t value, char* const buffer);
 
 /// <summary>
-/// Print an unsigned 16-bit integer with thousands groups separated by the default separator character.
+/// Format an unsigned 64 bit number.
 /// </summary>
-/// <param name="aNumber">Number to proint.</param>
-/// <returns>Pointer to string of number.</returns>
-char* FormatUint16NumberWithDefaultSeparator(uint16_t const aNumber);
+/// <param name="value">Number to format.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatUint64(const uint64_t value, char* const buffer);
+
+/// <summary>
+/// Format an unsigned 64 bit number with thousands groups.
+/// </summary>
+/// <param name="value">Number to format.</param>
+/// <param name="separator">Thousands group separator character.</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatUint64WithSeparator(const uint64_t value, const char separator, char* const buffer);
 
 /// <summary>
-/// Print an unsigned 16-bit integer.
+/// Format a number as a fixed point number with a given number of fraction digits.
+/// The number is rounded half away from zero.
 /// </summary>
-/// <param name="aNumber">Number to proint.</param>
-/// <returns>Pointer to string of number.</returns>
-char* FormatUint16Number(uint16_t const aNumber);
+/// <param name="value">Number to format.</param>
+/// <param name="fractionDigits">Number of fraction digits (at most 9).</param>
+/// <param name="buffer">Destination buffer with room for at least NUMBER_BUFFER_SIZE characters.</param>
+/// <returns>Number of characters written without the terminating 0.</returns>
+size_t FormatFixedPoint(const double value, const ULONG fractionDigits, char* const buffer);
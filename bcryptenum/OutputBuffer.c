@@ -0,0 +1,369 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.2.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Append numbers without printf.
+//    2026-10-16: V1.2.0: Reserve room for direct writes and append UTF-8 strings.
+//
+
+#include <stdarg.h>
+#include <string.h>
+
+#include "Console.h"
+#include "NumberFormatter.h"
+#include "OutputBuffer.h"
+#include "Transcoder.h"
+
+// ******** Private constants ********
+
+/// Default initial size of the buffer.
+#define DEFAULT_CAPACITY 0x10000
+
+/// Maximum number of bytes a wide character needs in the console code page.
+#define MAX_BYTES_PER_WIDE_CHARACTER 4
+
+// ******** Private methods ********
+
+/// <summary>
+/// Count the line ends in a byte sequence.
+/// </summary>
+/// <param name="pBytes">Bytes.</param>
+/// <param name="byteCount">Number of bytes.</param>
+/// <returns>Number of line ends.</returns>
+static uint64_t countLines(const char* const pBytes, const size_t byteCount) {
+   uint64_t lineCount = 0;
+   const char* pActual = pBytes;
+   const char* pEnd = pBytes + byteCount;
+
+   while ((pActual = memchr(pActual, '\n', (size_t)(pEnd - pActual))) != NULL) {
+      lineCount++;
+      pActual++;
+   }
+
+   return lineCount;
+}
+
+/// <summary>
+/// Write data directly to the file.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pBytes">Bytes to write.</param>
+/// <param name="byteCount">Number of bytes.</param>
+/// <returns>TRUE, if the data could be written, FALSE if not.</returns>
+static BOOL writeToFile(OUTPUT_BUFFER* const pOutput, const char* const pBytes, const size_t byteCount) {
+   BOOL result = (fwrite(pBytes, 1, byteCount, pOutput->fOut) == byteCount);
+   result &= (fflush(pOutput->fOut) == 0);
+
+   pOutput->flushCount++;
+   if (result == FALSE)
+      pOutput->hasWriteError = TRUE;
+
+   return result;
+}
+
+/// <summary>
+/// Make sure that there is room for a number of bytes in the buffer.
+/// If the buffer can not grow, it is flushed, so that its space can be reused.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="byteCount">Number of bytes that need room.</param>
+/// <returns>TRUE, if there is room, FALSE if the bytes have to be written directly.</returns>
+static BOOL reserveRoom(OUTPUT_BUFFER* const pOutput, const size_t byteCount) {
+   size_t neededCapacity = pOutput->length + byteCount;
+   if (neededCapacity <= pOutput->capacity)
+      return TRUE;
+
+   // 1. Grow the buffer.
+   size_t newCapacity = (pOutput->capacity != 0) ? pOutput->capacity * 2 : DEFAULT_CAPACITY;
+   if (newCapacity < neededCapacity)
+      newCapacity = neededCapacity;
+
+   char* pNewData;
+   if (pOutput->pData == NULL)
+      pNewData = HeapAlloc(GetProcessHeap(), 0, newCapacity);
+   else
+      pNewData = HeapReAlloc(GetProcessHeap(), 0, pOutput->pData, newCapacity);
+
+   if (pNewData != NULL) {
+      pOutput->pData = pNewData;
+      pOutput->capacity = newCapacity;
+      return TRUE;
+   }
+
+   // 2. If the buffer can not grow, write the buffered data and reuse the buffer.
+   if (pOutput->length != 0) {
+      writeToFile(pOutput, pOutput->pData, pOutput->length);
+      pOutput->length = 0;
+   }
+
+   return (byteCount <= pOutput->capacity);
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Initialize an output buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="fOut">File the output is written to.</param>
+/// <param name="initialCapacity">Initial size of the buffer. 0 means the default size.</param>
+/// <returns>TRUE, if the buffer could be allocated, FALSE if not.</returns>
+BOOL InitOutputBuffer(OUTPUT_BUFFER* const pOutput, FILE* const fOut, const size_t initialCapacity) {
+   const PCHAR functionName = "InitOutputBuffer";
+
+   memset(pOutput, 0, sizeof(OUTPUT_BUFFER));
+   pOutput->fOut = fOut;
+
+   size_t capacity = (initialCapacity != 0) ? initialCapacity : DEFAULT_CAPACITY;
+   pOutput->pData = HeapAlloc(GetProcessHeap(), 0, capacity);
+   if (pOutput->pData == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for output buffer failed.\n", functionName);
+      return FALSE;
+   }
+
+   pOutput->capacity = capacity;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release the memory of an output buffer. The buffer is not flushed.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+void FreeOutputBuffer(OUTPUT_BUFFER* const pOutput) {
+   if (pOutput->pData != NULL)
+      HeapFree(GetProcessHeap(), 0, pOutput->pData);
+
+   pOutput->pData = NULL;
+   pOutput->length = 0;
+   pOutput->capacity = 0;
+}
+
+/// <summary>
+/// Write the buffered data to the file with a single write.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <returns>TRUE, if the data could be written, FALSE if not.</returns>
+BOOL FlushOutputBuffer(OUTPUT_BUFFER* const pOutput) {
+   if (pOutput->length != 0) {
+      writeToFile(pOutput, pOutput->pData, pOutput->length);
+      pOutput->length = 0;
+   }
+
+   return (pOutput->hasWriteError == FALSE);
+}
+
+/// <summary>
+/// Append bytes to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pBytes">Bytes to append.</param>
+/// <param name="byteCount">Number of bytes.</param>
+void OutputBytes(OUTPUT_BUFFER* const pOutput, const char* const pBytes, const size_t byteCount) {
+   pOutput->byteCount += byteCount;
+   pOutput->lineCount += countLines(pBytes, byteCount);
+
+   if (reserveRoom(pOutput, byteCount) != FALSE) {
+      memcpy(pOutput->pData + pOutput->length, pBytes, byteCount);
+      pOutput->length += byteCount;
+   } else
+      writeToFile(pOutput, pBytes, byteCount);
+}
+
+/// <summary>
+/// Append a character to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="c">Character.</param>
+void OutputChar(OUTPUT_BUFFER* const pOutput, const char c) {
+   if (pOutput->length < pOutput->capacity || reserveRoom(pOutput, 1) != FALSE) {
+      pOutput->pData[pOutput->length++] = c;
+      pOutput->byteCount++;
+      if (c == '\n')
+         pOutput->lineCount++;
+   } else
+      OutputBytes(pOutput, &c, 1);
+}
+
+/// <summary>
+/// Append a 0 terminated string to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="text">String.</param>
+void OutputString(OUTPUT_BUFFER* const pOutput, const char* const text) {
+   OutputBytes(pOutput, text, strlen(text));
+}
+
+/// <summary>
+/// Append a wide character string to the output. It is converted to the console code page.
+/// The conversion is done directly into the buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="wideText">Wide character string.</param>
+void OutputWideString(OUTPUT_BUFFER* const pOutput, const wchar_t* const wideText) {
+   size_t maxLength = wcslen(wideText) * MAX_BYTES_PER_WIDE_CHARACTER + 1;
+
+   if (reserveRoom(pOutput, maxLength) != FALSE) {
+      char* pDestination = pOutput->pData + pOutput->length;
+      size_t length = EncodeForConsole(wideText, pDestination, maxLength);
+
+      pOutput->length += length;
+      pOutput->byteCount += length;
+      pOutput->lineCount += countLines(pDestination, length);
+   } else
+      OutputString(pOutput, AsConsoleCodePageString(wideText));
+}
+
+/// <summary>
+/// Append a part of a wide character string to the output. It is converted to UTF-8.
+/// The conversion is done directly into the buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="wideText">Wide character string.</param>
+/// <param name="wideLength">Number of wide characters to append.</param>
+void OutputUtf8String(OUTPUT_BUFFER* const pOutput, const wchar_t* const wideText, const size_t wideLength) {
+   size_t maxLength = wideLength * MAX_BYTES_PER_WIDE_CHARACTER + 1;
+
+   if (reserveRoom(pOutput, maxLength) != FALSE) {
+      char* pDestination = pOutput->pData + pOutput->length;
+      size_t length = TranscodeToUtf8(wideText, wideLength, pDestination, maxLength);
+
+      pOutput->length += length;
+      pOutput->byteCount += length;
+      pOutput->lineCount += countLines(pDestination, length);
+   } else {
+      // Without room in the buffer, the text is converted in pieces.
+      char part[256];
+      const size_t maxPartLength = sizeof(part) / MAX_BYTES_PER_WIDE_CHARACTER - 1;
+
+      for (size_t position = 0; position < wideLength; ) {
+         size_t partLength = wideLength - position;
+         if (partLength > maxPartLength) {
+            partLength = maxPartLength;
+
+            // A surrogate pair must not be split.
+            if (sizeof(wchar_t) == 2 && (wideText[position + partLength - 1] & 0xfc00) == 0xd800)
+               partLength--;
+         }
+
+         OutputBytes(pOutput, part, TranscodeToUtf8(wideText + position, partLength, part, sizeof(part)));
+         position += partLength;
+      }
+   }
+}
+
+/// <summary>
+/// Get room for a number of bytes at the end of the output, so that they can be written directly into the buffer.
+/// The bytes are only part of the output after CommitOutput has been called.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="maxLength">Maximum number of bytes that will be written.</param>
+/// <returns>Pointer to the room or NULL, if the buffer can not hold that many bytes.</returns>
+char* ReserveOutput(OUTPUT_BUFFER* const pOutput, const size_t maxLength) {
+   if (reserveRoom(pOutput, maxLength) == FALSE)
+      return NULL;
+
+   return pOutput->pData + pOutput->length;
+}
+
+/// <summary>
+/// Add bytes that have been written into the room from ReserveOutput to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="length">Number of bytes written. It must not be larger than the reserved length.</param>
+void CommitOutput(OUTPUT_BUFFER* const pOutput, const size_t length) {
+   pOutput->lineCount += countLines(pOutput->pData + pOutput->length, length);
+   pOutput->length += length;
+   pOutput->byteCount += length;
+}
+
+/// <summary>
+/// Append an unsigned number to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="value">Number.</param>
+void OutputNumber(OUTPUT_BUFFER* const pOutput, const uint64_t value) {
+   if (pOutput->capacity - pOutput->length >= NUMBER_BUFFER_SIZE || reserveRoom(pOutput, NUMBER_BUFFER_SIZE) != FALSE) {
+      size_t length = FormatUint64(value, pOutput->pData + pOutput->length);
+      pOutput->length += length;
+      pOutput->byteCount += length;
+   } else {
+      char number[NUMBER_BUFFER_SIZE];
+      OutputBytes(pOutput, number, FormatUint64(value, number));
+   }
+}
+
+/// <summary>
+/// Append formatted text to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="format">printf format.</param>
+/// <param name="">Parameters for format.</param>
+void OutputFormat(OUTPUT_BUFFER* const pOutput, const char* const format, ...) {
+   va_list args;
+
+   // 1. Try to format into the free space of the buffer.
+   size_t freeSpace = pOutput->capacity - pOutput->length;
+   va_start(args, format);
+   int length = vsnprintf(pOutput->pData + pOutput->length, freeSpace, format, args);
+   va_end(args);
+
+   if (length < 0)
+      return;
+
+   // 2. If the space was too small, make room and format again.
+   if ((size_t)length >= freeSpace) {
+      if (reserveRoom(pOutput, (size_t)length + 1) == FALSE) {
+         va_start(args, format);
+         vfprintf(pOutput->fOut, format, args);
+         va_end(args);
+
+         pOutput->flushCount++;
+         pOutput->byteCount += (size_t)length;
+         return;
+      }
+
+      va_start(args, format);
+      vsnprintf(pOutput->pData + pOutput->length, (size_t)length + 1, format, args);
+      va_end(args);
+   }
+
+   pOutput->lineCount += countLines(pOutput->pData + pOutput->length, (size_t)length);
+   pOutput->length += (size_t)length;
+   pOutput->byteCount += (size_t)length;
+}
+
+/// <summary>
+/// Print the byte, line and write counts of an output buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="fStats">File to print to.</param>
+void PrintOutputStatistics(const OUTPUT_BUFFER* const pOutput, FILE* const fStats) {
+   fprintf(fStats,
+           "Output: %llu bytes, %llu lines, %lu writes\n",
+           (unsigned long long)pOutput->byteCount,
+           (unsigned long long)pOutput->lineCount,
+           (unsigned long)pOutput->flushCount);
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <wchar.h>
+
+#include "Platform.h"
+
+/// <summary>
+/// Growable buffer that collects the output, so that it can be written with a single write.
+/// </summary>
+typedef struct _OUTPUT_BUFFER {
+   /// File the output is written to.
+   FILE* fOut;
+
+   /// Buffered data.
+   char* pData;
+
+   /// Number of buffered bytes.
+   size_t length;
+
+   /// Size of the data buffer.
+   size_t capacity;
+
+   /// Total number of bytes written to the buffer.
+   uint64_t byteCount;
+
+   /// Total number of lines written to the buffer.
+   uint64_t lineCount;
+
+   /// Number of writes to the file.
+   ULONG flushCount;
+
+   /// TRUE, if a write to the file failed.
+   BOOL hasWriteError;
+} OUTPUT_BUFFER;
+
+/// <summary>
+/// Initialize an output buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="fOut">File the output is written to.</param>
+/// <param name="initialCapacity">Initial size of the buffer. 0 means the default size.</param>
+/// <returns>TRUE, if the buffer could be allocated, FALSE if not.</returns>
+BOOL InitOutputBuffer(OUTPUT_BUFFER* const pOutput, FILE* const fOut, const size_t initialCapacity);
+
+/// <summary>
+/// Release the memory of an output buffer. The buffer is not flushed.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+void FreeOutputBuffer(OUTPUT_BUFFER* const pOutput);
+
+/// <summary>
+/// Write the buffered data to the file with a single write.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <returns>TRUE, if the data could be written, FALSE if not.</returns>
+BOOL FlushOutputBuffer(OUTPUT_BUFFER* const pOutput);
+
+/// <summary>
+/// Append bytes to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="pBytes">Bytes to append.</param>
+/// <param name="byteCount">Number of bytes.</param>
+void OutputBytes(OUTPUT_BUFFER* const pOutput, const char* const pBytes, const size_t byteCount);
+
+/// <summary>
+/// Append a character to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="c">Character.</param>
+void OutputChar(OUTPUT_BUFFER* const pOutput, const char c);
+
+/// <summary>
+/// Append a 0 terminated string to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="text">String.</param>
+void OutputString(OUTPUT_BUFFER* const pOutput, const char* const text);
+
+/// <summary>
+/// Append a wide character string to the output. It is converted to the console code page.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="wideText">Wide character string.</param>
+void OutputWideString(OUTPUT_BUFFER* const pOutput, const wchar_t* const wideText);
+
+/// <summary>
+/// Append a part of a wide character string to the output. It is converted to UTF-8.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="wideText">Wide character string.</param>
+/// <param name="wideLength">Number of wide characters to append.</param>
+void OutputUtf8String(OUTPUT_BUFFER* const pOutput, const wchar_t* const wideText, const size_t wideLength);
+
+/// <summary>
+/// Get room for a number of bytes at the end of the output, so that they can be written directly into the buffer.
+/// The bytes are only part of the output after CommitOutput has been called.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="maxLength">Maximum number of bytes that will be written.</param>
+/// <returns>Pointer to the room or NULL, if the buffer can not hold that many bytes.</returns>
+char* ReserveOutput(OUTPUT_BUFFER* const pOutput, const size_t maxLength);
+
+/// <summary>
+/// Add bytes that have been written into the room from ReserveOutput to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="length">Number of bytes written. It must not be larger than the reserved length.</param>
+void CommitOutput(OUTPUT_BUFFER* const pOutput, const size_t length);
+
+/// <summary>
+/// Append an unsigned number to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="value">Number.</param>
+void OutputNumber(OUTPUT_BUFFER* const pOutput, const uint64_t value);
+
+/// <summary>
+/// Append formatted text to the output.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="format">printf format.</param>
+/// <param name="">Parameters for format.</param>
+void OutputFormat(OUTPUT_BUFFER* const pOutput, const char* const format, ...);
+
+/// <summary>
+/// Print the byte, line and write counts of an output buffer.
+/// </summary>
+/// <param name="pOutput">Output buffer.</param>
+/// <param name="fStats">File to print to.</param>
+void PrintOutputStatistics(const OUTPUT_BUFFER* const pOutput, FILE* const fStats);
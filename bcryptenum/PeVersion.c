@@ -0,0 +1,362 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#include <string.h>
+
+#include "FileMapping.h"
+#include "PeVersion.h"
+
+// ******** Private constants ********
+
+// The offsets are those of the structures in winnt.h and verrsrc.h.
+// The structures themselves are not used, as the fields have to be read
+// in little endian byte order from possibly unaligned addresses.
+
+/// "MZ" of the DOS header.
+#define DOS_SIGNATURE 0x5a4d
+
+/// Offset of e_lfanew in the DOS header.
+#define DOS_PE_OFFSET 0x3c
+
+/// "PE\0\0".
+#define PE_SIGNATURE 0x00004550
+
+/// Offsets in the file header that follows the PE signature.
+#define FILE_HEADER_OFFSET          4
+#define FILE_SECTION_COUNT          2
+#define FILE_OPTIONAL_HEADER_LENGTH 16
+#define FILE_HEADER_LENGTH          20
+
+/// Magic numbers of the optional header.
+#define OPTIONAL_MAGIC_PE32      0x10b
+#define OPTIONAL_MAGIC_PE32_PLUS 0x20b
+
+/// Offsets of the number of data directories in the optional header.
+#define OPTIONAL_DIRECTORY_COUNT_PE32      92
+#define OPTIONAL_DIRECTORY_COUNT_PE32_PLUS 108
+
+/// Index of the resource directory in the data directories.
+#define DIRECTORY_RESOURCE 2
+
+/// Length of a data directory entry.
+#define DIRECTORY_ENTRY_LENGTH 8
+
+/// Offsets in a section header.
+#define SECTION_VIRTUAL_ADDRESS 12
+#define SECTION_RAW_SIZE        16
+#define SECTION_RAW_POINTER     20
+#define SECTION_HEADER_LENGTH   40
+
+/// Offsets in a resource directory.
+#define RESOURCE_NAMED_COUNT     12
+#define RESOURCE_ID_COUNT        14
+#define RESOURCE_DIRECTORY_LENGTH 16
+
+/// Length of a resource directory entry.
+#define RESOURCE_ENTRY_LENGTH 8
+
+/// Flag of a resource entry that points to a subdirectory.
+#define RESOURCE_SUBDIRECTORY 0x80000000
+
+/// Resource type of the version information.
+#define RT_VERSION_ID 16
+
+/// Offsets in a resource data entry.
+#define RESOURCE_DATA_RVA    0
+#define RESOURCE_DATA_SIZE   4
+#define RESOURCE_DATA_LENGTH 16
+
+/// Offset of the VS_FIXEDFILEINFO in VS_VERSIONINFO: 3 WORDs, L"VS_VERSION_INFO" and padding to a DWORD boundary.
+#define VERSION_INFO_VALUE_LENGTH 2
+#define VERSION_INFO_VALUE        40
+
+/// Signature and offsets of VS_FIXEDFILEINFO.
+#define FIXED_INFO_SIGNATURE     0xfeef04bd
+#define FIXED_PRODUCT_VERSION_MS 16
+#define FIXED_PRODUCT_VERSION_LS 20
+#define FIXED_INFO_LENGTH        52
+
+// ******** Private types ********
+
+/// <summary>
+/// PE image that is parsed.
+/// </summary>
+typedef struct _PE_IMAGE {
+   const UCHAR* pData;
+   size_t size;
+   PE_LAYOUT layout;
+   size_t sectionTableOffset;
+   ULONG sectionCount;
+} PE_IMAGE;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Read a little endian 16 bit number.
+/// </summary>
+/// <param name="p">Address of the number.</param>
+/// <returns>Number.</returns>
+static inline USHORT readUint16(const UCHAR* const p) {
+   return (USHORT)(p[0] | (p[1] << 8));
+}
+
+/// <summary>
+/// Read a little endian 32 bit number.
+/// </summary>
+/// <param name="p">Address of the number.</param>
+/// <returns>Number.</returns>
+static inline ULONG readUint32(const UCHAR* const p) {
+   return (ULONG)p[0] | ((ULONG)p[1] << 8) | ((ULONG)p[2] << 16) | ((ULONG)p[3] << 24);
+}
+
+/// <summary>
+/// Check, if a range lies within the image.
+/// </summary>
+/// <param name="pImage">Image.</param>
+/// <param name="offset">Offset of the range.</param>
+/// <param name="length">Length of the range.</param>
+/// <returns>TRUE, if the range lies within the image, FALSE if not.</returns>
+static inline BOOL isInImage(const PE_IMAGE* const pImage, const size_t offset, const size_t length) {
+   return (offset <= pImage->size && length <= pImage->size - offset);
+}
+
+/// <summary>
+/// Get the offset of a relative virtual address in the image.
+/// </summary>
+/// <param name="pImage">Image.</param>
+/// <param name="rva">Relative virtual address.</param>
+/// <param name="length">Length of the range that has to be readable at the address.</param>
+/// <param name="pOffset">Pointer to the variable that receives the offset.</param>
+/// <returns>TRUE, if the range lies within the image, FALSE if not.</returns>
+static BOOL rvaToOffset(const PE_IMAGE* const pImage, const ULONG rva, const ULONG length, size_t* const pOffset) {
+   // 1. A loaded image is laid out at the virtual addresses.
+   if (pImage->layout == PE_LAYOUT_IMAGE) {
+      *pOffset = rva;
+      return isInImage(pImage, rva, length);
+   }
+
+   // 2. In a file, find the section that contains the address.
+   const UCHAR* pSection = pImage->pData + pImage->sectionTableOffset;
+   for (ULONG i = pImage->sectionCount; i > 0; i--) {
+      ULONG virtualAddress = readUint32(pSection + SECTION_VIRTUAL_ADDRESS);
+      ULONG rawSize = readUint32(pSection + SECTION_RAW_SIZE);
+
+      if (rva >= virtualAddress && rva - virtualAddress < rawSize) {
+         ULONG sectionOffset = rva - virtualAddress;
+         if (length > rawSize - sectionOffset)
+            return FALSE;
+
+         *pOffset = (size_t)readUint32(pSection + SECTION_RAW_POINTER) + sectionOffset;
+         return isInImage(pImage, *pOffset, length);
+      }
+
+      pSection += SECTION_HEADER_LENGTH;
+   }
+
+   return FALSE;
+}
+
+/// <summary>
+/// Find the offset of the resource directory.
+/// </summary>
+/// <param name="pImage">Image. The section table is filled in.</param>
+/// <param name="pResourceOffset">Pointer to the variable that receives the offset of the resource directory.</param>
+/// <param name="pResourceSize">Pointer to the variable that receives the size of the resource directory.</param>
+/// <returns>TRUE, if the image has a resource directory, FALSE if not.</returns>
+static BOOL findResourceDirectory(PE_IMAGE* const pImage, size_t* const pResourceOffset, ULONG* const pResourceSize) {
+   const UCHAR* pData = pImage->pData;
+
+   // 1. DOS header and PE signature.
+   if (isInImage(pImage, 0, DOS_PE_OFFSET + 4) == FALSE || readUint16(pData) != DOS_SIGNATURE)
+      return FALSE;
+
+   size_t peOffset = readUint32(pData + DOS_PE_OFFSET);
+   if (isInImage(pImage, peOffset, FILE_HEADER_OFFSET + FILE_HEADER_LENGTH) == FALSE || readUint32(pData + peOffset) != PE_SIGNATURE)
+      return FALSE;
+
+   // 2. File header.
+   const UCHAR* pFileHeader = pData + peOffset + FILE_HEADER_OFFSET;
+   pImage->sectionCount = readUint16(pFileHeader + FILE_SECTION_COUNT);
+   ULONG optionalHeaderLength = readUint16(pFileHeader + FILE_OPTIONAL_HEADER_LENGTH);
+
+   size_t optionalOffset = peOffset + FILE_HEADER_OFFSET + FILE_HEADER_LENGTH;
+   pImage->sectionTableOffset = optionalOffset + optionalHeaderLength;
+   if (isInImage(pImage, optionalOffset, optionalHeaderLength) == FALSE ||
+       isInImage(pImage, pImage->sectionTableOffset, (size_t)pImage->sectionCount * SECTION_HEADER_LENGTH) == FALSE ||
+       optionalHeaderLength < 2)
+      return FALSE;
+
+   // 3. Optional header. The data directories follow the directory count, whose place depends on the format.
+   ULONG countOffset;
+   switch (readUint16(pData + optionalOffset)) {
+      case OPTIONAL_MAGIC_PE32:
+         countOffset = OPTIONAL_DIRECTORY_COUNT_PE32;
+         break;
+
+      case OPTIONAL_MAGIC_PE32_PLUS:
+         countOffset = OPTIONAL_DIRECTORY_COUNT_PE32_PLUS;
+         break;
+
+      default:
+         return FALSE;
+   }
+
+   ULONG entryOffset = countOffset + 4 + DIRECTORY_RESOURCE * DIRECTORY_ENTRY_LENGTH;
+   if (optionalHeaderLength < entryOffset + DIRECTORY_ENTRY_LENGTH ||
+       readUint32(pData + optionalOffset + countOffset) <= DIRECTORY_RESOURCE)
+      return FALSE;
+
+   ULONG resourceRva = readUint32(pData + optionalOffset + entryOffset);
+   *pResourceSize = readUint32(pData + optionalOffset + entryOffset + 4);
+   if (resourceRva == 0 || *pResourceSize < RESOURCE_DIRECTORY_LENGTH)
+      return FALSE;
+
+   return rvaToOffset(pImage, resourceRva, RESOURCE_DIRECTORY_LENGTH, pResourceOffset);
+}
+
+/// <summary>
+/// Find an entry of a resource directory.
+/// </summary>
+/// <param name="pImage">Image.</param>
+/// <param name="resourceOffset">Offset of the root resource directory.</param>
+/// <param name="resourceSize">Size of the resource directory.</param>
+/// <param name="directoryOffset">Offset of the directory relative to the root directory.</param>
+/// <param name="id">Id of the entry or 0 for the first entry.</param>
+/// <param name="pEntryData">Pointer to the variable that receives the OffsetToData field of the entry.</param>
+/// <returns>TRUE, if the entry was found, FALSE if not.</returns>
+static BOOL findResourceEntry(const PE_IMAGE* const pImage,
+                              const size_t resourceOffset,
+                              const ULONG resourceSize,
+                              const ULONG directoryOffset,
+                              const ULONG id,
+                              ULONG* const pEntryData) {
+   if (directoryOffset > resourceSize - RESOURCE_DIRECTORY_LENGTH ||
+       isInImage(pImage, resourceOffset + directoryOffset, RESOURCE_DIRECTORY_LENGTH) == FALSE)
+      return FALSE;
+
+   const UCHAR* pDirectory = pImage->pData + resourceOffset + directoryOffset;
+   ULONG namedCount = readUint16(pDirectory + RESOURCE_NAMED_COUNT);
+   ULONG entryCount = namedCount + readUint16(pDirectory + RESOURCE_ID_COUNT);
+
+   size_t entriesOffset = resourceOffset + directoryOffset + RESOURCE_DIRECTORY_LENGTH;
+   if (isInImage(pImage, entriesOffset, (size_t)entryCount * RESOURCE_ENTRY_LENGTH) == FALSE)
+      return FALSE;
+
+   // The named entries come first. Ids are only searched in the id entries that follow them.
+   const UCHAR* pEntry = pImage->pData + entriesOffset;
+   ULONG first = (id != 0) ? namedCount : 0;
+   for (ULONG i = first; i < entryCount; i++) {
+      const UCHAR* pCurrent = pEntry + (size_t)i * RESOURCE_ENTRY_LENGTH;
+      if (id == 0 || readUint32(pCurrent) == id) {
+         *pEntryData = readUint32(pCurrent + 4);
+         return TRUE;
+      }
+   }
+
+   return FALSE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the product version from the VS_FIXEDFILEINFO of a PE image.
+/// The resource directory is walked directly. Nothing is allocated and every offset is checked against the size.
+/// </summary>
+/// <param name="pImage">Start of the PE image.</param>
+/// <param name="imageSize">Size of the PE image in bytes.</param>
+/// <param name="layout">Layout of the image.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the image has a version resource, FALSE if not.</returns>
+BOOL GetPeVersion(const UCHAR* const pImage, const size_t imageSize, const PE_LAYOUT layout, MODULE_VERSION* const pVersion) {
+   PE_IMAGE image = { pImage, imageSize, layout, 0, 0 };
+   if (pImage == NULL)
+      return FALSE;
+
+   // 1. Find the resource directory.
+   size_t resourceOffset;
+   ULONG resourceSize;
+   if (findResourceDirectory(&image, &resourceOffset, &resourceSize) == FALSE)
+      return FALSE;
+
+   // 2. Walk the three levels type -> name -> language. Only the type is fixed, the first name and language are used.
+   ULONG entryData;
+   if (findResourceEntry(&image, resourceOffset, resourceSize, 0, RT_VERSION_ID, &entryData) == FALSE ||
+       (entryData & RESOURCE_SUBDIRECTORY) == 0)
+      return FALSE;
+
+   if (findResourceEntry(&image, resourceOffset, resourceSize, entryData & ~RESOURCE_SUBDIRECTORY, 0, &entryData) == FALSE ||
+       (entryData & RESOURCE_SUBDIRECTORY) == 0)
+      return FALSE;
+
+   if (findResourceEntry(&image, resourceOffset, resourceSize, entryData & ~RESOURCE_SUBDIRECTORY, 0, &entryData) == FALSE ||
+       (entryData & RESOURCE_SUBDIRECTORY) != 0 ||
+       entryData > resourceSize - RESOURCE_DATA_LENGTH ||
+       isInImage(&image, resourceOffset + entryData, RESOURCE_DATA_LENGTH) == FALSE)
+      return FALSE;
+
+   // 3. The data entry holds the address of the VS_VERSIONINFO.
+   const UCHAR* pDataEntry = pImage + resourceOffset + entryData;
+   ULONG versionInfoSize = readUint32(pDataEntry + RESOURCE_DATA_SIZE);
+   size_t versionInfoOffset;
+   if (versionInfoSize < VERSION_INFO_VALUE + FIXED_INFO_LENGTH ||
+       rvaToOffset(&image, readUint32(pDataEntry + RESOURCE_DATA_RVA), VERSION_INFO_VALUE + FIXED_INFO_LENGTH, &versionInfoOffset) == FALSE)
+      return FALSE;
+
+   // 4. VS_VERSIONINFO starts with the fixed file info.
+   const UCHAR* pVersionInfo = pImage + versionInfoOffset;
+   const UCHAR* pFixedInfo = pVersionInfo + VERSION_INFO_VALUE;
+   if (readUint16(pVersionInfo + VERSION_INFO_VALUE_LENGTH) < FIXED_INFO_LENGTH || readUint32(pFixedInfo) != FIXED_INFO_SIGNATURE)
+      return FALSE;
+
+   ULONG versionMs = readUint32(pFixedInfo + FIXED_PRODUCT_VERSION_MS);
+   ULONG versionLs = readUint32(pFixedInfo + FIXED_PRODUCT_VERSION_LS);
+   pVersion->major    = (USHORT)(versionMs >> 16);
+   pVersion->minor    = (USHORT)(versionMs & 0xffff);
+   pVersion->build    = (USHORT)(versionLs >> 16);
+   pVersion->revision = (USHORT)(versionLs & 0xffff);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Get the product version of a PE file.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the file could be mapped and has a version resource, FALSE if not.</returns>
+BOOL GetPeFileVersion(const char* const path, MODULE_VERSION* const pVersion) {
+   MAPPED_FILE file;
+   if (MapFile(path, &file) == FALSE)
+      return FALSE;
+
+   BOOL result = GetPeVersion(file.pData, file.size, PE_LAYOUT_FILE, pVersion);
+
+   UnmapFile(&file);
+
+   return result;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "AlgorithmBackend.h"
+#include "Platform.h"
+
+/// <summary>
+/// Layout of a PE image in memory.
+/// </summary>
+typedef enum _PE_LAYOUT {
+   /// Raw file, e.g. mapped with MapFile. Sections are found through the section table.
+   PE_LAYOUT_FILE,
+
+   /// Image loaded by the Windows loader. Relative virtual addresses are offsets from the module base.
+   PE_LAYOUT_IMAGE
+} PE_LAYOUT;
+
+/// <summary>
+/// Get the product version from the VS_FIXEDFILEINFO of a PE image.
+/// The resource directory is walked directly. Nothing is allocated and every offset is checked against the size.
+/// </summary>
+/// <param name="pImage">Start of the PE image.</param>
+/// <param name="imageSize">Size of the PE image in bytes.</param>
+/// <param name="layout">Layout of the image.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the image has a version resource, FALSE if not.</returns>
+BOOL GetPeVersion(const UCHAR* const pImage, const size_t imageSize, const PE_LAYOUT layout, MODULE_VERSION* const pVersion);
+
+/// <summary>
+/// Get the product version of a PE file.
+/// </summary>
+/// <param name="path">Path of the file.</param>
+/// <param name="pVersion">Pointer to the version structure to fill.</param>
+/// <returns>TRUE, if the file could be mapped and has a version resource, FALSE if not.</returns>
+BOOL GetPeFileVersion(const char* const path, MODULE_VERSION* const pVersion);
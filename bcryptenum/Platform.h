@@ -0,0 +1,244 @@
+#pragma once
+
+//
+// Platform abstraction.
+//
+// On Windows this just pulls in the Windows and BCrypt headers.
+// On all other platforms it supplies the small subset of Windows types,
+// BCrypt definitions and runtime functions that the portable parts of
+// this program use. This makes it possible to build and run the listing
+// pipeline with the fixture backend on e.g. Linux.
+//
+
+#ifdef _WIN32
+
+#include <Windows.h>
+#include <bcrypt.h>
+
+#else
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <wchar.h>
+
+// ******** Windows types ********
+
+typedef int BOOL;
+typedef unsigned char UCHAR;
+typedef UCHAR* PUCHAR;
+typedef unsigned short USHORT;
+typedef uint32_t ULONG;
+typedef uint32_t DWORD;
+typedef int32_t LONG;
+typedef int32_t NTSTATUS;
+typedef char CHAR;
+typedef CHAR* PCHAR;
+typedef wchar_t WCHAR;
+typedef WCHAR* LPWSTR;
+typedef const WCHAR* LPCWSTR;
+typedef void* PVOID;
+typedef void* LPVOID;
+typedef void* HANDLE;
+
+#define TRUE  1
+#define FALSE 0
+
+#define __cdecl
+
+// ******** BCrypt definitions ********
+
+typedef struct _BCRYPT_ALGORITHM_IDENTIFIER {
+   LPWSTR pszName;
+   ULONG  dwClass;
+   ULONG  dwFlags;
+} BCRYPT_ALGORITHM_IDENTIFIER;
+
+#define BCRYPT_CIPHER_OPERATION                 0x00000001
+#define BCRYPT_HASH_OPERATION                   0x00000002
+#define BCRYPT_ASYMMETRIC_ENCRYPTION_OPERATION  0x00000004
+#define BCRYPT_SECRET_AGREEMENT_OPERATION       0x00000008
+#define BCRYPT_SIGNATURE_OPERATION              0x00000010
+#define BCRYPT_RNG_OPERATION                    0x00000020
+#define BCRYPT_KEY_DERIVATION_OPERATION         0x00000040
+
+#define BCRYPT_CIPHER_INTERFACE                 0x00000001
+#define BCRYPT_HASH_INTERFACE                   0x00000002
+#define BCRYPT_ASYMMETRIC_ENCRYPTION_INTERFACE  0x00000003
+#define BCRYPT_SECRET_AGREEMENT_INTERFACE       0x00000004
+#define BCRYPT_SIGNATURE_INTERFACE              0x00000005
+#define BCRYPT_RNG_INTERFACE                    0x00000006
+#define BCRYPT_KEY_DERIVATION_INTERFACE         0x00000007
+
+// Provider registration and configuration
+#define CRYPT_LOCAL  0x00000001
+#define CRYPT_DOMAIN 0x00000002
+
+#define CRYPT_UM  0x00000001
+#define CRYPT_KM  0x00000002
+#define CRYPT_MM  0x00000003
+#define CRYPT_ANY 0x00000004
+
+typedef struct _CRYPT_PROVIDERS {
+   ULONG cProviders;
+   LPWSTR* rgpszProviders;
+} CRYPT_PROVIDERS, *PCRYPT_PROVIDERS;
+
+typedef struct _CRYPT_CONTEXTS {
+   ULONG cContexts;
+   LPWSTR* rgpszContexts;
+} CRYPT_CONTEXTS, *PCRYPT_CONTEXTS;
+
+typedef struct _CRYPT_CONTEXT_FUNCTIONS {
+   ULONG cFunctions;
+   LPWSTR* rgpszFunctions;
+} CRYPT_CONTEXT_FUNCTIONS, *PCRYPT_CONTEXT_FUNCTIONS;
+
+typedef struct _CRYPT_CONTEXT_FUNCTION_PROVIDERS {
+   ULONG cProviders;
+   LPWSTR* rgpszProviders;
+} CRYPT_CONTEXT_FUNCTION_PROVIDERS, *PCRYPT_CONTEXT_FUNCTION_PROVIDERS;
+
+typedef struct _CRYPT_INTERFACE_REG {
+   ULONG dwInterface;
+   ULONG dwFlags;
+   ULONG cFunctions;
+   LPWSTR* rgpszFunctions;
+} CRYPT_INTERFACE_REG, *PCRYPT_INTERFACE_REG;
+
+typedef struct _CRYPT_IMAGE_REG {
+   LPWSTR pszImage;
+   ULONG cInterfaces;
+   PCRYPT_INTERFACE_REG* rgpInterfaces;
+} CRYPT_IMAGE_REG, *PCRYPT_IMAGE_REG;
+
+typedef struct _CRYPT_PROVIDER_REG {
+   ULONG cAliases;
+   LPWSTR* rgpszAliases;
+   PCRYPT_IMAGE_REG pUM;
+   PCRYPT_IMAGE_REG pKM;
+} CRYPT_PROVIDER_REG, *PCRYPT_PROVIDER_REG;
+
+typedef PVOID BCRYPT_HANDLE;
+typedef PVOID BCRYPT_ALG_HANDLE;
+
+typedef struct _BCRYPT_KEY_LENGTHS_STRUCT {
+   ULONG dwMinLength;
+   ULONG dwMaxLength;
+   ULONG dwIncrement;
+} BCRYPT_KEY_LENGTHS_STRUCT;
+
+#define BCRYPT_OBJECT_LENGTH    L"ObjectLength"
+#define BCRYPT_BLOCK_LENGTH     L"BlockLength"
+#define BCRYPT_HASH_LENGTH      L"HashDigestLength"
+#define BCRYPT_KEY_LENGTHS      L"KeyLengths"
+#define BCRYPT_CHAINING_MODE    L"ChainingMode"
+
+#define BCRYPT_CHAIN_MODE_NA    L"ChainingModeN/A"
+#define BCRYPT_CHAIN_MODE_CBC   L"ChainingModeCBC"
+#define BCRYPT_CHAIN_MODE_ECB   L"ChainingModeECB"
+#define BCRYPT_CHAIN_MODE_CFB   L"ChainingModeCFB"
+#define BCRYPT_CHAIN_MODE_CCM   L"ChainingModeCCM"
+#define BCRYPT_CHAIN_MODE_GCM   L"ChainingModeGCM"
+
+// ******** Runtime functions ********
+
+/// <summary>
+/// Get the last error of the C runtime.
+/// </summary>
+/// <returns>Value of errno.</returns>
+static inline DWORD GetLastError(void) {
+   return (DWORD)errno;
+}
+
+/// <summary>
+/// There is only one heap, the C runtime heap. This returns a dummy handle for it.
+/// </summary>
+/// <returns>Dummy heap handle.</returns>
+static inline HANDLE GetProcessHeap(void) {
+   static int processHeap;
+   return &processHeap;
+}
+
+/// <summary>
+/// Allocate memory from the C runtime heap.
+/// </summary>
+/// <param name="hHeap">Heap handle (ignored).</param>
+/// <param name="dwFlags">Allocation flags (ignored).</param>
+/// <param name="dwBytes">Number of bytes to allocate.</param>
+/// <returns>Pointer to the allocated memory or NULL.</returns>
+static inline LPVOID HeapAlloc(HANDLE hHeap, DWORD dwFlags, size_t dwBytes) {
+   (void)hHeap;
+   (void)dwFlags;
+   return malloc(dwBytes);
+}
+
+/// <summary>
+/// Change the size of memory from the C runtime heap.
+/// </summary>
+/// <param name="hHeap">Heap handle (ignored).</param>
+/// <param name="dwFlags">Allocation flags (ignored).</param>
+/// <param name="lpMem">Pointer to the memory to resize.</param>
+/// <param name="dwBytes">New number of bytes.</param>
+/// <returns>Pointer to the resized memory or NULL. The original memory is unchanged, if NULL is returned.</returns>
+static inline LPVOID HeapReAlloc(HANDLE hHeap, DWORD dwFlags, LPVOID lpMem, size_t dwBytes) {
+   (void)hHeap;
+   (void)dwFlags;
+   return realloc(lpMem, dwBytes);
+}
+
+/// <summary>
+/// Release memory to the C runtime heap.
+/// </summary>
+/// <param name="hHeap">Heap handle (ignored).</param>
+/// <param name="dwFlags">Flags (ignored).</param>
+/// <param name="lpMem">Pointer to the memory to release.</param>
+/// <returns>Always TRUE.</returns>
+static inline BOOL HeapFree(HANDLE hHeap, DWORD dwFlags, LPVOID lpMem) {
+   (void)hHeap;
+   (void)dwFlags;
+   free(lpMem);
+   return TRUE;
+}
+
+/// <summary>
+/// Open a file like the "secure" Microsoft C runtime function.
+/// </summary>
+/// <param name="ppFile">Pointer to the variable that receives the file pointer.</param>
+/// <param name="fileName">File name.</param>
+/// <param name="mode">Open mode.</param>
+/// <returns>0 on success, an errno value otherwise.</returns>
+static inline int fopen_s(FILE** ppFile, const char* fileName, const char* mode) {
+   *ppFile = fopen(fileName, mode);
+   return (*ppFile == NULL) ? errno : 0;
+}
+
+#define sprintf_s snprintf
+
+#define _putc_nolock(c, stream)  putc_unlocked((c), (stream))
+#define _fputc_nolock(c, stream) putc_unlocked((c), (stream))
+
+#endif
+
+// ******** Status codes used by all backends ********
+
+#ifndef STATUS_NO_MEMORY
+#define STATUS_NO_MEMORY ((NTSTATUS)0xC0000017L)
+#endif
+
+#ifndef STATUS_NOT_FOUND
+#define STATUS_NOT_FOUND ((NTSTATUS)0xC0000225L)
+#endif
+
+#ifndef STATUS_NOT_SUPPORTED
+#define STATUS_NOT_SUPPORTED ((NTSTATUS)0xC00000BBL)
+#endif
+
+#ifndef STATUS_INVALID_PARAMETER
+#define STATUS_INVALID_PARAMETER ((NTSTATUS)0xC000000DL)
+#endif
+
+#ifndef STATUS_INVALID_SIGNATURE
+#define STATUS_INVALID_SIGNATURE ((NTSTATUS)0xC000A000L)
+#endif
@@ -1,10 +1,19 @@
 #pragma once
 
-#include <Windows.h>
+#include "AlgorithmBackend.h"
+#include "OutputBuffer.h"
+
+/// <summary>
+/// Print a module version.
+/// </summary>
+/// <param name="pVersion">Module version.</param>
+/// <param name="pOutput">Output buffer.</param>
+void OutputModuleVersion(const MODULE_VERSION* const pVersion, OUTPUT_BUFFER* const pOutput);
 
 /// <summary>
 /// Print the version of the supplied module file.
 /// </summary>
+/// <param name="pBackend">Backend that knows the module version.</param>
 /// <param name="moduleName">Name of the module.</param>
-/// <param name="fStdOut">Stdout file pointer.</param>
-void PrintModuleVersion(const PCHAR moduleName, FILE* fStdOut);
+/// <param name="pOutput">Output buffer.</param>
+void PrintModuleVersion(const ALGORITHM_BACKEND* const pBackend, const PCHAR moduleName, OUTPUT_BUFFER* const pOutput);
@@ -0,0 +1,442 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.1
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.0.1: Sort the functions of the providers and the chains in collation order.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ApiErrorHandler.h"
+#include "ListEmitter.h"
+#include "NameSort.h"
+#include "OutputBuffer.h"
+#include "ProviderList.h"
+#include "Timer.h"
+#include "WorkerPool.h"
+
+// ******** Private constants ********
+
+#define RC_OK  0
+#define RC_ERR 0xff
+
+/// Separator of the providers of a chain.
+#define CHAIN_SEPARATOR " -> "
+
+// ******** Private types ********
+
+/// <summary>
+/// Registrations of one provider for all operation types.
+/// </summary>
+typedef struct _PROVIDER_QUERY {
+   LPCWSTR providerName;
+   PCRYPT_PROVIDER_REG pRegistrations[OPERATION_TYPE_COUNT];
+   LPWSTR* pFunctionNames[OPERATION_TYPE_COUNT];   // Sorted functions of all interfaces of the user mode image.
+   ULONG functionCounts[OPERATION_TYPE_COUNT];
+} PROVIDER_QUERY;
+
+/// <summary>
+/// Provider chains of the functions of one operation type in one configuration context.
+/// </summary>
+typedef struct _CHAIN_QUERY {
+   LPCWSTR contextName;
+   ULONG operationType;
+   PCRYPT_CONTEXT_FUNCTIONS pFunctions;
+   PCRYPT_CONTEXT_FUNCTION_PROVIDERS* ppChains;
+} CHAIN_QUERY;
+
+/// <summary>
+/// Queries that are run by the workers.
+/// The first work items query the providers, the others the provider chains.
+/// </summary>
+typedef struct _PROVIDER_SCAN {
+   const ALGORITHM_BACKEND* pBackend;
+   HANDLE hHeap;
+   ULONG providerCount;
+   PROVIDER_QUERY* pProviderQueries;
+   ULONG chainQueryCount;
+   CHAIN_QUERY* pChainQueries;
+} PROVIDER_SCAN;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Collect the functions of all interfaces of a user mode image and sort them.
+/// </summary>
+/// <param name="pScan">Scan.</param>
+/// <param name="pImage">User mode image.</param>
+/// <param name="pFunctionCount">Pointer to the variable that receives the number of functions.</param>
+/// <returns>Sorted list of the function names, or NULL, if there was not enough memory.</returns>
+static LPWSTR* sortImageFunctions(const PROVIDER_SCAN* const pScan, const CRYPT_IMAGE_REG* const pImage, ULONG* const pFunctionCount) {
+   const PCHAR functionName = "sortImageFunctions";
+
+   // 1. Collect the function names.
+   ULONG functionCount = 0;
+   for (ULONG i = 0; i < pImage->cInterfaces; i++)
+      functionCount += pImage->rgpInterfaces[i]->cFunctions;
+
+   LPWSTR* pNames = HeapAlloc(pScan->hHeap, 0, (functionCount + 1) * sizeof(LPWSTR));
+   if (pNames == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for function name list failed.\n", functionName);
+      return NULL;
+   }
+
+   ULONG n = 0;
+   for (ULONG i = 0; i < pImage->cInterfaces; i++) {
+      const CRYPT_INTERFACE_REG* pInterface = pImage->rgpInterfaces[i];
+      for (ULONG j = 0; j < pInterface->cFunctions; j++)
+         pNames[n++] = pInterface->rgpszFunctions[j];
+   }
+
+   // 2. Sort them like all other listings.
+   if (SortNames(pNames, functionCount) == FALSE) {
+      fprintf(stderr, "Function \"%s\": Sorting of function names failed.\n", functionName);
+      HeapFree(pScan->hHeap, 0, pNames);
+      return NULL;
+   }
+
+   *pFunctionCount = functionCount;
+
+   return pNames;
+}
+
+/// <summary>
+/// Query the registrations of one provider.
+/// </summary>
+/// <param name="pScan">Scan.</param>
+/// <param name="pQuery">Provider query.</param>
+static void queryProvider(const PROVIDER_SCAN* const pScan, PROVIDER_QUERY* const pQuery) {
+   const ALGORITHM_BACKEND* pBackend = pScan->pBackend;
+
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+      ULONG bufferSize;
+      if (pBackend->QueryProviderRegistration(pBackend->context,
+                                              pQuery->providerName,
+                                              CRYPT_UM,
+                                              OperationTypeInterface(OperationTypes[t]),
+                                              &bufferSize,
+                                              &pQuery->pRegistrations[t]) < 0) {
+         pQuery->pRegistrations[t] = NULL;
+         continue;
+      }
+
+      if (pQuery->pRegistrations[t]->pUM != NULL)
+         pQuery->pFunctionNames[t] = sortImageFunctions(pScan, pQuery->pRegistrations[t]->pUM, &pQuery->functionCounts[t]);
+   }
+}
+
+/// <summary>
+/// Query the provider chains of the functions of one operation type in one context.
+/// </summary>
+/// <param name="pScan">Scan.</param>
+/// <param name="pQuery">Chain query.</param>
+static void queryChains(const PROVIDER_SCAN* const pScan, CHAIN_QUERY* const pQuery) {
+   const PCHAR functionName = "queryChains";
+
+   const ALGORITHM_BACKEND* pBackend = pScan->pBackend;
+   ULONG interfaceId = OperationTypeInterface(pQuery->operationType);
+
+   // 1. Get the functions. An operation type without functions is not an error.
+   ULONG bufferSize;
+   if (pBackend->EnumContextFunctions(pBackend->context, CRYPT_LOCAL, pQuery->contextName, interfaceId, &bufferSize, &pQuery->pFunctions) < 0) {
+      pQuery->pFunctions = NULL;
+      return;
+   }
+
+   // 2. Sort the functions like all other listings. The chains are queried in this order.
+   if (SortNames(pQuery->pFunctions->rgpszFunctions, pQuery->pFunctions->cFunctions) == FALSE) {
+      fprintf(stderr, "Function \"%s\": Sorting of function names failed.\n", functionName);
+      return;
+   }
+
+   pQuery->ppChains = HeapAlloc(pScan->hHeap, 0, (pQuery->pFunctions->cFunctions + 1) * sizeof(PCRYPT_CONTEXT_FUNCTION_PROVIDERS));
+   if (pQuery->ppChains == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for provider chains failed.\n", functionName);
+      return;
+   }
+
+   // 3. Get the provider chain of each function.
+   for (ULONG i = 0; i < pQuery->pFunctions->cFunctions; i++)
+      if (pBackend->EnumContextFunctionProviders(pBackend->context,
+                                                 CRYPT_LOCAL,
+                                                 pQuery->contextName,
+                                                 interfaceId,
+                                                 pQuery->pFunctions->rgpszFunctions[i],
+                                                 &bufferSize,
+                                                 &pQuery->ppChains[i]) < 0)
+         pQuery->ppChains[i] = NULL;
+}
+
+/// <summary>
+/// Run one query on a worker thread.
+/// </summary>
+/// <param name="context">Scan.</param>
+/// <param name="index">Index of the query.</param>
+static void queryWorkItem(PVOID const context, const ULONG index) {
+   const PROVIDER_SCAN* pScan = context;
+
+   if (index < pScan->providerCount)
+      queryProvider(pScan, pScan->pProviderQueries + index);
+   else
+      queryChains(pScan, pScan->pChainQueries + (index - pScan->providerCount));
+}
+
+/// <summary>
+/// Print the registered providers and their functions.
+/// </summary>
+/// <param name="pScan">Scan with the query results.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printProviders(const PROVIDER_SCAN* const pScan, OUTPUT_BUFFER* const pOutput) {
+   OutputString(pOutput, "\nRegistered providers:\n\n");
+
+   for (ULONG p = 0; p < pScan->providerCount; p++) {
+      const PROVIDER_QUERY* pQuery = pScan->pProviderQueries + p;
+
+      // 1. Provider name and user mode image.
+      OutputString(pOutput, "   ");
+      OutputWideString(pOutput, pQuery->providerName);
+      for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+         const CRYPT_PROVIDER_REG* pRegistration = pQuery->pRegistrations[t];
+         if (pRegistration != NULL && pRegistration->pUM != NULL && pRegistration->pUM->pszImage != NULL) {
+            OutputString(pOutput, " (");
+            OutputWideString(pOutput, pRegistration->pUM->pszImage);
+            OutputChar(pOutput, ')');
+            break;
+         }
+      }
+
+      OutputChar(pOutput, '\n');
+
+      // 2. Functions by operation type.
+      for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+         const LPWSTR* pNames = pQuery->pFunctionNames[t];
+         if (pNames == NULL)
+            continue;
+
+         OutputString(pOutput, "      ");
+         OutputString(pOutput, OperationTypeTitle(OperationTypes[t]));
+         OutputChar(pOutput, ':');
+
+         for (ULONG i = 0; i < pQuery->functionCounts[t]; i++) {
+            OutputString(pOutput, (i == 0) ? " " : ", ");
+            OutputWideString(pOutput, pNames[i]);
+         }
+
+         OutputChar(pOutput, '\n');
+      }
+
+      OutputChar(pOutput, '\n');
+   }
+}
+
+/// <summary>
+/// Print the provider chains of the functions by configuration context and operation type.
+/// </summary>
+/// <param name="pScan">Scan with the query results.</param>
+/// <param name="pOutput">Output buffer.</param>
+static void printChains(const PROVIDER_SCAN* const pScan, OUTPUT_BUFFER* const pOutput) {
+   LPCWSTR contextName = NULL;
+
+   for (ULONG q = 0; q < pScan->chainQueryCount; q++) {
+      const CHAIN_QUERY* pQuery = pScan->pChainQueries + q;
+
+      // 1. Title of the context. The queries of one context are adjacent.
+      if (pQuery->contextName != contextName) {
+         contextName = pQuery->contextName;
+         OutputString(pOutput, "Provider chains of the context \"");
+         OutputWideString(pOutput, contextName);
+         OutputString(pOutput, "\":\n\n");
+      }
+
+      if (pQuery->pFunctions == NULL || pQuery->ppChains == NULL)
+         continue;
+
+      // 2. One line per function with its providers in the order of their priority.
+      OutputString(pOutput, "   ");
+      OutputString(pOutput, OperationTypeTitle(pQuery->operationType));
+      OutputString(pOutput, ":\n");
+
+      for (ULONG i = 0; i < pQuery->pFunctions->cFunctions; i++) {
+         OutputString(pOutput, "      ");
+         OutputWideString(pOutput, pQuery->pFunctions->rgpszFunctions[i]);
+         OutputChar(pOutput, ':');
+
+         const CRYPT_CONTEXT_FUNCTION_PROVIDERS* pChain = pQuery->ppChains[i];
+         if (pChain == NULL || pChain->cProviders == 0)
+            OutputString(pOutput, " no provider");
+         else
+            for (ULONG j = 0; j < pChain->cProviders; j++) {
+               OutputString(pOutput, (j == 0) ? " " : CHAIN_SEPARATOR);
+               OutputWideString(pOutput, pChain->rgpszProviders[j]);
+            }
+
+         OutputChar(pOutput, '\n');
+      }
+
+      OutputChar(pOutput, '\n');
+   }
+}
+
+/// <summary>
+/// Release the query results.
+/// </summary>
+/// <param name="pScan">Scan.</param>
+static void freeScan(PROVIDER_SCAN* const pScan) {
+   const ALGORITHM_BACKEND* pBackend = pScan->pBackend;
+
+   if (pScan->pProviderQueries != NULL) {
+      for (ULONG p = 0; p < pScan->providerCount; p++)
+         for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+            if (pScan->pProviderQueries[p].pFunctionNames[t] != NULL)
+               HeapFree(pScan->hHeap, 0, pScan->pProviderQueries[p].pFunctionNames[t]);
+
+            if (pScan->pProviderQueries[p].pRegistrations[t] != NULL)
+               pBackend->FreeBuffer(pBackend->context, pScan->pProviderQueries[p].pRegistrations[t]);
+         }
+
+      HeapFree(pScan->hHeap, 0, pScan->pProviderQueries);
+   }
+
+   if (pScan->pChainQueries != NULL) {
+      for (ULONG q = 0; q < pScan->chainQueryCount; q++) {
+         CHAIN_QUERY* pQuery = pScan->pChainQueries + q;
+         if (pQuery->ppChains != NULL) {
+            for (ULONG i = 0; i < pQuery->pFunctions->cFunctions; i++)
+               if (pQuery->ppChains[i] != NULL)
+                  pBackend->FreeBuffer(pBackend->context, pQuery->ppChains[i]);
+
+            HeapFree(pScan->hHeap, 0, pQuery->ppChains);
+         }
+
+         if (pQuery->pFunctions != NULL)
+            pBackend->FreeBuffer(pBackend->context, pQuery->pFunctions);
+      }
+
+      HeapFree(pScan->hHeap, 0, pScan->pChainQueries);
+   }
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Print the registered providers with their functions and the provider chain of each function in the local configuration contexts.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options. maxThreads limits the query threads.</param>
+/// <returns>0, if the providers could be listed, an error code if not.</returns>
+unsigned char ListProviders(const ALGORITHM_BACKEND* const pBackend, const LIST_OPTIONS* const pOptions) {
+   const PCHAR functionName = "ListProviders";
+
+   HANDLE hHeap = GetProcessHeap();
+   if (hHeap == NULL) {
+      PrintLastError(functionName, "GetProcessHeap");
+      return RC_ERR;
+   }
+
+   uint64_t startTime = GetTimeNs();
+
+   // 1. Get the providers and the contexts.
+   ULONG bufferSize;
+   PCRYPT_PROVIDERS pProviders;
+   NTSTATUS nts = pBackend->EnumProviders(pBackend->context, &bufferSize, &pProviders);
+   if (nts < 0) {
+      PrintNtStatus(functionName, "EnumProviders", nts);
+      return RC_ERR;
+   }
+
+   PCRYPT_CONTEXTS pContexts;
+   nts = pBackend->EnumContexts(pBackend->context, CRYPT_LOCAL, &bufferSize, &pContexts);
+   if (nts < 0) {
+      PrintNtStatus(functionName, "EnumContexts", nts);
+      pBackend->FreeBuffer(pBackend->context, pProviders);
+      return RC_ERR;
+   }
+
+   // 2. Prepare one query per provider and one per context and operation type.
+   PROVIDER_SCAN scan;
+   memset(&scan, 0, sizeof(scan));
+   scan.pBackend = pBackend;
+   scan.hHeap = hHeap;
+   scan.providerCount = pProviders->cProviders;
+   scan.chainQueryCount = pContexts->cContexts * OPERATION_TYPE_COUNT;
+   scan.pProviderQueries = HeapAlloc(hHeap, 0, (scan.providerCount + 1) * sizeof(PROVIDER_QUERY));
+   scan.pChainQueries = HeapAlloc(hHeap, 0, (scan.chainQueryCount + 1) * sizeof(CHAIN_QUERY));
+   if (scan.pProviderQueries == NULL || scan.pChainQueries == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for queries failed.\n", functionName);
+      scan.providerCount = 0;
+      scan.chainQueryCount = 0;
+      freeScan(&scan);
+      pBackend->FreeBuffer(pBackend->context, pContexts);
+      pBackend->FreeBuffer(pBackend->context, pProviders);
+      return RC_ERR;
+   }
+
+   memset(scan.pProviderQueries, 0, scan.providerCount * sizeof(PROVIDER_QUERY));
+   for (ULONG p = 0; p < scan.providerCount; p++)
+      scan.pProviderQueries[p].providerName = pProviders->rgpszProviders[p];
+
+   memset(scan.pChainQueries, 0, scan.chainQueryCount * sizeof(CHAIN_QUERY));
+   for (ULONG q = 0; q < scan.chainQueryCount; q++) {
+      scan.pChainQueries[q].contextName = pContexts->rgpszContexts[q / OPERATION_TYPE_COUNT];
+      scan.pChainQueries[q].operationType = OperationTypes[q % OPERATION_TYPE_COUNT];
+   }
+
+   // 3. Run the queries in parallel. Each query writes only to its own result.
+   RunWorkItems(scan.providerCount + scan.chainQueryCount, pOptions->maxThreads, queryWorkItem, &scan);
+
+   uint64_t queryTime = GetTimeNs() - startTime;
+
+   // 4. Print the results.
+   OUTPUT_BUFFER output;
+   BOOL result = InitOutputBuffer(&output, stdout, 0);
+   if (result != FALSE) {
+      printProviders(&scan, &output);
+      printChains(&scan, &output);
+
+      result = FlushOutputBuffer(&output);
+
+      if (pOptions->showStatistics != FALSE) {
+         fprintf(stderr,
+                 "Queries: %lu providers, %lu contexts in %.3f ms\n",
+                 (unsigned long)scan.providerCount,
+                 (unsigned long)pContexts->cContexts,
+                 (double)queryTime / 1.0e6);
+         PrintOutputStatistics(&output, stderr);
+      }
+
+      FreeOutputBuffer(&output);
+   }
+
+   // 5. Release memory.
+   freeScan(&scan);
+   pBackend->FreeBuffer(pBackend->context, pContexts);
+   pBackend->FreeBuffer(pBackend->context, pProviders);
+
+   if (result == FALSE)
+      return RC_ERR;
+
+   return RC_OK;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "AlgorithmBackend.h"
+#include "BCryptList.h"
+
+/// <summary>
+/// Print the registered providers with their functions and the provider chain of each function in the local configuration contexts.
+/// </summary>
+/// <param name="pBackend">Enumeration backend.</param>
+/// <param name="pOptions">List options. maxThreads limits the query threads.</param>
+/// <returns>0, if the providers could be listed, an error code if not.</returns>
+unsigned char ListProviders(const ALGORITHM_BACKEND* const pBackend, const LIST_OPTIONS* const pOptions);
@@ -0,0 +1,550 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+#define _CRT_DISABLE_PERFCRIT_LOCKS 1
+
+#include <string.h>
+
+#include "ApiErrorHandler.h"
+#include "Console.h"
+#include "NumberFormatter.h"
+#include "RngBenchmark.h"
+#include "Timer.h"
+#include "WorkerPool.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// ******** Private constants ********
+
+/// Maximum number of measurement threads.
+#define MAX_RNG_THREADS 64
+
+/// Size of the smallest request in bytes.
+#define MIN_REQUEST_SIZE 16UL
+
+/// Size of the largest request in bytes.
+#define MAX_REQUEST_SIZE (64UL * 1024UL)
+
+/// The request size is multiplied by 2^REQUEST_STEP_SHIFT from one measurement to the next.
+#define REQUEST_STEP_SHIFT 2
+
+/// Size of the buffer of a thread in bytes, from which buffered requests are served.
+/// Requests of this size or larger are not buffered.
+#define REFILL_SIZE 4096UL
+
+/// Number of requests each thread makes before the measurement starts.
+#define WARMUP_REQUESTS 16
+
+// ******** Private types ********
+
+/// <summary>
+/// Data shared by all threads of one measurement.
+/// </summary>
+typedef struct _RNG_RUN {
+   const CRYPTO_ENGINE* pEngine;
+   ENGINE_HANDLE hAlgorithm;  // NULL for the system-preferred random number generator.
+   ULONG requestSize;
+   BOOL isBuffered;
+   volatile LONG readyCount;
+   volatile LONG startFlag;
+   volatile LONG stopFlag;
+} RNG_RUN;
+
+/// <summary>
+/// Data of one measurement thread.
+/// </summary>
+typedef struct _RNG_WORKER {
+   RNG_RUN* pRun;
+   ULONG processorIndex;
+   BOOL isPinned;
+   NTSTATUS status;
+   uint64_t requestCount;
+   uint64_t nanoseconds;
+} RNG_WORKER;
+
+/// <summary>
+/// Result of one measurement.
+/// </summary>
+typedef struct _RNG_RESULT {
+   double megabytesPerSecond;
+   double nanosecondsPerRequest;
+   BOOL allPinned;
+} RNG_RESULT;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Read a flag with acquire semantics.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+/// <returns>Value of the flag.</returns>
+static inline LONG loadFlag(volatile LONG* const pFlag) {
+#ifdef _WIN32
+   return InterlockedCompareExchange(pFlag, 0, 0);
+#else
+   return __atomic_load_n(pFlag, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/// <summary>
+/// Set a flag with release semantics.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+static inline void setFlag(volatile LONG* const pFlag) {
+#ifdef _WIN32
+   InterlockedExchange(pFlag, 1);
+#else
+   __atomic_store_n(pFlag, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+/// <summary>
+/// Increment a counter.
+/// </summary>
+/// <param name="pCounter">Pointer to the counter.</param>
+static inline void incrementCounter(volatile LONG* const pCounter) {
+#ifdef _WIN32
+   InterlockedIncrement(pCounter);
+#else
+   __atomic_add_fetch(pCounter, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/// <summary>
+/// Give the processor to another thread.
+/// </summary>
+static inline void yieldThread(void) {
+#ifdef _WIN32
+   SwitchToThread();
+#else
+   sched_yield();
+#endif
+}
+
+/// <summary>
+/// Serve one request.
+/// A buffered request is copied from the buffer of the thread, which is refilled with one call, when it runs out.
+/// </summary>
+/// <param name="pRun">Data shared by all threads.</param>
+/// <param name="pRequest">Buffer that receives the requested bytes.</param>
+/// <param name="pRefill">Buffer of the thread with REFILL_SIZE bytes or NULL, if requests are not buffered.</param>
+/// <param name="pAvailable">Pointer to the number of unused bytes in the buffer of the thread.</param>
+/// <returns>NTSTATUS of the operation.</returns>
+static inline NTSTATUS serveRequest(const RNG_RUN* const pRun, PUCHAR const pRequest, PUCHAR const pRefill, ULONG* const pAvailable) {
+   const CRYPTO_ENGINE* pEngine = pRun->pEngine;
+   const ULONG requestSize = pRun->requestSize;
+
+   if (pRefill == NULL)
+      return pEngine->GenRandom(pEngine->context, pRun->hAlgorithm, pRequest, requestSize);
+
+   if (*pAvailable < requestSize) {
+      NTSTATUS nts = pEngine->GenRandom(pEngine->context, pRun->hAlgorithm, pRefill, REFILL_SIZE);
+      if (nts < 0)
+         return nts;
+
+      *pAvailable = REFILL_SIZE;
+   }
+
+   memcpy(pRequest, pRefill + (REFILL_SIZE - *pAvailable), requestSize);
+   *pAvailable -= requestSize;
+
+   return 0;
+}
+
+/// <summary>
+/// Make requests until the measurement is stopped.
+/// </summary>
+/// <param name="pWorker">Data of the thread.</param>
+static void runWorker(RNG_WORKER* const pWorker) {
+   RNG_RUN* pRun = pWorker->pRun;
+
+   pWorker->isPinned = PinCurrentThread(pWorker->processorIndex);
+
+   // 1. Allocate the buffers on the pinned thread and warm up. Nothing of this is measured.
+   //    The buffer of the thread starts empty, so each measurement includes its refills.
+   NTSTATUS nts = 0;
+   ULONG bufferSize = pRun->requestSize + ((pRun->isBuffered != FALSE) ? REFILL_SIZE : 0);
+   PUCHAR pBuffer = HeapAlloc(GetProcessHeap(), 0, bufferSize);
+   if (pBuffer != NULL)
+      memset(pBuffer, 0, bufferSize);
+   else
+      nts = STATUS_NO_MEMORY;
+
+   PUCHAR pRefill = (pRun->isBuffered != FALSE && pBuffer != NULL) ? pBuffer + pRun->requestSize : NULL;
+   ULONG available = 0;
+
+   for (ULONG i = WARMUP_REQUESTS; i > 0 && nts >= 0; i--)
+      nts = pRun->pEngine->GenRandom(pRun->pEngine->context, pRun->hAlgorithm, pBuffer, pRun->requestSize);
+
+   // 2. Wait until all threads are ready.
+   incrementCounter(&pRun->readyCount);
+   while (loadFlag(&pRun->startFlag) == 0)
+      yieldThread();
+
+   // 3. Make requests until the measurement is stopped.
+   uint64_t requestCount = 0;
+   uint64_t startTime = GetTimeNs();
+   if (nts >= 0)
+      while (loadFlag(&pRun->stopFlag) == 0) {
+         nts = serveRequest(pRun, pBuffer, pRefill, &available);
+         if (nts < 0)
+            break;
+
+         requestCount++;
+      }
+
+   pWorker->nanoseconds = GetTimeNs() - startTime;
+   pWorker->requestCount = requestCount;
+   pWorker->status = nts;
+
+   // 4. Release the buffers.
+   if (pBuffer != NULL)
+      HeapFree(GetProcessHeap(), 0, pBuffer);
+}
+
+#ifdef _WIN32
+/// <summary>
+/// Thread procedure of a measurement thread.
+/// </summary>
+/// <param name="parameter">Data of the thread.</param>
+/// <returns>Always 0.</returns>
+static DWORD WINAPI workerThread(LPVOID parameter) {
+   runWorker(parameter);
+   return 0;
+}
+#else
+/// <summary>
+/// Thread procedure of a measurement thread.
+/// </summary>
+/// <param name="parameter">Data of the thread.</param>
+/// <returns>Always NULL.</returns>
+static void* workerThread(void* parameter) {
+   runWorker(parameter);
+   return NULL;
+}
+#endif
+
+/// <summary>
+/// Run one measurement with a number of threads.
+/// The calling thread only controls the measurement, so that it does not disturb the measurement threads.
+/// </summary>
+/// <param name="pRun">Data shared by all threads.</param>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="threadCount">Number of threads.</param>
+/// <param name="intervalNs">Duration of the measurement in nanoseconds.</param>
+/// <returns>TRUE, if all threads could be started, FALSE if not.</returns>
+static BOOL runThreads(RNG_RUN* const pRun, RNG_WORKER* const pWorkers, const ULONG threadCount, const uint64_t intervalNs) {
+   const PCHAR functionName = "runThreads";
+
+   pRun->readyCount = 0;
+   pRun->startFlag = 0;
+   pRun->stopFlag = 0;
+
+   // 1. Start the threads.
+   ULONG startedCount = 0;
+#ifdef _WIN32
+   HANDLE hThreads[MAX_RNG_THREADS];
+#else
+   pthread_t threads[MAX_RNG_THREADS];
+#endif
+   for (; startedCount < threadCount; startedCount++) {
+      RNG_WORKER* pWorker = pWorkers + startedCount;
+      memset(pWorker, 0, sizeof(RNG_WORKER));
+      pWorker->pRun = pRun;
+      pWorker->processorIndex = startedCount;
+
+#ifdef _WIN32
+      hThreads[startedCount] = CreateThread(NULL, 0, workerThread, pWorker, 0, NULL);
+      if (hThreads[startedCount] == NULL) {
+         PrintLastError(functionName, "CreateThread");
+         break;
+      }
+#else
+      int rc = pthread_create(&threads[startedCount], NULL, workerThread, pWorker);
+      if (rc != 0) {
+         PrintWinError(functionName, "pthread_create", (DWORD)rc);
+         break;
+      }
+#endif
+   }
+
+   // 2. Wait until all threads are ready, start them, let them run for the interval and stop them.
+   //    If not all threads could be started, the started ones are stopped immediately.
+   if (startedCount == threadCount) {
+      while ((ULONG)loadFlag(&pRun->readyCount) < threadCount)
+         SleepMilliseconds(1);
+
+      setFlag(&pRun->startFlag);
+      SleepMilliseconds((ULONG)(intervalNs / 1000000ULL));
+   } else
+      setFlag(&pRun->startFlag);
+
+   setFlag(&pRun->stopFlag);
+
+   // 3. Wait for the threads.
+#ifdef _WIN32
+   for (ULONG i = 0; i < startedCount; i++) {
+      WaitForSingleObject(hThreads[i], INFINITE);
+      CloseHandle(hThreads[i]);
+   }
+#else
+   for (ULONG i = 0; i < startedCount; i++)
+      pthread_join(threads[i], NULL);
+#endif
+
+   return (startedCount == threadCount);
+}
+
+/// <summary>
+/// Combine the measurements of the threads.
+/// The throughput is the sum of the throughputs of the threads, the latency is the average time of a request of all threads.
+/// </summary>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="threadCount">Number of threads.</param>
+/// <param name="requestSize">Size of a request in bytes.</param>
+/// <param name="pResult">Pointer to the result.</param>
+static void combineThreads(const RNG_WORKER* const pWorkers, const ULONG threadCount, const ULONG requestSize, RNG_RESULT* const pResult) {
+   double megabytesPerSecond = 0.0;
+   uint64_t totalNanoseconds = 0;
+   uint64_t totalRequests = 0;
+   BOOL allPinned = TRUE;
+
+   for (ULONG i = 0; i < threadCount; i++) {
+      const RNG_WORKER* pWorker = pWorkers + i;
+      uint64_t nanoseconds = (pWorker->nanoseconds != 0) ? pWorker->nanoseconds : 1;
+      megabytesPerSecond += (double)pWorker->requestCount * requestSize * 1000.0 / (double)nanoseconds;
+      totalNanoseconds += nanoseconds;
+      totalRequests += pWorker->requestCount;
+      allPinned &= pWorker->isPinned;
+   }
+
+   pResult->megabytesPerSecond = megabytesPerSecond;
+   pResult->nanosecondsPerRequest = (totalRequests != 0) ? (double)totalNanoseconds / (double)totalRequests : 0.0;
+   pResult->allPinned = allPinned;
+}
+
+/// <summary>
+/// Measure one request size with one thread count, with or without buffering.
+/// </summary>
+/// <param name="pRun">Data shared by all threads with the request size and the buffering set.</param>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="threadCount">Number of threads.</param>
+/// <param name="intervalNs">Duration of the measurement in nanoseconds.</param>
+/// <param name="pResult">Pointer to the result.</param>
+/// <returns>TRUE, if the measurement could be made, FALSE if not.</returns>
+static BOOL measureRequests(RNG_RUN* const pRun,
+                            RNG_WORKER* const pWorkers,
+                            const ULONG threadCount,
+                            const uint64_t intervalNs,
+                            RNG_RESULT* const pResult) {
+   const PCHAR functionName = "measureRequests";
+
+   if (runThreads(pRun, pWorkers, threadCount, intervalNs) == FALSE)
+      return FALSE;
+
+   for (ULONG i = 0; i < threadCount; i++)
+      if (pWorkers[i].status < 0) {
+         PrintNtStatus(functionName, "GenRandom", pWorkers[i].status);
+         return FALSE;
+      }
+
+   combineThreads(pWorkers, threadCount, pRun->requestSize, pResult);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Print the size of a request with a binary unit.
+/// </summary>
+/// <param name="requestSize">Size of the request.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+static void printRequestSize(const ULONG requestSize, FILE* fStdOut) {
+   const char* unit = "B";
+   ULONG value = requestSize;
+   if (requestSize >= 1024UL) {
+      unit = "KiB";
+      value = requestSize >> 10;
+   }
+
+   fprintf(fStdOut, "      %5lu %-3s", (unsigned long)value, unit);
+}
+
+/// <summary>
+/// Print the throughput and the latency of a measurement.
+/// </summary>
+/// <param name="pResult">Result of the measurement or NULL, if the measurement was not made.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+static void printResult(const RNG_RESULT* const pResult, FILE* fStdOut) {
+   if (pResult == NULL) {
+      fprintf(fStdOut, " %13s %10s", "-", "-");
+      return;
+   }
+
+   char throughput[NUMBER_BUFFER_SIZE];
+   char latency[NUMBER_BUFFER_SIZE];
+   FormatFixedPoint(pResult->megabytesPerSecond, 2, throughput);
+   FormatFixedPoint(pResult->nanosecondsPerRequest, 1, latency);
+
+   fprintf(fStdOut, " %13s %10s", throughput, latency);
+}
+
+/// <summary>
+/// Measure all request sizes on 1 up to maxThreads threads.
+/// The thread count is doubled from one step to the next. The maximum is always measured.
+/// </summary>
+/// <param name="pRun">Data shared by all threads.</param>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="maxThreads">Maximum number of threads.</param>
+/// <param name="intervalNs">Duration of each measurement in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if all measurements could be made, FALSE if not.</returns>
+static BOOL measureRequestSizes(RNG_RUN* const pRun,
+                                RNG_WORKER* const pWorkers,
+                                const ULONG maxThreads,
+                                const uint64_t intervalNs,
+                                FILE* fStdOut) {
+   fputs("      Request   Threads   Direct MB/s    ns/call Buffered MB/s    ns/call\n", fStdOut);
+
+   for (ULONG requestSize = MIN_REQUEST_SIZE; requestSize <= MAX_REQUEST_SIZE; requestSize <<= REQUEST_STEP_SHIFT) {
+      pRun->requestSize = requestSize;
+
+      ULONG threadCount = 1;
+      for (;;) {
+         RNG_RESULT direct;
+         pRun->isBuffered = FALSE;
+         if (measureRequests(pRun, pWorkers, threadCount, intervalNs, &direct) == FALSE)
+            return FALSE;
+
+         // Requests that are as large as the buffer of a thread would only be copied.
+         RNG_RESULT buffered;
+         BOOL isBuffered = (requestSize < REFILL_SIZE);
+         if (isBuffered != FALSE) {
+            pRun->isBuffered = TRUE;
+            if (measureRequests(pRun, pWorkers, threadCount, intervalNs, &buffered) == FALSE)
+               return FALSE;
+         }
+
+         printRequestSize(requestSize, fStdOut);
+         fprintf(fStdOut, " %7lu", (unsigned long)threadCount);
+         printResult(&direct, fStdOut);
+         printResult((isBuffered != FALSE) ? &buffered : NULL, fStdOut);
+         BOOL allPinned = direct.allPinned & ((isBuffered != FALSE) ? buffered.allPinned : TRUE);
+         fputs((allPinned != FALSE) ? "\n" : " (not pinned)\n", fStdOut);
+         fflush(fStdOut);
+
+         if (threadCount >= maxThreads)
+            break;
+
+         threadCount <<= 1;
+         if (threadCount > maxThreads)
+            threadCount = maxThreads;
+      }
+   }
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Measure the throughput and the latency per call of a random number generator for request sizes
+/// from 16 bytes to 64 KiB on 1 up to maxThreads threads, which share the algorithm handle.
+/// Small requests are measured once with one call per request and once served from a buffer per thread,
+/// which shows whether buffering random bytes pays off.
+/// </summary>
+/// <param name="pEngine">Crypto engine that runs the algorithm.</param>
+/// <param name="algorithmName">Name of the algorithm or NULL for the system-preferred random number generator.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+/// <param name="intervalNs">Duration of the measurement for each request size and thread count in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+BOOL MeasureRandomNumbers(const CRYPTO_ENGINE* const pEngine,
+                          LPCWSTR const algorithmName,
+                          const ULONG maxThreads,
+                          const uint64_t intervalNs,
+                          FILE* fStdOut) {
+   const PCHAR functionName = "MeasureRandomNumbers";
+
+   fputs("   ", fStdOut);
+   fputs((algorithmName != NULL) ? AsConsoleCodePageString(algorithmName) : "System-preferred random number generator", fStdOut);
+   _putc_nolock('\n', fStdOut);
+
+   // 1. Open the shared algorithm handle and check that the engine can generate random numbers with it.
+   ENGINE_HANDLE hAlgorithm = NULL;
+   NTSTATUS nts = 0;
+   if (algorithmName != NULL)
+      nts = pEngine->OpenAlgorithm(pEngine->context, algorithmName, &hAlgorithm);
+
+   if (nts >= 0) {
+      UCHAR probe[MIN_REQUEST_SIZE];
+      nts = pEngine->GenRandom(pEngine->context, hAlgorithm, probe, MIN_REQUEST_SIZE);
+      if (nts < 0 && hAlgorithm != NULL)
+         pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+   }
+
+   if (nts == STATUS_NOT_SUPPORTED) {
+      fprintf(fStdOut, "      Not supported by engine %s\n", pEngine->name);
+      return TRUE;
+   }
+
+   if (nts < 0) {
+      fprintf(fStdOut, "      Could not open algorithm: 0x%08lx\n", (unsigned long)(ULONG)nts);
+      return TRUE;
+   }
+
+   // 2. Allocate the thread data.
+   ULONG threadLimit = (maxThreads == 0) ? GetProcessorCount() : maxThreads;
+   if (threadLimit > MAX_RNG_THREADS)
+      threadLimit = MAX_RNG_THREADS;
+
+   RNG_WORKER* pWorkers = HeapAlloc(GetProcessHeap(), 0, threadLimit * sizeof(RNG_WORKER));
+   if (pWorkers == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for thread data failed.\n", functionName);
+      if (hAlgorithm != NULL)
+         pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+      return FALSE;
+   }
+
+   // 3. Measure all request sizes and thread counts.
+   RNG_RUN run;
+   memset(&run, 0, sizeof(run));
+   run.pEngine = pEngine;
+   run.hAlgorithm = hAlgorithm;
+
+   BOOL result = measureRequestSizes(&run, pWorkers, threadLimit, intervalNs, fStdOut);
+
+   // 4. Release the thread data and the algorithm handle.
+   HeapFree(GetProcessHeap(), 0, pWorkers);
+   if (hAlgorithm != NULL)
+      pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+
+   return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "CryptoEngine.h"
+
+/// <summary>
+/// Measure the throughput and the latency per call of a random number generator for request sizes
+/// from 16 bytes to 64 KiB on 1 up to maxThreads threads, which share the algorithm handle.
+/// Small requests are measured once with one call per request and once served from a buffer per thread,
+/// which shows whether buffering random bytes pays off.
+/// </summary>
+/// <param name="pEngine">Crypto engine that runs the algorithm.</param>
+/// <param name="algorithmName">Name of the algorithm or NULL for the system-preferred random number generator.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+/// <param name="intervalNs">Duration of the measurement for each request size and thread count in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+BOOL MeasureRandomNumbers(const CRYPTO_ENGINE* const pEngine,
+                          LPCWSTR const algorithmName,
+                          const ULONG maxThreads,
+                          const uint64_t intervalNs,
+                          FILE* fStdOut);
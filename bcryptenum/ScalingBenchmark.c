@@ -0,0 +1,498 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Format throughput with the number formatter.
+//
+
+#define _CRT_DISABLE_PERFCRIT_LOCKS 1
+
+#include <math.h>
+#include <string.h>
+
+#include "ApiErrorHandler.h"
+#include "BenchTarget.h"
+#include "Console.h"
+#include "NumberFormatter.h"
+#include "ScalingBenchmark.h"
+#include "Timer.h"
+#include "WorkerPool.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// ******** Private constants ********
+
+/// Maximum number of measurement threads.
+#define MAX_SCALING_THREADS 64
+
+/// Number of messages each thread processes before the measurement starts.
+#define WARMUP_MESSAGES 16
+
+// ******** Private types ********
+
+/// <summary>
+/// Data shared by all threads of one measurement.
+/// </summary>
+typedef struct _SCALING_RUN {
+   const CRYPTO_ENGINE* pEngine;
+   LPCWSTR algorithmName;
+   ENGINE_HANDLE hSharedAlgorithm;  // NULL, if each thread opens its own algorithm handle.
+   BOOL isHash;
+   ULONG messageSize;
+   volatile LONG readyCount;
+   volatile LONG startFlag;
+   volatile LONG stopFlag;
+} SCALING_RUN;
+
+/// <summary>
+/// Data of one measurement thread.
+/// </summary>
+typedef struct _SCALING_WORKER {
+   SCALING_RUN* pRun;
+   ULONG processorIndex;
+   BOOL isPinned;
+   NTSTATUS status;
+   uint64_t bytes;
+   uint64_t nanoseconds;
+} SCALING_WORKER;
+
+/// <summary>
+/// Result of one measurement.
+/// </summary>
+typedef struct _SCALING_RESULT {
+   double megabytesPerSecond;
+   double relativeDeviation;
+   BOOL allPinned;
+} SCALING_RESULT;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Read a flag with acquire semantics.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+/// <returns>Value of the flag.</returns>
+static inline LONG loadFlag(volatile LONG* const pFlag) {
+#ifdef _WIN32
+   return InterlockedCompareExchange(pFlag, 0, 0);
+#else
+   return __atomic_load_n(pFlag, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/// <summary>
+/// Set a flag with release semantics.
+/// </summary>
+/// <param name="pFlag">Pointer to the flag.</param>
+static inline void setFlag(volatile LONG* const pFlag) {
+#ifdef _WIN32
+   InterlockedExchange(pFlag, 1);
+#else
+   __atomic_store_n(pFlag, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+/// <summary>
+/// Increment a counter.
+/// </summary>
+/// <param name="pCounter">Pointer to the counter.</param>
+static inline void incrementCounter(volatile LONG* const pCounter) {
+#ifdef _WIN32
+   InterlockedIncrement(pCounter);
+#else
+   __atomic_add_fetch(pCounter, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/// <summary>
+/// Give the processor to another thread.
+/// </summary>
+static inline void yieldThread(void) {
+#ifdef _WIN32
+   SwitchToThread();
+#else
+   sched_yield();
+#endif
+}
+
+/// <summary>
+/// Prepare the objects of a thread, process messages until the measurement is stopped and release the objects.
+/// </summary>
+/// <param name="pWorker">Data of the thread.</param>
+static void runWorker(SCALING_WORKER* const pWorker) {
+   SCALING_RUN* pRun = pWorker->pRun;
+   const CRYPTO_ENGINE* pEngine = pRun->pEngine;
+   const ULONG messageSize = pRun->messageSize;
+
+   pWorker->isPinned = PinCurrentThread(pWorker->processorIndex);
+
+   // 1. Prepare the algorithm handle, the hash or key object and the buffers on the pinned thread.
+   //    Nothing of this is measured.
+   NTSTATUS nts = 0;
+   ENGINE_HANDLE hAlgorithm = pRun->hSharedAlgorithm;
+   if (hAlgorithm == NULL)
+      nts = pEngine->OpenAlgorithm(pEngine->context, pRun->algorithmName, &hAlgorithm);
+
+   BENCH_TARGET target;
+   memset(&target, 0, sizeof(target));
+   target.pEngine = pEngine;
+   target.isHash = pRun->isHash;
+
+   BOOL hasObject = FALSE;
+   if (nts >= 0) {
+      nts = CreateBenchObject(&target, hAlgorithm);
+      hasObject = (nts >= 0);
+   }
+
+   PUCHAR pBuffer = NULL;
+   if (nts >= 0) {
+      pBuffer = HeapAlloc(GetProcessHeap(), 0, 2 * (size_t)messageSize);
+      if (pBuffer != NULL) {
+         for (ULONG i = 0; i < 2 * messageSize; i++)
+            pBuffer[i] = (UCHAR)(i * 131 + 7);
+
+         target.pInput = pBuffer;
+         target.pOutput = pBuffer + messageSize;
+      } else
+         nts = STATUS_NO_MEMORY;
+   }
+
+   for (ULONG i = WARMUP_MESSAGES; i > 0 && nts >= 0; i--)
+      nts = ProcessMessage(&target, messageSize);
+
+   // 2. Wait until all threads are ready.
+   incrementCounter(&pRun->readyCount);
+   while (loadFlag(&pRun->startFlag) == 0)
+      yieldThread();
+
+   // 3. Process messages until the measurement is stopped.
+   uint64_t messageCount = 0;
+   uint64_t startTime = GetTimeNs();
+   if (nts >= 0)
+      while (loadFlag(&pRun->stopFlag) == 0) {
+         nts = ProcessMessage(&target, messageSize);
+         if (nts < 0)
+            break;
+
+         messageCount++;
+      }
+
+   pWorker->nanoseconds = GetTimeNs() - startTime;
+   pWorker->bytes = messageCount * messageSize;
+   pWorker->status = nts;
+
+   // 4. Release the objects.
+   if (pBuffer != NULL)
+      HeapFree(GetProcessHeap(), 0, pBuffer);
+
+   if (hasObject != FALSE)
+      DestroyBenchObject(&target);
+
+   if (pRun->hSharedAlgorithm == NULL && hAlgorithm != NULL)
+      pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+}
+
+#ifdef _WIN32
+/// <summary>
+/// Thread procedure of a measurement thread.
+/// </summary>
+/// <param name="parameter">Data of the thread.</param>
+/// <returns>Always 0.</returns>
+static DWORD WINAPI workerThread(LPVOID parameter) {
+   runWorker(parameter);
+   return 0;
+}
+#else
+/// <summary>
+/// Thread procedure of a measurement thread.
+/// </summary>
+/// <param name="parameter">Data of the thread.</param>
+/// <returns>Always NULL.</returns>
+static void* workerThread(void* parameter) {
+   runWorker(parameter);
+   return NULL;
+}
+#endif
+
+/// <summary>
+/// Run one measurement with a number of threads.
+/// The calling thread only controls the measurement, so that it does not disturb the measurement threads.
+/// </summary>
+/// <param name="pRun">Data shared by all threads.</param>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="threadCount">Number of threads.</param>
+/// <param name="intervalNs">Duration of the measurement in nanoseconds.</param>
+/// <returns>TRUE, if all threads could be started, FALSE if not.</returns>
+static BOOL runThreads(SCALING_RUN* const pRun, SCALING_WORKER* const pWorkers, const ULONG threadCount, const uint64_t intervalNs) {
+   const PCHAR functionName = "runThreads";
+
+   pRun->readyCount = 0;
+   pRun->startFlag = 0;
+   pRun->stopFlag = 0;
+
+   // 1. Start the threads.
+   ULONG startedCount = 0;
+#ifdef _WIN32
+   HANDLE hThreads[MAX_SCALING_THREADS];
+#else
+   pthread_t threads[MAX_SCALING_THREADS];
+#endif
+   for (; startedCount < threadCount; startedCount++) {
+      SCALING_WORKER* pWorker = pWorkers + startedCount;
+      memset(pWorker, 0, sizeof(SCALING_WORKER));
+      pWorker->pRun = pRun;
+      pWorker->processorIndex = startedCount;
+
+#ifdef _WIN32
+      hThreads[startedCount] = CreateThread(NULL, 0, workerThread, pWorker, 0, NULL);
+      if (hThreads[startedCount] == NULL) {
+         PrintLastError(functionName, "CreateThread");
+         break;
+      }
+#else
+      int rc = pthread_create(&threads[startedCount], NULL, workerThread, pWorker);
+      if (rc != 0) {
+         PrintWinError(functionName, "pthread_create", (DWORD)rc);
+         break;
+      }
+#endif
+   }
+
+   // 2. Wait until all threads are ready, start them, let them run for the interval and stop them.
+   //    If not all threads could be started, the started ones are stopped immediately.
+   if (startedCount == threadCount) {
+      while ((ULONG)loadFlag(&pRun->readyCount) < threadCount)
+         SleepMilliseconds(1);
+
+      setFlag(&pRun->startFlag);
+      SleepMilliseconds((ULONG)(intervalNs / 1000000ULL));
+   } else
+      setFlag(&pRun->startFlag);
+
+   setFlag(&pRun->stopFlag);
+
+   // 3. Wait for the threads.
+#ifdef _WIN32
+   for (ULONG i = 0; i < startedCount; i++) {
+      WaitForSingleObject(hThreads[i], INFINITE);
+      CloseHandle(hThreads[i]);
+   }
+#else
+   for (ULONG i = 0; i < startedCount; i++)
+      pthread_join(threads[i], NULL);
+#endif
+
+   return (startedCount == threadCount);
+}
+
+/// <summary>
+/// Combine the measurements of the threads.
+/// </summary>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="threadCount">Number of threads.</param>
+/// <param name="pResult">Pointer to the result.</param>
+static void combineThreads(const SCALING_WORKER* const pWorkers, const ULONG threadCount, SCALING_RESULT* const pResult) {
+   double sum = 0.0;
+   double sumOfSquares = 0.0;
+   BOOL allPinned = TRUE;
+
+   for (ULONG i = 0; i < threadCount; i++) {
+      const SCALING_WORKER* pWorker = pWorkers + i;
+      double megabytesPerSecond = (double)pWorker->bytes * 1000.0 / (double)((pWorker->nanoseconds != 0) ? pWorker->nanoseconds : 1);
+      sum += megabytesPerSecond;
+      sumOfSquares += megabytesPerSecond * megabytesPerSecond;
+      allPinned &= pWorker->isPinned;
+   }
+
+   double mean = sum / threadCount;
+   double variance = sumOfSquares / threadCount - mean * mean;
+
+   pResult->megabytesPerSecond = sum;
+   pResult->relativeDeviation = (mean > 0.0 && variance > 0.0) ? sqrt(variance) / mean : 0.0;
+   pResult->allPinned = allPinned;
+}
+
+/// <summary>
+/// Measure the scaling for thread counts from 1 to the maximum.
+/// The thread count is doubled from one step to the next. The maximum is always measured.
+/// </summary>
+/// <param name="pRun">Data shared by all threads.</param>
+/// <param name="pWorkers">Data of the threads.</param>
+/// <param name="maxThreads">Maximum number of threads.</param>
+/// <param name="intervalNs">Duration of the measurement for each thread count in nanoseconds.</param>
+/// <param name="modeName">Name of the handle mode for the output.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if all measurements could be made, FALSE if not.</returns>
+static BOOL measureThreadCounts(SCALING_RUN* const pRun,
+                                SCALING_WORKER* const pWorkers,
+                                const ULONG maxThreads,
+                                const uint64_t intervalNs,
+                                const char* const modeName,
+                                FILE* fStdOut) {
+   const PCHAR functionName = "measureThreadCounts";
+
+   double singleThreadThroughput = 0.0;
+
+   ULONG threadCount = 1;
+   for (;;) {
+      if (runThreads(pRun, pWorkers, threadCount, intervalNs) == FALSE)
+         return FALSE;
+
+      for (ULONG i = 0; i < threadCount; i++)
+         if (pWorkers[i].status < 0) {
+            PrintNtStatus(functionName, pRun->isHash != FALSE ? "HashData" : "Encrypt", pWorkers[i].status);
+            return FALSE;
+         }
+
+      SCALING_RESULT result;
+      combineThreads(pWorkers, threadCount, &result);
+
+      if (threadCount == 1)
+         singleThreadThroughput = result.megabytesPerSecond;
+
+      double efficiency = (singleThreadThroughput > 0.0) ? result.megabytesPerSecond / (singleThreadThroughput * threadCount) : 0.0;
+
+      char throughput[NUMBER_BUFFER_SIZE];
+      char efficiencyPercent[NUMBER_BUFFER_SIZE];
+      char deviationPercent[NUMBER_BUFFER_SIZE];
+      FormatFixedPoint(result.megabytesPerSecond, 2, throughput);
+      FormatFixedPoint(efficiency * 100.0, 1, efficiencyPercent);
+      FormatFixedPoint(result.relativeDeviation * 100.0, 1, deviationPercent);
+
+      fprintf(fStdOut,
+              "      %-10s %7lu %12s %9s %% %9s %%%s\n",
+              modeName,
+              (unsigned long)threadCount,
+              throughput,
+              efficiencyPercent,
+              deviationPercent,
+              (result.allPinned != FALSE) ? "" : " (not pinned)");
+      fflush(fStdOut);
+
+      if (threadCount >= maxThreads)
+         break;
+
+      threadCount <<= 1;
+      if (threadCount > maxThreads)
+         threadCount = maxThreads;
+   }
+
+   return TRUE;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Measure how the throughput of an algorithm scales with the number of threads.
+/// Each thread is pinned to a processor and has its own hash or key object.
+/// The measurement is done once with an algorithm handle that is shared by all threads
+/// and once with an algorithm handle per thread.
+/// </summary>
+/// <param name="pEngine">Crypto engine that runs the algorithm.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="isHash">TRUE for a hash, FALSE for a symmetric cipher.</param>
+/// <param name="messageSize">Size of the messages. It has to be a multiple of MAX_BLOCK_LENGTH.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+/// <param name="intervalNs">Duration of the measurement for each thread count in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+BOOL MeasureScaling(const CRYPTO_ENGINE* const pEngine,
+                    LPCWSTR const algorithmName,
+                    const BOOL isHash,
+                    const ULONG messageSize,
+                    const ULONG maxThreads,
+                    const uint64_t intervalNs,
+                    FILE* fStdOut) {
+   const PCHAR functionName = "MeasureScaling";
+
+   fputs("   ", fStdOut);
+   fputs(AsConsoleCodePageString(algorithmName), fStdOut);
+   fprintf(fStdOut, " (%lu byte messages)\n", (unsigned long)messageSize);
+
+   // 1. Open the shared algorithm handle and check that the engine can measure the algorithm.
+   ENGINE_HANDLE hAlgorithm;
+   NTSTATUS nts = pEngine->OpenAlgorithm(pEngine->context, algorithmName, &hAlgorithm);
+   if (nts >= 0) {
+      BENCH_TARGET target;
+      memset(&target, 0, sizeof(target));
+      target.pEngine = pEngine;
+      target.isHash = isHash;
+
+      nts = CreateBenchObject(&target, hAlgorithm);
+      if (nts >= 0)
+         DestroyBenchObject(&target);
+      else
+         pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+   }
+
+   if (nts == STATUS_NOT_SUPPORTED) {
+      fprintf(fStdOut, "      Not supported by engine %s\n", pEngine->name);
+      return TRUE;
+   }
+
+   if (nts < 0) {
+      fprintf(fStdOut, "      Could not open algorithm: 0x%08lx\n", (unsigned long)(ULONG)nts);
+      return TRUE;
+   }
+
+   // 2. Allocate the thread data.
+   ULONG threadLimit = (maxThreads == 0) ? GetProcessorCount() : maxThreads;
+   if (threadLimit > MAX_SCALING_THREADS)
+      threadLimit = MAX_SCALING_THREADS;
+
+   SCALING_WORKER* pWorkers = HeapAlloc(GetProcessHeap(), 0, threadLimit * sizeof(SCALING_WORKER));
+   if (pWorkers == NULL) {
+      fprintf(stderr, "Function \"%s\": HeapAlloc for thread data failed.\n", functionName);
+      pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+      return FALSE;
+   }
+
+   // 3. Measure with a shared algorithm handle and with one algorithm handle per thread.
+   fputs("      Handles    Threads         MB/s  Efficiency   Deviation\n", fStdOut);
+
+   SCALING_RUN run;
+   memset(&run, 0, sizeof(run));
+   run.pEngine = pEngine;
+   run.algorithmName = algorithmName;
+   run.isHash = isHash;
+   run.messageSize = messageSize;
+
+   run.hSharedAlgorithm = hAlgorithm;
+   BOOL result = measureThreadCounts(&run, pWorkers, threadLimit, intervalNs, "shared", fStdOut);
+
+   if (result != FALSE) {
+      run.hSharedAlgorithm = NULL;
+      result = measureThreadCounts(&run, pWorkers, threadLimit, intervalNs, "per thread", fStdOut);
+   }
+
+   // 4. Release the thread data and the shared algorithm handle.
+   HeapFree(GetProcessHeap(), 0, pWorkers);
+   pEngine->CloseAlgorithm(pEngine->context, hAlgorithm);
+
+   return result;
+}
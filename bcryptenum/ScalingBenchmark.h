@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "CryptoEngine.h"
+
+/// <summary>
+/// Measure how the throughput of an algorithm scales with the number of threads.
+/// Each thread is pinned to a processor and has its own hash or key object.
+/// The measurement is done once with an algorithm handle that is shared by all threads
+/// and once with an algorithm handle per thread.
+/// </summary>
+/// <param name="pEngine">Crypto engine that runs the algorithm.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="isHash">TRUE for a hash, FALSE for a symmetric cipher.</param>
+/// <param name="messageSize">Size of the messages. It has to be a multiple of MAX_BLOCK_LENGTH.</param>
+/// <param name="maxThreads">Maximum number of threads. 0 means the number of processors.</param>
+/// <param name="intervalNs">Duration of the measurement for each thread count in nanoseconds.</param>
+/// <param name="fStdOut">Stdout file pointer.</param>
+/// <returns>TRUE, if the algorithm could be measured or is not supported by the engine, FALSE if an operation failed.</returns>
+BOOL MeasureScaling(const CRYPTO_ENGINE* const pEngine,
+                    LPCWSTR const algorithmName,
+                    const BOOL isHash,
+                    const ULONG messageSize,
+                    const ULONG maxThreads,
+                    const uint64_t intervalNs,
+                    FILE* fStdOut);
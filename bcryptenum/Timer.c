@@ -0,0 +1,105 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Sleep function.
+//
+
+#include <stdint.h>
+
+#include "Timer.h"
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+// ******** Private variables ********
+
+#ifdef _WIN32
+/// Frequency of the performance counter. 0 means not yet known.
+static volatile LONGLONG counterFrequency = 0;
+#endif
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the value of a monotonic high resolution clock.
+/// </summary>
+/// <returns>Time in nanoseconds since an arbitrary starting point.</returns>
+uint64_t GetTimeNs(void) {
+#ifdef _WIN32
+   LARGE_INTEGER value;
+   if (counterFrequency == 0) {
+      QueryPerformanceFrequency(&value);
+      counterFrequency = value.QuadPart;  // The frequency never changes, so a race is harmless.
+   }
+
+   QueryPerformanceCounter(&value);
+
+   // Split the conversion so that the multiplication can not overflow.
+   uint64_t seconds = (uint64_t)(value.QuadPart / counterFrequency);
+   uint64_t remainder = (uint64_t)(value.QuadPart % counterFrequency);
+   return seconds * 1000000000ULL + (remainder * 1000000000ULL) / (uint64_t)counterFrequency;
+#else
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/// <summary>
+/// Read the processor cycle counter.
+/// </summary>
+/// <returns>Cycle counter or 0, if the processor has no cycle counter that can be read.</returns>
+uint64_t ReadCycleCounter(void) {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+   return __rdtsc();
+#else
+   return 0;
+#endif
+}
+
+/// <summary>
+/// Suspend the calling thread.
+/// </summary>
+/// <param name="milliseconds">Time to sleep in milliseconds.</param>
+void SleepMilliseconds(const ULONG milliseconds) {
+#ifdef _WIN32
+   Sleep(milliseconds);
+#else
+   struct timespec duration;
+   duration.tv_sec = milliseconds / 1000;
+   duration.tv_nsec = (long)(milliseconds % 1000) * 1000000L;
+
+   // Continue sleeping, if the sleep was interrupted by a signal.
+   while (nanosleep(&duration, &duration) != 0)
+      ;
+#endif
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Platform.h"
+
+/// <summary>
+/// Get the value of a monotonic high resolution clock.
+/// </summary>
+/// <returns>Time in nanoseconds since an arbitrary starting point.</returns>
+uint64_t GetTimeNs(void);
+
+/// <summary>
+/// Read the processor cycle counter.
+/// </summary>
+/// <returns>Cycle counter or 0, if the processor has no cycle counter that can be read.</returns>
+uint64_t ReadCycleCounter(void);
+
+/// <summary>
+/// Suspend the calling thread.
+/// </summary>
+/// <param name="milliseconds">Time to sleep in milliseconds.</param>
+void SleepMilliseconds(const ULONG milliseconds);
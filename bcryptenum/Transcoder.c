@@ -0,0 +1,406 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Get the code page of the console output.
+//
+
+//
+// Nearly all algorithm names are ASCII. So the transcoder first narrows as many ASCII characters as possible in bulk.
+// On x86 and x64 processors this is done with SSE2 instructions, 16 characters at a time.
+// On other processors 8 bytes of wide characters are checked at once.
+// Only a non-ASCII character is converted with the full conversion.
+//
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Platform.h"
+#include "Transcoder.h"
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// ******** Private constants ********
+
+/// Replacement character for invalid input.
+#define REPLACEMENT_CHARACTER 0xfffd
+
+/// Number of wide characters that are narrowed in one block.
+#define BLOCK_SIZE 16
+
+/// Code page number of UTF-8.
+#define UTF8_CODE_PAGE 65001
+
+// ******** Private variables ********
+
+#ifdef _WIN32
+/// Code page of the console. 0 means not yet known.
+static volatile UINT consoleCodePage = 0;
+
+/// 1, if the console code page stores ASCII characters as themselves, 0 if not, -1 if not yet known.
+static volatile LONG isAsciiCompatible = -1;
+#endif
+
+// ******** Private methods ********
+
+#ifdef USE_SSE2
+/// <summary>
+/// Narrow one block of ASCII wide characters, if all of them are ASCII.
+/// </summary>
+/// <param name="pWide">Block of BLOCK_SIZE wide characters.</param>
+/// <param name="pNarrow">Destination for BLOCK_SIZE bytes.</param>
+/// <returns>TRUE, if the block was narrowed, FALSE if it contains a non-ASCII character.</returns>
+static inline BOOL narrowAsciiBlock(const wchar_t* const pWide, char* const pNarrow) {
+   const __m128i* pSource = (const __m128i*)pWide;
+
+#if WCHAR_MAX <= 0xffff
+   __m128i first = _mm_loadu_si128(pSource);
+   __m128i second = _mm_loadu_si128(pSource + 1);
+
+   // A character is ASCII, if no bit above bit 6 is set.
+   __m128i highBits = _mm_and_si128(_mm_or_si128(first, second), _mm_set1_epi16((short)0xff80));
+   if (_mm_movemask_epi8(_mm_cmpeq_epi16(highBits, _mm_setzero_si128())) != 0xffff)
+      return FALSE;
+
+   _mm_storeu_si128((__m128i*)pNarrow, _mm_packus_epi16(first, second));
+#else
+   __m128i first = _mm_loadu_si128(pSource);
+   __m128i second = _mm_loadu_si128(pSource + 1);
+   __m128i third = _mm_loadu_si128(pSource + 2);
+   __m128i fourth = _mm_loadu_si128(pSource + 3);
+
+   __m128i all = _mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth));
+   __m128i highBits = _mm_and_si128(all, _mm_set1_epi32((int)0xffffff80));
+   if (_mm_movemask_epi8(_mm_cmpeq_epi32(highBits, _mm_setzero_si128())) != 0xffff)
+      return FALSE;
+
+   // All values are below 0x80, so the saturation never happens.
+   __m128i low = _mm_packs_epi32(first, second);
+   __m128i high = _mm_packs_epi32(third, fourth);
+   _mm_storeu_si128((__m128i*)pNarrow, _mm_packus_epi16(low, high));
+#endif
+
+   return TRUE;
+}
+#else
+/// <summary>
+/// Narrow one block of ASCII wide characters, if all of them are ASCII.
+/// The check is done on 8 bytes at a time.
+/// </summary>
+/// <param name="pWide">Block of BLOCK_SIZE wide characters.</param>
+/// <param name="pNarrow">Destination for BLOCK_SIZE bytes.</param>
+/// <returns>TRUE, if the block was narrowed, FALSE if it contains a non-ASCII character.</returns>
+static inline BOOL narrowAsciiBlock(const wchar_t* const pWide, char* const pNarrow) {
+#if WCHAR_MAX <= 0xffff
+   const uint64_t highBitsMask = 0xff80ff80ff80ff80ULL;
+#else
+   const uint64_t highBitsMask = 0xffffff80ffffff80ULL;
+#endif
+
+   const size_t wordCount = (BLOCK_SIZE * sizeof(wchar_t)) / sizeof(uint64_t);
+
+   uint64_t all = 0;
+   for (size_t i = 0; i < wordCount; i++) {
+      uint64_t word;
+      memcpy(&word, (const char*)pWide + i * sizeof(uint64_t), sizeof(word));
+      all |= word;
+   }
+
+   if ((all & highBitsMask) != 0)
+      return FALSE;
+
+   for (size_t i = 0; i < BLOCK_SIZE; i++)
+      pNarrow[i] = (char)pWide[i];
+
+   return TRUE;
+}
+#endif
+
+/// <summary>
+/// Narrow the ASCII characters at the start of a wide character string.
+/// </summary>
+/// <param name="pWide">Wide characters.</param>
+/// <param name="count">Maximum number of characters to narrow.</param>
+/// <param name="pNarrow">Destination.</param>
+/// <returns>Number of narrowed characters. The character after them is not ASCII, if it is less than count.</returns>
+static size_t narrowAscii(const wchar_t* const pWide, const size_t count, char* const pNarrow) {
+   size_t done = 0;
+
+   while (count - done >= BLOCK_SIZE && narrowAsciiBlock(pWide + done, pNarrow + done) != FALSE)
+      done += BLOCK_SIZE;
+
+   while (done < count && (uint32_t)pWide[done] < 0x80) {
+      pNarrow[done] = (char)pWide[done];
+      done++;
+   }
+
+   return done;
+}
+
+/// <summary>
+/// Get the next code point from a wide character string.
+/// </summary>
+/// <param name="pWide">Wide characters.</param>
+/// <param name="remaining">Number of remaining wide characters (at least 1).</param>
+/// <param name="pCodePoint">Pointer to the variable that receives the code point.</param>
+/// <returns>Number of wide characters used for the code point.</returns>
+static size_t nextCodePoint(const wchar_t* const pWide, const size_t remaining, uint32_t* const pCodePoint) {
+   uint32_t codePoint = (uint32_t)pWide[0];
+   size_t used = 1;
+
+#if WCHAR_MAX <= 0xffff
+   // UTF-16: Combine surrogate pairs.
+   if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+      uint32_t low = (remaining > 1) ? (uint32_t)pWide[1] : 0;
+      if (low >= 0xdc00 && low <= 0xdfff) {
+         codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+         used = 2;
+      } else
+         codePoint = REPLACEMENT_CHARACTER;
+   } else if (codePoint >= 0xdc00 && codePoint <= 0xdfff)
+      codePoint = REPLACEMENT_CHARACTER;
+#else
+   (void)remaining;
+
+   if (codePoint > 0x10ffff || (codePoint >= 0xd800 && codePoint <= 0xdfff))
+      codePoint = REPLACEMENT_CHARACTER;
+#endif
+
+   *pCodePoint = codePoint;
+   return used;
+}
+
+/// <summary>
+/// Store a code point as UTF-8.
+/// </summary>
+/// <param name="codePoint">Code point.</param>
+/// <param name="pBuffer">Destination.</param>
+/// <param name="remaining">Remaining bytes in the destination.</param>
+/// <returns>Number of bytes stored. 0, if there is not enough room.</returns>
+static size_t storeUtf8(const uint32_t codePoint, char* const pBuffer, const size_t remaining) {
+   if (codePoint < 0x80) {
+      if (remaining < 1)
+         return 0;
+
+      pBuffer[0] = (char)codePoint;
+      return 1;
+   }
+
+   if (codePoint < 0x800) {
+      if (remaining < 2)
+         return 0;
+
+      pBuffer[0] = (char)(0xc0 | (codePoint >> 6));
+      pBuffer[1] = (char)(0x80 | (codePoint & 0x3f));
+      return 2;
+   }
+
+   if (codePoint < 0x10000) {
+      if (remaining < 3)
+         return 0;
+
+      pBuffer[0] = (char)(0xe0 | (codePoint >> 12));
+      pBuffer[1] = (char)(0x80 | ((codePoint >> 6) & 0x3f));
+      pBuffer[2] = (char)(0x80 | (codePoint & 0x3f));
+      return 3;
+   }
+
+   if (remaining < 4)
+      return 0;
+
+   pBuffer[0] = (char)(0xf0 | (codePoint >> 18));
+   pBuffer[1] = (char)(0x80 | ((codePoint >> 12) & 0x3f));
+   pBuffer[2] = (char)(0x80 | ((codePoint >> 6) & 0x3f));
+   pBuffer[3] = (char)(0x80 | (codePoint & 0x3f));
+   return 4;
+}
+
+#ifdef _WIN32
+/// <summary>
+/// Get the console code page and find out, whether it is compatible with ASCII.
+/// Both values never change, so a race between threads is harmless.
+/// </summary>
+/// <returns>Console code page.</returns>
+static UINT getConsoleCodePage(void) {
+   if (consoleCodePage != 0)
+      return consoleCodePage;
+
+   UINT codePage = GetConsoleOutputCP();
+   if (codePage == 0)
+      codePage = GetACP();  // There is no console.
+
+   // Some code pages (e.g. EBCDIC) do not store ASCII characters as themselves.
+   static const wchar_t asciiTest[] = L"\t\n\r !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+   char converted[sizeof(asciiTest) / sizeof(asciiTest[0])];
+   int length = WideCharToMultiByte(codePage, 0, asciiTest, -1, converted, (int)sizeof(converted), NULL, NULL);
+
+   BOOL compatible = (length == (int)sizeof(converted));
+   for (int i = 0; compatible != FALSE && i < length; i++)
+      compatible = ((wchar_t)(UCHAR)converted[i] == asciiTest[i]);
+
+   isAsciiCompatible = compatible;
+   consoleCodePage = codePage;
+
+   return codePage;
+}
+
+/// <summary>
+/// Convert wide characters with WideCharToMultiByte.
+/// If the destination is too small, the characters are converted one code point at a time, until it is full.
+/// </summary>
+/// <param name="codePage">Code page.</param>
+/// <param name="pWide">Wide characters.</param>
+/// <param name="wideLength">Number of wide characters.</param>
+/// <param name="pBuffer">Destination.</param>
+/// <param name="remaining">Remaining bytes in the destination.</param>
+/// <returns>Number of bytes stored.</returns>
+static size_t convertWithCodePage(const UINT codePage, const wchar_t* const pWide, const size_t wideLength, char* const pBuffer, const size_t remaining) {
+   int length = WideCharToMultiByte(codePage, 0, pWide, (int)wideLength, pBuffer, (int)remaining, NULL, NULL);
+   if (length > 0 || remaining == 0)
+      return (length > 0) ? (size_t)length : 0;
+
+   size_t stored = 0;
+   size_t position = 0;
+   while (position < wideLength) {
+      uint32_t codePoint;
+      size_t used = nextCodePoint(pWide + position, wideLength - position, &codePoint);
+
+      length = WideCharToMultiByte(codePage, 0, pWide + position, (int)used, pBuffer + stored, (int)(remaining - stored), NULL, NULL);
+      if (length <= 0)
+         break;
+
+      stored += (size_t)length;
+      position += used;
+   }
+
+   return stored;
+}
+#endif
+
+// ******** Public methods ********
+
+/// <summary>
+/// Convert a wide character string to UTF-8.
+/// ASCII characters are converted in bulk, only other characters are converted one by one.
+/// The function uses no static data, so it can be called from several threads at the same time.
+/// </summary>
+/// <param name="wideString">Wide character string (UTF-16 or UTF-32, depending on the size of wchar_t).</param>
+/// <param name="wideLength">Number of wide characters.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. The output is truncated at a character boundary, if the buffer is too small.</returns>
+size_t TranscodeToUtf8(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize) {
+   if (bufferSize == 0)
+      return 0;
+
+   const size_t limit = bufferSize - 1;  // Keep room for the terminating 0.
+   size_t position = 0;
+   size_t length = 0;
+   BOOL isFull = FALSE;
+
+   while (position < wideLength && isFull == FALSE) {
+      // 1. Narrow the ASCII characters in bulk.
+      size_t count = wideLength - position;
+      if (count > limit - length)
+         count = limit - length;
+
+      size_t narrowed = narrowAscii(wideString + position, count, buffer + length);
+      position += narrowed;
+      length += narrowed;
+
+      if (position >= wideLength || length >= limit)
+         break;
+
+      // 2. Convert the following non-ASCII characters one by one.
+      do {
+         uint32_t codePoint;
+         size_t used = nextCodePoint(wideString + position, wideLength - position, &codePoint);
+         size_t stored = storeUtf8(codePoint, buffer + length, limit - length);
+
+         isFull = (stored == 0);
+         position += used;
+         length += stored;
+      } while (isFull == FALSE && position < wideLength && (uint32_t)wideString[position] >= 0x80);
+   }
+
+   buffer[length] = 0;
+
+   return length;
+}
+
+/// <summary>
+/// Convert a wide character string to the console code page. On platforms other than Windows this is UTF-8.
+/// ASCII characters are converted in bulk, if the code page is compatible with ASCII.
+/// </summary>
+/// <param name="wideString">Wide character string.</param>
+/// <param name="wideLength">Number of wide characters.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. The output is truncated at a character boundary, if the buffer is too small.</returns>
+size_t TranscodeToConsole(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize) {
+#ifdef _WIN32
+   UINT codePage = getConsoleCodePage();
+   if (codePage == CP_UTF8)
+      return TranscodeToUtf8(wideString, wideLength, buffer, bufferSize);
+
+   if (bufferSize == 0)
+      return 0;
+
+   const size_t limit = bufferSize - 1;  // Keep room for the terminating 0.
+   size_t length = 0;
+   size_t position = 0;
+
+   // 1. Narrow the ASCII characters at the start in bulk.
+   if (isAsciiCompatible > 0) {
+      length = narrowAscii(wideString, (wideLength < limit) ? wideLength : limit, buffer);
+      position = length;
+   }
+
+   // 2. Convert the rest with the code page, if there is a rest.
+   if (position < wideLength && length < limit)
+      length += convertWithCodePage(codePage, wideString + position, wideLength - position, buffer + length, limit - length);
+
+   buffer[length] = 0;
+
+   return length;
+#else
+   return TranscodeToUtf8(wideString, wideLength, buffer, bufferSize);
+#endif
+}
+
+/// <summary>
+/// Get the code page that TranscodeToConsole converts to.
+/// </summary>
+/// <returns>Code page number. On platforms other than Windows this is always the UTF-8 code page 65001.</returns>
+ULONG GetConsoleCodePage(void) {
+#ifdef _WIN32
+   return (ULONG)getConsoleCodePage();
+#else
+   return UTF8_CODE_PAGE;
+#endif
+}
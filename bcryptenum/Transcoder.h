@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stddef.h>
+#include <wchar.h>
+
+#include "Platform.h"
+
+/// <summary>
+/// Convert a wide character string to UTF-8.
+/// ASCII characters are converted in bulk, only other characters are converted one by one.
+/// The function uses no static data, so it can be called from several threads at the same time.
+/// </summary>
+/// <param name="wideString">Wide character string (UTF-16 or UTF-32, depending on the size of wchar_t).</param>
+/// <param name="wideLength">Number of wide characters.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. The output is truncated at a character boundary, if the buffer is too small.</returns>
+size_t TranscodeToUtf8(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize);
+
+/// <summary>
+/// Convert a wide character string to the console code page. On platforms other than Windows this is UTF-8.
+/// ASCII characters are converted in bulk, if the code page is compatible with ASCII.
+/// </summary>
+/// <param name="wideString">Wide character string.</param>
+/// <param name="wideLength">Number of wide characters.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. The output is truncated at a character boundary, if the buffer is too small.</returns>
+size_t TranscodeToConsole(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize);
+
+/// <summary>
+/// Get the code page that TranscodeToConsole converts to.
+/// </summary>
+/// <returns>Code page number. On platforms other than Windows this is always the UTF-8 code page 65001.</returns>
+ULONG GetConsoleCodePage(void);
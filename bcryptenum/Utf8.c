@@ -0,0 +1,149 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Encode with the transcoder.
+//
+
+#include <stdint.h>
+#include <wchar.h>
+
+#include "Transcoder.h"
+
+// ******** Private constants ********
+
+/// Replacement character for invalid input.
+#define REPLACEMENT_CHARACTER 0xfffd
+
+// ******** Private methods ********
+
+/// <summary>
+/// Store a code point as wide characters.
+/// </summary>
+/// <param name="codePoint">Code point.</param>
+/// <param name="pBuffer">Destination.</param>
+/// <param name="remaining">Remaining wide characters in the destination.</param>
+/// <returns>Number of wide characters stored. 0, if there is not enough room.</returns>
+static size_t storeCodePoint(const uint32_t codePoint, wchar_t* const pBuffer, const size_t remaining) {
+#if WCHAR_MAX <= 0xffff
+   if (codePoint >= 0x10000) {
+      if (remaining < 2)
+         return 0;
+
+      uint32_t value = codePoint - 0x10000;
+      pBuffer[0] = (wchar_t)(0xd800 + (value >> 10));
+      pBuffer[1] = (wchar_t)(0xdc00 + (value & 0x3ff));
+      return 2;
+   }
+#endif
+
+   if (remaining < 1)
+      return 0;
+
+   *pBuffer = (wchar_t)codePoint;
+   return 1;
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Encode a 0 terminated wide character string as UTF-8.
+/// </summary>
+/// <param name="wideString">Wide character string (UTF-16 or UTF-32, depending on the size of wchar_t).</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. The output is truncated at a character boundary, if the buffer is too small.</returns>
+size_t EncodeUtf8(const wchar_t* const wideString, char* const buffer, const size_t bufferSize) {
+   return TranscodeToUtf8(wideString, wcslen(wideString), buffer, bufferSize);
+}
+
+/// <summary>
+/// Decode UTF-8 into a 0 terminated wide character string.
+/// </summary>
+/// <param name="utf8">UTF-8 bytes.</param>
+/// <param name="utf8Length">Number of UTF-8 bytes.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferCount">Size of the destination buffer in wide characters.</param>
+/// <returns>Number of wide characters written without the terminating 0. Invalid sequences are replaced by U+FFFD.</returns>
+size_t DecodeUtf8(const char* const utf8, const size_t utf8Length, wchar_t* const buffer, const size_t bufferCount) {
+   if (bufferCount == 0)
+      return 0;
+
+   const uint8_t* pByte = (const uint8_t*)utf8;
+   const uint8_t* const pEnd = pByte + utf8Length;
+   size_t length = 0;
+   const size_t limit = bufferCount - 1;  // Keep room for the terminating 0.
+
+   while (pByte < pEnd) {
+      uint32_t codePoint = *pByte++;
+      uint32_t continuationCount;
+      uint32_t minimum;
+
+      if (codePoint < 0x80) {
+         continuationCount = 0;
+         minimum = 0;
+      } else if ((codePoint & 0xe0) == 0xc0) {
+         codePoint &= 0x1f;
+         continuationCount = 1;
+         minimum = 0x80;
+      } else if ((codePoint & 0xf0) == 0xe0) {
+         codePoint &= 0x0f;
+         continuationCount = 2;
+         minimum = 0x800;
+      } else if ((codePoint & 0xf8) == 0xf0) {
+         codePoint &= 0x07;
+         continuationCount = 3;
+         minimum = 0x10000;
+      } else {
+         codePoint = REPLACEMENT_CHARACTER;
+         continuationCount = 0;
+         minimum = 0;
+      }
+
+      for (; continuationCount > 0; continuationCount--) {
+         if (pByte >= pEnd || (*pByte & 0xc0) != 0x80) {
+            codePoint = REPLACEMENT_CHARACTER;
+            minimum = 0;
+            break;
+         }
+
+         codePoint = (codePoint << 6) | (*pByte++ & 0x3f);
+      }
+
+      // Reject overlong encodings, surrogates and values beyond the Unicode range.
+      if (codePoint < minimum || codePoint > 0x10ffff || (codePoint >= 0xd800 && codePoint <= 0xdfff))
+         codePoint = REPLACEMENT_CHARACTER;
+
+      size_t stored = storeCodePoint(codePoint, buffer + length, limit - length);
+      if (stored == 0)
+         break;
+
+      length += stored;
+   }
+
+   buffer[length] = 0;
+
+   return length;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stddef.h>
+#include <wchar.h>
+
+/// <summary>
+/// Encode a 0 terminated wide character string as UTF-8.
+/// </summary>
+/// <param name="wideString">Wide character string (UTF-16 or UTF-32, depending on the size of wchar_t).</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. The output is truncated at a character boundary, if the buffer is too small.</returns>
+size_t EncodeUtf8(const wchar_t* const wideString, char* const buffer, const size_t bufferSize);
+
+/// <summary>
+/// Decode UTF-8 into a 0 terminated wide character string.
+/// </summary>
+/// <param name="utf8">UTF-8 bytes.</param>
+/// <param name="utf8Length">Number of UTF-8 bytes.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferCount">Size of the destination buffer in wide characters.</param>
+/// <returns>Number of wide characters written without the terminating 0. Invalid sequences are replaced by U+FFFD.</returns>
+size_t DecodeUtf8(const char* const utf8, const size_t utf8Length, wchar_t* const buffer, const size_t bufferCount);
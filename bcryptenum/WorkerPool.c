@@ -0,0 +1,249 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Pin threads to processors.
+//
+
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE  // Needed for the affinity functions.
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ApiErrorHandler.h"
+#include "WorkerPool.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+// ******** Private constants ********
+
+/// Maximum number of worker threads.
+#define MAX_WORKER_THREADS 64
+
+// ******** Private types ********
+
+/// <summary>
+/// Data shared by all workers.
+/// </summary>
+typedef struct _WORK_QUEUE {
+   volatile LONG nextIndex;
+   ULONG itemCount;
+   WORK_ITEM_FUNCTION workFunction;
+   PVOID context;
+} WORK_QUEUE;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the index of the next work item.
+/// </summary>
+/// <param name="pQueue">Work queue.</param>
+/// <returns>Index of the next work item. It is greater or equal to the item count, if all items have been taken.</returns>
+static inline ULONG takeNextIndex(WORK_QUEUE* const pQueue) {
+#ifdef _WIN32
+   return (ULONG)(InterlockedIncrement(&pQueue->nextIndex) - 1);
+#else
+   return (ULONG)__atomic_fetch_add(&pQueue->nextIndex, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+/// <summary>
+/// Process work items until there are no more left.
+/// </summary>
+/// <param name="pQueue">Work queue.</param>
+static void processItems(WORK_QUEUE* const pQueue) {
+   ULONG index;
+   while ((index = takeNextIndex(pQueue)) < pQueue->itemCount)
+      pQueue->workFunction(pQueue->context, index);
+}
+
+#ifdef _WIN32
+/// <summary>
+/// Thread procedure of a worker.
+/// </summary>
+/// <param name="parameter">Work queue.</param>
+/// <returns>Always 0.</returns>
+static DWORD WINAPI workerThread(LPVOID parameter) {
+   processItems(parameter);
+   return 0;
+}
+#else
+/// <summary>
+/// Thread procedure of a worker.
+/// </summary>
+/// <param name="parameter">Work queue.</param>
+/// <returns>Always NULL.</returns>
+static void* workerThread(void* parameter) {
+   processItems(parameter);
+   return NULL;
+}
+#endif
+
+// ******** Public methods ********
+
+/// <summary>
+/// Get the number of processors available to this process.
+/// </summary>
+/// <returns>Number of processors (at least 1).</returns>
+ULONG GetProcessorCount(void) {
+#ifdef _WIN32
+   ULONG count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+   long onlineCount = sysconf(_SC_NPROCESSORS_ONLN);
+   ULONG count = (onlineCount > 0) ? (ULONG)onlineCount : 1;
+#endif
+
+   return (count > 0) ? count : 1;
+}
+
+/// <summary>
+/// Pin the calling thread to one processor.
+/// The index counts the processors available to this process. It wraps around, if it is larger than their number.
+/// </summary>
+/// <param name="processorIndex">Index of the processor.</param>
+/// <returns>TRUE, if the thread was pinned, FALSE if not.</returns>
+BOOL PinCurrentThread(const ULONG processorIndex) {
+#ifdef _WIN32
+   // Processors are organized in groups of at most 64 processors.
+   ULONG index = processorIndex % GetProcessorCount();
+   WORD groupCount = GetActiveProcessorGroupCount();
+   for (WORD group = 0; group < groupCount; group++) {
+      DWORD groupSize = GetActiveProcessorCount(group);
+      if (index < groupSize) {
+         GROUP_AFFINITY affinity;
+         memset(&affinity, 0, sizeof(affinity));
+         affinity.Group = group;
+         affinity.Mask = (KAFFINITY)1 << index;
+
+         return SetThreadGroupAffinity(GetCurrentThread(), &affinity, NULL);
+      }
+
+      index -= groupSize;
+   }
+
+   return FALSE;
+#else
+   // The process may be restricted to a subset of the processors, e.g. in a container.
+   cpu_set_t allowedSet;
+   if (sched_getaffinity(0, sizeof(allowedSet), &allowedSet) != 0)
+      return FALSE;
+
+   int allowedCount = CPU_COUNT(&allowedSet);
+   if (allowedCount == 0)
+      return FALSE;
+
+   ULONG index = processorIndex % (ULONG)allowedCount;
+   for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &allowedSet)) {
+         if (index == 0) {
+            cpu_set_t pinnedSet;
+            CPU_ZERO(&pinnedSet);
+            CPU_SET(cpu, &pinnedSet);
+
+            return pthread_setaffinity_np(pthread_self(), sizeof(pinnedSet), &pinnedSet) == 0;
+         }
+
+         index--;
+      }
+   }
+
+   return FALSE;
+#endif
+}
+
+/// <summary>
+/// Process work items on a bounded number of worker threads.
+/// Each item index from 0 to itemCount - 1 is processed exactly once.
+/// The function returns when all items have been processed.
+/// If a worker thread can not be started, the remaining threads process its items.
+/// </summary>
+/// <param name="itemCount">Number of work items.</param>
+/// <param name="maxThreads">Maximum number of worker threads. 0 means the number of processors.</param>
+/// <param name="workFunction">Function that processes one work item.</param>
+/// <param name="context">Context that is passed to the work function.</param>
+void RunWorkItems(const ULONG itemCount, const ULONG maxThreads, const WORK_ITEM_FUNCTION workFunction, PVOID const context) {
+   const PCHAR functionName = "RunWorkItems";
+
+   WORK_QUEUE queue;
+   queue.nextIndex = 0;
+   queue.itemCount = itemCount;
+   queue.workFunction = workFunction;
+   queue.context = context;
+
+   // 1. Determine the number of threads. The calling thread is one of the workers.
+   ULONG threadCount = (maxThreads == 0) ? GetProcessorCount() : maxThreads;
+   if (threadCount > itemCount)
+      threadCount = itemCount;
+
+   if (threadCount > MAX_WORKER_THREADS)
+      threadCount = MAX_WORKER_THREADS;
+
+   if (threadCount <= 1) {
+      processItems(&queue);
+      return;
+   }
+
+   // 2. Start the additional threads.
+   ULONG startedCount = 0;
+#ifdef _WIN32
+   HANDLE hThreads[MAX_WORKER_THREADS];
+   for (; startedCount < threadCount - 1; startedCount++) {
+      hThreads[startedCount] = CreateThread(NULL, 0, workerThread, &queue, 0, NULL);
+      if (hThreads[startedCount] == NULL) {
+         PrintLastError(functionName, "CreateThread");
+         break;
+      }
+   }
+#else
+   pthread_t threads[MAX_WORKER_THREADS];
+   for (; startedCount < threadCount - 1; startedCount++) {
+      int rc = pthread_create(&threads[startedCount], NULL, workerThread, &queue);
+      if (rc != 0) {
+         PrintWinError(functionName, "pthread_create", (DWORD)rc);
+         break;
+      }
+   }
+#endif
+
+   // 3. Work on the items in this thread, too.
+   processItems(&queue);
+
+   // 4. Wait for the other threads.
+#ifdef _WIN32
+   for (ULONG i = 0; i < startedCount; i++) {
+      WaitForSingleObject(hThreads[i], INFINITE);
+      CloseHandle(hThreads[i]);
+   }
+#else
+   for (ULONG i = 0; i < startedCount; i++)
+      pthread_join(threads[i], NULL);
+#endif
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Platform.h"
+
+/// <summary>
+/// Function that processes one work item.
+/// </summary>
+/// <param name="context">Context supplied to RunWorkItems.</param>
+/// <param name="index">Index of the work item.</param>
+typedef void (*WORK_ITEM_FUNCTION)(PVOID const context, const ULONG index);
+
+/// <summary>
+/// Get the number of processors available to this process.
+/// </summary>
+/// <returns>Number of processors (at least 1).</returns>
+ULONG GetProcessorCount(void);
+
+/// <summary>
+/// Pin the calling thread to one processor.
+/// The index counts the processors available to this process. It wraps around, if it is larger than their number.
+/// </summary>
+/// <param name="processorIndex">Index of the processor.</param>
+/// <returns>TRUE, if the thread was pinned, FALSE if not.</returns>
+BOOL PinCurrentThread(const ULONG processorIndex);
+
+/// <summary>
+/// Process work items on a bounded number of worker threads.
+/// Each item index from 0 to itemCount - 1 is processed exactly once.
+/// The function returns when all items have been processed.
+/// If a worker thread can not be started, the remaining threads process its items.
+/// </summary>
+/// <param name="itemCount">Number of work items.</param>
+/// <param name="maxThreads">Maximum number of worker threads. 0 means the number of processors.</param>
+/// <param name="workFunction">Function that processes one work item.</param>
+/// <param name="context">Context that is passed to the work function.</param>
+void RunWorkItems(const ULONG itemCount, const ULONG maxThreads, const WORK_ITEM_FUNCTION workFunction, PVOID const context);
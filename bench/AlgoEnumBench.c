@@ -0,0 +1,431 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Benchmark of the algoenum library on a synthetic algorithm catalog.
+//
+// Usage: AlgoEnumBench [--count <n>] [--threads <n>]
+//
+// The process wide catalog is set to a mock backend that enumerates the synthetic catalog.
+// All threads use the catalog for the first time at once, so the first use is built once and the others wait.
+// Then the time per query is printed for known and unknown names, for IsAlgorithmSupported on one and
+// on all threads, and for the name search of the catalog, which the listing used before.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "AlgoEnum.h"
+#include "AlgorithmBackend.h"
+#include "AlgorithmCatalog.h"
+#include "SyntheticCatalog.h"
+#include "Timer.h"
+#include "WorkerPool.h"
+
+// ******** Private constants ********
+
+/// Default number of algorithms. This is about twice the size of a real catalog.
+#define DEFAULT_ALGORITHM_COUNT 256UL
+
+/// Seed of the synthetic catalog.
+#define CATALOG_SEED 0x2545f491UL
+
+/// Number of queries per measurement and thread.
+#define QUERY_COUNT 2000000UL
+
+/// Number of queries per measurement of the name search of the catalog, which is much slower.
+#define SEARCH_COUNT 20000UL
+
+/// Number of repetitions of each measurement. The fastest one is printed.
+#define REPETITIONS 5
+
+/// Suffix that makes a known name unknown.
+#define MISS_SUFFIX L"#"
+
+// ******** Private types ********
+
+/// <summary>
+/// Data of the benchmark.
+/// </summary>
+typedef struct _BENCH_CONTEXT {
+   /// Synthetic catalog in enumeration order.
+   SYNTHETIC_CATALOG synthetic;
+
+   /// Mock backend that enumerates the synthetic catalog.
+   ALGORITHM_BACKEND backend;
+
+   /// Names that are not in the catalog.
+   wchar_t** ppMissNames;
+
+   /// Number of threads.
+   ULONG threadCount;
+
+   /// Time of each thread in nanoseconds.
+   uint64_t* pThreadNs;
+
+   /// Number of supported queries of each thread.
+   size_t* pThreadFound;
+
+   /// Catalog each thread got on its first use.
+   const ALGOENUM** ppThreadEnums;
+
+   /// Sum of the results, so that the compiler can not remove the work.
+   volatile size_t sink;
+} BENCH_CONTEXT;
+
+/// <summary>
+/// Function that runs a number of queries.
+/// </summary>
+typedef size_t (*QUERY_FUNCTION)(const BENCH_CONTEXT* const pContext, const ULONG queryCount);
+
+// ******** Private methods ********
+
+/// <summary>
+/// Return the synthetic algorithms. Only the combined mask and the signature operation are requested by the catalog.
+/// </summary>
+static NTSTATUS syntheticEnumAlgorithms(PVOID const context,
+                                        const ULONG operationMask,
+                                        ULONG* const pAlgoCount,
+                                        BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList) {
+   const SYNTHETIC_CATALOG* pSynthetic = context;
+
+   if (operationMask == BCRYPT_SIGNATURE_OPERATION) {
+      *pAlgoCount = pSynthetic->signingCount;
+      *ppAlgoList = pSynthetic->pSigningAlgorithms;
+   } else {
+      *pAlgoCount = pSynthetic->count;
+      *ppAlgoList = pSynthetic->pAlgorithms;
+   }
+
+   return 0;
+}
+
+/// <summary>
+/// The lists belong to the synthetic catalog, so there is nothing to release.
+/// </summary>
+static void syntheticFreeBuffer(PVOID const context, PVOID const pBuffer) {
+   (void)context;
+   (void)pBuffer;
+}
+
+/// <summary>
+/// Query known names with IsAlgorithmSupported.
+/// </summary>
+static size_t queryHits(const BENCH_CONTEXT* const pContext, const ULONG queryCount) {
+   size_t found = 0;
+   ULONG a = 0;
+
+   for (ULONG i = 0; i < queryCount; i++) {
+      found += IsAlgorithmSupported(pContext->synthetic.pAlgorithms[a].pszName, OperationTypes[i % OPERATION_TYPE_COUNT]);
+      if (++a == pContext->synthetic.count)
+         a = 0;
+   }
+
+   return found;
+}
+
+/// <summary>
+/// Query unknown names with IsAlgorithmSupported.
+/// </summary>
+static size_t queryMisses(const BENCH_CONTEXT* const pContext, const ULONG queryCount) {
+   size_t found = 0;
+   ULONG a = 0;
+
+   for (ULONG i = 0; i < queryCount; i++) {
+      found += IsAlgorithmSupported(pContext->ppMissNames[a], OperationTypes[i % OPERATION_TYPE_COUNT]);
+      if (++a == pContext->synthetic.count)
+         a = 0;
+   }
+
+   return found;
+}
+
+/// <summary>
+/// Look up known names with the name search of the catalog.
+/// </summary>
+static size_t searchHits(const BENCH_CONTEXT* const pContext, const ULONG queryCount) {
+   const ALGORITHM_CATALOG* pCatalog = &GetAlgoEnum()->catalog;
+   size_t found = 0;
+   ULONG a = 0;
+
+   for (ULONG i = 0; i < queryCount; i++) {
+      const long index = FindCatalogAlgorithm(pCatalog, pContext->synthetic.pAlgorithms[a].pszName);
+      if (index >= 0 && (pCatalog->pOperations[index] & OperationTypes[i % OPERATION_TYPE_COUNT]) != 0)
+         found++;
+
+      if (++a == pContext->synthetic.count)
+         a = 0;
+   }
+
+   return found;
+}
+
+/// <summary>
+/// Measure a query function on the calling thread.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <param name="Query">Query function.</param>
+/// <param name="queryCount">Number of queries per run.</param>
+/// <returns>Fastest time per query in nanoseconds.</returns>
+static double measureQueries(BENCH_CONTEXT* const pContext, const QUERY_FUNCTION Query, const ULONG queryCount) {
+   uint64_t fastestNs = UINT64_MAX;
+
+   for (int r = 0; r < REPETITIONS; r++) {
+      const uint64_t startTime = GetTimeNs();
+      pContext->sink += Query(pContext, queryCount);
+      const uint64_t duration = GetTimeNs() - startTime;
+
+      if (duration < fastestNs)
+         fastestNs = duration;
+   }
+
+   return (double)fastestNs / queryCount;
+}
+
+/// <summary>
+/// Use the process wide catalog for the first time on a worker thread.
+/// </summary>
+/// <param name="context">Benchmark data.</param>
+/// <param name="index">Index of the thread.</param>
+static void firstUseWorkItem(PVOID const context, const ULONG index) {
+   BENCH_CONTEXT* pContext = context;
+
+   const uint64_t startTime = GetTimeNs();
+   pContext->ppThreadEnums[index] = GetAlgoEnum();
+   pContext->pThreadNs[index] = GetTimeNs() - startTime;
+}
+
+/// <summary>
+/// Query known names on a worker thread.
+/// </summary>
+/// <param name="context">Benchmark data.</param>
+/// <param name="index">Index of the thread.</param>
+static void queryWorkItem(PVOID const context, const ULONG index) {
+   BENCH_CONTEXT* pContext = context;
+
+   const uint64_t startTime = GetTimeNs();
+   pContext->pThreadFound[index] = queryHits(pContext, QUERY_COUNT);
+   pContext->pThreadNs[index] = GetTimeNs() - startTime;
+}
+
+/// <summary>
+/// Check that the name index finds the same algorithms as the name search of the catalog.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <param name="pEnum">Catalog.</param>
+/// <returns>TRUE, if all queries have the same result, FALSE if not.</returns>
+static BOOL checkQueries(const BENCH_CONTEXT* const pContext, const ALGOENUM* const pEnum) {
+   if (pEnum->catalog.count != pContext->synthetic.count)
+      return FALSE;
+
+   for (ULONG i = 0; i < pContext->synthetic.count; i++) {
+      const long index = FindCatalogAlgorithm(&pEnum->catalog, pContext->synthetic.pAlgorithms[i].pszName);
+      if (index < 0 || GetAlgoEnumOperations(pEnum, pContext->synthetic.pAlgorithms[i].pszName) != pEnum->catalog.pOperations[index])
+         return FALSE;
+
+      if (GetAlgoEnumOperations(pEnum, pContext->ppMissNames[i]) != 0)
+         return FALSE;
+   }
+
+   ALGOENUM_ITERATOR iterator;
+   BeginAlgoEnumIteration(pEnum, ALL_OPERATIONS_MASK, &iterator);
+
+   ULONG iteratedCount = 0;
+   while (NextAlgoEnumAlgorithm(&iterator) != NULL)
+      iteratedCount++;
+
+   return (iteratedCount == pEnum->catalog.count);
+}
+
+/// <summary>
+/// Release the benchmark data.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+static void freeContext(BENCH_CONTEXT* const pContext) {
+   if (pContext->ppMissNames != NULL)
+      for (ULONG i = 0; i < pContext->synthetic.count; i++)
+         free(pContext->ppMissNames[i]);
+
+   free(pContext->ppMissNames);
+   free(pContext->pThreadNs);
+   free(pContext->pThreadFound);
+   free(pContext->ppThreadEnums);
+
+   FreeSyntheticCatalog(&pContext->synthetic);
+}
+
+/// <summary>
+/// Create the synthetic catalog, its mock backend and the unknown names.
+/// </summary>
+/// <param name="pContext">Benchmark data. The thread count must be set.</param>
+/// <param name="count">Number of algorithms.</param>
+/// <returns>TRUE, if the data could be created, FALSE if not.</returns>
+static BOOL createContext(BENCH_CONTEXT* const pContext, const ULONG count) {
+   if (CreateSyntheticCatalog(&pContext->synthetic, count, CATALOG_SEED) == FALSE)
+      return FALSE;
+
+   memset(&pContext->backend, 0, sizeof(pContext->backend));
+   pContext->backend.name = "synthetic";
+   pContext->backend.context = &pContext->synthetic;
+   pContext->backend.EnumAlgorithms = syntheticEnumAlgorithms;
+   pContext->backend.FreeBuffer = syntheticFreeBuffer;
+
+   pContext->pThreadNs = calloc(pContext->threadCount, sizeof(uint64_t));
+   pContext->pThreadFound = calloc(pContext->threadCount, sizeof(size_t));
+   pContext->ppThreadEnums = calloc(pContext->threadCount, sizeof(ALGOENUM*));
+   pContext->ppMissNames = calloc(count, sizeof(wchar_t*));
+   if (pContext->pThreadNs == NULL || pContext->pThreadFound == NULL || pContext->ppThreadEnums == NULL || pContext->ppMissNames == NULL)
+      return FALSE;
+
+   for (ULONG i = 0; i < count; i++) {
+      const size_t nameLength = wcslen(pContext->synthetic.pAlgorithms[i].pszName);
+
+      pContext->ppMissNames[i] = malloc((nameLength + wcslen(MISS_SUFFIX) + 1) * sizeof(wchar_t));
+      if (pContext->ppMissNames[i] == NULL)
+         return FALSE;
+
+      wcscpy(pContext->ppMissNames[i], pContext->synthetic.pAlgorithms[i].pszName);
+      wcscat(pContext->ppMissNames[i], MISS_SUFFIX);
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Run the benchmark and print the results.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <returns>TRUE, if the library gave the expected results, FALSE if not.</returns>
+static BOOL runBenchmark(BENCH_CONTEXT* const pContext) {
+   // 1. All threads use the catalog for the first time at once. The first one builds it.
+   if (SetAlgoEnumBackend(&pContext->backend) == FALSE) {
+      fputs("The backend of the catalog could not be set.\n", stderr);
+      return FALSE;
+   }
+
+   RunWorkItems(pContext->threadCount, pContext->threadCount, firstUseWorkItem, pContext);
+
+   const ALGOENUM* pEnum = GetAlgoEnum();
+   uint64_t firstUseNs = 0;
+   for (ULONG t = 0; t < pContext->threadCount; t++) {
+      if (pContext->ppThreadEnums[t] != pEnum || pEnum == NULL) {
+         fputs("The threads got different catalogs.\n", stderr);
+         return FALSE;
+      }
+
+      if (pContext->pThreadNs[t] > firstUseNs)
+         firstUseNs = pContext->pThreadNs[t];
+   }
+
+   if (SetAlgoEnumBackend(&pContext->backend) != FALSE) {
+      fputs("The backend could be set after the first use.\n", stderr);
+      return FALSE;
+   }
+
+   if (checkQueries(pContext, pEnum) == FALSE) {
+      fputs("The name index and the name search of the catalog give different results.\n", stderr);
+      return FALSE;
+   }
+
+   fprintf(stdout, "Algorithms:                       %10lu\n", (unsigned long)pEnum->catalog.count);
+   fprintf(stdout, "First use on %3lu threads:         %10.1f us\n", (unsigned long)pContext->threadCount, (double)firstUseNs / 1000.0);
+
+   // 2. Queries on one thread.
+   fprintf(stdout, "IsAlgorithmSupported, known:      %10.1f ns/query\n", measureQueries(pContext, queryHits, QUERY_COUNT));
+   fprintf(stdout, "IsAlgorithmSupported, unknown:    %10.1f ns/query\n", measureQueries(pContext, queryMisses, QUERY_COUNT));
+   fprintf(stdout, "FindCatalogAlgorithm, known:      %10.1f ns/query\n", measureQueries(pContext, searchHits, SEARCH_COUNT));
+
+   // 3. Queries on all threads at once. The catalog is only read, so the time per query should not grow.
+   uint64_t slowestNs = 0;
+   for (int r = 0; r < REPETITIONS; r++) {
+      RunWorkItems(pContext->threadCount, pContext->threadCount, queryWorkItem, pContext);
+
+      uint64_t runNs = 0;
+      for (ULONG t = 0; t < pContext->threadCount; t++) {
+         pContext->sink += pContext->pThreadFound[t];
+         if (pContext->pThreadNs[t] > runNs)
+            runNs = pContext->pThreadNs[t];
+      }
+
+      if (r == 0 || runNs < slowestNs)
+         slowestNs = runNs;
+   }
+
+   fprintf(stdout,
+           "IsAlgorithmSupported, %3lu threads: %9.1f ns/query, %.1f Mqueries/s\n",
+           (unsigned long)pContext->threadCount,
+           (double)slowestNs / QUERY_COUNT,
+           (double)QUERY_COUNT * pContext->threadCount * 1000.0 / (double)slowestNs);
+
+   return TRUE;
+}
+
+// ******** Main method ********
+
+int main(int argc, char* argv[]) {
+   ULONG count = DEFAULT_ALGORITHM_COUNT;
+   ULONG threadCount = GetProcessorCount();
+
+   for (int i = 1; i < argc; i++) {
+      if (i + 1 < argc && strcmp(argv[i], "--count") == 0)
+         count = strtoul(argv[++i], NULL, 10);
+      else if (i + 1 < argc && strcmp(argv[i], "--threads") == 0)
+         threadCount = strtoul(argv[++i], NULL, 10);
+      else {
+         fputs("Usage: AlgoEnumBench [--count <n>] [--threads <n>]\n", stderr);
+         return 2;
+      }
+   }
+
+   if (count == 0 || threadCount == 0) {
+      fputs("The count and the number of threads must be greater than 0.\n", stderr);
+      return 2;
+   }
+
+   BENCH_CONTEXT* pContext = calloc(1, sizeof(BENCH_CONTEXT));
+   if (pContext == NULL) {
+      fputs("Not enough memory.\n", stderr);
+      return 2;
+   }
+
+   pContext->threadCount = threadCount;
+
+   int rc = 0;
+   if (createContext(pContext, count) == FALSE) {
+      fputs("Not enough memory.\n", stderr);
+      rc = 2;
+   } else if (runBenchmark(pContext) == FALSE)
+      rc = 1;
+
+   freeContext(pContext);
+   free(pContext);
+
+   return rc;
+}
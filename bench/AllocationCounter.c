@@ -0,0 +1,112 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Counter of the heap allocations of the benchmarks.
+//
+// If BENCH_WRAP_ALLOCATIONS is defined, the program has to be linked with
+// "-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc", so that all calls of these functions,
+// including the ones in the HeapAlloc functions of Platform.h, go through the counter.
+//
+
+#include <string.h>
+
+#include "AllocationCounter.h"
+
+// ******** Private variables ********
+
+/// Number of allocations.
+static volatile uint64_t allocationCount;
+
+/// Number of requested bytes.
+static volatile uint64_t byteCount;
+
+// ******** Private methods ********
+
+#ifdef BENCH_WRAP_ALLOCATIONS
+/// <summary>
+/// Count an allocation. The linker option only exists with the GNU tool chain, so the atomics are the GNU ones.
+/// </summary>
+/// <param name="size">Number of requested bytes.</param>
+static inline void countAllocation(const size_t size) {
+   __atomic_fetch_add(&allocationCount, 1, __ATOMIC_RELAXED);
+   __atomic_fetch_add(&byteCount, size, __ATOMIC_RELAXED);
+}
+
+// ******** Wrapped allocation functions ********
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pMemory, size_t size);
+
+void* __wrap_malloc(size_t size) {
+   countAllocation(size);
+
+   return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+   countAllocation(count * size);
+
+   return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pMemory, size_t size) {
+   countAllocation(size);
+
+   return __real_realloc(pMemory, size);
+}
+#endif
+
+// ******** Public methods ********
+
+/// <summary>
+/// Check, if the allocations are counted.
+/// They are only counted, if the linker can redirect the allocation functions to the counter.
+/// </summary>
+/// <returns>TRUE, if the allocations are counted, FALSE if not.</returns>
+BOOL IsAllocationCounting(void) {
+#ifdef BENCH_WRAP_ALLOCATIONS
+   return TRUE;
+#else
+   return FALSE;
+#endif
+}
+
+/// <summary>
+/// Get the numbers of allocations since the start of the program.
+/// </summary>
+/// <param name="pCounts">Pointer to the counts to fill.</param>
+void GetAllocationCounts(ALLOCATION_COUNTS* const pCounts) {
+#ifdef BENCH_WRAP_ALLOCATIONS
+   pCounts->allocationCount = __atomic_load_n(&allocationCount, __ATOMIC_RELAXED);
+   pCounts->byteCount = __atomic_load_n(&byteCount, __ATOMIC_RELAXED);
+#else
+   memset(pCounts, 0, sizeof(ALLOCATION_COUNTS));
+#endif
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Platform.h"
+
+/// <summary>
+/// Numbers of heap allocations.
+/// </summary>
+typedef struct _ALLOCATION_COUNTS {
+   /// Number of calls to malloc, calloc and realloc.
+   uint64_t allocationCount;
+
+   /// Number of requested bytes.
+   uint64_t byteCount;
+} ALLOCATION_COUNTS;
+
+/// <summary>
+/// Check, if the allocations are counted.
+/// They are only counted, if the linker can redirect the allocation functions to the counter.
+/// </summary>
+/// <returns>TRUE, if the allocations are counted, FALSE if not.</returns>
+BOOL IsAllocationCounting(void);
+
+/// <summary>
+/// Get the numbers of allocations since the start of the program.
+/// </summary>
+/// <param name="pCounts">Pointer to the counts to fill.</param>
+void GetAllocationCounts(ALLOCATION_COUNTS* const pCounts);
@@ -0,0 +1,507 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Benchmark of the portable core on synthetic algorithm catalogs.
+//
+// Usage: bcryptenum_bench [--max-count <n>]
+//
+// The catalogs have 10^2 to 10^6 algorithms (or up to the maximum count).
+// For each size the time per algorithm and the heap allocations of one run are printed for
+// building the catalog, sorting, looking up names, transcoding names, formatting numbers and emitting the lists.
+// The allocations are only counted, if the program was linked with the allocation wrappers (see CMakeLists.txt).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "AlgorithmBackend.h"
+#include "AlgorithmCatalog.h"
+#include "AllocationCounter.h"
+#include "Arena.h"
+#include "ListEmitter.h"
+#include "NameSort.h"
+#include "NumberFormatter.h"
+#include "SyntheticCatalog.h"
+#include "Timer.h"
+#include "Transcoder.h"
+
+// ******** Private constants ********
+
+/// Smallest catalog.
+#define MIN_ALGORITHM_COUNT 100UL
+
+/// Default largest catalog.
+#define MAX_ALGORITHM_COUNT 1000000UL
+
+/// Seed of the synthetic catalogs.
+#define CATALOG_SEED 0x2545f491UL
+
+/// Minimum measurement time per component and size in nanoseconds.
+#define MIN_MEASUREMENT_NS 100000000ULL
+
+/// Minimum number of runs per component and size.
+#define MIN_RUNS 3
+
+/// Size of the arena blocks.
+#define ARENA_BLOCK_SIZE 0x10000
+
+/// Size of the transcoding and formatting buffer.
+#define BUFFER_SIZE 256
+
+/// Name of the null device.
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+// ******** Private types ********
+
+/// <summary>
+/// Data of the benchmarks of one catalog size.
+/// </summary>
+typedef struct _BENCH_CONTEXT {
+   /// Synthetic catalog in enumeration order.
+   SYNTHETIC_CATALOG synthetic;
+
+   /// Backend that enumerates the synthetic catalog.
+   ALGORITHM_BACKEND backend;
+
+   /// Arena of the catalog.
+   ARENA arena;
+
+   /// Catalog built from the synthetic catalog.
+   ALGORITHM_CATALOG catalog;
+
+   /// Pointers to the synthetic algorithms in enumeration order.
+   BCRYPT_ALGORITHM_IDENTIFIER** ppOriginal;
+
+   /// Work list of the sort and the views.
+   BCRYPT_ALGORITHM_IDENTIFIER** ppWork;
+
+   /// Numbers to format.
+   uint32_t* pNumbers;
+
+   /// File the emitted lists would be written to.
+   FILE* fNull;
+
+   /// Sum of the results, so that the compiler can not remove the work.
+   volatile size_t sink;
+} BENCH_CONTEXT;
+
+/// <summary>
+/// Function that prepares or runs a benchmark.
+/// </summary>
+typedef BOOL (*BENCH_FUNCTION)(BENCH_CONTEXT* const pContext);
+
+/// <summary>
+/// Component to measure.
+/// </summary>
+typedef struct _BENCH_COMPONENT {
+   /// Name of the component.
+   const char* name;
+
+   /// Preparation of a run, which is not measured. NULL, if there is none.
+   BENCH_FUNCTION Prepare;
+
+   /// Measured run. It processes each algorithm once.
+   BENCH_FUNCTION Run;
+} BENCH_COMPONENT;
+
+/// <summary>
+/// Result of a measurement.
+/// </summary>
+typedef struct _MEASUREMENT {
+   /// Fastest time of a run in nanoseconds.
+   uint64_t fastestNs;
+
+   /// Allocations of one run.
+   ALLOCATION_COUNTS allocations;
+} MEASUREMENT;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Return the synthetic algorithms. Only the combined mask and the signature operation are requested by the catalog.
+/// </summary>
+static NTSTATUS syntheticEnumAlgorithms(PVOID const context,
+                                        const ULONG operationMask,
+                                        ULONG* const pAlgoCount,
+                                        BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList) {
+   const SYNTHETIC_CATALOG* pSynthetic = context;
+
+   if (operationMask == BCRYPT_SIGNATURE_OPERATION) {
+      *pAlgoCount = pSynthetic->signingCount;
+      *ppAlgoList = pSynthetic->pSigningAlgorithms;
+   } else {
+      *pAlgoCount = pSynthetic->count;
+      *ppAlgoList = pSynthetic->pAlgorithms;
+   }
+
+   return 0;
+}
+
+/// <summary>
+/// The lists belong to the synthetic catalog, so there is nothing to release.
+/// </summary>
+static void syntheticFreeBuffer(PVOID const context, PVOID const pBuffer) {
+   (void)context;
+   (void)pBuffer;
+}
+
+/// <summary>
+/// Build a catalog from the synthetic algorithms.
+/// </summary>
+static BOOL runCatalog(BENCH_CONTEXT* const pContext) {
+   ARENA arena;
+   InitArena(&arena, GetProcessHeap(), ARENA_BLOCK_SIZE);
+
+   ALGORITHM_CATALOG catalog;
+   BOOL result = BuildAlgorithmCatalog(&pContext->backend, &arena, &catalog, NULL);
+   pContext->sink += catalog.count;
+
+   FreeArena(&arena);
+
+   return result;
+}
+
+/// <summary>
+/// Restore the enumeration order of the work list.
+/// </summary>
+static BOOL prepareSort(BENCH_CONTEXT* const pContext) {
+   memcpy(pContext->ppWork, pContext->ppOriginal, pContext->synthetic.count * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*));
+
+   return TRUE;
+}
+
+/// <summary>
+/// Sort the work list by name.
+/// </summary>
+static BOOL runSort(BENCH_CONTEXT* const pContext) {
+   return SortAlgorithms(pContext->ppWork, pContext->synthetic.count);
+}
+
+/// <summary>
+/// Look up each algorithm in the catalog in enumeration order.
+/// </summary>
+static BOOL runLookup(BENCH_CONTEXT* const pContext) {
+   for (ULONG i = 0; i < pContext->synthetic.count; i++) {
+      long index = FindCatalogAlgorithm(&pContext->catalog, pContext->ppOriginal[i]->pszName);
+      if (index < 0)
+         return FALSE;
+
+      pContext->sink += (size_t)index;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Transcode each name to UTF-8.
+/// </summary>
+static BOOL runTranscode(BENCH_CONTEXT* const pContext) {
+   char buffer[BUFFER_SIZE];
+   size_t total = 0;
+
+   for (ULONG i = 0; i < pContext->synthetic.count; i++) {
+      LPCWSTR name = pContext->ppOriginal[i]->pszName;
+      total += TranscodeToUtf8(name, wcslen(name), buffer, sizeof(buffer));
+   }
+
+   pContext->sink += total;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Format one number per algorithm.
+/// </summary>
+static BOOL runFormat(BENCH_CONTEXT* const pContext) {
+   char buffer[BUFFER_SIZE];
+   size_t total = 0;
+
+   for (ULONG i = 0; i < pContext->synthetic.count; i++)
+      total += FormatUint32(pContext->pNumbers[i], buffer);
+
+   pContext->sink += total;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Emit all types of the catalog with an emitter. The output is not written.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <param name="pEmitter">Emitter.</param>
+/// <returns>TRUE, if the output buffer could be allocated, FALSE if not.</returns>
+static BOOL emitCatalog(BENCH_CONTEXT* const pContext, const LIST_EMITTER* const pEmitter) {
+   OUTPUT_BUFFER output;
+   if (InitOutputBuffer(&output, pContext->fNull, 0) == FALSE)
+      return FALSE;
+
+   EMITTER_STATE state = { &output, 0, 0 };
+   pEmitter->BeginList(&state, "synthetic", NULL);
+
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++) {
+      ULONG count = GetCatalogView(&pContext->catalog, OperationTypes[t], pContext->ppWork);
+
+      state.algorithmCount = 0;
+      pEmitter->BeginType(&state, OperationTypes[t]);
+
+      for (ULONG i = 0; i < count; i++) {
+         pEmitter->EmitAlgorithm(&state, OperationTypes[t], pContext->ppWork[i], NULL);
+         state.algorithmCount++;
+      }
+
+      pEmitter->EndType(&state);
+      state.typeCount++;
+   }
+
+   pEmitter->EndList(&state);
+
+   pContext->sink += output.byteCount;
+   FreeOutputBuffer(&output);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Emit the catalog as JSON.
+/// </summary>
+static BOOL runEmitJson(BENCH_CONTEXT* const pContext) {
+   return emitCatalog(pContext, GetJsonEmitter());
+}
+
+/// <summary>
+/// Emit the catalog as CSV.
+/// </summary>
+static BOOL runEmitCsv(BENCH_CONTEXT* const pContext) {
+   return emitCatalog(pContext, GetCsvEmitter());
+}
+
+// ******** Private constants ********
+
+/// Components to measure.
+static const BENCH_COMPONENT components[] = {
+   { "Catalog",   NULL,        runCatalog },
+   { "Sort",      prepareSort, runSort },
+   { "Lookup",    NULL,        runLookup },
+   { "Transcode", NULL,        runTranscode },
+   { "Format",    NULL,        runFormat },
+   { "Emit JSON", NULL,        runEmitJson },
+   { "Emit CSV",  NULL,        runEmitCsv }
+};
+
+// ******** Private methods ********
+
+/// <summary>
+/// Measure a component.
+/// </summary>
+/// <param name="pComponent">Component.</param>
+/// <param name="pContext">Benchmark data.</param>
+/// <param name="pMeasurement">Pointer to the result.</param>
+/// <returns>TRUE, if all runs succeeded, FALSE if not.</returns>
+static BOOL measureComponent(const BENCH_COMPONENT* const pComponent, BENCH_CONTEXT* const pContext, MEASUREMENT* const pMeasurement) {
+   uint64_t total = 0;
+
+   pMeasurement->fastestNs = UINT64_MAX;
+   for (ULONG run = 0; run < MIN_RUNS || total < MIN_MEASUREMENT_NS; run++) {
+      if (pComponent->Prepare != NULL && pComponent->Prepare(pContext) == FALSE)
+         return FALSE;
+
+      ALLOCATION_COUNTS before;
+      GetAllocationCounts(&before);
+
+      uint64_t startTime = GetTimeNs();
+      if (pComponent->Run(pContext) == FALSE)
+         return FALSE;
+
+      uint64_t duration = GetTimeNs() - startTime;
+
+      // Each run allocates the same, so the counts of the last run are the ones of every run.
+      GetAllocationCounts(&pMeasurement->allocations);
+      pMeasurement->allocations.allocationCount -= before.allocationCount;
+      pMeasurement->allocations.byteCount -= before.byteCount;
+
+      if (duration < pMeasurement->fastestNs)
+         pMeasurement->fastestNs = duration;
+
+      total += duration;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release the data of one catalog size.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+static void freeContext(BENCH_CONTEXT* const pContext) {
+   FreeArena(&pContext->arena);
+   FreeSyntheticCatalog(&pContext->synthetic);
+
+   free(pContext->ppOriginal);
+   free(pContext->ppWork);
+   free(pContext->pNumbers);
+}
+
+/// <summary>
+/// Create the synthetic catalog of one size and the catalog built from it.
+/// </summary>
+/// <param name="pContext">Benchmark data. The file must be set.</param>
+/// <param name="count">Number of algorithms.</param>
+/// <returns>TRUE, if the data could be created, FALSE if not.</returns>
+static BOOL createContext(BENCH_CONTEXT* const pContext, const ULONG count) {
+   InitArena(&pContext->arena, GetProcessHeap(), ARENA_BLOCK_SIZE);
+
+   pContext->ppOriginal = malloc(((size_t)count + 1) * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*));
+   pContext->ppWork = malloc(((size_t)count + 1) * sizeof(BCRYPT_ALGORITHM_IDENTIFIER*));
+   pContext->pNumbers = malloc(((size_t)count + 1) * sizeof(uint32_t));
+   if (pContext->ppOriginal == NULL || pContext->ppWork == NULL || pContext->pNumbers == NULL ||
+       CreateSyntheticCatalog(&pContext->synthetic, count, CATALOG_SEED) == FALSE) {
+      fputs("Not enough memory.\n", stderr);
+      return FALSE;
+   }
+
+   memset(&pContext->backend, 0, sizeof(pContext->backend));
+   pContext->backend.name = "synthetic";
+   pContext->backend.context = &pContext->synthetic;
+   pContext->backend.EnumAlgorithms = syntheticEnumAlgorithms;
+   pContext->backend.FreeBuffer = syntheticFreeBuffer;
+
+   // Numbers like the ones in a list with details: key lengths, block lengths and object sizes.
+   ULONG state = CATALOG_SEED;
+   for (ULONG i = 0; i < count; i++) {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      pContext->ppOriginal[i] = pContext->synthetic.pAlgorithms + i;
+      pContext->pNumbers[i] = (uint32_t)(state >> ((state & 3) * 8));
+   }
+
+   // All names are unique, so the catalog has to contain all of them.
+   if (BuildAlgorithmCatalog(&pContext->backend, &pContext->arena, &pContext->catalog, NULL) == FALSE ||
+       pContext->catalog.count != count) {
+      fputs("The synthetic catalog could not be built.\n", stderr);
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Check that the work list is in collation order.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <returns>TRUE, if the list is sorted, FALSE if not.</returns>
+static BOOL isSorted(const BENCH_CONTEXT* const pContext) {
+   for (ULONG i = 1; i < pContext->synthetic.count; i++)
+      if (CompareNames(pContext->ppWork[i - 1]->pszName, pContext->ppWork[i]->pszName) > 0)
+         return FALSE;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Measure all components for one catalog size and print the results.
+/// </summary>
+/// <param name="count">Number of algorithms.</param>
+/// <param name="fNull">File the emitted lists would be written to.</param>
+/// <returns>TRUE, if all components could be measured, FALSE if not.</returns>
+static BOOL measureCatalogSize(const ULONG count, FILE* const fNull) {
+   BENCH_CONTEXT* pContext = calloc(1, sizeof(BENCH_CONTEXT));
+   if (pContext == NULL) {
+      fputs("Not enough memory.\n", stderr);
+      return FALSE;
+   }
+
+   pContext->fNull = fNull;
+
+   BOOL result = createContext(pContext, count);
+   for (size_t c = 0; result != FALSE && c < sizeof(components) / sizeof(components[0]); c++) {
+      const BENCH_COMPONENT* pComponent = components + c;
+
+      MEASUREMENT measurement;
+      result = measureComponent(pComponent, pContext, &measurement);
+      if (result != FALSE && pComponent->Run == runSort)
+         result = isSorted(pContext);
+
+      if (result == FALSE) {
+         fprintf(stdout, "%10lu  %-10s  failed\n", (unsigned long)count, pComponent->name);
+         break;
+      }
+
+      fprintf(stdout, "%10lu  %-10s %10.1f", (unsigned long)count, pComponent->name, (double)measurement.fastestNs / count);
+      if (IsAllocationCounting() != FALSE)
+         fprintf(stdout,
+                 " %12llu %14llu\n",
+                 (unsigned long long)measurement.allocations.allocationCount,
+                 (unsigned long long)measurement.allocations.byteCount);
+      else
+         fputs("          n/a            n/a\n", stdout);
+   }
+
+   fflush(stdout);
+
+   freeContext(pContext);
+   free(pContext);
+
+   return result;
+}
+
+// ******** Main method ********
+
+int main(int argc, char* argv[]) {
+   ULONG maxCount = MAX_ALGORITHM_COUNT;
+   if (argc == 3 && strcmp(argv[1], "--max-count") == 0)
+      maxCount = strtoul(argv[2], NULL, 10);
+   else if (argc != 1) {
+      fputs("Usage: bcryptenum_bench [--max-count <n>]\n", stderr);
+      return 2;
+   }
+
+   FILE* fNull = fopen(NULL_DEVICE, "wb");
+   if (fNull == NULL) {
+      fputs("The null device could not be opened.\n", stderr);
+      return 2;
+   }
+
+   fputs("     Count  Component       ns/op   allocs/run      bytes/run\n", stdout);
+
+   int rc = 0;
+   for (ULONG count = MIN_ALGORITHM_COUNT; count <= maxCount && rc == 0; count *= 10)
+      if (measureCatalogSize(count, fNull) == FALSE)
+         rc = 1;
+
+   fclose(fNull);
+
+   return rc;
+}
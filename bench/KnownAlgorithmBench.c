@@ -0,0 +1,343 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Benchmark of the perfect hash of the documented CNG algorithm identifiers.
+//
+// Usage: KnownAlgorithmBench [--generate]
+//
+// The time per lookup of the perfect hash is compared with a linear search and a binary search
+// of the names with wcscmp, for documented names and for vendor names of a synthetic catalog.
+// With --generate the seed and the slot table of KnownAlgorithms.c are searched and printed.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "KnownAlgorithms.h"
+#include "SyntheticCatalog.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Number of names in the synthetic catalog of the vendor names.
+#define SYNTHETIC_COUNT 1024UL
+
+/// Seed of the synthetic catalog.
+#define CATALOG_SEED 0x2545f491UL
+
+/// Number of lookups per measurement.
+#define LOOKUP_COUNT 2000000UL
+
+/// Number of repetitions of each measurement. The fastest one is printed.
+#define REPETITIONS 5
+
+/// Largest seed that is tried by --generate.
+#define MAX_SEED 0x01000000UL
+
+/// Number of slots per line of the generated table.
+#define SLOTS_PER_LINE 16
+
+// ******** Private types ********
+
+/// <summary>
+/// Data of the benchmark.
+/// </summary>
+typedef struct _BENCH_CONTEXT {
+   /// Synthetic catalog with the vendor names.
+   SYNTHETIC_CATALOG synthetic;
+
+   /// Documented names in the order of the lookups.
+   LPCWSTR* pKnownNames;
+
+   /// Vendor names that are not documented.
+   LPCWSTR* pVendorNames;
+
+   /// Number of vendor names.
+   ULONG vendorCount;
+
+   /// Documented names sorted with wcscmp for the binary search.
+   LPCWSTR* pSortedNames;
+
+   /// Sum of the results, so that the compiler can not remove the work.
+   volatile long sink;
+} BENCH_CONTEXT;
+
+/// <summary>
+/// Function that looks up a name.
+/// </summary>
+typedef long (*LOOKUP_FUNCTION)(const BENCH_CONTEXT* const pContext, LPCWSTR const name);
+
+// ******** Private methods ********
+
+/// <summary>
+/// Look up a name with the perfect hash.
+/// </summary>
+static long lookupPerfectHash(const BENCH_CONTEXT* const pContext, LPCWSTR const name) {
+   (void)pContext;
+
+   return FindKnownAlgorithm(name);
+}
+
+/// <summary>
+/// Look up a name with a linear search.
+/// </summary>
+static long lookupLinear(const BENCH_CONTEXT* const pContext, LPCWSTR const name) {
+   (void)pContext;
+
+   for (long i = 0; i < KNOWN_ALGORITHM_COUNT; i++)
+      if (wcscmp(KnownAlgorithms[i].name, name) == 0)
+         return i;
+
+   return -1;
+}
+
+/// <summary>
+/// Look up a name with a binary search of the sorted names.
+/// </summary>
+static long lookupBinary(const BENCH_CONTEXT* const pContext, LPCWSTR const name) {
+   long low = 0;
+   long high = KNOWN_ALGORITHM_COUNT - 1;
+
+   while (low <= high) {
+      const long middle = (low + high) >> 1;
+      const int comparison = wcscmp(pContext->pSortedNames[middle], name);
+
+      if (comparison == 0)
+         return middle;
+
+      if (comparison < 0)
+         low = middle + 1;
+      else
+         high = middle - 1;
+   }
+
+   return -1;
+}
+
+/// <summary>
+/// Compare two names with wcscmp for qsort.
+/// </summary>
+static int compareNames(const void* pLeft, const void* pRight) {
+   return wcscmp(*(LPCWSTR const*)pLeft, *(LPCWSTR const*)pRight);
+}
+
+/// <summary>
+/// Measure a lookup function.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <param name="Lookup">Lookup function.</param>
+/// <param name="pNames">Names to look up.</param>
+/// <param name="nameCount">Number of names. They are looked up in turn.</param>
+/// <returns>Fastest time per lookup in nanoseconds.</returns>
+static double measureLookups(BENCH_CONTEXT* const pContext, const LOOKUP_FUNCTION Lookup, LPCWSTR const* const pNames, const ULONG nameCount) {
+   uint64_t fastestNs = UINT64_MAX;
+
+   for (int r = 0; r < REPETITIONS; r++) {
+      long sum = 0;
+      ULONG n = 0;
+
+      const uint64_t startTime = GetTimeNs();
+      for (ULONG i = 0; i < LOOKUP_COUNT; i++) {
+         sum += Lookup(pContext, pNames[n]);
+         if (++n == nameCount)
+            n = 0;
+      }
+
+      const uint64_t duration = GetTimeNs() - startTime;
+
+      pContext->sink += sum;
+      if (duration < fastestNs)
+         fastestNs = duration;
+   }
+
+   return (double)fastestNs / LOOKUP_COUNT;
+}
+
+/// <summary>
+/// Search a seed with which each documented name has a slot of its own, and print it with the slot table.
+/// </summary>
+/// <returns>TRUE, if a seed was found, FALSE if not.</returns>
+static BOOL generateTable(void) {
+   UCHAR slots[KNOWN_HASH_SLOT_COUNT];
+
+   for (ULONG seed = 1; seed < MAX_SEED; seed++) {
+      memset(slots, 0, sizeof(slots));
+
+      ULONG id = 0;
+      while (id < KNOWN_ALGORITHM_COUNT) {
+         const ULONG slot = KNOWN_HASH_SLOT(HashAlgorithmName(KnownAlgorithms[id].name, seed));
+         if (slots[slot] != 0)
+            break;
+
+         slots[slot] = (UCHAR)(id + 1);
+         id++;
+      }
+
+      if (id < KNOWN_ALGORITHM_COUNT)
+         continue;
+
+      fprintf(stdout, "#define KNOWN_HASH_SEED 0x%08lxu\n\n", (unsigned long)seed);
+      for (ULONG s = 0; s < KNOWN_HASH_SLOT_COUNT; s++)
+         fprintf(stdout,
+                 "%s%2u%s",
+                 (s % SLOTS_PER_LINE == 0) ? "   " : "",
+                 (unsigned)slots[s],
+                 (s + 1 == KNOWN_HASH_SLOT_COUNT) ? "\n" : ((s % SLOTS_PER_LINE == SLOTS_PER_LINE - 1) ? ",\n" : ", "));
+
+      return TRUE;
+   }
+
+   fputs("No seed found. Increase KNOWN_HASH_SLOT_BITS.\n", stderr);
+
+   return FALSE;
+}
+
+/// <summary>
+/// Check that all lookups find the documented names and only them.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <returns>TRUE, if all lookups have the expected result, FALSE if not.</returns>
+static BOOL checkLookups(const BENCH_CONTEXT* const pContext) {
+   for (long i = 0; i < KNOWN_ALGORITHM_COUNT; i++) {
+      LPCWSTR name = KnownAlgorithms[i].name;
+
+      if (FindKnownAlgorithm(name) != i || lookupLinear(pContext, name) != i ||
+          wcscmp(pContext->pSortedNames[lookupBinary(pContext, name)], name) != 0)
+         return FALSE;
+   }
+
+   for (ULONG i = 0; i < pContext->vendorCount; i++)
+      if (FindKnownAlgorithm(pContext->pVendorNames[i]) >= 0 || lookupBinary(pContext, pContext->pVendorNames[i]) >= 0)
+         return FALSE;
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release the benchmark data.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+static void freeContext(BENCH_CONTEXT* const pContext) {
+   free(pContext->pKnownNames);
+   free(pContext->pVendorNames);
+   free(pContext->pSortedNames);
+
+   FreeSyntheticCatalog(&pContext->synthetic);
+}
+
+/// <summary>
+/// Create the name lists.
+/// </summary>
+/// <param name="pContext">Benchmark data.</param>
+/// <returns>TRUE, if the lists could be created, FALSE if not.</returns>
+static BOOL createContext(BENCH_CONTEXT* const pContext) {
+   pContext->pKnownNames = malloc(KNOWN_ALGORITHM_COUNT * sizeof(LPCWSTR));
+   pContext->pSortedNames = malloc(KNOWN_ALGORITHM_COUNT * sizeof(LPCWSTR));
+   pContext->pVendorNames = malloc(SYNTHETIC_COUNT * sizeof(LPCWSTR));
+   if (pContext->pKnownNames == NULL || pContext->pSortedNames == NULL || pContext->pVendorNames == NULL ||
+       CreateSyntheticCatalog(&pContext->synthetic, SYNTHETIC_COUNT, CATALOG_SEED) == FALSE)
+      return FALSE;
+
+   for (ULONG i = 0; i < KNOWN_ALGORITHM_COUNT; i++) {
+      pContext->pKnownNames[i] = KnownAlgorithms[i].name;
+      pContext->pSortedNames[i] = KnownAlgorithms[i].name;
+   }
+
+   qsort(pContext->pSortedNames, KNOWN_ALGORITHM_COUNT, sizeof(LPCWSTR), compareNames);
+
+   // The documented names are looked up in a pseudo random order, so that the branches can not be learned (Fisher-Yates).
+   ULONG state = CATALOG_SEED;
+   for (ULONG i = KNOWN_ALGORITHM_COUNT; i > 1; i--) {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+
+      const ULONG j = state % i;
+      LPCWSTR temp = pContext->pKnownNames[i - 1];
+      pContext->pKnownNames[i - 1] = pContext->pKnownNames[j];
+      pContext->pKnownNames[j] = temp;
+   }
+
+   for (ULONG i = 0; i < pContext->synthetic.count; i++)
+      if (lookupLinear(pContext, pContext->synthetic.pAlgorithms[i].pszName) < 0)
+         pContext->pVendorNames[pContext->vendorCount++] = pContext->synthetic.pAlgorithms[i].pszName;
+
+   return (pContext->vendorCount > 0);
+}
+
+// ******** Main method ********
+
+int main(int argc, char* argv[]) {
+   if (argc == 2 && strcmp(argv[1], "--generate") == 0)
+      return (generateTable() != FALSE) ? 0 : 1;
+
+   if (argc != 1) {
+      fputs("Usage: KnownAlgorithmBench [--generate]\n", stderr);
+      return 2;
+   }
+
+   BENCH_CONTEXT* pContext = calloc(1, sizeof(BENCH_CONTEXT));
+   if (pContext == NULL || createContext(pContext) == FALSE) {
+      fputs("Not enough memory.\n", stderr);
+      if (pContext != NULL) {
+         freeContext(pContext);
+         free(pContext);
+      }
+
+      return 2;
+   }
+
+   int rc = 0;
+   if (checkLookups(pContext) == FALSE) {
+      fputs("The lookups give different results.\n", stderr);
+      rc = 1;
+   } else {
+      fprintf(stdout, "Documented names: %lu, vendor names: %lu\n", (unsigned long)KNOWN_ALGORITHM_COUNT, (unsigned long)pContext->vendorCount);
+      fputs("Lookup            known ns  vendor ns\n", stdout);
+      fprintf(stdout,
+              "Perfect hash     %9.1f  %9.1f\n",
+              measureLookups(pContext, lookupPerfectHash, pContext->pKnownNames, KNOWN_ALGORITHM_COUNT),
+              measureLookups(pContext, lookupPerfectHash, pContext->pVendorNames, pContext->vendorCount));
+      fprintf(stdout,
+              "Binary search    %9.1f  %9.1f\n",
+              measureLookups(pContext, lookupBinary, pContext->pKnownNames, KNOWN_ALGORITHM_COUNT),
+              measureLookups(pContext, lookupBinary, pContext->pVendorNames, pContext->vendorCount));
+      fprintf(stdout,
+              "Linear search    %9.1f  %9.1f\n",
+              measureLookups(pContext, lookupLinear, pContext->pKnownNames, KNOWN_ALGORITHM_COUNT),
+              measureLookups(pContext, lookupLinear, pContext->pVendorNames, pContext->vendorCount));
+   }
+
+   freeContext(pContext);
+   free(pContext);
+
+   return rc;
+}
@@ -0,0 +1,254 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.1.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//    2026-10-16: V1.1.0: Probe the algorithms, as the lists come from one catalog.
+//
+
+//
+// Benchmark of the concurrent listing of all types with details against the sequential listing with a slow mock backend.
+//
+// Usage: ListPipelineBench
+//
+// The mock backend waits a fixed time in each enumeration and in each opening of an algorithm, like a backend that has to ask a service.
+// All algorithms are enumerated with one call, so the time of the listing is dominated by the probes.
+// The sequential listing is the listing with one thread.
+// The lists are written to stdout, which is redirected to the null device. The results are printed to stderr.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "AlgorithmBackend.h"
+#include "BCryptList.h"
+#include "ListEmitter.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Number of algorithms of each type.
+#define ALGORITHMS_PER_TYPE 8
+
+/// Maximum length of a synthetic name including the terminating 0.
+#define MAX_NAME_LENGTH 32
+
+/// Number of runs per measurement.
+#define RUN_COUNT 9
+
+/// Name of the null device.
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+/// Delays of one backend call in milliseconds.
+static const ULONG backendDelays[] = { 0, 1, 2, 5 };
+
+/// Thread counts of the concurrent listing.
+static const ULONG threadCounts[] = { 2, 4, OPERATION_TYPE_COUNT };
+
+// ******** Private types ********
+
+/// <summary>
+/// Mock backend data.
+/// </summary>
+typedef struct _MOCK_BACKEND {
+   /// Delay of one enumeration and of opening one algorithm in milliseconds.
+   ULONG delayMs;
+
+   /// Names of the algorithms of all types.
+   wchar_t names[OPERATION_TYPE_COUNT][ALGORITHMS_PER_TYPE][MAX_NAME_LENGTH];
+} MOCK_BACKEND;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Wait and return the synthetic algorithms of the types in the operation mask.
+/// </summary>
+static NTSTATUS mockEnumAlgorithms(PVOID const context,
+                                   const ULONG operationMask,
+                                   ULONG* const pAlgoCount,
+                                   BCRYPT_ALGORITHM_IDENTIFIER** const ppAlgoList) {
+   MOCK_BACKEND* pMock = context;
+
+   if (pMock->delayMs != 0)
+      SleepMilliseconds(pMock->delayMs);
+
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgoList = malloc(OPERATION_TYPE_COUNT * ALGORITHMS_PER_TYPE * sizeof(BCRYPT_ALGORITHM_IDENTIFIER));
+   if (pAlgoList == NULL)
+      return STATUS_NO_MEMORY;
+
+   ULONG count = 0;
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      if ((OperationTypes[t] & operationMask) != 0)
+         for (ULONG i = 0; i < ALGORITHMS_PER_TYPE; i++) {
+            pAlgoList[count].pszName = pMock->names[t][i];
+            pAlgoList[count].dwClass = OperationTypeInterface(OperationTypes[t]);
+            pAlgoList[count].dwFlags = 0;
+            count++;
+         }
+
+   *pAlgoCount = count;
+   *ppAlgoList = pAlgoList;
+
+   return 0;
+}
+
+/// <summary>
+/// Wait and fail to open an algorithm.
+/// </summary>
+static NTSTATUS mockOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm) {
+   MOCK_BACKEND* pMock = context;
+   (void)algorithmName;
+   (void)phAlgorithm;
+
+   if (pMock->delayMs != 0)
+      SleepMilliseconds(pMock->delayMs);
+
+   return STATUS_NOT_FOUND;
+}
+
+/// <summary>
+/// Release a list returned by the mock backend.
+/// </summary>
+static void mockFreeBuffer(PVOID const context, PVOID const pBuffer) {
+   (void)context;
+
+   free(pBuffer);
+}
+
+/// <summary>
+/// The mock backend has no module version.
+/// </summary>
+static BOOL mockGetModuleVersion(PVOID const context, const PCHAR moduleName, MODULE_VERSION* const pVersion) {
+   (void)context;
+   (void)moduleName;
+   (void)pVersion;
+
+   return FALSE;
+}
+
+/// <summary>
+/// Create the names of the mock backend. The names are in reverse order, so that they have to be sorted.
+/// </summary>
+/// <param name="pMock">Mock backend.</param>
+static void createNames(MOCK_BACKEND* const pMock) {
+   for (int t = 0; t < OPERATION_TYPE_COUNT; t++)
+      for (ULONG i = 0; i < ALGORITHMS_PER_TYPE; i++)
+         swprintf(pMock->names[t][i], MAX_NAME_LENGTH, L"ALGO%d_%lu", t, (unsigned long)(ALGORITHMS_PER_TYPE - i));
+}
+
+/// <summary>
+/// Measure the listing of all types.
+/// </summary>
+/// <param name="pBackend">Mock backend.</param>
+/// <param name="threadCount">Number of threads.</param>
+/// <returns>Median time of a listing in nanoseconds. 0, if the listing failed.</returns>
+static uint64_t measureListing(const ALGORITHM_BACKEND* const pBackend, const ULONG threadCount) {
+   LIST_OPTIONS options;
+   memset(&options, 0, sizeof(options));
+   options.showDetails = TRUE;
+   options.maxThreads = threadCount;
+
+   uint64_t times[RUN_COUNT];
+   for (int run = 0; run < RUN_COUNT; run++) {
+      uint64_t startTime = GetTimeNs();
+      if (ListAllTypes(pBackend, &options) != 0)
+         return 0;
+
+      times[run] = GetTimeNs() - startTime;
+   }
+
+   // Insertion sort for the median.
+   for (int i = 1; i < RUN_COUNT; i++) {
+      uint64_t value = times[i];
+      int j = i;
+      for (; j > 0 && times[j - 1] > value; j--)
+         times[j] = times[j - 1];
+
+      times[j] = value;
+   }
+
+   return times[RUN_COUNT / 2];
+}
+
+// ******** Main method ********
+
+int main(void) {
+   MOCK_BACKEND* pMock = malloc(sizeof(MOCK_BACKEND));
+   if (pMock == NULL) {
+      fputs("Not enough memory.\n", stderr);
+      return 2;
+   }
+
+   createNames(pMock);
+
+   ALGORITHM_BACKEND backend;
+   memset(&backend, 0, sizeof(backend));
+   backend.name = "mock";
+   backend.context = pMock;
+   backend.EnumAlgorithms = mockEnumAlgorithms;
+   backend.FreeBuffer = mockFreeBuffer;
+   backend.GetModuleVersion = mockGetModuleVersion;
+   backend.OpenAlgorithm = mockOpenAlgorithm;
+
+   if (freopen(NULL_DEVICE, "w", stdout) == NULL) {
+      fputs("The null device could not be opened.\n", stderr);
+      free(pMock);
+      return 2;
+   }
+
+   fputs("  Delay  Sequential", stderr);
+   for (size_t c = 0; c < sizeof(threadCounts) / sizeof(threadCounts[0]); c++)
+      fprintf(stderr, "   %lu threads (speedup)", (unsigned long)threadCounts[c]);
+   fputc('\n', stderr);
+
+   int rc = 0;
+   for (size_t d = 0; d < sizeof(backendDelays) / sizeof(backendDelays[0]); d++) {
+      pMock->delayMs = backendDelays[d];
+
+      uint64_t sequentialTime = measureListing(&backend, 1);
+      fprintf(stderr, "%4lu ms %8.3f ms", (unsigned long)pMock->delayMs, (double)sequentialTime / 1.0e6);
+
+      for (size_t c = 0; c < sizeof(threadCounts) / sizeof(threadCounts[0]); c++) {
+         uint64_t concurrentTime = measureListing(&backend, threadCounts[c]);
+         if (sequentialTime == 0 || concurrentTime == 0) {
+            fputs("                 failed", stderr);
+            rc = 1;
+         }
+         else
+            fprintf(stderr, " %10.3f ms (%5.2fx)", (double)concurrentTime / 1.0e6, (double)sequentialTime / (double)concurrentTime);
+      }
+
+      fputc('\n', stderr);
+   }
+
+   free(pMock);
+
+   return rc;
+}
@@ -0,0 +1,283 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Benchmark of the name sort against the former shell sort and qsort with wcscmp.
+//
+// Usage: NameSortBench [--all]
+//
+// The shell sort is quadratic, so it is only run up to 10^5 names, unless "--all" is specified.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "NameSort.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Smallest number of names.
+#define MIN_NAME_COUNT 100UL
+
+/// Largest number of names.
+#define MAX_NAME_COUNT 1000000UL
+
+/// Largest number of names for the shell sort, unless all sizes are requested.
+#define MAX_SHELL_SORT_COUNT 100000UL
+
+/// Maximum length of a synthetic name including the terminating 0.
+#define MAX_NAME_LENGTH 32
+
+/// Minimum measurement time per sort and size in nanoseconds.
+#define MIN_MEASUREMENT_NS 200000000ULL
+
+/// Minimum number of runs per sort and size.
+#define MIN_RUNS 3
+
+// ******** Private types ********
+
+/// <summary>
+/// Sort function to measure.
+/// </summary>
+typedef BOOL (*SORT_FUNCTION)(LPWSTR* const pNames, const ULONG nameCount);
+
+// ******** Private variables ********
+
+/// Prefixes of the synthetic names. They resemble real algorithm names.
+static const wchar_t* const namePrefixes[] = {
+   L"AES", L"AES_GCM_", L"CHACHA20_POLY", L"DH", L"DSA", L"ECDH_P", L"ECDSA_P",
+   L"HKDF", L"KMAC", L"MD", L"PBKDF", L"RC", L"RSA", L"SHA", L"SHA3-", L"SP800_"
+};
+
+/// State of the pseudo random number generator.
+static ULONG randomState = 0x2545f491UL;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the next pseudo random number (xorshift32).
+/// </summary>
+/// <returns>Pseudo random number.</returns>
+static ULONG nextRandom(void) {
+   ULONG x = randomState;
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   randomState = x;
+
+   return x;
+}
+
+/// <summary>
+/// The shell sort that was used to sort the algorithm names before.
+/// The count is a ULONG here, so that it can sort more than 65535 names.
+/// </summary>
+/// <param name="pNames">List of name pointers.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <returns>Always TRUE.</returns>
+static BOOL shellSort(LPWSTR* const pNames, const ULONG nameCount) {
+   ULONG stepSize[] = {7, 4, 1};
+
+   for (ULONG s = 0; s < sizeof(stepSize) / sizeof(stepSize[0]); s++) {
+      ULONG step = stepSize[s];
+
+      for (ULONG i = step; i < nameCount; i++) {
+         LPWSTR insertionName = pNames[i];
+         ULONG insertionIndex = i;
+
+         while (insertionIndex >= step &&
+                wcscmp(insertionName, pNames[insertionIndex - step]) < 0) {
+            pNames[insertionIndex] = pNames[insertionIndex - step];
+            insertionIndex -= step;
+         }
+
+         pNames[insertionIndex] = insertionName;
+      }
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Compare two name pointers for qsort.
+/// </summary>
+/// <param name="pLeft">Pointer to the left name pointer.</param>
+/// <param name="pRight">Pointer to the right name pointer.</param>
+/// <returns>Result of the comparison.</returns>
+static int compareNames(const void* const pLeft, const void* const pRight) {
+   return wcscmp(*(LPCWSTR const*)pLeft, *(LPCWSTR const*)pRight);
+}
+
+/// <summary>
+/// Sort with qsort and wcscmp.
+/// </summary>
+/// <param name="pNames">List of name pointers.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <returns>Always TRUE.</returns>
+static BOOL quickSort(LPWSTR* const pNames, const ULONG nameCount) {
+   qsort(pNames, nameCount, sizeof(LPWSTR), compareNames);
+
+   return TRUE;
+}
+
+/// <summary>
+/// Create synthetic names.
+/// </summary>
+/// <param name="pPool">Pool for the names with room for nameCount names of MAX_NAME_LENGTH characters.</param>
+/// <param name="pNames">List that receives the name pointers.</param>
+/// <param name="nameCount">Number of names.</param>
+static void createNames(wchar_t* const pPool, LPWSTR* const pNames, const ULONG nameCount) {
+   const ULONG prefixCount = sizeof(namePrefixes) / sizeof(namePrefixes[0]);
+
+   for (ULONG i = 0; i < nameCount; i++) {
+      wchar_t* pName = pPool + (size_t)i * MAX_NAME_LENGTH;
+      ULONG random = nextRandom();
+      const wchar_t* prefix = namePrefixes[random % prefixCount];
+
+      if ((random & 0x100) != 0)
+         swprintf(pName, MAX_NAME_LENGTH, L"%ls%lu", prefix, (unsigned long)(nextRandom() % 100000UL));
+      else
+         swprintf(pName, MAX_NAME_LENGTH, L"%ls%lu_%lu", prefix, (unsigned long)(nextRandom() % 1000UL), (unsigned long)(nextRandom() % 4096UL));
+
+      pNames[i] = pName;
+   }
+}
+
+/// <summary>
+/// Measure a sort function.
+/// </summary>
+/// <param name="sortFunction">Sort function.</param>
+/// <param name="pOriginal">Unsorted names.</param>
+/// <param name="pWork">Work list.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <returns>Fastest time of a run in nanoseconds. 0, if the sort failed.</returns>
+static uint64_t measureSort(const SORT_FUNCTION sortFunction, LPWSTR* const pOriginal, LPWSTR* const pWork, const ULONG nameCount) {
+   uint64_t fastest = UINT64_MAX;
+   uint64_t total = 0;
+
+   for (ULONG run = 0; run < MIN_RUNS || total < MIN_MEASUREMENT_NS; run++) {
+      memcpy(pWork, pOriginal, nameCount * sizeof(LPWSTR));
+
+      uint64_t startTime = GetTimeNs();
+      if (sortFunction(pWork, nameCount) == FALSE)
+         return 0;
+
+      uint64_t duration = GetTimeNs() - startTime;
+      if (duration < fastest)
+         fastest = duration;
+
+      total += duration;
+   }
+
+   return fastest;
+}
+
+/// <summary>
+/// Print a measurement.
+/// </summary>
+/// <param name="nanoseconds">Duration in nanoseconds. 0 means not measured.</param>
+/// <param name="nameCount">Number of names.</param>
+static void printMeasurement(const uint64_t nanoseconds, const ULONG nameCount) {
+   if (nanoseconds == 0)
+      fputs("            skipped", stdout);
+   else
+      fprintf(stdout, " %10.3f ms %6.1f ns", (double)nanoseconds / 1.0e6, (double)nanoseconds / nameCount);
+}
+
+/// <summary>
+/// Check that the names are in collation order.
+/// </summary>
+/// <param name="pNames">Sorted names.</param>
+/// <param name="nameCount">Number of names.</param>
+/// <returns>TRUE, if the names are sorted, FALSE if not.</returns>
+static BOOL isSorted(LPWSTR* const pNames, const ULONG nameCount) {
+   UCHAR leftKey[4 * MAX_NAME_LENGTH];
+   UCHAR rightKey[4 * MAX_NAME_LENGTH];
+
+   for (ULONG i = 1; i < nameCount; i++) {
+      size_t leftLength = BuildCollationKey(pNames[i - 1], leftKey, sizeof(leftKey));
+      size_t rightLength = BuildCollationKey(pNames[i], rightKey, sizeof(rightKey));
+      size_t commonLength = (leftLength < rightLength) ? leftLength : rightLength;
+
+      int result = memcmp(leftKey, rightKey, commonLength);
+      if (result > 0 || (result == 0 && leftLength > rightLength))
+         return FALSE;
+   }
+
+   return TRUE;
+}
+
+// ******** Main method ********
+
+int main(int argc, char* argv[]) {
+   BOOL runAll = (argc > 1 && strcmp(argv[1], "--all") == 0);
+
+   wchar_t* pPool = malloc((size_t)MAX_NAME_COUNT * MAX_NAME_LENGTH * sizeof(wchar_t));
+   LPWSTR* pOriginal = malloc(MAX_NAME_COUNT * sizeof(LPWSTR));
+   LPWSTR* pWork = malloc(MAX_NAME_COUNT * sizeof(LPWSTR));
+   if (pPool == NULL || pOriginal == NULL || pWork == NULL) {
+      fputs("Not enough memory.\n", stderr);
+      return 2;
+   }
+
+   createNames(pPool, pOriginal, MAX_NAME_COUNT);
+
+   fputs("     Names     Shell sort (per name)   qsort/wcscmp (per name)  Collation sort (per name)\n", stdout);
+
+   int rc = 0;
+   for (ULONG nameCount = MIN_NAME_COUNT; nameCount <= MAX_NAME_COUNT; nameCount *= 10) {
+      fprintf(stdout, "%10lu", (unsigned long)nameCount);
+
+      uint64_t shellTime = 0;
+      if (runAll != FALSE || nameCount <= MAX_SHELL_SORT_COUNT)
+         shellTime = measureSort(shellSort, pOriginal, pWork, nameCount);
+      printMeasurement(shellTime, nameCount);
+
+      printMeasurement(measureSort(quickSort, pOriginal, pWork, nameCount), nameCount);
+
+      uint64_t collationTime = measureSort(SortNames, pOriginal, pWork, nameCount);
+      printMeasurement(collationTime, nameCount);
+
+      if (collationTime == 0 || isSorted(pWork, nameCount) == FALSE) {
+         fputs("  NOT SORTED", stdout);
+         rc = 1;
+      }
+
+      fputc('\n', stdout);
+      fflush(stdout);
+   }
+
+   free(pWork);
+   free(pOriginal);
+   free(pPool);
+
+   return rc;
+}
@@ -0,0 +1,250 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Benchmark of the number formatter against snprintf.
+//
+// Usage: NumberFormatterBench
+//
+// All results are compared with the result of snprintf before they are measured.
+//
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "NumberFormatter.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Number of values per measurement.
+#define VALUE_COUNT 4096
+
+/// Minimum measurement time per formatter in nanoseconds.
+#define MIN_MEASUREMENT_NS 200000000ULL
+
+/// Minimum number of runs per formatter.
+#define MIN_RUNS 3
+
+// ******** Private types ********
+
+/// <summary>
+/// Formatter to measure. It formats the value with the given index.
+/// </summary>
+typedef size_t (*FORMAT_FUNCTION)(const ULONG index, char* const buffer);
+
+/// <summary>
+/// Pair of formatters that produce the same text.
+/// </summary>
+typedef struct _BENCH_CASE {
+   const char* name;
+   FORMAT_FUNCTION formatter;
+   FORMAT_FUNCTION reference;
+} BENCH_CASE;
+
+// ******** Private variables ********
+
+/// 32 bit values with all numbers of digits.
+static uint32_t values32[VALUE_COUNT];
+
+/// 64 bit values with all numbers of digits.
+static uint64_t values64[VALUE_COUNT];
+
+/// Throughput values with two fraction digits, like in the benchmark output.
+static double throughputs[VALUE_COUNT];
+
+/// State of the pseudo random number generator.
+static uint64_t randomState = 0x9e3779b97f4a7c15ULL;
+
+/// Result sink, so that the compiler can not remove the formatting.
+static volatile size_t totalLength;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the next pseudo random number (xorshift64).
+/// </summary>
+/// <returns>Pseudo random number.</returns>
+static uint64_t nextRandom(void) {
+   uint64_t x = randomState;
+   x ^= x << 13;
+   x ^= x >> 7;
+   x ^= x << 17;
+   randomState = x;
+
+   return x;
+}
+
+/// <summary>
+/// Create the values. The number of digits is evenly distributed.
+/// </summary>
+static void createValues(void) {
+   for (ULONG i = 0; i < VALUE_COUNT; i++) {
+      values32[i] = (uint32_t)(nextRandom() >> (nextRandom() % 32 + 32));
+      values64[i] = nextRandom() >> (nextRandom() % 64);
+
+      // Values between 0.01 and 100000 that are not close to a rounding boundary.
+      throughputs[i] = (double)(nextRandom() % 10000000ULL) / 100.0 + 0.003;
+   }
+}
+
+static size_t formatUint32(const ULONG index, char* const buffer) {
+   return FormatUint32(values32[index], buffer);
+}
+
+static size_t printUint32(const ULONG index, char* const buffer) {
+   return (size_t)snprintf(buffer, NUMBER_BUFFER_SIZE, "%" PRIu32, values32[index]);
+}
+
+static size_t formatUint64(const ULONG index, char* const buffer) {
+   return FormatUint64(values64[index], buffer);
+}
+
+static size_t printUint64(const ULONG index, char* const buffer) {
+   return (size_t)snprintf(buffer, NUMBER_BUFFER_SIZE, "%" PRIu64, values64[index]);
+}
+
+static size_t formatUint64WithSeparator(const ULONG index, char* const buffer) {
+   return FormatUint64WithSeparator(values64[index], ',', buffer);
+}
+
+/// <summary>
+/// Format with snprintf and insert the separators afterwards, as there is no portable printf flag for it.
+/// </summary>
+static size_t printUint64WithSeparator(const ULONG index, char* const buffer) {
+   char digits[NUMBER_BUFFER_SIZE];
+   size_t digitCount = (size_t)snprintf(digits, sizeof(digits), "%" PRIu64, values64[index]);
+   size_t length = 0;
+
+   for (size_t i = 0; i < digitCount; i++) {
+      if (i != 0 && (digitCount - i) % 3 == 0)
+         buffer[length++] = ',';
+
+      buffer[length++] = digits[i];
+   }
+
+   buffer[length] = 0;
+
+   return length;
+}
+
+static size_t formatFixedPoint(const ULONG index, char* const buffer) {
+   return FormatFixedPoint(throughputs[index], 2, buffer);
+}
+
+static size_t printFixedPoint(const ULONG index, char* const buffer) {
+   return (size_t)snprintf(buffer, NUMBER_BUFFER_SIZE, "%.2f", throughputs[index]);
+}
+
+/// <summary>
+/// Measure a formatter.
+/// </summary>
+/// <param name="formatFunction">Formatter.</param>
+/// <returns>Fastest time per value in nanoseconds.</returns>
+static double measureFormatter(const FORMAT_FUNCTION formatFunction) {
+   char buffer[NUMBER_BUFFER_SIZE];
+   uint64_t fastest = UINT64_MAX;
+   uint64_t total = 0;
+
+   for (ULONG run = 0; run < MIN_RUNS || total < MIN_MEASUREMENT_NS; run++) {
+      size_t length = 0;
+
+      uint64_t startTime = GetTimeNs();
+      for (ULONG i = 0; i < VALUE_COUNT; i++)
+         length += formatFunction(i, buffer);
+
+      uint64_t duration = GetTimeNs() - startTime;
+      if (duration < fastest)
+         fastest = duration;
+
+      total += duration;
+      totalLength = length;
+   }
+
+   return (double)fastest / VALUE_COUNT;
+}
+
+/// <summary>
+/// Check that a formatter produces the same text as its reference.
+/// </summary>
+/// <param name="pCase">Formatter and reference.</param>
+/// <returns>TRUE, if all texts are the same, FALSE if not.</returns>
+static BOOL isSameResult(const BENCH_CASE* const pCase) {
+   for (ULONG i = 0; i < VALUE_COUNT; i++) {
+      char expected[NUMBER_BUFFER_SIZE];
+      char actual[NUMBER_BUFFER_SIZE];
+
+      size_t expectedLength = pCase->reference(i, expected);
+      size_t actualLength = pCase->formatter(i, actual);
+
+      if (expectedLength != actualLength || strcmp(expected, actual) != 0) {
+         fprintf(stdout, "  DIFFERENT: \"%s\" instead of \"%s\"", actual, expected);
+         return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+// ******** Main method ********
+
+int main(void) {
+   const BENCH_CASE cases[] = {
+      {"32 bit", formatUint32, printUint32},
+      {"64 bit", formatUint64, printUint64},
+      {"64 bit grouped", formatUint64WithSeparator, printUint64WithSeparator},
+      {"Fixed point .2", formatFixedPoint, printFixedPoint}
+   };
+
+   createValues();
+
+   fputs("Value type        snprintf   Formatter   Speedup\n", stdout);
+
+   int rc = 0;
+   for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+      const BENCH_CASE* pCase = cases + i;
+
+      fprintf(stdout, "%-15s", pCase->name);
+
+      if (isSameResult(pCase) == FALSE) {
+         fputc('\n', stdout);
+         rc = 1;
+         continue;
+      }
+
+      double referenceTime = measureFormatter(pCase->reference);
+      double formatterTime = measureFormatter(pCase->formatter);
+
+      fprintf(stdout, " %8.1f ns %8.1f ns %8.1fx\n", referenceTime, formatterTime, referenceTime / formatterTime);
+      fflush(stdout);
+   }
+
+   return rc;
+}
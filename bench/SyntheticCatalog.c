@@ -0,0 +1,263 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Generator of synthetic algorithm catalogs with the name and class distribution of real providers.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "SyntheticCatalog.h"
+
+// ******** Private constants ********
+
+/// Maximum length of a synthetic name including the terminating 0.
+#define MAX_NAME_LENGTH 48
+
+// ******** Private types ********
+
+/// <summary>
+/// Documented algorithm identifier and its interface class.
+/// </summary>
+typedef struct _KNOWN_ALGORITHM {
+   const wchar_t* name;
+   ULONG algorithmClass;
+   BOOL canSign;
+} KNOWN_ALGORITHM;
+
+// ******** Private constants ********
+
+/// Documented CNG algorithm identifiers in the order of their frequency in vendor providers.
+static const KNOWN_ALGORITHM knownAlgorithms[] = {
+   { L"AES",                BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"SHA256",             BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"RSA",                BCRYPT_ASYMMETRIC_ENCRYPTION_INTERFACE, TRUE },
+   { L"SHA384",             BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"SHA512",             BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"ECDSA_P256",         BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"ECDH_P256",          BCRYPT_SECRET_AGREEMENT_INTERFACE,      FALSE },
+   { L"SHA1",               BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"RNG",                BCRYPT_RNG_INTERFACE,                   FALSE },
+   { L"ECDSA_P384",         BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"ECDH_P384",          BCRYPT_SECRET_AGREEMENT_INTERFACE,      FALSE },
+   { L"HKDF",               BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"SHA3-256",           BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"CHACHA20_POLY1305",  BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"ECDSA_P521",         BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"ECDH_P521",          BCRYPT_SECRET_AGREEMENT_INTERFACE,      FALSE },
+   { L"PBKDF2",             BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"SP800_108_CTR_HMAC", BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"ML-KEM",             BCRYPT_ASYMMETRIC_ENCRYPTION_INTERFACE, FALSE },
+   { L"ML-DSA",             BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"ECDSA",              BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"ECDH",               BCRYPT_SECRET_AGREEMENT_INTERFACE,      FALSE },
+   { L"AES-GMAC",           BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"AES-CMAC",           BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"XTS-AES",            BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"SHA3-384",           BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"SHA3-512",           BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"CSHAKE128",          BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"CSHAKE256",          BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"KMAC128",            BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"KMAC256",            BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"SLH-DSA",            BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"LMS",                BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"XMSS",               BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"DH",                 BCRYPT_SECRET_AGREEMENT_INTERFACE,      FALSE },
+   { L"DSA",                BCRYPT_SIGNATURE_INTERFACE,             FALSE },
+   { L"3DES",               BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"3DES_112",           BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"MD5",                BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"TLS1_1_KDF",         BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"TLS1_2_KDF",         BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"SP800_56A_CONCAT",   BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"CAPI_KDF",           BCRYPT_KEY_DERIVATION_INTERFACE,        FALSE },
+   { L"DES",                BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"DESX",               BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"RC2",                BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"RC4",                BCRYPT_CIPHER_INTERFACE,                FALSE },
+   { L"MD4",                BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"MD2",                BCRYPT_HASH_INTERFACE,                  FALSE },
+   { L"DUALECRNG",          BCRYPT_RNG_INTERFACE,                   FALSE },
+   { L"FIPS186DSARNG",      BCRYPT_RNG_INTERFACE,                   FALSE }
+};
+
+/// Number of documented identifiers.
+#define KNOWN_ALGORITHM_COUNT (sizeof(knownAlgorithms) / sizeof(knownAlgorithms[0]))
+
+/// Vendors of the variants.
+static const wchar_t* const vendorNames[] = {
+   L"CONTOSO", L"FABRIKAM", L"LITWARE", L"NORTHWIND", L"TAILSPIN", L"WOODGROVE"
+};
+
+/// Number of vendors.
+#define VENDOR_COUNT (sizeof(vendorNames) / sizeof(vendorNames[0]))
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the next pseudo random number (xorshift32).
+/// </summary>
+/// <param name="pState">State of the generator.</param>
+/// <returns>Pseudo random number.</returns>
+static ULONG nextRandom(ULONG* const pState) {
+   ULONG x = *pState;
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   *pState = x;
+
+   return x;
+}
+
+/// <summary>
+/// Pick a documented algorithm. The first ones in the list are picked more often.
+/// </summary>
+/// <param name="pState">State of the generator.</param>
+/// <returns>Index of the algorithm.</returns>
+static ULONG pickKnownAlgorithm(ULONG* const pState) {
+   // The minimum of two uniform numbers has a linearly falling distribution.
+   ULONG first = nextRandom(pState) % KNOWN_ALGORITHM_COUNT;
+   ULONG second = nextRandom(pState) % KNOWN_ALGORITHM_COUNT;
+
+   return (first < second) ? first : second;
+}
+
+/// <summary>
+/// Create the name of a vendor variant.
+/// The index makes the name unique. Some variants have a key or parameter size, like real vendor algorithms.
+/// </summary>
+/// <param name="pName">Buffer of MAX_NAME_LENGTH characters for the name.</param>
+/// <param name="pKnown">Documented algorithm the variant is based on.</param>
+/// <param name="index">Index of the variant.</param>
+/// <param name="pState">State of the generator.</param>
+static void createVariantName(wchar_t* const pName, const KNOWN_ALGORITHM* const pKnown, const ULONG index, ULONG* const pState) {
+   ULONG random = nextRandom(pState);
+   const wchar_t* vendor = vendorNames[random % VENDOR_COUNT];
+
+   switch ((random >> 8) & 3) {
+   case 0:
+      swprintf(pName, MAX_NAME_LENGTH, L"%ls_%ls_%lu", pKnown->name, vendor, (unsigned long)index);
+      break;
+
+   case 1:
+      swprintf(pName, MAX_NAME_LENGTH, L"%ls%lu_%ls", pKnown->name, (unsigned long)index, vendor);
+      break;
+
+   case 2:
+      swprintf(pName, MAX_NAME_LENGTH, L"%ls-%lu_%ls%lu", pKnown->name, 128UL << ((random >> 12) & 3), vendor, (unsigned long)index);
+      break;
+
+   default:
+      swprintf(pName, MAX_NAME_LENGTH, L"%ls_%lu", vendor, (unsigned long)index);
+      break;
+   }
+}
+
+// ******** Public methods ********
+
+/// <summary>
+/// Create a synthetic catalog.
+/// The first names are the documented CNG algorithm identifiers. The others are vendor variants of them,
+/// with the common algorithms more frequent than the rare ones. All names are unique.
+/// The same seed always creates the same catalog.
+/// </summary>
+/// <param name="pCatalog">Pointer to the catalog to fill.</param>
+/// <param name="count">Number of algorithms.</param>
+/// <param name="seed">Seed of the pseudo random numbers. Must not be 0.</param>
+/// <returns>TRUE, if the catalog could be created, FALSE if there is not enough memory.</returns>
+BOOL CreateSyntheticCatalog(SYNTHETIC_CATALOG* const pCatalog, const ULONG count, const ULONG seed) {
+   memset(pCatalog, 0, sizeof(SYNTHETIC_CATALOG));
+
+   pCatalog->pAlgorithms = malloc(((size_t)count + 1) * sizeof(BCRYPT_ALGORITHM_IDENTIFIER));
+   pCatalog->pSigningAlgorithms = malloc(((size_t)count + 1) * sizeof(BCRYPT_ALGORITHM_IDENTIFIER));
+   pCatalog->pNamePool = malloc(((size_t)count + 1) * MAX_NAME_LENGTH * sizeof(wchar_t));
+   if (pCatalog->pAlgorithms == NULL || pCatalog->pSigningAlgorithms == NULL || pCatalog->pNamePool == NULL) {
+      FreeSyntheticCatalog(pCatalog);
+      return FALSE;
+   }
+
+   // 1. Create the names. The documented ones come first, then the vendor variants.
+   ULONG state = seed;
+   for (ULONG i = 0; i < count; i++) {
+      wchar_t* pName = pCatalog->pNamePool + (size_t)i * MAX_NAME_LENGTH;
+
+      const KNOWN_ALGORITHM* pKnown;
+      if (i < KNOWN_ALGORITHM_COUNT) {
+         pKnown = knownAlgorithms + i;
+         wcscpy(pName, pKnown->name);
+      } else {
+         pKnown = knownAlgorithms + pickKnownAlgorithm(&state);
+         createVariantName(pName, pKnown, i, &state);
+      }
+
+      BCRYPT_ALGORITHM_IDENTIFIER* pAlgorithm = pCatalog->pAlgorithms + i;
+      pAlgorithm->pszName = pName;
+      pAlgorithm->dwClass = pKnown->algorithmClass;
+      pAlgorithm->dwFlags = 0;
+   }
+
+   pCatalog->count = count;
+
+   // 2. Shuffle the algorithms, as an enumeration does not return them sorted (Fisher-Yates).
+   for (ULONG i = count; i > 1; i--) {
+      ULONG j = nextRandom(&state) % i;
+      BCRYPT_ALGORITHM_IDENTIFIER temp = pCatalog->pAlgorithms[i - 1];
+      pCatalog->pAlgorithms[i - 1] = pCatalog->pAlgorithms[j];
+      pCatalog->pAlgorithms[j] = temp;
+   }
+
+   // 3. Collect the algorithms that can sign. These are the signature algorithms and the asymmetric ciphers that can sign.
+   for (ULONG i = 0; i < count; i++) {
+      const BCRYPT_ALGORITHM_IDENTIFIER* pAlgorithm = pCatalog->pAlgorithms + i;
+      BOOL canSign = (pAlgorithm->dwClass == BCRYPT_SIGNATURE_INTERFACE);
+      if (pAlgorithm->dwClass == BCRYPT_ASYMMETRIC_ENCRYPTION_INTERFACE)
+         for (ULONG k = 0; k < KNOWN_ALGORITHM_COUNT; k++)
+            if (knownAlgorithms[k].canSign != FALSE && wcsncmp(pAlgorithm->pszName, knownAlgorithms[k].name, wcslen(knownAlgorithms[k].name)) == 0)
+               canSign = TRUE;
+
+      if (canSign != FALSE)
+         pCatalog->pSigningAlgorithms[pCatalog->signingCount++] = *pAlgorithm;
+   }
+
+   return TRUE;
+}
+
+/// <summary>
+/// Release a synthetic catalog.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+void FreeSyntheticCatalog(SYNTHETIC_CATALOG* const pCatalog) {
+   free(pCatalog->pAlgorithms);
+   free(pCatalog->pSigningAlgorithms);
+   free(pCatalog->pNamePool);
+
+   memset(pCatalog, 0, sizeof(SYNTHETIC_CATALOG));
+}
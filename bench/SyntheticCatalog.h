@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Platform.h"
+
+/// <summary>
+/// Synthetic algorithm catalog for the benchmarks.
+/// </summary>
+typedef struct _SYNTHETIC_CATALOG {
+   /// Number of algorithms.
+   ULONG count;
+
+   /// Algorithms in enumeration order, which is not sorted.
+   BCRYPT_ALGORITHM_IDENTIFIER* pAlgorithms;
+
+   /// Algorithms that can sign, in the same order.
+   BCRYPT_ALGORITHM_IDENTIFIER* pSigningAlgorithms;
+
+   /// Number of algorithms that can sign.
+   ULONG signingCount;
+
+   /// Memory of the names.
+   wchar_t* pNamePool;
+} SYNTHETIC_CATALOG;
+
+/// <summary>
+/// Create a synthetic catalog.
+/// The first names are the documented CNG algorithm identifiers. The others are vendor variants of them,
+/// with the common algorithms more frequent than the rare ones. All names are unique.
+/// The same seed always creates the same catalog.
+/// </summary>
+/// <param name="pCatalog">Pointer to the catalog to fill.</param>
+/// <param name="count">Number of algorithms.</param>
+/// <param name="seed">Seed of the pseudo random numbers. Must not be 0.</param>
+/// <returns>TRUE, if the catalog could be created, FALSE if there is not enough memory.</returns>
+BOOL CreateSyntheticCatalog(SYNTHETIC_CATALOG* const pCatalog, const ULONG count, const ULONG seed);
+
+/// <summary>
+/// Release a synthetic catalog.
+/// </summary>
+/// <param name="pCatalog">Catalog.</param>
+void FreeSyntheticCatalog(SYNTHETIC_CATALOG* const pCatalog);
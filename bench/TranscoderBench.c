@@ -0,0 +1,373 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Benchmark of the UTF-8 transcoder against the former character by character encoder and wcstombs.
+//
+// Usage: TranscoderBench
+//
+// wcstombs is only measured, if a UTF-8 locale is available.
+//
+
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "Timer.h"
+#include "Transcoder.h"
+
+// ******** Private constants ********
+
+/// Number of short names.
+#define NAME_COUNT 1024
+
+/// Maximum length of a short name including the terminating 0.
+#define MAX_NAME_LENGTH 32
+
+/// Length of the long texts in wide characters.
+#define TEXT_LENGTH 4096
+
+/// Maximum number of bytes a wide character needs in UTF-8.
+#define MAX_BYTES_PER_WIDE_CHARACTER 4
+
+/// Minimum measurement time per encoder and input in nanoseconds.
+#define MIN_MEASUREMENT_NS 200000000ULL
+
+/// Minimum number of runs per encoder and input.
+#define MIN_RUNS 3
+
+// ******** Private types ********
+
+/// <summary>
+/// Encoder to measure.
+/// </summary>
+typedef size_t (*ENCODE_FUNCTION)(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize);
+
+/// <summary>
+/// Input of a measurement: A list of 0 terminated strings.
+/// </summary>
+typedef struct _BENCH_INPUT {
+   const char* name;
+   const wchar_t** pStrings;
+   size_t* pLengths;
+   ULONG count;
+} BENCH_INPUT;
+
+// ******** Private variables ********
+
+/// Prefixes of the short names. They resemble real algorithm names.
+static const wchar_t* const namePrefixes[] = {
+   L"AES", L"AES_GCM_", L"CHACHA20_POLY", L"DH", L"DSA", L"ECDH_P", L"ECDSA_P",
+   L"HKDF", L"KMAC", L"MD", L"PBKDF", L"RC", L"RSA", L"SHA", L"SHA3-", L"SP800_"
+};
+
+/// State of the pseudo random number generator.
+static ULONG randomState = 0x2545f491UL;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Get the next pseudo random number (xorshift32).
+/// </summary>
+/// <returns>Pseudo random number.</returns>
+static ULONG nextRandom(void) {
+   ULONG x = randomState;
+   x ^= x << 13;
+   x ^= x >> 17;
+   x ^= x << 5;
+   randomState = x;
+
+   return x;
+}
+
+/// <summary>
+/// The encoder that was used before. It converts one character at a time.
+/// </summary>
+/// <param name="wideString">Wide character string.</param>
+/// <param name="wideLength">Number of wide characters.</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0.</returns>
+static size_t encodeByCharacter(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize) {
+   if (bufferSize == 0)
+      return 0;
+
+   const wchar_t* pWide = wideString;
+   const wchar_t* const pEnd = wideString + wideLength;
+   size_t length = 0;
+   const size_t limit = bufferSize - 1;
+
+   while (pWide < pEnd) {
+      uint32_t codePoint = (uint32_t)*pWide++;
+
+#if WCHAR_MAX <= 0xffff
+      if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+         uint32_t low = (pWide < pEnd) ? (uint32_t)*pWide : 0;
+         if (low >= 0xdc00 && low <= 0xdfff) {
+            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+            pWide++;
+         } else
+            codePoint = 0xfffd;
+      } else if (codePoint >= 0xdc00 && codePoint <= 0xdfff)
+         codePoint = 0xfffd;
+#else
+      if (codePoint > 0x10ffff || (codePoint >= 0xd800 && codePoint <= 0xdfff))
+         codePoint = 0xfffd;
+#endif
+
+      if (codePoint < 0x80) {
+         if (length + 1 > limit)
+            break;
+
+         buffer[length++] = (char)codePoint;
+      } else if (codePoint < 0x800) {
+         if (length + 2 > limit)
+            break;
+
+         buffer[length++] = (char)(0xc0 | (codePoint >> 6));
+         buffer[length++] = (char)(0x80 | (codePoint & 0x3f));
+      } else if (codePoint < 0x10000) {
+         if (length + 3 > limit)
+            break;
+
+         buffer[length++] = (char)(0xe0 | (codePoint >> 12));
+         buffer[length++] = (char)(0x80 | ((codePoint >> 6) & 0x3f));
+         buffer[length++] = (char)(0x80 | (codePoint & 0x3f));
+      } else {
+         if (length + 4 > limit)
+            break;
+
+         buffer[length++] = (char)(0xf0 | (codePoint >> 18));
+         buffer[length++] = (char)(0x80 | ((codePoint >> 12) & 0x3f));
+         buffer[length++] = (char)(0x80 | ((codePoint >> 6) & 0x3f));
+         buffer[length++] = (char)(0x80 | (codePoint & 0x3f));
+      }
+   }
+
+   buffer[length] = 0;
+
+   return length;
+}
+
+/// <summary>
+/// Encode with wcstombs. The string has to be 0 terminated.
+/// </summary>
+/// <param name="wideString">Wide character string.</param>
+/// <param name="wideLength">Number of wide characters (not used).</param>
+/// <param name="buffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer in bytes.</param>
+/// <returns>Number of bytes written without the terminating 0. 0, if the string could not be converted.</returns>
+static size_t encodeWithLibrary(const wchar_t* const wideString, const size_t wideLength, char* const buffer, const size_t bufferSize) {
+   (void)wideLength;
+
+   size_t length = wcstombs(buffer, wideString, bufferSize);
+
+   return (length != (size_t)-1) ? length : 0;
+}
+
+/// <summary>
+/// Create the short names.
+/// </summary>
+/// <param name="pPool">Pool for the names with room for NAME_COUNT names of MAX_NAME_LENGTH characters.</param>
+/// <param name="pInput">Input that receives the names.</param>
+static void createNames(wchar_t* const pPool, BENCH_INPUT* const pInput) {
+   const ULONG prefixCount = sizeof(namePrefixes) / sizeof(namePrefixes[0]);
+
+   for (ULONG i = 0; i < pInput->count; i++) {
+      wchar_t* pName = pPool + (size_t)i * MAX_NAME_LENGTH;
+      ULONG random = nextRandom();
+
+      swprintf(pName, MAX_NAME_LENGTH, L"%ls%lu", namePrefixes[random % prefixCount], (unsigned long)(nextRandom() % 100000UL));
+
+      pInput->pStrings[i] = pName;
+      pInput->pLengths[i] = wcslen(pName);
+   }
+}
+
+/// <summary>
+/// Create a long text.
+/// </summary>
+/// <param name="pText">Buffer with room for TEXT_LENGTH + 1 characters.</param>
+/// <param name="nonAsciiDistance">Distance of the non-ASCII characters. 0 means no non-ASCII characters.</param>
+/// <param name="firstCharacter">First character of the non-ASCII characters.</param>
+/// <param name="characterRange">Number of different non-ASCII characters.</param>
+static void createText(wchar_t* const pText, const ULONG nonAsciiDistance, const ULONG firstCharacter, const ULONG characterRange) {
+   for (ULONG i = 0; i < TEXT_LENGTH; i++) {
+      if (nonAsciiDistance != 0 && (i % nonAsciiDistance) == nonAsciiDistance - 1)
+         pText[i] = (wchar_t)(firstCharacter + nextRandom() % characterRange);
+      else
+         pText[i] = (wchar_t)(L' ' + nextRandom() % 95);
+   }
+
+   pText[TEXT_LENGTH] = 0;
+}
+
+/// <summary>
+/// Measure an encoder.
+/// </summary>
+/// <param name="encodeFunction">Encoder.</param>
+/// <param name="pInput">Input.</param>
+/// <param name="pBuffer">Destination buffer.</param>
+/// <param name="bufferSize">Size of the destination buffer.</param>
+/// <param name="pByteCount">Pointer to the variable that receives the number of bytes produced by one run.</param>
+/// <returns>Fastest time of a run in nanoseconds.</returns>
+static uint64_t measureEncoder(const ENCODE_FUNCTION encodeFunction, const BENCH_INPUT* const pInput, char* const pBuffer, const size_t bufferSize, size_t* const pByteCount) {
+   uint64_t fastest = UINT64_MAX;
+   uint64_t total = 0;
+   size_t byteCount = 0;
+
+   for (ULONG run = 0; run < MIN_RUNS || total < MIN_MEASUREMENT_NS; run++) {
+      byteCount = 0;
+
+      uint64_t startTime = GetTimeNs();
+      for (ULONG i = 0; i < pInput->count; i++)
+         byteCount += encodeFunction(pInput->pStrings[i], pInput->pLengths[i], pBuffer, bufferSize);
+
+      uint64_t duration = GetTimeNs() - startTime;
+      if (duration < fastest)
+         fastest = duration;
+
+      total += duration;
+   }
+
+   *pByteCount = byteCount;
+
+   return fastest;
+}
+
+/// <summary>
+/// Print a measurement.
+/// </summary>
+/// <param name="nanoseconds">Duration in nanoseconds. 0 means not measured.</param>
+/// <param name="byteCount">Number of bytes produced.</param>
+static void printMeasurement(const uint64_t nanoseconds, const size_t byteCount) {
+   if (nanoseconds == 0)
+      fputs("         skipped", stdout);
+   else
+      fprintf(stdout, " %10.1f MB/s", (double)byteCount * 1000.0 / (double)nanoseconds);
+}
+
+/// <summary>
+/// Check that the transcoder produces the same bytes as the former encoder, also if the buffer is too small.
+/// </summary>
+/// <param name="pInput">Input.</param>
+/// <param name="pExpected">Buffer for the expected bytes.</param>
+/// <param name="pActual">Buffer for the actual bytes.</param>
+/// <param name="bufferSize">Size of the buffers.</param>
+/// <returns>TRUE, if the results are the same, FALSE if not.</returns>
+static BOOL isSameResult(const BENCH_INPUT* const pInput, char* const pExpected, char* const pActual, const size_t bufferSize) {
+   for (ULONG i = 0; i < pInput->count; i++) {
+      // Check the full buffer and some sizes that truncate the output.
+      size_t sizes[] = {bufferSize, 1, 2, 7, 16, 17, 33, pInput->pLengths[i]};
+
+      for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+         size_t size = (sizes[s] < bufferSize) ? sizes[s] : bufferSize;
+         size_t expectedLength = encodeByCharacter(pInput->pStrings[i], pInput->pLengths[i], pExpected, size);
+         size_t actualLength = TranscodeToUtf8(pInput->pStrings[i], pInput->pLengths[i], pActual, size);
+
+         if (expectedLength != actualLength || memcmp(pExpected, pActual, expectedLength + 1) != 0)
+            return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+// ******** Main method ********
+
+int main(void) {
+   BOOL hasUtf8Locale = (setlocale(LC_CTYPE, "C.UTF-8") != NULL || setlocale(LC_CTYPE, "en_US.UTF-8") != NULL);
+
+   // 1. Create the inputs.
+   static wchar_t namePool[NAME_COUNT * MAX_NAME_LENGTH];
+   static const wchar_t* pNames[NAME_COUNT];
+   static size_t nameLengths[NAME_COUNT];
+
+   static wchar_t asciiText[TEXT_LENGTH + 1];
+   static wchar_t mixedText[TEXT_LENGTH + 1];
+   static wchar_t cjkText[TEXT_LENGTH + 1];
+   const wchar_t* pTexts[] = {asciiText, mixedText, cjkText};
+   size_t textLength = TEXT_LENGTH;
+
+   BENCH_INPUT inputs[] = {
+      {"Short ASCII names", pNames, nameLengths, NAME_COUNT},
+      {"4 KiB ASCII text", pTexts, &textLength, 1},
+      {"Mixed text", pTexts + 1, &textLength, 1},
+      {"CJK text", pTexts + 2, &textLength, 1}
+   };
+
+   createNames(namePool, &inputs[0]);
+   createText(asciiText, 0, 0, 1);
+   createText(mixedText, 24, 0xc0, 0x40);  // Latin-1 letters.
+   createText(cjkText, 1, 0x4e00, 0x5200);  // CJK unified ideographs.
+
+   const size_t bufferSize = TEXT_LENGTH * MAX_BYTES_PER_WIDE_CHARACTER + 1;
+   char* pExpected = malloc(bufferSize);
+   char* pActual = malloc(bufferSize);
+   if (pExpected == NULL || pActual == NULL) {
+      fputs("Not enough memory.\n", stderr);
+      return 2;
+   }
+
+   // 2. Measure the encoders.
+   fputs("Input                  By character     Transcoder       wcstombs\n", stdout);
+
+   int rc = 0;
+   for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      const BENCH_INPUT* pInput = inputs + i;
+      size_t byteCount;
+
+      fprintf(stdout, "%-18s", pInput->name);
+
+      uint64_t duration = measureEncoder(encodeByCharacter, pInput, pExpected, bufferSize, &byteCount);
+      printMeasurement(duration, byteCount);
+
+      duration = measureEncoder(TranscodeToUtf8, pInput, pActual, bufferSize, &byteCount);
+      printMeasurement(duration, byteCount);
+
+      duration = 0;
+      if (hasUtf8Locale != FALSE)
+         duration = measureEncoder(encodeWithLibrary, pInput, pActual, bufferSize, &byteCount);
+      printMeasurement(duration, byteCount);
+
+      if (isSameResult(pInput, pExpected, pActual, bufferSize) == FALSE) {
+         fputs("  DIFFERENT", stdout);
+         rc = 1;
+      }
+
+      fputc('\n', stdout);
+      fflush(stdout);
+   }
+
+   free(pActual);
+   free(pExpected);
+
+   return rc;
+}
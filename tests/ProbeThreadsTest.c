@@ -0,0 +1,206 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Test of the thread bound of the probes with the fixture backend.
+//
+// Usage: ProbeThreadsTest <snapshot file> <output file>
+//
+// The algorithms are listed like "bcryptenum --fixture <snapshot file> --details --threads <n>" for several n.
+// Each probe holds the algorithm open for a moment, so that the probes overlap.
+// The number of algorithms that are open at the same time must not exceed n.
+// The output file is overwritten.
+//
+
+#include <stdio.h>
+#include <string.h>
+
+#include "BCryptList.h"
+#include "FixtureBackend.h"
+#include "Timer.h"
+
+// ******** Private constants ********
+
+/// Time an algorithm is held open in milliseconds.
+#define HOLD_TIME_MS 2
+
+/// Thread counts that are tested.
+static const ULONG threadCounts[] = { 1, 2, 3, 4 };
+
+/// Number of thread counts.
+#define THREAD_COUNT_COUNT (sizeof(threadCounts) / sizeof(threadCounts[0]))
+
+// ******** Private variables ********
+
+/// OpenAlgorithm function of the fixture backend.
+static NTSTATUS (*fixtureOpenAlgorithm)(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm);
+
+/// Number of probes that are running.
+static volatile LONG activeCount;
+
+/// Largest number of probes that ran at the same time.
+static volatile LONG maxActiveCount;
+
+/// Number of probes.
+static volatile LONG openCount;
+
+// ******** Private methods ********
+
+/// <summary>
+/// Add a value to a counter.
+/// </summary>
+/// <param name="pCounter">Pointer to the counter.</param>
+/// <param name="value">Value to add.</param>
+/// <returns>Value of the counter after the addition.</returns>
+static inline LONG addToCounter(volatile LONG* const pCounter, const LONG value) {
+#ifdef _WIN32
+   return InterlockedExchangeAdd(pCounter, value) + value;
+#else
+   return __atomic_add_fetch(pCounter, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/// <summary>
+/// Raise the maximum to a value, if it is smaller.
+/// </summary>
+/// <param name="pMaximum">Pointer to the maximum.</param>
+/// <param name="value">Value.</param>
+static inline void raiseMaximum(volatile LONG* const pMaximum, const LONG value) {
+#ifdef _WIN32
+   LONG current = InterlockedCompareExchange(pMaximum, 0, 0);
+   while (current < value) {
+      LONG previous = InterlockedCompareExchange(pMaximum, value, current);
+      if (previous == current)
+         break;
+
+      current = previous;
+   }
+#else
+   LONG current = __atomic_load_n(pMaximum, __ATOMIC_SEQ_CST);
+   while (current < value &&
+          __atomic_compare_exchange_n(pMaximum, &current, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) == 0)
+      ;
+#endif
+}
+
+/// <summary>
+/// OpenAlgorithm function of the test backend.
+/// It counts the probes that run at the same time and holds each one for a moment.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <param name="algorithmName">Name of the algorithm.</param>
+/// <param name="phAlgorithm">Pointer to the variable that receives the algorithm handle.</param>
+/// <returns>Result of the fixture.</returns>
+static NTSTATUS countingOpenAlgorithm(PVOID const context, LPCWSTR const algorithmName, BCRYPT_ALG_HANDLE* const phAlgorithm) {
+   addToCounter(&openCount, 1);
+   raiseMaximum(&maxActiveCount, addToCounter(&activeCount, 1));
+
+   SleepMilliseconds(HOLD_TIME_MS);
+   NTSTATUS nts = fixtureOpenAlgorithm(context, algorithmName, phAlgorithm);
+
+   addToCounter(&activeCount, -1);
+
+   return nts;
+}
+
+// ******** Main method ********
+
+int main(int argc, char* argv[]) {
+   if (argc != 3) {
+      fputs("Usage: ProbeThreadsTest <snapshot file> <output file>\n", stderr);
+      return 2;
+   }
+
+   const char* snapshotPath = argv[1];
+   const char* outputPath = argv[2];
+
+   // 1. Open the fixture and count its probes.
+   ALGORITHM_BACKEND* pFixture = OpenFixtureBackend(snapshotPath);
+   if (pFixture == NULL)
+      return 2;
+
+   fixtureOpenAlgorithm = pFixture->OpenAlgorithm;
+   pFixture->OpenAlgorithm = countingOpenAlgorithm;
+
+   // 2. List with the details into the output file.
+   if (freopen(outputPath, "wb", stdout) == NULL) {
+      fprintf(stderr, "Could not create \"%s\".\n", outputPath);
+      CloseFixtureBackend(pFixture);
+      return 2;
+   }
+
+   LIST_OPTIONS options;
+   memset(&options, 0, sizeof(options));
+   options.showDetails = TRUE;
+
+   ULONG errorCount = 0;
+   for (ULONG i = 0; i < THREAD_COUNT_COUNT; i++) {
+      options.maxThreads = threadCounts[i];
+      activeCount = 0;
+      maxActiveCount = 0;
+      openCount = 0;
+
+      unsigned char rc = ListAllTypes(pFixture, &options);
+
+      // 3. Check the result and the bound.
+      if (rc != 0) {
+         fprintf(stderr, "--threads %lu: the listing ended with code %u.\n", (unsigned long)options.maxThreads, (unsigned)rc);
+         errorCount++;
+      }
+
+      if (openCount == 0) {
+         fprintf(stderr, "--threads %lu: no algorithm was probed.\n", (unsigned long)options.maxThreads);
+         errorCount++;
+      }
+
+      if ((ULONG)maxActiveCount > options.maxThreads) {
+         fprintf(stderr,
+                 "--threads %lu: %ld probes ran at the same time.\n",
+                 (unsigned long)options.maxThreads,
+                 (long)maxActiveCount);
+         errorCount++;
+      } else
+         fprintf(stderr,
+                 "--threads %lu: %ld probes, at most %ld at the same time.\n",
+                 (unsigned long)options.maxThreads,
+                 (long)openCount,
+                 (long)maxActiveCount);
+   }
+
+   pFixture->OpenAlgorithm = fixtureOpenAlgorithm;
+   CloseFixtureBackend(pFixture);
+
+   if (errorCount != 0) {
+      fprintf(stderr, "%lu errors.\n", (unsigned long)errorCount);
+      return 1;
+   }
+
+   fputs("All thread bounds held.\n", stderr);
+
+   return 0;
+}
@@ -0,0 +1,282 @@
+//
+// SPDX-FileCopyrightText: Copyright 2026 Frank Schwab
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// SPDX-FileType: SOURCE
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// You may not use this file except in compliance with the License.
+//
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Author: Frank Schwab
+//
+// Version: 1.0.0
+//
+// Change history:
+//    2026-10-16: V1.0.0: Created.
+//
+
+//
+// Test of the watch mode with the fixture backend.
+//
+// Usage: WatchFixtureTest <snapshot file> <output file>
+//
+// The watch runs like "bcryptenum --fixture <snapshot file> --watch 1 --watch-count 6".
+// Before each check the snapshot file is rewritten with the next step of a script:
+// algorithms are added, removed and changed and the module version is bumped.
+// The delta lines of each check are compared with the expected ones. Checks without a change must print nothing.
+// Both files are overwritten.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CatalogWatch.h"
+#include "FixtureBackend.h"
+
+// ******** Private constants ********
+
+/// Maximum number of delta lines of a check.
+#define MAX_DELTA_LINES 4
+
+/// Size of the buffer for a line of the output file.
+#define LINE_SIZE 256
+
+// ******** Private types ********
+
+/// <summary>
+/// One check of the script.
+/// </summary>
+typedef struct _WATCH_STEP {
+   /// Contents of the snapshot file before the check or NULL, if the file is not rewritten.
+   const char* pSnapshot;
+
+   /// Expected delta lines without the time, terminated by NULL.
+   const char* expectedLines[MAX_DELTA_LINES + 1];
+} WATCH_STEP;
+
+// ******** Private constants ********
+
+/// The script. The snapshots have different sizes, so that the change is seen even with a coarse file time.
+static const WATCH_STEP steps[] = {
+   {
+      "# bcryptenum snapshot 1\n"
+      "module bcrypt.dll 10.0.1.1\n"
+      "0x00000001 0x00000001 0x00000000 AES\n"
+      "0x00000002 0x00000002 0x00000000 SHA256\n",
+      { "v bcrypt.dll V10.0.1.1", "+ cipher AES 0x00000001 0x00000000", "+ hash SHA256 0x00000002 0x00000000", NULL }
+   },
+   {
+      NULL,
+      { NULL }
+   },
+   {
+      "# bcryptenum snapshot 1\n"
+      "module bcrypt.dll 10.0.1.1\n"
+      "0x00000001 0x00000001 0x00000000 AES\n"
+      "0x00000002 0x00000002 0x00000000 SHA256\n"
+      "0x00000002 0x00000002 0x00000000 SHA512\n",
+      { "+ hash SHA512 0x00000002 0x00000000", NULL }
+   },
+   {
+      NULL,
+      { NULL }
+   },
+   {
+      "# bcryptenum snapshot 1\n"
+      "module bcrypt.dll 10.0.1.10\n"
+      "0x00000001 0x00000001 0x00000001 AES\n"
+      "0x00000002 0x00000002 0x00000000 SHA512\n",
+      { "v bcrypt.dll V10.0.1.10", "~ cipher AES 0x00000001 0x00000001", "- hash SHA256", NULL }
+   },
+   {
+      NULL,
+      { NULL }
+   }
+};
+
+/// Number of checks.
+#define STEP_COUNT (sizeof(steps) / sizeof(steps[0]))
+
+// ******** Private variables ********
+
+/// Path of the snapshot file.
+static const char* snapshotPath;
+
+/// Refresh function of the fixture backend.
+static BOOL (*fixtureRefresh)(PVOID const context);
+
+/// Number of checks that have been started.
+static ULONG checkIndex;
+
+/// Position in the output file at the start of each check and at the end.
+static long checkOffsets[STEP_COUNT + 1];
+
+// ******** Private methods ********
+
+/// <summary>
+/// Write the snapshot file.
+/// </summary>
+/// <param name="pSnapshot">Contents of the snapshot file.</param>
+/// <returns>TRUE, if the file was written, FALSE if not.</returns>
+static BOOL writeSnapshot(const char* const pSnapshot) {
+   FILE* f = fopen(snapshotPath, "wb");
+   if (f == NULL) {
+      fprintf(stderr, "Could not create \"%s\".\n", snapshotPath);
+      return FALSE;
+   }
+
+   size_t length = strlen(pSnapshot);
+   BOOL result = (fwrite(pSnapshot, 1, length, f) == length);
+
+   if (fclose(f) != 0)
+      result = FALSE;
+
+   return result;
+}
+
+/// <summary>
+/// Refresh function of the test backend.
+/// It is called at the start of each check, so it notes where the output of the check starts,
+/// rewrites the snapshot file for the check and lets the fixture read it again.
+/// </summary>
+/// <param name="context">Fixture.</param>
+/// <returns>Result of the refresh of the fixture.</returns>
+static BOOL rewriteAndRefresh(PVOID const context) {
+   fflush(stdout);
+   checkOffsets[checkIndex] = ftell(stdout);
+
+   const char* pSnapshot = steps[checkIndex].pSnapshot;
+   checkIndex++;
+
+   if (pSnapshot != NULL && writeSnapshot(pSnapshot) == FALSE)
+      return FALSE;
+
+   return fixtureRefresh(context);
+}
+
+/// <summary>
+/// Compare the output of the checks with the expected delta lines.
+/// </summary>
+/// <param name="outputPath">Path of the output file.</param>
+/// <returns>Number of differences.</returns>
+static ULONG compareOutput(const char* const outputPath) {
+   FILE* f = fopen(outputPath, "rb");
+   if (f == NULL) {
+      fprintf(stderr, "Could not open \"%s\".\n", outputPath);
+      return 1;
+   }
+
+   ULONG errorCount = 0;
+   char line[LINE_SIZE];
+   for (ULONG s = 0; s < STEP_COUNT; s++) {
+      const WATCH_STEP* pStep = steps + s;
+      ULONG lineIndex = 0;
+
+      // 1. Each line is "<time> <marker> ...". The time is not compared.
+      fseek(f, checkOffsets[s], SEEK_SET);
+      while (ftell(f) < checkOffsets[s + 1] && fgets(line, LINE_SIZE, f) != NULL) {
+         line[strcspn(line, "\r\n")] = 0;
+
+         const char* pDelta = strchr(line, ' ');
+         pDelta = (pDelta != NULL) ? pDelta + 1 : line;
+
+         const char* pExpected = (lineIndex < MAX_DELTA_LINES) ? pStep->expectedLines[lineIndex] : NULL;
+         if (pExpected == NULL) {
+            fprintf(stderr, "Check %lu: unexpected line \"%s\".\n", (unsigned long)(s + 1), line);
+            errorCount++;
+         } else if (strcmp(pDelta, pExpected) != 0) {
+            fprintf(stderr, "Check %lu: line \"%s\" instead of \"%s\".\n", (unsigned long)(s + 1), line, pExpected);
+            errorCount++;
+         }
+
+         lineIndex++;
+      }
+
+      // 2. All expected lines have to be there.
+      for (; lineIndex < MAX_DELTA_LINES && pStep->expectedLines[lineIndex] != NULL; lineIndex++) {
+         fprintf(stderr, "Check %lu: missing line \"%s\".\n", (unsigned long)(s + 1), pStep->expectedLines[lineIndex]);
+         errorCount++;
+      }
+   }
+
+   fclose(f);
+
+   return errorCount;
+}
+
+// ******** Main method ********
+
+int main(int argc, char* argv[]) {
+   if (argc != 3) {
+      fputs("Usage: WatchFixtureTest <snapshot file> <output file>\n", stderr);
+      return 2;
+   }
+
+   snapshotPath = argv[1];
+   const char* outputPath = argv[2];
+
+   // 1. Open the fixture with the first step and redirect its refresh.
+   if (writeSnapshot(steps[0].pSnapshot) == FALSE)
+      return 2;
+
+   ALGORITHM_BACKEND* pFixture = OpenFixtureBackend(snapshotPath);
+   if (pFixture == NULL)
+      return 2;
+
+   fixtureRefresh = pFixture->Refresh;
+   pFixture->Refresh = rewriteAndRefresh;
+
+   // 2. Watch with the output in the output file.
+   if (freopen(outputPath, "w+b", stdout) == NULL) {
+      fprintf(stderr, "Could not create \"%s\".\n", outputPath);
+      CloseFixtureBackend(pFixture);
+      return 2;
+   }
+
+   WATCH_OPTIONS options;
+   memset(&options, 0, sizeof(options));
+   options.intervalMs = 1;
+   options.checkCount = STEP_COUNT;
+
+   unsigned char rc = WatchCatalog(pFixture, &options);
+
+   fflush(stdout);
+   checkOffsets[STEP_COUNT] = ftell(stdout);
+
+   pFixture->Refresh = fixtureRefresh;
+   CloseFixtureBackend(pFixture);
+
+   // 3. Compare the output.
+   ULONG errorCount = 0;
+   if (rc != 0) {
+      fprintf(stderr, "The watch ended with code %u.\n", (unsigned)rc);
+      errorCount++;
+   }
+
+   if (checkIndex != STEP_COUNT) {
+      fprintf(stderr, "%lu checks instead of %lu.\n", (unsigned long)checkIndex, (unsigned long)STEP_COUNT);
+      errorCount++;
+   } else
+      errorCount += compareOutput(outputPath);
+
+   if (errorCount != 0) {
+      fprintf(stderr, "%lu errors.\n", (unsigned long)errorCount);
+      return 1;
+   }
+
+   fprintf(stderr, "%lu checks passed.\n", (unsigned long)STEP_COUNT);
+
+   return 0;
+}